@@ -0,0 +1,218 @@
+/***********************************************************************************************/ /**
+                                                                                                   * \file bench_cfar.c
+                                                                                                   *
+                                                                                                   * \brief
+                                                                                                   * Benchmark of the CFAR detectors of the XENSIV BGT60TRxx library against direct evaluation.
+                                                                                                   *
+                                                                                                   ***************************************************************************************************
+                                                                                                   * \copyright
+                                                                                                   * Copyright 2022 Infineon Technologies AG
+                                                                                                   * SPDX-License-Identifier: Apache-2.0
+                                                                                                   **************************************************************************************************/
+
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "../xensiv_bgt60trxx.h"
+#include "../xensiv_bgt60trxx_cfar.h"
+
+/*******************************************************************************
+ * Macros
+ *******************************************************************************/
+#define MIN_DURATION_SEC 0.2
+
+#define GUARD_CELLS 2U
+#define TRAIN_CELLS 8U
+
+/*******************************************************************************
+ * Function Implementations
+ *******************************************************************************/
+
+static double now_sec(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double) ts.tv_sec + ((double) ts.tv_nsec * 1e-9);
+}
+
+/* Cell averaging CFAR summing the training window of every cell, wrapping the Doppler axis */
+static uint32_t naive_ca(const float *power, uint32_t rows, uint32_t cols, float factor)
+{
+    const int32_t reach = (int32_t) (GUARD_CELLS + TRAIN_CELLS);
+    const int32_t guard = (int32_t) GUARD_CELLS;
+    uint32_t num_detections = 0U;
+
+    for (int32_t i = 0; i < (int32_t) rows; ++i) {
+        for (int32_t j = 0; j < (int32_t) cols; ++j) {
+            float sum = 0.0f;
+            uint32_t count = 0U;
+            for (int32_t r = i - reach; r <= (i + reach); ++r) {
+                if ((r < 0) || (r >= (int32_t) rows)) {
+                    continue;
+                }
+                for (int32_t c = j - reach; c <= (j + reach); ++c) {
+                    if ((abs(r - i) <= guard) && (abs(c - j) <= guard)) {
+                        continue;
+                    }
+                    sum += power[(r * (int32_t) cols) + ((c + (int32_t) cols) % (int32_t) cols)];
+                    ++count;
+                }
+            }
+            num_detections += (power[(i * (int32_t) cols) + j] > (factor * sum / count)) ? 1U : 0U;
+        }
+    }
+
+    return num_detections;
+}
+
+static int compare_float(const void *a, const void *b)
+{
+    float x = *(const float *) a;
+    float y = *(const float *) b;
+    return (x > y) - (x < y);
+}
+
+/* Ordered statistic CFAR sorting the training window of every cell, wrapping the Doppler axis */
+static uint32_t naive_os(const float *power, uint32_t rows, uint32_t cols, float factor)
+{
+    const int32_t reach = (int32_t) (GUARD_CELLS + TRAIN_CELLS);
+    const int32_t guard = (int32_t) GUARD_CELLS;
+    static float cells[(2U * (GUARD_CELLS + TRAIN_CELLS) + 1U) *
+                       (2U * (GUARD_CELLS + TRAIN_CELLS) + 1U)];
+    uint32_t num_detections = 0U;
+
+    for (int32_t i = 0; i < (int32_t) rows; ++i) {
+        for (int32_t j = 0; j < (int32_t) cols; ++j) {
+            uint32_t count = 0U;
+            for (int32_t r = i - reach; r <= (i + reach); ++r) {
+                if ((r < 0) || (r >= (int32_t) rows)) {
+                    continue;
+                }
+                for (int32_t c = j - reach; c <= (j + reach); ++c) {
+                    if ((abs(r - i) <= guard) && (abs(c - j) <= guard)) {
+                        continue;
+                    }
+                    cells[count++] =
+                        power[(r * (int32_t) cols) + ((c + (int32_t) cols) % (int32_t) cols)];
+                }
+            }
+            qsort(cells, count, sizeof(float), compare_float);
+            float noise = cells[(3U * count) / 4U];
+            num_detections += (power[(i * (int32_t) cols) + j] > (factor * noise)) ? 1U : 0U;
+        }
+    }
+
+    return num_detections;
+}
+
+int main(void)
+{
+    /* Range x Doppler maps of frames that fit the FIFO of each device */
+    static const struct {
+        uint32_t range_bins;
+        uint32_t doppler_bins;
+        const char *frame;
+    } maps[] = {
+        {32U, 32U, "UTR11, 1 RX x 32 chirps x 64 samples"},
+        {32U, 64U, "UTR11, 1 RX x 64 chirps x 64 samples"},
+        {64U, 64U, "TR13C, 3 RX x 64 chirps x 128 samples"},
+        {128U, 64U, "TR13C, 1 RX x 64 chirps x 256 samples"},
+        {64U, 128U, "TR13C, 1 RX x 128 chirps x 128 samples"},
+    };
+    static const struct {
+        xensiv_bgt60trxx_cfar_type_t type;
+        const char *name;
+    } types[] = {
+        {XENSIV_BGT60TRXX_CFAR_CA, "CA"},
+        {XENSIV_BGT60TRXX_CFAR_GO, "GO"},
+        {XENSIV_BGT60TRXX_CFAR_SO, "SO"},
+        {XENSIV_BGT60TRXX_CFAR_OS, "OS"},
+    };
+    uint32_t checksum = 0U;
+
+    printf("XENSIV BGT60TRxx CFAR benchmark, %u guard and %u training cells per side, us per map\n",
+           GUARD_CELLS, TRAIN_CELLS);
+    printf("  %9s %10s %10s", "map", "naive CA", "naive OS");
+    for (size_t t = 0; t < sizeof(types) / sizeof(types[0]); ++t) {
+        printf(" %8s", types[t].name);
+    }
+    printf("  frame\n");
+
+    for (size_t m = 0; m < sizeof(maps) / sizeof(maps[0]); ++m) {
+        const uint32_t rows = maps[m].range_bins;
+        const uint32_t cols = maps[m].doppler_bins;
+        float *power = malloc(rows * cols * sizeof(float));
+        xensiv_bgt60trxx_detection_t *detections =
+            malloc(rows * cols * sizeof(xensiv_bgt60trxx_detection_t));
+        if (!power || !detections) {
+            fprintf(stderr, "Failed to allocate buffers\n");
+            return 1;
+        }
+        for (uint32_t i = 0; i < rows * cols; ++i) {
+            power[i] = (float) -log(((double) ((i * 2654435761U) >> 8) + 1.0) / 16777217.0);
+        }
+
+        uint32_t iterations = 0;
+        double start = now_sec();
+        double elapsed;
+        do {
+            checksum += naive_ca(power, rows, cols, 5.0f);
+            ++iterations;
+            elapsed = now_sec() - start;
+        } while (elapsed < MIN_DURATION_SEC);
+        printf("  %4ux%-4u %10.1f", rows, cols, (elapsed / iterations) * 1e6);
+
+        iterations = 0;
+        start = now_sec();
+        do {
+            checksum += naive_os(power, rows, cols, 5.0f);
+            ++iterations;
+            elapsed = now_sec() - start;
+        } while (elapsed < MIN_DURATION_SEC);
+        printf(" %10.1f", (elapsed / iterations) * 1e6);
+
+        for (size_t t = 0; t < sizeof(types) / sizeof(types[0]); ++t) {
+            xensiv_bgt60trxx_cfar_config_t config = {
+                .type = types[t].type,
+                .guard = {GUARD_CELLS, GUARD_CELLS},
+                .train = {TRAIN_CELLS, TRAIN_CELLS},
+                .threshold = 0.0f,
+                .pfa = 1e-4f,
+                .os_rank = 0U,
+                .wrap_doppler = true,
+            };
+            size_t storage_size = xensiv_bgt60trxx_cfar_storage_size(&config, rows, cols);
+            void *storage = malloc(storage_size);
+            xensiv_bgt60trxx_cfar_t cfar;
+            if (!storage ||
+                (xensiv_bgt60trxx_cfar_init(&cfar, &config, rows, cols, storage, storage_size) !=
+                 XENSIV_BGT60TRXX_STATUS_OK)) {
+                fprintf(stderr, "Failed to set up the CFAR detector\n");
+                return 1;
+            }
+
+            iterations = 0;
+            start = now_sec();
+            do {
+                checksum += xensiv_bgt60trxx_cfar_process(&cfar, power, detections, rows * cols);
+                ++iterations;
+                elapsed = now_sec() - start;
+            } while (elapsed < MIN_DURATION_SEC);
+            printf(" %8.1f", (elapsed / iterations) * 1e6);
+            free(storage);
+        }
+        printf("  %s\n", maps[m].frame);
+
+        free(detections);
+        free(power);
+    }
+    printf("(checksum %u)\n", checksum);
+
+    return 0;
+}
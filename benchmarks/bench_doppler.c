@@ -0,0 +1,144 @@
+/***********************************************************************************************/ /**
+                                                                                                   * \file bench_doppler.c
+                                                                                                   *
+                                                                                                   * \brief
+                                                                                                   * Benchmark of the Doppler stage of the XENSIV BGT60TRxx library across corner turn tile sizes.
+                                                                                                   *
+                                                                                                   ***************************************************************************************************
+                                                                                                   * \copyright
+                                                                                                   * Copyright 2022 Infineon Technologies AG
+                                                                                                   * SPDX-License-Identifier: Apache-2.0
+                                                                                                   **************************************************************************************************/
+
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "../xensiv_bgt60trxx_assembler.h"
+#include "../xensiv_bgt60trxx_doppler.h"
+#include "../xensiv_bgt60trxx_range.h"
+
+/*******************************************************************************
+ * Macros
+ *******************************************************************************/
+#define MIN_DURATION_SEC 0.2
+
+/* Frame of the benchmark: 3 RX x 64 chirps x 512 samples, 256 range bins */
+#define FRAME_RX_MASK 0x7U
+#define FRAME_NUM_RX 3U
+#define FRAME_CHIRPS 64U
+#define FRAME_SAMPLES 512U
+
+/*******************************************************************************
+ * Function Implementations
+ *******************************************************************************/
+
+static double now_sec(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double) ts.tv_sec + ((double) ts.tv_nsec * 1e-9);
+}
+
+int main(void)
+{
+    /* 0 selects the default tile of XENSIV_BGT60TRXX_DOPPLER_TILE_BYTES */
+    static const uint32_t tiles[] = {1U, 4U, 16U, 64U, 256U, 0U};
+
+    xensiv_bgt60trxx_frame_geometry_t geometry;
+    memset(&geometry, 0, sizeof(geometry));
+    geometry.shape_groups = 1U;
+    geometry.shapes[0].num_chirps = FRAME_CHIRPS;
+    geometry.shapes[0].up_samples = FRAME_SAMPLES;
+    geometry.shapes[0].up_rx_mask = FRAME_RX_MASK;
+
+    xensiv_bgt60trxx_assembler_t assembler;
+    xensiv_bgt60trxx_assembler_init(&assembler, &geometry, XENSIV_BGT60TRXX_LAYOUT_PLANAR, 0U);
+    xensiv_bgt60trxx_range_config_t range_config = {
+        .window = XENSIV_BGT60TRXX_WINDOW_HANN,
+        .algo = XENSIV_BGT60TRXX_FFT_RADIX4,
+        .remove_dc = true,
+        .fft_size = 0U,
+    };
+    size_t range_size = xensiv_bgt60trxx_range_storage_size(&assembler, &range_config);
+    void *range_storage = malloc(range_size);
+    if (!range_storage) {
+        fprintf(stderr, "Failed to allocate buffers\n");
+        return 1;
+    }
+    xensiv_bgt60trxx_range_t range;
+    xensiv_bgt60trxx_range_init(&range, &assembler, &range_config, range_storage, range_size);
+
+    xensiv_bgt60trxx_complex_t *profiles = malloc(range.frame_bins * sizeof(*profiles));
+    if (!profiles) {
+        fprintf(stderr, "Failed to allocate buffers\n");
+        return 1;
+    }
+    for (uint32_t i = 0; i < range.frame_bins; ++i) {
+        profiles[i].re = (float) ((i * 2654435761U) >> 20) - 2048.0f;
+        profiles[i].im = (float) ((i * 40503U) >> 4) - 2048.0f;
+    }
+
+    printf("XENSIV BGT60TRxx Doppler benchmark, %u RX x %u chirps x %u range bins\n",
+           FRAME_NUM_RX, FRAME_CHIRPS, FRAME_SAMPLES / 2U);
+    printf("  %10s %10s %12s %12s\n", "tile bins", "tile KiB", "map us", "map+nci us");
+
+    float checksum = 0.0f;
+    for (size_t t = 0; t < sizeof(tiles) / sizeof(tiles[0]); ++t) {
+        xensiv_bgt60trxx_doppler_config_t config = {
+            .window = XENSIV_BGT60TRXX_WINDOW_HANN,
+            .algo = XENSIV_BGT60TRXX_FFT_RADIX4,
+            .clutter = XENSIV_BGT60TRXX_CLUTTER_MEAN,
+            .fft_size = 0U,
+            .center_zero = true,
+            .tile_bins = tiles[t],
+        };
+        size_t storage_size = xensiv_bgt60trxx_doppler_storage_size(&range, &config);
+        void *storage = malloc(storage_size);
+        xensiv_bgt60trxx_doppler_t doppler;
+        if (!storage ||
+            (xensiv_bgt60trxx_doppler_init(&doppler, &range, &config, storage, storage_size) !=
+             XENSIV_BGT60TRXX_STATUS_OK)) {
+            fprintf(stderr, "Failed to set up the Doppler stage\n");
+            return 1;
+        }
+        xensiv_bgt60trxx_complex_t *map = malloc(doppler.frame_cells * sizeof(*map));
+        float *nci = malloc(doppler.frame_nci_cells * sizeof(*nci));
+        if (!map || !nci) {
+            fprintf(stderr, "Failed to allocate buffers\n");
+            return 1;
+        }
+
+        double us[2];
+        for (uint32_t pass = 0; pass < 2U; ++pass) {
+            uint32_t iterations = 0;
+            double start = now_sec();
+            double elapsed;
+            do {
+                xensiv_bgt60trxx_doppler_process(&doppler, profiles, map,
+                                                 (pass == 0U) ? NULL : nci);
+                checksum += map[iterations % doppler.frame_cells].re;
+                ++iterations;
+                elapsed = now_sec() - start;
+            } while (elapsed < MIN_DURATION_SEC);
+            us[pass] = (elapsed / iterations) * 1e6;
+        }
+        printf("  %10u %10.1f %12.1f %12.1f%s\n", doppler.tile_bins,
+               (double) (doppler.tile_bins * FRAME_CHIRPS * sizeof(xensiv_bgt60trxx_complex_t)) /
+               1024.0, us[0], us[1], (tiles[t] == 0U) ? " (default)" : "");
+
+        free(nci);
+        free(map);
+        free(storage);
+    }
+    printf("(checksum %g)\n", (double) checksum);
+
+    free(profiles);
+    free(range_storage);
+    return 0;
+}
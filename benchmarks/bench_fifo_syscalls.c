@@ -0,0 +1,175 @@
+/***********************************************************************************************/ /**
+                                                                                                   * \file bench_fifo_syscalls.c
+                                                                                                   *
+                                                                                                   * \brief
+                                                                                                   * Benchmark counting the kernel round trips and latency of a FIFO burst read
+                                                                                                   * with the XENSIV BGT60TRxx Linux platform. Requires the sensor hardware.
+                                                                                                   *
+                                                                                                   ***************************************************************************************************
+                                                                                                   * \copyright
+                                                                                                   * Copyright 2022 Infineon Technologies AG
+                                                                                                   * SPDX-License-Identifier: Apache-2.0
+                                                                                                   **************************************************************************************************/
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <getopt.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "../xensiv_bgt60trxx.h"
+#include "../xensiv_bgt60trxx_linux.h"
+#include "../xensiv_bgt60trxx_platform.h"
+
+/*******************************************************************************
+ * Macros
+ *******************************************************************************/
+#define DEFAULT_SPI_DEVICE "/dev/spidev0.0"
+#define DEFAULT_GPIO_CHIP "/dev/gpiochip0"
+#define DEFAULT_RST_GPIO 18
+#define DEFAULT_CS_GPIO 24
+#define DEFAULT_NUM_SAMPLES 64U
+#define DEFAULT_ITERATIONS 1000U
+
+/*******************************************************************************
+ * Function Implementations
+ *******************************************************************************/
+
+static double now_sec(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double) ts.tv_sec + ((double) ts.tv_nsec * 1e-9);
+}
+
+/* The FIFO read sequence used before the fused burst path: CS, header, payload, CS */
+static int32_t legacy_fifo_read(xensiv_bgt60trxx_linux_obj_t *obj,
+                                uint16_t *data,
+                                uint32_t num_samples)
+{
+    uint32_t gsr0;
+    uint32_t header = xensiv_bgt60trxx_platform_word_reverse(
+        0xFF000000UL | (XENSIV_BGT60TRXX_REG_FIFO_TR13C << 17U));
+
+    if (xensiv_bgt60trxx_get_device(&obj->dev) == XENSIV_DEVICE_BGT60UTR13D) {
+        header = xensiv_bgt60trxx_platform_word_reverse(
+            0xFF000000UL | (XENSIV_BGT60TRXX_REG_FIFO_UTR13D << 17U));
+    } else if (xensiv_bgt60trxx_get_device(&obj->dev) == XENSIV_DEVICE_BGT60UTR11) {
+        header = xensiv_bgt60trxx_platform_word_reverse(
+            0xFF000000UL | (XENSIV_BGT60TRXX_REG_FIFO_UTR11 << 17U));
+    }
+
+    xensiv_bgt60trxx_platform_spi_cs_set(&obj->iface, false);
+    int32_t retval = xensiv_bgt60trxx_platform_spi_transfer(
+        &obj->iface, (uint8_t *) &header, (uint8_t *) &gsr0, sizeof(header));
+    if (retval == XENSIV_BGT60TRXX_STATUS_OK) {
+        /* Always read the payload so both paths move the same amount of data */
+        retval = xensiv_bgt60trxx_platform_spi_fifo_read(&obj->iface, data, num_samples);
+    }
+    xensiv_bgt60trxx_platform_spi_cs_set(&obj->iface, true);
+
+    return retval;
+}
+
+static void run(const char *name,
+                xensiv_bgt60trxx_linux_obj_t *obj,
+                uint16_t *data,
+                uint32_t num_samples,
+                uint32_t iterations,
+                bool fused)
+{
+    uint32_t spi_start = obj->iface.spi_ioctls;
+    uint32_t gpio_start = obj->iface.gpio_ioctls;
+    uint32_t errors = 0;
+
+    double start = now_sec();
+    for (uint32_t i = 0; i < iterations; ++i) {
+        int32_t result = fused ? xensiv_bgt60trxx_get_fifo_data(&obj->dev, data, num_samples)
+                               : legacy_fifo_read(obj, data, num_samples);
+        if (result == XENSIV_BGT60TRXX_STATUS_COM_ERROR) {
+            ++errors;
+        }
+    }
+    double elapsed = now_sec() - start;
+
+    uint32_t spi = obj->iface.spi_ioctls - spi_start;
+    uint32_t gpio = obj->iface.gpio_ioctls - gpio_start;
+    printf("  %-8s %5.2f ioctls/read (spi %.2f, gpio %.2f)  %8.2f us/read  %u errors\n",
+           name,
+           (double) (spi + gpio) / iterations,
+           (double) spi / iterations,
+           (double) gpio / iterations,
+           (elapsed / iterations) * 1e6,
+           errors);
+}
+
+int main(int argc, char *argv[])
+{
+    const char *spi_device = DEFAULT_SPI_DEVICE;
+    const char *gpio_chip = DEFAULT_GPIO_CHIP;
+    unsigned int rst_gpio = DEFAULT_RST_GPIO;
+    unsigned int cs_gpio = DEFAULT_CS_GPIO;
+    uint32_t num_samples = DEFAULT_NUM_SAMPLES;
+    uint32_t iterations = DEFAULT_ITERATIONS;
+    xensiv_bgt60trxx_linux_obj_t obj;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "s:g:r:c:n:i:h")) != -1) {
+        switch (opt) {
+            case 's':
+                spi_device = optarg;
+                break;
+            case 'g':
+                gpio_chip = optarg;
+                break;
+            case 'r':
+                rst_gpio = (unsigned int) atoi(optarg);
+                break;
+            case 'c':
+                cs_gpio = (strcmp(optarg, "native") == 0) ? XENSIV_BGT60TRXX_LINUX_NATIVE_CS
+                                                          : (unsigned int) atoi(optarg);
+                break;
+            case 'n':
+                num_samples = (uint32_t) atoi(optarg) & ~1U;
+                break;
+            case 'i':
+                iterations = (uint32_t) atoi(optarg);
+                break;
+            default:
+                printf("Usage: %s [-s spidev] [-g gpiochip] [-r rst] [-c cs|native] [-n samples] "
+                       "[-i iterations]\n",
+                       argv[0]);
+                return (opt == 'h') ? 0 : 1;
+        }
+    }
+
+    if (num_samples == 0U || iterations == 0U) {
+        fprintf(stderr, "Sample count and iterations must be positive\n");
+        return 1;
+    }
+
+    if (xensiv_bgt60trxx_linux_init_sensor(
+            &obj, spi_device, gpio_chip, rst_gpio, cs_gpio, false) != XENSIV_BGT60TRXX_STATUS_OK) {
+        fprintf(stderr, "Failed to initialize sensor\n");
+        return 1;
+    }
+
+    uint16_t *data = malloc(num_samples * sizeof(uint16_t));
+    if (!data) {
+        xensiv_bgt60trxx_linux_deinit_sensor(&obj);
+        return 1;
+    }
+
+    printf("XENSIV BGT60TRxx FIFO read syscall benchmark (%u samples x %u reads)\n",
+           num_samples,
+           iterations);
+    run("legacy", &obj, data, num_samples, iterations, false);
+    run("fused", &obj, data, num_samples, iterations, true);
+
+    free(data);
+    xensiv_bgt60trxx_linux_deinit_sensor(&obj);
+    return 0;
+}
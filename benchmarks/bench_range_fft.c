@@ -0,0 +1,191 @@
+/***********************************************************************************************/ /**
+                                                                                                   * \file bench_range_fft.c
+                                                                                                   *
+                                                                                                   * \brief
+                                                                                                   * Benchmark of the range FFT kernels of the XENSIV BGT60TRxx library against a naive DFT.
+                                                                                                   *
+                                                                                                   ***************************************************************************************************
+                                                                                                   * \copyright
+                                                                                                   * Copyright 2022 Infineon Technologies AG
+                                                                                                   * SPDX-License-Identifier: Apache-2.0
+                                                                                                   **************************************************************************************************/
+
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "../xensiv_bgt60trxx_assembler.h"
+#include "../xensiv_bgt60trxx_fft.h"
+#include "../xensiv_bgt60trxx_range.h"
+
+/*******************************************************************************
+ * Macros
+ *******************************************************************************/
+#define MAX_FFT_SIZE 1024U
+#define MIN_DURATION_SEC 0.2
+
+/* Frame of the range stage benchmark: 3 RX x 64 chirps x 128 samples */
+#define FRAME_RX_MASK 0x7U
+#define FRAME_NUM_RX 3U
+#define FRAME_CHIRPS 64U
+#define FRAME_SAMPLES 128U
+
+/*******************************************************************************
+ * Function Implementations
+ *******************************************************************************/
+
+static double now_sec(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double) ts.tv_sec + ((double) ts.tv_nsec * 1e-9);
+}
+
+/* Naive DFT of the positive frequency bins with a precomputed twiddle table */
+static void naive_dft(const float *in,
+                      xensiv_bgt60trxx_complex_t *out,
+                      const xensiv_bgt60trxx_complex_t *twiddles,
+                      uint32_t n)
+{
+    for (uint32_t k = 0; k < (n / 2U); ++k) {
+        float re = 0.0f;
+        float im = 0.0f;
+        for (uint32_t t = 0; t < n; ++t) {
+            const xensiv_bgt60trxx_complex_t *w = &twiddles[(k * t) % n];
+            re += in[t] * w->re;
+            im += in[t] * w->im;
+        }
+        out[k].re = re;
+        out[k].im = im;
+    }
+}
+
+int main(void)
+{
+    static const struct {
+        xensiv_bgt60trxx_fft_algo_t algo;
+        const char *name;
+    } algos[] = {
+        {XENSIV_BGT60TRXX_FFT_RADIX2, "radix-2"},
+        {XENSIV_BGT60TRXX_FFT_RADIX4, "radix-4"},
+        {XENSIV_BGT60TRXX_FFT_SPLIT_RADIX, "split"},
+    };
+
+    static float input[MAX_FFT_SIZE];
+    static float work[MAX_FFT_SIZE];
+    static xensiv_bgt60trxx_complex_t out[MAX_FFT_SIZE / 2U];
+    static xensiv_bgt60trxx_complex_t twiddles[MAX_FFT_SIZE];
+    static uint8_t storage[XENSIV_BGT60TRXX_RFFT_PLAN_STORAGE_BYTES(MAX_FFT_SIZE)];
+    float checksum = 0.0f;
+
+    for (uint32_t i = 0; i < MAX_FFT_SIZE; ++i) {
+        input[i] = (float) ((i * 2654435761U) >> 20) - 2048.0f;
+    }
+
+    printf("XENSIV BGT60TRxx range FFT benchmark (real input, us per transform)\n");
+    printf("  %6s %10s", "size", "dft");
+    for (size_t a = 0; a < sizeof(algos) / sizeof(algos[0]); ++a) {
+        printf(" %10s", algos[a].name);
+    }
+    printf(" %10s\n", "speedup");
+
+    for (uint32_t n = 64U; n <= MAX_FFT_SIZE; n <<= 1) {
+        for (uint32_t k = 0; k < n; ++k) {
+            double phase = (-2.0 * 3.14159265358979323846 * k) / n;
+            twiddles[k].re = (float) cos(phase);
+            twiddles[k].im = (float) sin(phase);
+        }
+
+        uint32_t iterations = 0;
+        double start = now_sec();
+        double elapsed;
+        do {
+            naive_dft(input, out, twiddles, n);
+            checksum += out[iterations % (n / 2U)].re;
+            ++iterations;
+            elapsed = now_sec() - start;
+        } while (elapsed < MIN_DURATION_SEC);
+        double dft_us = (elapsed / iterations) * 1e6;
+        printf("  %6u %10.2f", n, dft_us);
+
+        double best_us = dft_us;
+        for (size_t a = 0; a < sizeof(algos) / sizeof(algos[0]); ++a) {
+            xensiv_bgt60trxx_rfft_plan_t plan;
+            xensiv_bgt60trxx_rfft_plan_init(&plan, n, algos[a].algo, storage);
+
+            iterations = 0;
+            start = now_sec();
+            do {
+                memcpy(work, input, n * sizeof(float));
+                xensiv_bgt60trxx_rfft(&plan, work, (xensiv_bgt60trxx_complex_t *) work);
+                checksum += work[iterations % n];
+                ++iterations;
+                elapsed = now_sec() - start;
+            } while (elapsed < MIN_DURATION_SEC);
+            double us = (elapsed / iterations) * 1e6;
+            best_us = (us < best_us) ? us : best_us;
+            printf(" %10.2f", us);
+        }
+        printf(" %9.0fx\n", dft_us / best_us);
+    }
+
+    /* Complete range stage on an assembled frame */
+    xensiv_bgt60trxx_frame_geometry_t geometry;
+    memset(&geometry, 0, sizeof(geometry));
+    geometry.shape_groups = 1U;
+    geometry.shapes[0].num_chirps = FRAME_CHIRPS;
+    geometry.shapes[0].up_samples = FRAME_SAMPLES;
+    geometry.shapes[0].up_rx_mask = FRAME_RX_MASK;
+
+    xensiv_bgt60trxx_assembler_t assembler;
+    xensiv_bgt60trxx_assembler_init(&assembler, &geometry, XENSIV_BGT60TRXX_LAYOUT_PLANAR, 64U);
+    xensiv_bgt60trxx_range_config_t config = {
+        .window = XENSIV_BGT60TRXX_WINDOW_HANN,
+        .algo = XENSIV_BGT60TRXX_FFT_RADIX4,
+        .remove_dc = true,
+        .fft_size = 0U,
+    };
+    size_t storage_size = xensiv_bgt60trxx_range_storage_size(&assembler, &config);
+    void *range_storage = malloc(storage_size);
+    uint16_t *frame = malloc(assembler.frame_size * sizeof(uint16_t));
+    if (!range_storage || !frame) {
+        fprintf(stderr, "Failed to allocate buffers\n");
+        return 1;
+    }
+    for (uint32_t i = 0; i < assembler.frame_size; ++i) {
+        frame[i] = (uint16_t) ((i * 2654435761U) >> 20);
+    }
+
+    xensiv_bgt60trxx_range_t range;
+    xensiv_bgt60trxx_range_init(&range, &assembler, &config, range_storage, storage_size);
+    xensiv_bgt60trxx_complex_t *profiles = malloc(range.frame_bins * sizeof(*profiles));
+    if (!profiles) {
+        fprintf(stderr, "Failed to allocate buffers\n");
+        return 1;
+    }
+
+    uint32_t iterations = 0;
+    double start = now_sec();
+    double elapsed;
+    do {
+        xensiv_bgt60trxx_range_process(&range, frame, profiles);
+        checksum += profiles[iterations % range.frame_bins].re;
+        ++iterations;
+        elapsed = now_sec() - start;
+    } while (elapsed < MIN_DURATION_SEC);
+    printf("Range stage, %u RX x %u chirps x %u samples, Hann, radix-4: %.1f us/frame\n",
+           FRAME_NUM_RX, FRAME_CHIRPS, FRAME_SAMPLES,
+           (elapsed / iterations) * 1e6);
+    printf("(checksum %g)\n", (double) checksum);
+
+    free(profiles);
+    free(frame);
+    free(range_storage);
+    return 0;
+}
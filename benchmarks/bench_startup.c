@@ -0,0 +1,215 @@
+/***********************************************************************************************/ /**
+                                                                                                   * \file bench_startup.c
+                                                                                                   *
+                                                                                                   * \brief
+                                                                                                   * Benchmark of the startup latency of the XENSIV BGT60TRxx Linux platform, from
+                                                                                                   * init to the first FIFO word. Requires the configured sensor hardware.
+                                                                                                   *
+                                                                                                   ***************************************************************************************************
+                                                                                                   * \copyright
+                                                                                                   * Copyright 2022 Infineon Technologies AG
+                                                                                                   * SPDX-License-Identifier: Apache-2.0
+                                                                                                   **************************************************************************************************/
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <getopt.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "../xensiv_bgt60trxx.h"
+#include "../xensiv_bgt60trxx_linux.h"
+#include "../xensiv_bgt60trxx_platform.h"
+
+/*******************************************************************************
+ * Macros
+ *******************************************************************************/
+#define DEFAULT_SPI_DEVICE "/dev/spidev0.0"
+#define DEFAULT_GPIO_CHIP "/dev/gpiochip0"
+#define DEFAULT_RST_GPIO 18
+#define DEFAULT_CS_GPIO 24
+#define DEFAULT_ITERATIONS 20U
+#define FIRST_WORD_TIMEOUT_SEC (1.0)
+
+/*******************************************************************************
+ * Types
+ *******************************************************************************/
+typedef struct {
+    const char *name;
+    double min;
+    double max;
+    double sum;
+    uint32_t count;
+} stage_t;
+
+/*******************************************************************************
+ * Function Implementations
+ *******************************************************************************/
+
+static double now_sec(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double) ts.tv_sec + ((double) ts.tv_nsec * 1e-9);
+}
+
+static void stage_add(stage_t *stage, double elapsed)
+{
+    if ((stage->count == 0U) || (elapsed < stage->min)) {
+        stage->min = elapsed;
+    }
+    if ((stage->count == 0U) || (elapsed > stage->max)) {
+        stage->max = elapsed;
+    }
+    stage->sum += elapsed;
+    ++stage->count;
+}
+
+static void stage_print(const stage_t *stage)
+{
+    if (stage->count == 0U) {
+        printf("  %-16s %10s\n", stage->name, "-");
+    } else {
+        printf("  %-16s %10.1f %10.1f %10.1f us\n",
+               stage->name,
+               stage->min * 1e6,
+               (stage->sum / stage->count) * 1e6,
+               stage->max * 1e6);
+    }
+}
+
+/* Frame generation is started on a FIFO that was just reset: the first word marks the end of
+   the first chirp acquisition */
+static int32_t wait_first_word(xensiv_bgt60trxx_t *dev)
+{
+    double deadline = now_sec() + FIRST_WORD_TIMEOUT_SEC;
+    uint32_t fstat = 0U;
+    int32_t status = XENSIV_BGT60TRXX_STATUS_OK;
+
+    while ((status == XENSIV_BGT60TRXX_STATUS_OK) &&
+           ((fstat & XENSIV_BGT60TRXX_REG_FSTAT_FILL_STATUS_MSK) == 0U)) {
+        if (now_sec() > deadline) {
+            status = XENSIV_BGT60TRXX_STATUS_TIMEOUT_ERROR;
+        } else {
+            status = xensiv_bgt60trxx_get_fifo_status(dev, &fstat);
+        }
+    }
+
+    return status;
+}
+
+int main(int argc, char *argv[])
+{
+    const char *spi_device = DEFAULT_SPI_DEVICE;
+    const char *gpio_chip = DEFAULT_GPIO_CHIP;
+    unsigned int rst_gpio = DEFAULT_RST_GPIO;
+    unsigned int cs_gpio = DEFAULT_CS_GPIO;
+    uint32_t iterations = DEFAULT_ITERATIONS;
+    xensiv_bgt60trxx_linux_obj_t obj;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "s:g:r:c:i:h")) != -1) {
+        switch (opt) {
+            case 's':
+                spi_device = optarg;
+                break;
+            case 'g':
+                gpio_chip = optarg;
+                break;
+            case 'r':
+                rst_gpio = (unsigned int) atoi(optarg);
+                break;
+            case 'c':
+                cs_gpio = (strcmp(optarg, "native") == 0) ? XENSIV_BGT60TRXX_LINUX_NATIVE_CS
+                                                          : (unsigned int) atoi(optarg);
+                break;
+            case 'i':
+                iterations = (uint32_t) atoi(optarg);
+                break;
+            default:
+                printf("Usage: %s [-s spidev] [-g gpiochip] [-r rst] [-c cs|native] "
+                       "[-i iterations]\n",
+                       argv[0]);
+                return (opt == 'h') ? 0 : 1;
+        }
+    }
+
+    if (iterations == 0U) {
+        fprintf(stderr, "Iterations must be positive\n");
+        return 1;
+    }
+
+    stage_t init = {.name = "init"};
+    stage_t fifo_reset = {.name = "fifo reset"};
+    stage_t first_word = {.name = "first FIFO word"};
+    stage_t total = {.name = "total"};
+    uint32_t errors = 0U;
+
+    printf("XENSIV BGT60TRxx startup benchmark (%u restarts of a configured sensor)\n",
+           iterations);
+
+    for (uint32_t i = 0; i < iterations; ++i) {
+        double t0 = now_sec();
+        if (xensiv_bgt60trxx_linux_init_sensor(
+                &obj, spi_device, gpio_chip, rst_gpio, cs_gpio, false) !=
+            XENSIV_BGT60TRXX_STATUS_OK) {
+            fprintf(stderr, "Failed to initialize sensor\n");
+            return 1;
+        }
+        double t1 = now_sec();
+
+        int32_t status = xensiv_bgt60trxx_soft_reset(&obj.dev, XENSIV_BGT60TRXX_RESET_FIFO);
+        double t2 = now_sec();
+
+        if (status == XENSIV_BGT60TRXX_STATUS_OK) {
+            status = xensiv_bgt60trxx_start_frame(&obj.dev, true);
+        }
+        if (status == XENSIV_BGT60TRXX_STATUS_OK) {
+            status = wait_first_word(&obj.dev);
+        }
+        double t3 = now_sec();
+
+        if (status == XENSIV_BGT60TRXX_STATUS_OK) {
+            stage_add(&init, t1 - t0);
+            stage_add(&fifo_reset, t2 - t1);
+            stage_add(&first_word, t3 - t2);
+            stage_add(&total, t3 - t0);
+        } else {
+            ++errors;
+        }
+
+        (void) xensiv_bgt60trxx_start_frame(&obj.dev, false);
+        xensiv_bgt60trxx_linux_deinit_sensor(&obj);
+    }
+
+    printf("  %-16s %10s %10s %10s\n", "stage", "min", "avg", "max");
+    stage_print(&init);
+    stage_print(&fifo_reset);
+    stage_print(&first_word);
+    stage_print(&total);
+
+    /* The resets below drop the configuration, they run once at the end */
+    stage_t hard_reset = {.name = "hard reset"};
+    stage_t sw_reset = {.name = "software reset"};
+    if (xensiv_bgt60trxx_linux_init_sensor(&obj, spi_device, gpio_chip, rst_gpio, cs_gpio, false) ==
+        XENSIV_BGT60TRXX_STATUS_OK) {
+        double t0 = now_sec();
+        xensiv_bgt60trxx_hard_reset(&obj.dev);
+        double t1 = now_sec();
+        stage_add(&hard_reset, t1 - t0);
+
+        if (xensiv_bgt60trxx_soft_reset(&obj.dev, XENSIV_BGT60TRXX_RESET_SW) ==
+            XENSIV_BGT60TRXX_STATUS_OK) {
+            stage_add(&sw_reset, now_sec() - t1);
+        }
+        xensiv_bgt60trxx_linux_deinit_sensor(&obj);
+    }
+    stage_print(&hard_reset);
+    stage_print(&sw_reset);
+    printf("  %u failed restarts\n", errors);
+
+    return (errors == 0U) ? 0 : 1;
+}
@@ -0,0 +1,296 @@
+/***********************************************************************************************/ /**
+                                                                                                   * \file bench_cfar.c
+                                                                                                   *
+                                                                                                   * \brief
+                                                                                                   * Benchmark of the XENSIV BGT60TRxx multi-target tracker on synthetic scenes.
+                                                                                                   *
+                                                                                                   ***************************************************************************************************
+                                                                                                   * \copyright
+                                                                                                   * Copyright 2022 Infineon Technologies AG
+                                                                                                   * SPDX-License-Identifier: Apache-2.0
+                                                                                                   **************************************************************************************************/
+
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "../xensiv_bgt60trxx.h"
+#include "../xensiv_bgt60trxx_tracker.h"
+
+/*******************************************************************************
+ * Macros
+ *******************************************************************************/
+#define MIN_DURATION_SEC 0.2
+
+#define NUM_FRAMES 64U
+#define POINTS_PER_TARGET 8U
+#define MAX_POINTS 512U
+#define AREA_M 20.0f
+#define EPS_M 0.4f
+#define MIN_POINTS 3U
+
+/*******************************************************************************
+ * Function Implementations
+ *******************************************************************************/
+
+static double now_sec(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double) ts.tv_sec + ((double) ts.tv_nsec * 1e-9);
+}
+
+static uint32_t lcg_state = 12345U;
+
+/* Uniform in [0, 1) */
+static float uniform(void)
+{
+    lcg_state = (lcg_state * 1664525U) + 1013904223U;
+    return (float) (lcg_state >> 8) / 16777216.0f;
+}
+
+/* Frames of num_targets targets moving in straight lines with POINTS_PER_TARGET detections each,
+   plus num_clutter uniform clutter points */
+static void make_scene(xensiv_bgt60trxx_point_t *frames,
+                       uint32_t num_targets,
+                       uint32_t num_clutter,
+                       float dt)
+{
+    const uint32_t num_points = (num_targets * POINTS_PER_TARGET) + num_clutter;
+    float pos[64][2];
+    float vel[64][2];
+
+    for (uint32_t t = 0; t < num_targets; ++t) {
+        pos[t][0] = AREA_M * uniform();
+        pos[t][1] = AREA_M * uniform();
+        vel[t][0] = 4.0f * (uniform() - 0.5f);
+        vel[t][1] = 4.0f * (uniform() - 0.5f);
+    }
+    for (uint32_t f = 0; f < NUM_FRAMES; ++f) {
+        xensiv_bgt60trxx_point_t *points = &frames[f * num_points];
+        uint32_t n = 0U;
+        for (uint32_t t = 0; t < num_targets; ++t) {
+            for (uint32_t k = 0; k < POINTS_PER_TARGET; ++k) {
+                points[n].x = pos[t][0] + (0.3f * (uniform() - 0.5f));
+                points[n].y = pos[t][1] + (0.3f * (uniform() - 0.5f));
+                points[n].power = 1.0f;
+                ++n;
+            }
+            pos[t][0] += vel[t][0] * dt;
+            pos[t][1] += vel[t][1] * dt;
+        }
+        for (uint32_t k = 0; k < num_clutter; ++k) {
+            points[n].x = AREA_M * uniform();
+            points[n].y = AREA_M * uniform();
+            points[n].power = 0.1f;
+            ++n;
+        }
+    }
+}
+
+static uint32_t naive_region(const xensiv_bgt60trxx_point_t *points,
+                             uint32_t num_points,
+                             uint32_t p,
+                             int32_t *labels,
+                             int32_t cluster,
+                             uint32_t *queue,
+                             uint32_t *tail)
+{
+    uint32_t count = 0U;
+
+    for (uint32_t q = 0; q < num_points; ++q) {
+        const float dx = points[q].x - points[p].x;
+        const float dy = points[q].y - points[p].y;
+        if (((dx * dx) + (dy * dy)) > (EPS_M * EPS_M)) {
+            continue;
+        }
+        ++count;
+        if ((cluster < 0) && (count >= MIN_POINTS)) {
+            break;
+        }
+        if (cluster >= 0) {
+            if (labels[q] == -2) {
+                queue[(*tail)++] = q;
+                labels[q] = cluster;
+            } else if (labels[q] == -1) {
+                labels[q] = cluster;
+            }
+        }
+    }
+
+    return count;
+}
+
+/* DBSCAN comparing every pair of points */
+static uint32_t naive_dbscan(const xensiv_bgt60trxx_point_t *points, uint32_t num_points)
+{
+    static int32_t labels[MAX_POINTS];
+    static uint32_t queue[MAX_POINTS];
+    int32_t num_clusters = 0;
+
+    for (uint32_t i = 0; i < num_points; ++i) {
+        labels[i] = -2;
+    }
+    for (uint32_t p = 0; p < num_points; ++p) {
+        if (labels[p] != -2) {
+            continue;
+        }
+        if (naive_region(points, num_points, p, labels, -1, NULL, NULL) < MIN_POINTS) {
+            labels[p] = -1;
+            continue;
+        }
+        uint32_t head = 0U;
+        uint32_t tail = 0U;
+        labels[p] = num_clusters;
+        queue[tail++] = p;
+        while (head < tail) {
+            uint32_t q = queue[head++];
+            if ((q == p) ||
+                (naive_region(points, num_points, q, labels, -1, NULL, NULL) >= MIN_POINTS)) {
+                (void) naive_region(points, num_points, q, labels, num_clusters, queue, &tail);
+            }
+        }
+        ++num_clusters;
+    }
+
+    return (uint32_t) num_clusters;
+}
+
+int main(void)
+{
+    static const struct {
+        uint32_t targets;
+        uint32_t clutter;
+    } scenes[] = {
+        {4U, 16U},
+        {8U, 32U},
+        {16U, 64U},
+        {24U, 108U},
+        {32U, 128U},
+        {48U, 116U},
+    };
+    static const struct {
+        xensiv_bgt60trxx_association_t association;
+        xensiv_bgt60trxx_motion_model_t model;
+    } trackers[] = {
+        {XENSIV_BGT60TRXX_ASSOC_HUNGARIAN, XENSIV_BGT60TRXX_MOTION_CV},
+        {XENSIV_BGT60TRXX_ASSOC_GNN, XENSIV_BGT60TRXX_MOTION_CV},
+        {XENSIV_BGT60TRXX_ASSOC_HUNGARIAN, XENSIV_BGT60TRXX_MOTION_CA},
+        {XENSIV_BGT60TRXX_ASSOC_GNN, XENSIV_BGT60TRXX_MOTION_CA},
+    };
+    const float dt = 0.05f;
+    uint32_t checksum = 0U;
+
+    printf("XENSIV BGT60TRxx tracker benchmark, %u frames per scene, us per frame\n", NUM_FRAMES);
+    printf("  %6s %8s %11s %10s %10s %10s %10s %10s %7s\n", "points", "clusters", "naive DBSCAN",
+           "DBSCAN", "Hung CV", "GNN CV", "Hung CA", "GNN CA", "tracks");
+
+    for (size_t s = 0; s < sizeof(scenes) / sizeof(scenes[0]); ++s) {
+        const uint32_t num_points = (scenes[s].targets * POINTS_PER_TARGET) + scenes[s].clutter;
+        xensiv_bgt60trxx_point_t *frames =
+            malloc(NUM_FRAMES * num_points * sizeof(xensiv_bgt60trxx_point_t));
+        if (!frames) {
+            fprintf(stderr, "Failed to allocate buffers\n");
+            return 1;
+        }
+        make_scene(frames, scenes[s].targets, scenes[s].clutter, dt);
+
+        uint32_t frame = 0;
+        uint32_t iterations = 0;
+        double start = now_sec();
+        double elapsed;
+        do {
+            checksum += naive_dbscan(&frames[frame * num_points], num_points);
+            frame = (frame + 1U) % NUM_FRAMES;
+            ++iterations;
+            elapsed = now_sec() - start;
+        } while (elapsed < MIN_DURATION_SEC);
+        const double naive_us = (elapsed / iterations) * 1e6;
+
+        uint32_t num_clusters = 0U;
+        uint32_t num_confirmed = 0U;
+        double us[sizeof(trackers) / sizeof(trackers[0]) + 1U];
+        for (size_t t = 0; t < sizeof(trackers) / sizeof(trackers[0]); ++t) {
+            xensiv_bgt60trxx_tracker_config_t config = {
+                .model = trackers[t].model,
+                .association = trackers[t].association,
+                .max_points = MAX_POINTS,
+                .max_clusters = 64U,
+                .max_tracks = 64U,
+                .cluster_eps = EPS_M,
+                .cluster_min_points = MIN_POINTS,
+                .dt = dt,
+                .process_noise = 1.0f,
+                .measurement_noise = 0.01f,
+                .initial_velocity_var = 4.0f,
+                .initial_accel_var = 4.0f,
+                .gate = 13.8f,
+                .confirm_hits = 3U,
+                .max_misses = 5U,
+            };
+            size_t storage_size = xensiv_bgt60trxx_tracker_storage_size(&config);
+            void *storage = malloc(storage_size);
+            xensiv_bgt60trxx_tracker_t tracker;
+            if (!storage ||
+                (xensiv_bgt60trxx_tracker_init(&tracker, &config, storage, storage_size) !=
+                 XENSIV_BGT60TRXX_STATUS_OK)) {
+                fprintf(stderr, "Failed to set up the tracker\n");
+                return 1;
+            }
+
+            if (t == 0U) {
+                frame = 0;
+                iterations = 0;
+                start = now_sec();
+                do {
+                    num_clusters = xensiv_bgt60trxx_tracker_cluster(
+                        &tracker, &frames[frame * num_points], num_points);
+                    checksum += num_clusters;
+                    frame = (frame + 1U) % NUM_FRAMES;
+                    ++iterations;
+                    elapsed = now_sec() - start;
+                } while (elapsed < MIN_DURATION_SEC);
+                us[0] = (elapsed / iterations) * 1e6;
+            }
+
+            /* Whole scenes from a fresh tracker, so tracks follow the targets */
+            iterations = 0;
+            start = now_sec();
+            do {
+                if (xensiv_bgt60trxx_tracker_init(&tracker, &config, storage, storage_size) !=
+                    XENSIV_BGT60TRXX_STATUS_OK) {
+                    return 1;
+                }
+                for (frame = 0; frame < NUM_FRAMES; ++frame) {
+                    xensiv_bgt60trxx_tracker_update(&tracker, &frames[frame * num_points],
+                                                    num_points);
+                }
+                ++iterations;
+                elapsed = now_sec() - start;
+            } while (elapsed < MIN_DURATION_SEC);
+            us[t + 1U] = (elapsed / (iterations * NUM_FRAMES)) * 1e6;
+
+            if (t == 0U) {
+                num_confirmed = 0U;
+                for (uint32_t k = 0; k < config.max_tracks; ++k) {
+                    num_confirmed += (tracker.tracks[k].state == XENSIV_BGT60TRXX_TRACK_CONFIRMED)
+                                     ? 1U : 0U;
+                }
+            }
+            checksum += tracker.next_id;
+            free(storage);
+        }
+
+        printf("  %6u %8u %11.1f %10.1f %10.1f %10.1f %10.1f %10.1f %7u\n", num_points,
+               num_clusters, naive_us, us[0], us[1], us[2], us[3], us[4], num_confirmed);
+        free(frames);
+    }
+    printf("(checksum %u)\n", checksum);
+
+    return 0;
+}
@@ -0,0 +1,92 @@
+/***********************************************************************************************/ /**
+                                                                                                   * \file bench_unpack.c
+                                                                                                   *
+                                                                                                   * \brief
+                                                                                                   * Micro-benchmark of the FIFO word unpacking kernels of the XENSIV BGT60TRxx library.
+                                                                                                   *
+                                                                                                   ***************************************************************************************************
+                                                                                                   * \copyright
+                                                                                                   * Copyright 2022 Infineon Technologies AG
+                                                                                                   * SPDX-License-Identifier: Apache-2.0
+                                                                                                   **************************************************************************************************/
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "../xensiv_bgt60trxx_unpack.h"
+
+/*******************************************************************************
+ * Macros
+ *******************************************************************************/
+#define NUM_SAMPLES (8192U * 2U) /* full BGT60TR13C FIFO */
+#define NUM_ITERATIONS 2000U
+
+/*******************************************************************************
+ * Function Implementations
+ *******************************************************************************/
+
+static double now_sec(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double) ts.tv_sec + ((double) ts.tv_nsec * 1e-9);
+}
+
+int main(void)
+{
+    static const struct {
+        xensiv_bgt60trxx_unpack_impl_t impl;
+        const char *name;
+    } impls[] = {
+        {XENSIV_BGT60TRXX_UNPACK_SCALAR, "scalar"},
+        {XENSIV_BGT60TRXX_UNPACK_SSSE3, "ssse3"},
+        {XENSIV_BGT60TRXX_UNPACK_AVX2, "avx2"},
+        {XENSIV_BGT60TRXX_UNPACK_NEON, "neon"},
+    };
+
+    uint8_t *packed = malloc(XENSIV_BGT60TRXX_PACKED_SIZE_BYTES(NUM_SAMPLES));
+    uint16_t *samples = malloc(NUM_SAMPLES * sizeof(uint16_t));
+    if (!packed || !samples) {
+        fprintf(stderr, "Failed to allocate buffers\n");
+        return 1;
+    }
+
+    for (uint32_t i = 0; i < XENSIV_BGT60TRXX_PACKED_SIZE_BYTES(NUM_SAMPLES); ++i) {
+        packed[i] = (uint8_t) (i * 31U);
+    }
+
+    printf("XENSIV BGT60TRxx FIFO unpack benchmark (%u samples x %u iterations)\n",
+           NUM_SAMPLES,
+           NUM_ITERATIONS);
+
+    for (size_t k = 0; k < sizeof(impls) / sizeof(impls[0]); ++k) {
+        if (!xensiv_bgt60trxx_unpack_impl_supported(impls[k].impl)) {
+            printf("  %-8s not supported\n", impls[k].name);
+            continue;
+        }
+
+        uint32_t checksum = 0;
+        double start = now_sec();
+        for (uint32_t it = 0; it < NUM_ITERATIONS; ++it) {
+            xensiv_bgt60trxx_unpack_fifo_data_impl(impls[k].impl, packed, samples, NUM_SAMPLES);
+            checksum += samples[it % NUM_SAMPLES];
+        }
+        double elapsed = now_sec() - start;
+
+        double msamples_per_sec = ((double) NUM_SAMPLES * NUM_ITERATIONS) / elapsed / 1e6;
+        printf("  %-8s %8.1f Msamples/s  %8.2f us/FIFO  (checksum %u)%s\n",
+               impls[k].name,
+               msamples_per_sec,
+               (elapsed / NUM_ITERATIONS) * 1e6,
+               checksum,
+               (impls[k].impl == xensiv_bgt60trxx_unpack_get_impl()) ? "  [selected]" : "");
+    }
+
+    free(packed);
+    free(samples);
+    return 0;
+}
@@ -18,6 +18,7 @@
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <unistd.h>
 
 // Include the main library headers
@@ -65,7 +66,8 @@ static void print_usage(const char *program_name)
     printf("  -s <device>    SPI device path (default: %s)\n", DEFAULT_SPI_DEVICE);
     printf("  -g <chip>      GPIO chip path (default: %s)\n", DEFAULT_GPIO_CHIP);
     printf("  -r <offset>    Reset GPIO offset (default: %d)\n", DEFAULT_RST_GPIO);
-    printf("  -c <offset>    CS GPIO offset (default: %d)\n", DEFAULT_CS_GPIO);
+    printf("  -c <offset>    CS GPIO offset, or 'native' for the SPI controller CS (default: %d)\n",
+           DEFAULT_CS_GPIO);
     printf("  -h             Show this help message\n");
     printf("\nExample:\n");
     printf("  %s -s /dev/spidev1.0 -g /dev/gpiochip1 -r 20 -c 21\n", program_name);
@@ -119,7 +121,8 @@ int main(int argc, char *argv[])
                 rst_gpio = (unsigned int) atoi(optarg);
                 break;
             case 'c':
-                cs_gpio = (unsigned int) atoi(optarg);
+                cs_gpio = (strcmp(optarg, "native") == 0) ? XENSIV_BGT60TRXX_LINUX_NATIVE_CS
+                                                          : (unsigned int) atoi(optarg);
                 break;
             case 'h':
                 print_usage(argv[0]);
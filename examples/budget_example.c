@@ -0,0 +1,241 @@
+/***********************************************************************************************/ /**
+                                                                                                   * \file budget_example.c
+                                                                                                   *
+                                                                                                   * \brief
+                                                                                                   * Command line check of a XENSIV BGT60TRxx register configuration against host SPI
+                                                                                                   * parameters: data rate, FIFO fill times, SPI clock and CREF limits.
+                                                                                                   *
+                                                                                                   ***************************************************************************************************
+                                                                                                   * \copyright
+                                                                                                   * Copyright 2022 Infineon Technologies AG
+                                                                                                   * SPDX-License-Identifier: Apache-2.0
+                                                                                                   **************************************************************************************************/
+
+#include <errno.h>
+#include <getopt.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Include the main library headers
+#include "../xensiv_bgt60trxx.h"
+#include "../xensiv_bgt60trxx_budget.h"
+#include "../xensiv_bgt60trxx_geometry.h"
+
+/*******************************************************************************
+ * Macros
+ *******************************************************************************/
+#define DEFAULT_SPI_CLOCK_HZ 10000000U
+#define DEFAULT_OVERHEAD_US 50U
+#define DEFAULT_LATENCY_US 1000U
+#define MAX_REGS 128U
+
+/*******************************************************************************
+ * Device Table
+ *******************************************************************************/
+static const struct {
+    const char *name;
+    uint32_t fifo_size; /* words */
+} devices[] = {
+    {"tr13c", 8192U},
+    {"utr13d", 8192U},
+    {"utr11", 2048U},
+};
+
+/*******************************************************************************
+ * Function Prototypes
+ *******************************************************************************/
+static void print_usage(const char *program_name);
+static int load_registers(const char *path, uint32_t *regs, uint32_t *len);
+static uint32_t config_cref(const uint32_t *regs, uint32_t len);
+
+/*******************************************************************************
+ * Function Implementations
+ *******************************************************************************/
+
+static void print_usage(const char *program_name)
+{
+    printf("Usage: %s -f <file> [options]\n", program_name);
+    printf("Options:\n");
+    printf("  -f <file>      Register list: configurator header or 0x-prefixed words\n");
+    printf("  -d <device>    tr13c, utr13d or utr11, selects the FIFO size (default: tr13c)\n");
+    printf("  -k <hz>        SPI clock (default: %u)\n", DEFAULT_SPI_CLOCK_HZ);
+    printf("  -H             MISO high speed read mode\n");
+    printf("  -o <us>        Host overhead per FIFO burst (default: %u)\n", DEFAULT_OVERHEAD_US);
+    printf("  -l <us>        Worst host service latency (default: %u)\n", DEFAULT_LATENCY_US);
+    printf("  -C <samples>   FIFO limit (default: from SFCTL, else one frame)\n");
+    printf("  -h             Show this help message\n");
+    printf("Exits with 0 if the host keeps up, 1 if it does not, 2 on errors.\n");
+}
+
+// Collects the 0x words of the first {...} initializer, or of the whole file if there is none
+static int load_registers(const char *path, uint32_t *regs, uint32_t *len)
+{
+    FILE *f = fopen(path, "r");
+    if (f == NULL) {
+        fprintf(stderr, "Cannot open %s: %s\n", path, strerror(errno));
+        return -1;
+    }
+
+    static char text[1 << 16];
+    size_t size = fread(text, 1, sizeof(text) - 1U, f);
+    fclose(f);
+    text[size] = '\0';
+
+    char *p = strchr(text, '{');
+    p = (p != NULL) ? p + 1 : text;
+    char *end = strchr(p, '}');
+    if (end != NULL) {
+        *end = '\0';
+    }
+
+    *len = 0;
+    while ((p = strstr(p, "0x")) != NULL) {
+        char *next;
+        unsigned long word = strtoul(p, &next, 16);
+        if (*len == MAX_REGS) {
+            fprintf(stderr, "More than %u registers in %s\n", MAX_REGS, path);
+            return -1;
+        }
+        regs[(*len)++] = (uint32_t) word;
+        p = next;
+    }
+
+    if (*len == 0U) {
+        fprintf(stderr, "No registers found in %s\n", path);
+        return -1;
+    }
+
+    return 0;
+}
+
+static uint32_t config_cref(const uint32_t *regs, uint32_t len)
+{
+    for (uint32_t i = 0; i < len; i++) {
+        if ((regs[i] >> 25) == XENSIV_BGT60TRXX_REG_SFCTL) {
+            uint32_t cref = (regs[i] & XENSIV_BGT60TRXX_REG_SFCTL_FIFO_CREF_MSK) >>
+                            XENSIV_BGT60TRXX_REG_SFCTL_FIFO_CREF_POS;
+            return (cref + 1U) * 2U;
+        }
+    }
+
+    return 0;
+}
+
+int main(int argc, char *argv[])
+{
+    const char *path = NULL;
+    uint32_t regs[MAX_REGS];
+    uint32_t len;
+    xensiv_bgt60trxx_host_config_t host = {
+        .spi_clock_hz = DEFAULT_SPI_CLOCK_HZ,
+        .high_speed = false,
+        .transaction_overhead_us = DEFAULT_OVERHEAD_US,
+        .service_latency_us = DEFAULT_LATENCY_US,
+        .cref_samples = 0,
+        .fifo_size = devices[0].fifo_size,
+    };
+    int opt;
+
+    // Parse command line arguments
+    while ((opt = getopt(argc, argv, "f:d:k:Ho:l:C:h")) != -1) {
+        switch (opt) {
+            case 'f':
+                path = optarg;
+                break;
+            case 'd': {
+                size_t i = 0;
+                while ((i < sizeof(devices) / sizeof(devices[0])) &&
+                       (strcmp(optarg, devices[i].name) != 0)) {
+                    i++;
+                }
+                if (i == sizeof(devices) / sizeof(devices[0])) {
+                    fprintf(stderr, "Unknown device %s\n", optarg);
+                    return 2;
+                }
+                host.fifo_size = devices[i].fifo_size;
+                break;
+            }
+            case 'k':
+                host.spi_clock_hz = (uint32_t) strtoul(optarg, NULL, 0);
+                break;
+            case 'H':
+                host.high_speed = true;
+                break;
+            case 'o':
+                host.transaction_overhead_us = (uint32_t) strtoul(optarg, NULL, 0);
+                break;
+            case 'l':
+                host.service_latency_us = (uint32_t) strtoul(optarg, NULL, 0);
+                break;
+            case 'C':
+                host.cref_samples = (uint32_t) strtoul(optarg, NULL, 0);
+                break;
+            case 'h':
+                print_usage(argv[0]);
+                return 0;
+            default:
+                print_usage(argv[0]);
+                return 2;
+        }
+    }
+
+    if ((path == NULL) || (load_registers(path, regs, &len) != 0)) {
+        if (path == NULL) {
+            print_usage(argv[0]);
+        }
+        return 2;
+    }
+
+    xensiv_bgt60trxx_frame_geometry_t geometry;
+    if (xensiv_bgt60trxx_decode_geometry(regs, len, &geometry) != XENSIV_BGT60TRXX_STATUS_OK) {
+        fprintf(stderr, "Configuration acquires no samples\n");
+        return 2;
+    }
+
+    if (host.cref_samples == 0U) {
+        host.cref_samples = config_cref(regs, len);
+    }
+    if (host.cref_samples == 0U) {
+        host.cref_samples = (geometry.samples_per_frame + 1U) & ~1U;
+    }
+
+    xensiv_bgt60trxx_budget_t budget;
+    if (xensiv_bgt60trxx_compute_budget(&geometry, &host, &budget) != XENSIV_BGT60TRXX_STATUS_OK) {
+        fprintf(stderr, "Invalid FIFO limit %u for a FIFO of %u samples\n",
+                host.cref_samples, host.fifo_size * 2U);
+        return 2;
+    }
+
+    printf("Configuration (%u registers)\n", len);
+    printf("  Chirp:               %u samples x %u RX (mask 0x%X), %u chirps per shape\n",
+           geometry.samples_per_chirp, geometry.num_rx, geometry.rx_mask,
+           geometry.chirps_per_shape);
+    printf("  Frame:               %u shapes, %u samples, %u us\n",
+           geometry.shapes_per_frame, geometry.samples_per_frame, geometry.frame_period_us);
+    printf("  ADC rate:            %u Hz\n", geometry.adc_rate_hz);
+    printf("  Data rate:           %u samples/s, %u bytes/s\n",
+           geometry.data_rate_sps, budget.data_rate_bytes_per_s);
+    printf("FIFO (%u samples, CREF %u)\n", host.fifo_size * 2U, host.cref_samples);
+    printf("  Fill to CREF:        %u us\n", budget.fill_to_cref_us);
+    printf("  Fill to full:        %u us\n", budget.fill_to_full_us);
+    printf("  Max safe CREF:       %u samples at %u us latency\n",
+           budget.max_safe_cref, host.service_latency_us);
+    printf("SPI (%u Hz, %s mode)\n", host.spi_clock_hz, host.high_speed ? "high speed" : "normal");
+    printf("  Burst:               %u us including %u us overhead\n",
+           budget.burst_us, host.transaction_overhead_us);
+    if (budget.min_spi_clock_hz == UINT32_MAX) {
+        printf("  Min clock:           none, overhead exceeds the refill time\n");
+    } else {
+        printf("  Min clock:           %u Hz\n", budget.min_spi_clock_hz);
+    }
+    printf("  Max clock:           %u Hz\n", budget.max_spi_clock_hz);
+    printf("  Bus utilisation:     %u.%u%% (%u.%u%% with overhead)\n",
+           budget.bus_load_permille / 10U, budget.bus_load_permille % 10U,
+           budget.host_load_permille / 10U, budget.host_load_permille % 10U);
+    printf("Verdict: %s\n", budget.feasible ? "host keeps up" : "FIFO overflow expected");
+
+    return budget.feasible ? 0 : 1;
+}
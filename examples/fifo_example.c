@@ -17,11 +17,13 @@
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <unistd.h>
 
 // Include the main library headers
 #include "../xensiv_bgt60trxx.h"
 #include "../xensiv_bgt60trxx_linux.h"
+#include "../xensiv_bgt60trxx_linux_sched.h"
 
 /*******************************************************************************
  * Macros
@@ -65,7 +67,10 @@ static void print_usage(const char *program_name)
     printf("  -s <device>    SPI device path (default: %s)\n", DEFAULT_SPI_DEVICE);
     printf("  -g <chip>      GPIO chip path (default: %s)\n", DEFAULT_GPIO_CHIP);
     printf("  -r <offset>    Reset GPIO offset (default: %d)\n", DEFAULT_RST_GPIO);
-    printf("  -c <offset>    CS GPIO offset (default: %d)\n", DEFAULT_CS_GPIO);
+    printf("  -c <offset>    CS GPIO offset, or 'native' for the SPI controller CS (default: %d)\n",
+           DEFAULT_CS_GPIO);
+    printf("  -i <offset>    IRQ GPIO offset, wait for the FIFO interrupt instead of polling\n");
+    printf("  -t             Train the SPI link (clock and MISO mode) before reading\n");
     printf("  -h             Show this help message\n");
 }
 
@@ -122,12 +127,15 @@ int main(int argc, char *argv[])
     const char *gpio_chip = DEFAULT_GPIO_CHIP;
     unsigned int rst_gpio = DEFAULT_RST_GPIO;
     unsigned int cs_gpio = DEFAULT_CS_GPIO;
+    unsigned int irq_gpio = 0;
+    bool use_irq = false;
+    bool train_link = false;
     int opt;
     int32_t result;
     uint16_t *fifo_buffer;
 
     // Parse command line arguments
-    while ((opt = getopt(argc, argv, "s:g:r:c:h")) != -1) {
+    while ((opt = getopt(argc, argv, "s:g:r:c:i:th")) != -1) {
         switch (opt) {
             case 's':
                 spi_device = optarg;
@@ -139,7 +147,15 @@ int main(int argc, char *argv[])
                 rst_gpio = (unsigned int) atoi(optarg);
                 break;
             case 'c':
-                cs_gpio = (unsigned int) atoi(optarg);
+                cs_gpio = (strcmp(optarg, "native") == 0) ? XENSIV_BGT60TRXX_LINUX_NATIVE_CS
+                                                          : (unsigned int) atoi(optarg);
+                break;
+            case 'i':
+                irq_gpio = (unsigned int) atoi(optarg);
+                use_irq = true;
+                break;
+            case 't':
+                train_link = true;
                 break;
             case 'h':
                 print_usage(argv[0]);
@@ -185,6 +201,39 @@ int main(int argc, char *argv[])
         return 1;
     }
 
+    // Pick the fastest SPI clock the board handles without bit errors
+    if (train_link) {
+        xensiv_bgt60trxx_linux_link_result_t link;
+
+        printf("Training SPI link...\n");
+        result = xensiv_bgt60trxx_linux_train_link(&g_sensor_obj, NULL, &link);
+        if (result != XENSIV_BGT60TRXX_STATUS_OK) {
+            fprintf(stderr, "Failed to train SPI link: %d\n", result);
+            xensiv_bgt60trxx_linux_deinit_sensor(&g_sensor_obj);
+            free(fifo_buffer);
+            return 1;
+        }
+
+        printf("SPI link: %u Hz%s (clean up to %u Hz, %llu bit errors in %llu bits)\n",
+               link.speed_hz,
+               link.high_speed ? ", high speed MISO" : "",
+               link.max_clean_hz,
+               (unsigned long long) link.bit_errors,
+               (unsigned long long) link.bits_tested);
+    }
+
+    // Let the sensor IRQ signal FIFO_THRESHOLD samples instead of polling FSTAT over SPI
+    if (use_irq) {
+        result =
+            xensiv_bgt60trxx_linux_interrupt_init(&g_sensor_obj, irq_gpio, FIFO_THRESHOLD);
+        if (result != XENSIV_BGT60TRXX_STATUS_OK) {
+            fprintf(stderr, "Failed to initialize IRQ GPIO: %d\n", result);
+            xensiv_bgt60trxx_linux_deinit_sensor(&g_sensor_obj);
+            free(fifo_buffer);
+            return 1;
+        }
+    }
+
     // Start frame generation
     printf("Starting frame generation...\n");
     result = xensiv_bgt60trxx_start_frame(&g_sensor_obj.dev, true);
@@ -195,33 +244,90 @@ int main(int argc, char *argv[])
         return 1;
     }
 
+    // Without the IRQ line, poll FSTAT at the predicted time the FIFO limit is reached
+    xensiv_bgt60trxx_linux_sched_t sched;
+    if (!use_irq) {
+        xensiv_bgt60trxx_linux_sched_config_t sched_cfg = {.cref_samples = FIFO_THRESHOLD};
+
+        result = xensiv_bgt60trxx_linux_sched_init(&sched, &sched_cfg);
+        if (result != XENSIV_BGT60TRXX_STATUS_OK) {
+            fprintf(stderr, "Failed to initialize FIFO polling: %d\n", result);
+            xensiv_bgt60trxx_start_frame(&g_sensor_obj.dev, false);
+            xensiv_bgt60trxx_linux_deinit_sensor(&g_sensor_obj);
+            free(fifo_buffer);
+            return 1;
+        }
+    }
+
     printf("Frame generation started. Reading FIFO data...\n");
     printf("Press Ctrl+C to stop...\n\n");
 
     // Main data acquisition loop
     while (g_running) {
-        uint32_t fifo_status;
-
-        // Check FIFO status
-        result = xensiv_bgt60trxx_get_fifo_status(&g_sensor_obj.dev, &fifo_status);
-        if (result != XENSIV_BGT60TRXX_STATUS_OK) {
-            fprintf(stderr, "Failed to get FIFO status: %d\n", result);
-            break;
+        bool data_ready;
+
+        if (use_irq) {
+            // Sleep until the IRQ fires; time out periodically to notice Ctrl+C
+            result = xensiv_bgt60trxx_linux_wait_fifo(&g_sensor_obj.iface, 100, NULL);
+            if (result != XENSIV_BGT60TRXX_STATUS_OK &&
+                result != XENSIV_BGT60TRXX_STATUS_TIMEOUT_ERROR) {
+                fprintf(stderr, "Failed to wait for FIFO interrupt: %d\n", result);
+                break;
+            }
+            data_ready = (result == XENSIV_BGT60TRXX_STATUS_OK);
+        } else {
+            uint32_t fill;
+
+            // Sleep until the predicted fill time; time out periodically to notice Ctrl+C
+            result = xensiv_bgt60trxx_linux_sched_wait(&sched, &g_sensor_obj.dev, 100, &fill);
+            if (result != XENSIV_BGT60TRXX_STATUS_OK &&
+                result != XENSIV_BGT60TRXX_STATUS_TIMEOUT_ERROR) {
+                fprintf(stderr, "Failed to get FIFO status: %d\n", result);
+                break;
+            }
+            data_ready = (result == XENSIV_BGT60TRXX_STATUS_OK);
         }
 
         // Check if enough data is available
-        if (fifo_status & XENSIV_BGT60TRXX_REG_FSTAT_CREF_MSK) {
-            // Read FIFO data
-            result = xensiv_bgt60trxx_get_fifo_data(&g_sensor_obj.dev, fifo_buffer, FIFO_THRESHOLD);
+        if (data_ready) {
+            uint32_t num_read;
+
+            // Read every complete block waiting in the FIFO, catching up after a stall
+            result = xensiv_bgt60trxx_drain_fifo(
+                &g_sensor_obj.dev, fifo_buffer, MAX_SAMPLES, FIFO_THRESHOLD, &num_read);
             if (result == XENSIV_BGT60TRXX_STATUS_OK) {
-                process_fifo_data(fifo_buffer, FIFO_THRESHOLD);
+                if (num_read > 0U) {
+                    process_fifo_data(fifo_buffer, num_read);
+                }
+                if (!use_irq) {
+                    xensiv_bgt60trxx_linux_sched_consumed(&sched, num_read);
+                }
+            } else if (result == XENSIV_BGT60TRXX_STATUS_FIFO_ERROR) {
+                // Overflow or underflow: drop the FIFO content and restart the frames
+                fprintf(stderr, "FIFO error, restarting frame generation\n");
+                result =
+                    xensiv_bgt60trxx_soft_reset(&g_sensor_obj.dev, XENSIV_BGT60TRXX_RESET_FIFO);
+                if (result == XENSIV_BGT60TRXX_STATUS_OK) {
+                    result = xensiv_bgt60trxx_start_frame(&g_sensor_obj.dev, true);
+                }
+                if (!use_irq) {
+                    xensiv_bgt60trxx_linux_sched_restart(&sched);
+                }
             } else {
                 fprintf(stderr, "Failed to read FIFO data: %d\n", result);
             }
         }
+    }
+
+    if (!use_irq) {
+        xensiv_bgt60trxx_linux_sched_stats_t stats;
 
-        // Small delay to prevent excessive CPU usage
-        usleep(10000);  // 10ms
+        xensiv_bgt60trxx_linux_sched_get_stats(&sched, &stats);
+        printf("\nFIFO polling: %u status reads, %u early, %.0f samples/s\n",
+               stats.reads,
+               stats.early_reads,
+               stats.rate_sps);
+        xensiv_bgt60trxx_linux_sched_deinit(&sched);
     }
 
     // Stop frame generation
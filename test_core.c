@@ -0,0 +1,1010 @@
+/**
+ * @file test_core.c
+ * @brief SPI protocol test for the XENSIV BGT60TRxx core driver
+ *
+ * The core driver is built against a fake platform that models the register file of the
+ * sensor and records every SPI transfer, so that the exact bytes on the bus and the decoding
+ * of the device responses can be checked without hardware. With Linux support the acquisition
+ * thread runs on the same fake, a pipe standing in for the GPIO line event fd of the IRQ line.
+ */
+
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+#ifdef ENABLE_LINUX_SUPPORT
+    #include <linux/gpio.h>
+    #include <poll.h>
+    #include <time.h>
+    #include <unistd.h>
+#endif
+
+#include "xensiv_bgt60trxx.h"
+#include "xensiv_bgt60trxx_platform.h"
+#ifdef ENABLE_LINUX_SUPPORT
+    #include "xensiv_bgt60trxx_geometry.h"
+    #include "xensiv_bgt60trxx_linux_acq.h"
+#endif
+
+#define TEST_REG(addr, data) (((uint32_t)(addr) << 25) | (data))
+
+#define FAKE_MAX_XFERS (64U)
+#define FAKE_MAX_XFER_BYTES (128U)
+
+/* Chip IDs: digital ID, RF ID */
+#define FAKE_CHIP_ID (0x000303UL)        /* TR13C */
+#define FAKE_CHIP_ID_UTR13D (0x000606UL) /* UTR13D: FSTAT is not next to the FIFO */
+#define FAKE_FSTAT (fake.fstat_addr)
+
+typedef struct {
+    uint32_t len;
+    uint8_t tx[FAKE_MAX_XFER_BYTES];
+} fake_xfer_t;
+
+/* Register file and transfer log of the fake sensor, the log keeps the first FAKE_MAX_XFERS */
+static struct {
+    uint32_t regs[128];
+    uint32_t fstat_addr;
+    bool reset_stuck;
+    bool spi_error;
+    uint32_t slept_us;
+    uint8_t gsr0;
+    bool cs_low;
+    uint32_t num_xfers;
+    fake_xfer_t xfers[FAKE_MAX_XFERS];
+    uint32_t num_fifo_reads;
+    uint32_t fifo_samples;
+    uint8_t fifo_header[XENSIV_BGT60TRXX_SPI_BURST_HEADER_SIZE_BYTES];
+} fake;
+
+static void fake_write_reg(uint32_t addr, uint32_t data)
+{
+    /* The reset bits of MAIN clear themselves once the reset is done, which also ends a running
+       frame sequence */
+    if ((addr == XENSIV_BGT60TRXX_REG_MAIN) && !fake.reset_stuck &&
+        ((data & XENSIV_BGT60TRXX_REG_MAIN_RESET_MSK) != 0U)) {
+        data &= (uint32_t) ~(XENSIV_BGT60TRXX_REG_MAIN_RESET_MSK |
+                             XENSIV_BGT60TRXX_REG_MAIN_FRAME_START_MSK);
+    }
+    fake.regs[addr] = data;
+}
+
+int32_t xensiv_bgt60trxx_platform_spi_transfer(void *iface,
+                                               uint8_t *tx_data,
+                                               uint8_t *rx_data,
+                                               uint32_t len)
+{
+    assert(iface == &fake);
+    assert(fake.cs_low);
+    assert((tx_data != NULL) && (len <= FAKE_MAX_XFER_BYTES));
+
+    if (fake.num_xfers < FAKE_MAX_XFERS) {
+        fake_xfer_t *xfer = &fake.xfers[fake.num_xfers];
+        xfer->len = len;
+        memcpy(xfer->tx, tx_data, len);
+    }
+    ++fake.num_xfers;
+
+    /* A failed transfer is logged but never reaches the register file */
+    if (fake.spi_error) {
+        return XENSIV_BGT60TRXX_STATUS_COM_ERROR;
+    }
+
+    if (tx_data[0] == 0xFFU) {
+        /* Burst: 0xFF, SADR and RWB, LEN, 0, then 24-bit register words */
+        uint32_t addr = tx_data[1] >> 1;
+        uint32_t count = tx_data[2] >> 1;
+        assert(len == (XENSIV_BGT60TRXX_SPI_BURST_HEADER_SIZE_BYTES + (3U * count)));
+        for (uint32_t i = 0; i < count; ++i) {
+            const uint8_t *word = &tx_data[XENSIV_BGT60TRXX_SPI_BURST_HEADER_SIZE_BYTES + (3U * i)];
+            if ((tx_data[1] & 1U) != 0U) {
+                fake_write_reg(addr + i,
+                               ((uint32_t) word[0] << 16) | ((uint32_t) word[1] << 8) | word[2]);
+            } else if (rx_data != NULL) {
+                uint8_t *out = &rx_data[XENSIV_BGT60TRXX_SPI_BURST_HEADER_SIZE_BYTES + (3U * i)];
+                out[0] = (uint8_t) (fake.regs[addr + i] >> 16);
+                out[1] = (uint8_t) (fake.regs[addr + i] >> 8);
+                out[2] = (uint8_t) fake.regs[addr + i];
+            } else {
+                /* Read without a receive buffer */
+            }
+        }
+        if (rx_data != NULL) {
+            memset(rx_data, 0, XENSIV_BGT60TRXX_SPI_BURST_HEADER_SIZE_BYTES);
+            rx_data[0] = fake.gsr0;
+        }
+    } else {
+        /* Single access: address and RW bit, then the 24-bit data */
+        uint32_t addr = tx_data[0] >> 1;
+        assert(len == 4U);
+        if ((tx_data[0] & 1U) != 0U) {
+            fake_write_reg(addr,
+                           ((uint32_t) tx_data[1] << 16) | ((uint32_t) tx_data[2] << 8) |
+                           tx_data[3]);
+        }
+        if (rx_data != NULL) {
+            rx_data[0] = fake.gsr0;
+            rx_data[1] = (uint8_t) (fake.regs[addr] >> 16);
+            rx_data[2] = (uint8_t) (fake.regs[addr] >> 8);
+            rx_data[3] = (uint8_t) fake.regs[addr];
+        }
+    }
+
+    return XENSIV_BGT60TRXX_STATUS_OK;
+}
+
+int32_t xensiv_bgt60trxx_platform_spi_fifo_burst_read(void *iface,
+                                                      uint8_t *header,
+                                                      uint8_t *gsr0,
+                                                      uint16_t *rx_data,
+                                                      uint32_t len)
+{
+    assert(iface == &fake);
+
+    /* Samples count up from the fill level, the fill level drops by the words read */
+    uint32_t fill = fake.regs[FAKE_FSTAT] & XENSIV_BGT60TRXX_REG_FSTAT_FILL_STATUS_MSK;
+    assert((len / XENSIV_BGT60TRXX_NUM_SAMPLES_FIFO_WORD) <= fill);
+    for (uint32_t i = 0; i < len; ++i) {
+        rx_data[i] = (uint16_t) (fake.fifo_samples + i);
+    }
+    fake.fifo_samples += len;
+    fake.regs[FAKE_FSTAT] -= len / XENSIV_BGT60TRXX_NUM_SAMPLES_FIFO_WORD;
+
+    memcpy(fake.fifo_header, header, sizeof(fake.fifo_header));
+    memset(gsr0, 0, XENSIV_BGT60TRXX_SPI_BURST_HEADER_SIZE_BYTES);
+    gsr0[0] = fake.gsr0;
+    ++fake.num_fifo_reads;
+
+    return XENSIV_BGT60TRXX_STATUS_OK;
+}
+
+int32_t xensiv_bgt60trxx_platform_spi_fifo_read(void *iface, uint16_t *rx_data, uint32_t len)
+{
+    (void) iface;
+    (void) rx_data;
+    (void) len;
+    return XENSIV_BGT60TRXX_STATUS_COM_ERROR;
+}
+
+void xensiv_bgt60trxx_platform_spi_cs_set(const void *iface, bool val)
+{
+    assert(iface == &fake);
+    assert(fake.cs_low == val);
+    fake.cs_low = !val;
+}
+
+void xensiv_bgt60trxx_platform_rst_set(const void *iface, bool val)
+{
+    (void) iface;
+    (void) val;
+}
+
+void xensiv_bgt60trxx_platform_delay(uint32_t ms)
+{
+    (void) ms;
+}
+
+void xensiv_bgt60trxx_platform_delay_us(uint32_t us)
+{
+    fake.slept_us += us;
+}
+
+/* Transmission byte order is big endian */
+uint32_t xensiv_bgt60trxx_platform_word_reverse(uint32_t x)
+{
+    const uint8_t bytes[4] = {(uint8_t) (x >> 24), (uint8_t) (x >> 16), (uint8_t) (x >> 8),
+                              (uint8_t) x};
+    uint32_t out;
+    memcpy(&out, bytes, sizeof(out));
+    return out;
+}
+
+void xensiv_bgt60trxx_platform_assert(bool expr)
+{
+    assert(expr);
+}
+
+#ifdef ENABLE_LINUX_SUPPORT
+/* Linux interface functions used by the acquisition thread: the IRQ line is a pipe */
+int xensiv_bgt60trxx_linux_get_irq_fd(const xensiv_bgt60trxx_linux_t *obj)
+{
+    return obj ? obj->irq_gpio_fd : -1;
+}
+
+int32_t xensiv_bgt60trxx_linux_alloc_buffers(xensiv_bgt60trxx_linux_t *obj,
+                                             uint32_t fifo_size,
+                                             bool lock)
+{
+    (void) obj;
+    (void) fifo_size;
+    (void) lock;
+    return XENSIV_BGT60TRXX_STATUS_OK;
+}
+
+int32_t xensiv_bgt60trxx_linux_wait_fifo(xensiv_bgt60trxx_linux_t *obj,
+                                         int timeout_ms,
+                                         uint64_t *timestamp_ns)
+{
+    struct pollfd pfd = {.fd = obj->irq_gpio_fd, .events = POLLIN};
+    struct gpio_v2_line_event event;
+
+    if (poll(&pfd, 1, timeout_ms) == 0) {
+        return XENSIV_BGT60TRXX_STATUS_TIMEOUT_ERROR;
+    }
+    ssize_t ret = read(obj->irq_gpio_fd, &event, sizeof(event));
+    assert(ret == (ssize_t) sizeof(event));
+    if (timestamp_ns) {
+        *timestamp_ns = event.timestamp_ns;
+    }
+
+    return XENSIV_BGT60TRXX_STATUS_OK;
+}
+#endif /* ENABLE_LINUX_SUPPORT */
+
+/* Resets the fake to the given register map and brings the driver up on it */
+static void fake_init_device(xensiv_bgt60trxx_t *dev,
+                             bool high_speed,
+                             uint32_t chip_id,
+                             uint32_t fstat_addr,
+                             xensiv_bgt60trxx_device_t device)
+{
+    memset(&fake, 0, sizeof(fake));
+    fake.regs[XENSIV_BGT60TRXX_REG_CHIP_ID] = chip_id;
+    fake.fstat_addr = fstat_addr;
+    assert(xensiv_bgt60trxx_init(dev, &fake, high_speed) == XENSIV_BGT60TRXX_STATUS_OK);
+    assert(xensiv_bgt60trxx_get_device(dev) == device);
+    fake.num_xfers = 0U;
+}
+
+/* Resets the fake to a TR13C and brings the driver up on it */
+static void fake_init(xensiv_bgt60trxx_t *dev, bool high_speed)
+{
+    fake_init_device(
+        dev, high_speed, FAKE_CHIP_ID, XENSIV_BGT60TRXX_REG_FSTAT_TR13C, XENSIV_DEVICE_BGT60TR13C);
+}
+
+static void expect_xfer(uint32_t idx, const uint8_t *bytes, uint32_t len)
+{
+    assert((idx < fake.num_xfers) && (idx < FAKE_MAX_XFERS));
+    assert(fake.xfers[idx].len == len);
+    assert(memcmp(fake.xfers[idx].tx, bytes, len) == 0);
+}
+
+static void expect_single_write(uint32_t idx, uint32_t addr, uint32_t data)
+{
+    const uint8_t bytes[4] = {(uint8_t) ((addr << 1) | 1U), (uint8_t) (data >> 16),
+                              (uint8_t) (data >> 8), (uint8_t) data};
+    expect_xfer(idx, bytes, sizeof(bytes));
+}
+
+static void expect_single_read(uint32_t idx, uint32_t addr)
+{
+    const uint8_t bytes[4] = {(uint8_t) (addr << 1), 0U, 0U, 0U};
+    expect_xfer(idx, bytes, sizeof(bytes));
+}
+
+/* A software reset without a shadow: read MAIN, set the reset bit, poll MAIN once */
+static uint32_t expect_soft_reset(uint32_t idx, uint32_t main, uint32_t reset)
+{
+    expect_single_read(idx, XENSIV_BGT60TRXX_REG_MAIN);
+    expect_single_write(idx + 1U, XENSIV_BGT60TRXX_REG_MAIN, main | reset);
+    expect_single_read(idx + 2U, XENSIV_BGT60TRXX_REG_MAIN);
+    return idx + 3U;
+}
+
+/**
+ * @brief Test the burst write encoding and the register runs of a configuration
+ * @return 0 on success, non-zero on failure
+ */
+static int test_burst_write(void)
+{
+    printf("Testing register burst writes...\n");
+
+    xensiv_bgt60trxx_t dev;
+    fake_init(&dev, false);
+
+    // Run 0x04-0x05, SFCTL alone, run 0x07-0x09, gap, 0x0b alone, then 34 registers from 0x10
+    uint32_t regs[7 + 34] = {
+        TEST_REG(XENSIV_BGT60TRXX_REG_PACR1, 0x0A1B2CU),
+        TEST_REG(XENSIV_BGT60TRXX_REG_PACR2, 0x3D4E5FU),
+        TEST_REG(XENSIV_BGT60TRXX_REG_SFCTL, 0x1120FFU),
+        TEST_REG(XENSIV_BGT60TRXX_REG_SADC_CTRL, 0x000555U),
+        TEST_REG(XENSIV_BGT60TRXX_REG_CSI_0, 0x800001U),
+        TEST_REG(XENSIV_BGT60TRXX_REG_CSI_1, 0x000100U),
+        TEST_REG(XENSIV_BGT60TRXX_REG_CSCI, 0xFEDCBAU),
+    };
+    for (uint32_t i = 0; i < 34U; ++i) {
+        regs[7U + i] = TEST_REG(0x10U + i, 0x010000U * i + i);
+    }
+    fake.regs[XENSIV_BGT60TRXX_REG_MAIN] = 0x1E8270U;
+    assert(xensiv_bgt60trxx_config(&dev, regs, sizeof(regs) / sizeof(regs[0])) ==
+           XENSIV_BGT60TRXX_STATUS_OK);
+
+    uint32_t idx = expect_soft_reset(0U, 0x1E8270U, XENSIV_BGT60TRXX_RESET_SW);
+
+    // Header: 0xFF, SADR << 1 | RWB, LEN << 1, 0; then 24-bit words MSB first
+    static const uint8_t run1[] = {0xFF, 0x09, 0x04, 0x00, 0x0A, 0x1B, 0x2C, 0x3D, 0x4E, 0x5F};
+    expect_xfer(idx++, run1, sizeof(run1));
+    // FIFO limit cleared by config, MISO HS cleared for a normal speed device
+    expect_single_write(idx++, XENSIV_BGT60TRXX_REG_SFCTL, 0x102000U);
+    static const uint8_t run2[] = {0xFF, 0x0F, 0x06, 0x00, 0x00, 0x05, 0x55,
+                                   0x80, 0x00, 0x01, 0x00, 0x01, 0x00};
+    expect_xfer(idx++, run2, sizeof(run2));
+    expect_single_write(idx++, XENSIV_BGT60TRXX_REG_CSCI, 0xFEDCBAU);
+
+    // A run longer than the burst limit continues in a second burst
+    const uint32_t first = XENSIV_BGT60TRXX_SPI_BURST_MAX_REGS;
+    for (uint32_t b = 0; b < 2U; ++b) {
+        const uint32_t start = (b == 0U) ? 0U : first;
+        const uint32_t count = (b == 0U) ? first : (34U - first);
+        const fake_xfer_t *xfer = &fake.xfers[idx++];
+        assert(xfer->len == 4U + (3U * count));
+        assert((xfer->tx[0] == 0xFFU) && (xfer->tx[1] == (((0x10U + start) << 1) | 1U)) &&
+               (xfer->tx[2] == (count << 1)) && (xfer->tx[3] == 0U));
+        for (uint32_t i = 0; i < count; ++i) {
+            uint32_t data = regs[7U + start + i] & 0xFFFFFFU;
+            assert(xfer->tx[4U + (3U * i)] == (uint8_t) (data >> 16));
+            assert(xfer->tx[5U + (3U * i)] == (uint8_t) (data >> 8));
+            assert(xfer->tx[6U + (3U * i)] == (uint8_t) data);
+        }
+    }
+    assert(idx == fake.num_xfers);
+    for (uint32_t i = 0; i < 34U; ++i) {
+        assert(fake.regs[0x10U + i] == (regs[7U + i] & 0xFFFFFFU));
+    }
+
+    // A high speed device gets MISO HS set in SFCTL
+    fake_init(&dev, true);
+    assert(xensiv_bgt60trxx_config(&dev, &regs[2], 1U) == XENSIV_BGT60TRXX_STATUS_OK);
+    expect_single_write(3U, XENSIV_BGT60TRXX_REG_SFCTL, 0x112000U);
+    assert(fake.num_xfers == 4U);
+
+    printf("✓ Register burst write test passed\n");
+    return 0;
+}
+
+/* Checks a burst read transfer: header with RWB=0 and the payload clocked out as 0xFF */
+static void expect_burst_read(uint32_t idx, uint32_t addr, uint32_t count)
+{
+    const fake_xfer_t *xfer = &fake.xfers[idx];
+
+    assert((idx < fake.num_xfers) && (idx < FAKE_MAX_XFERS));
+    assert(xfer->len == 4U + (3U * count));
+    assert((xfer->tx[0] == 0xFFU) && (xfer->tx[1] == (addr << 1)) &&
+           (xfer->tx[2] == (count << 1)) && (xfer->tx[3] == 0U));
+    for (uint32_t i = 4U; i < xfer->len; ++i) {
+        assert(xfer->tx[i] == 0xFFU);
+    }
+}
+
+/**
+ * @brief Test the burst read encoding, the splitting into bursts and the status snapshot
+ * @return 0 on success, non-zero on failure
+ */
+static int test_burst_read(void)
+{
+    printf("Testing register burst reads...\n");
+
+    xensiv_bgt60trxx_t dev;
+    fake_init(&dev, false);
+    for (uint32_t addr = 0; addr < 128U; ++addr) {
+        fake.regs[addr] = (0x030507UL * (addr + 1U)) & 0xFFFFFFUL;
+    }
+
+    // 40 registers need a full burst and a second one for the rest
+    uint32_t data[40];
+    const uint32_t first = XENSIV_BGT60TRXX_SPI_BURST_MAX_REGS;
+    assert(xensiv_bgt60trxx_get_regs(&dev, 0x02U, data, 40U) == XENSIV_BGT60TRXX_STATUS_OK);
+    assert(fake.num_xfers == 2U);
+    expect_burst_read(0U, 0x02U, first);
+    expect_burst_read(1U, 0x02U + first, 40U - first);
+    for (uint32_t i = 0; i < 40U; ++i) {
+        assert(data[i] == fake.regs[0x02U + i]);
+    }
+
+    // The snapshot reads MAIN..STAT1 and STAT0..FSTAT, GSR0 comes with the second burst
+    fake.regs[XENSIV_BGT60TRXX_REG_MAIN] = 0x1E8271U;
+    fake.regs[XENSIV_BGT60TRXX_REG_STAT1] = 0x00A5C3U;
+    fake.regs[XENSIV_BGT60TRXX_REG_STAT0] = 0x0000F1U;
+    fake.regs[FAKE_FSTAT] = XENSIV_BGT60TRXX_REG_FSTAT_CREF_MSK | 0x000123U;
+    fake.gsr0 = XENSIV_BGT60TRXX_REG_GSR0_MISO_HS_READ_MSK;
+    fake.num_xfers = 0U;
+    xensiv_bgt60trxx_status_snapshot_t snapshot;
+    memset(&snapshot, 0xA5, sizeof(snapshot));
+    assert(xensiv_bgt60trxx_get_status_snapshot(&dev, &snapshot) == XENSIV_BGT60TRXX_STATUS_OK);
+    assert(fake.num_xfers == 2U);
+    expect_burst_read(0U, XENSIV_BGT60TRXX_REG_MAIN, XENSIV_BGT60TRXX_REG_STAT1 + 1U);
+    expect_burst_read(1U, XENSIV_BGT60TRXX_REG_STAT0,
+                      (FAKE_FSTAT - XENSIV_BGT60TRXX_REG_STAT0) + 1U);
+    assert(snapshot.main == 0x1E8271U);
+    assert(snapshot.stat1 == 0x00A5C3U);
+    assert(snapshot.stat0 == 0x0000F1U);
+    assert(snapshot.fstat == (XENSIV_BGT60TRXX_REG_FSTAT_CREF_MSK | 0x000123U));
+    assert(snapshot.gsr0 == XENSIV_BGT60TRXX_REG_GSR0_MISO_HS_READ_MSK);
+
+    // FSTAT at its device address: 0x5f on the UTR13D with the FIFO at 0x63, 0x63 on the UTR11
+    const struct {
+        uint32_t chip_id;
+        uint32_t fstat_addr;
+        xensiv_bgt60trxx_device_t device;
+    } maps[] = {
+        {FAKE_CHIP_ID_UTR13D, XENSIV_BGT60TRXX_REG_FSTAT_UTR13D, XENSIV_DEVICE_BGT60UTR13D},
+        {0x000707UL, XENSIV_BGT60TRXX_REG_FSTAT_UTR11, XENSIV_DEVICE_BGT60UTR11},
+    };
+    for (uint32_t m = 0; m < sizeof(maps) / sizeof(maps[0]); ++m) {
+        fake_init_device(&dev, false, maps[m].chip_id, maps[m].fstat_addr, maps[m].device);
+        fake.regs[0x62U] = 0xFFFFFFU;
+        fake.regs[FAKE_FSTAT] = XENSIV_BGT60TRXX_REG_FSTAT_FUF_ERR_MSK | 0x000040U;
+        assert(xensiv_bgt60trxx_get_status_snapshot(&dev, &snapshot) ==
+               XENSIV_BGT60TRXX_STATUS_OK);
+        expect_burst_read(1U, XENSIV_BGT60TRXX_REG_STAT0,
+                          (maps[m].fstat_addr - XENSIV_BGT60TRXX_REG_STAT0) + 1U);
+        assert(snapshot.fstat == (XENSIV_BGT60TRXX_REG_FSTAT_FUF_ERR_MSK | 0x000040U));
+
+        uint32_t fifo_status;
+        assert(xensiv_bgt60trxx_get_fifo_status(&dev, &fifo_status) ==
+               XENSIV_BGT60TRXX_STATUS_OK);
+        expect_single_read(2U, maps[m].fstat_addr);
+        assert(fifo_status == XENSIV_BGT60TRXX_REG_FSTAT_FUF_ERR_MSK);
+    }
+
+    // Single register reads drop GSR0 from the returned word
+    fake_init(&dev, false);
+    fake.regs[XENSIV_BGT60TRXX_REG_STAT1] = 0x00A5C3U;
+    uint32_t value;
+    fake.num_xfers = 0U;
+    assert(xensiv_bgt60trxx_get_reg(&dev, XENSIV_BGT60TRXX_REG_STAT1, &value) ==
+           XENSIV_BGT60TRXX_STATUS_OK);
+    expect_single_read(0U, XENSIV_BGT60TRXX_REG_STAT1);
+    assert(value == 0x00A5C3U);
+
+    printf("✓ Register burst read test passed\n");
+    return 0;
+}
+
+/**
+ * @brief Test the bounded polling of a software reset
+ * @return 0 on success, non-zero on failure
+ */
+static int test_soft_reset(void)
+{
+    printf("Testing software reset polling...\n");
+
+    xensiv_bgt60trxx_t dev;
+    fake_init(&dev, false);
+
+    // A FIFO reset done at the first poll: no sleep, no settle time
+    fake.regs[XENSIV_BGT60TRXX_REG_MAIN] = 0x1E8270U;
+    assert(xensiv_bgt60trxx_soft_reset(&dev, XENSIV_BGT60TRXX_RESET_FIFO) ==
+           XENSIV_BGT60TRXX_STATUS_OK);
+    assert((expect_soft_reset(0U, 0x1E8270U, XENSIV_BGT60TRXX_RESET_FIFO) == fake.num_xfers) &&
+           (fake.slept_us == 0U));
+
+    // A reset bit that never clears times out once the sleep budget is used up
+    fake.reset_stuck = true;
+    fake.num_xfers = 0U;
+    assert(xensiv_bgt60trxx_soft_reset(&dev, XENSIV_BGT60TRXX_RESET_FSM) ==
+           XENSIV_BGT60TRXX_STATUS_TIMEOUT_ERROR);
+    assert(fake.slept_us >= XENSIV_BGT60TRXX_RESET_SLEEP_BUDGET_US);
+    assert(fake.slept_us < XENSIV_BGT60TRXX_RESET_SLEEP_BUDGET_US +
+                           XENSIV_BGT60TRXX_RESET_POLL_MAX_US);
+    // Read and write of MAIN, then the polls: 1 + 2 + 4 .. 64 us, then 64 us each
+    const uint32_t polls = fake.num_xfers - 2U;
+    assert(polls <= (XENSIV_BGT60TRXX_RESET_SLEEP_BUDGET_US / XENSIV_BGT60TRXX_RESET_POLL_MAX_US) +
+                    6U + 2U);
+    for (uint32_t i = 0; (i < polls) && ((2U + i) < FAKE_MAX_XFERS); ++i) {
+        expect_single_read(2U + i, XENSIV_BGT60TRXX_REG_MAIN);
+    }
+
+    printf("✓ Software reset polling test passed\n");
+    return 0;
+}
+
+/**
+ * @brief Test that a reconfiguration writes only the changed registers
+ * @return 0 on success, non-zero on failure
+ */
+static int test_reconfig(void)
+{
+    printf("Testing reconfiguration writes...\n");
+
+    xensiv_bgt60trxx_t dev;
+    xensiv_bgt60trxx_shadow_t shadow;
+    const uint32_t old_regs[] = {
+        TEST_REG(XENSIV_BGT60TRXX_REG_PACR1, 0x0A1B2CU),
+        TEST_REG(XENSIV_BGT60TRXX_REG_PACR2, 0x3D4E5FU),
+        TEST_REG(XENSIV_BGT60TRXX_REG_SFCTL, 0x102000U),
+        TEST_REG(XENSIV_BGT60TRXX_REG_SADC_CTRL, 0x000555U),
+    };
+    uint32_t new_regs[4];
+    const uint32_t len = sizeof(old_regs) / sizeof(old_regs[0]);
+
+    // Identical profiles, or differing only in the FIFO limit and MISO HS bits: nothing written
+    fake_init(&dev, false);
+    memcpy(new_regs, old_regs, sizeof(new_regs));
+    new_regs[2] |= XENSIV_BGT60TRXX_REG_SFCTL_MISO_HS_READ_MSK | 0x0FFFU;
+    assert(xensiv_bgt60trxx_reconfig(&dev, old_regs, new_regs, len) ==
+           XENSIV_BGT60TRXX_STATUS_OK);
+    assert(fake.num_xfers == 0U);
+
+    // A chirp register change while framing: FSM and FIFO reset, the changed register alone,
+    // frame start
+    const uint32_t stop = XENSIV_BGT60TRXX_RESET_FSM | XENSIV_BGT60TRXX_RESET_FIFO;
+    memcpy(new_regs, old_regs, sizeof(new_regs));
+    new_regs[1] = TEST_REG(XENSIV_BGT60TRXX_REG_PACR2, 0x3D4E60U);
+    fake.regs[XENSIV_BGT60TRXX_REG_MAIN] = 0x1E8271U;
+    fake.regs[XENSIV_BGT60TRXX_REG_SFCTL] = 0x10207FU;
+    assert(xensiv_bgt60trxx_reconfig(&dev, old_regs, new_regs, len) ==
+           XENSIV_BGT60TRXX_STATUS_OK);
+    expect_single_read(0U, XENSIV_BGT60TRXX_REG_MAIN);
+    uint32_t idx = expect_soft_reset(1U, 0x1E8271U, stop);
+    expect_single_write(idx++, XENSIV_BGT60TRXX_REG_PACR2, 0x3D4E60U);
+    expect_single_read(idx++, XENSIV_BGT60TRXX_REG_MAIN);
+    expect_single_write(idx++, XENSIV_BGT60TRXX_REG_MAIN, 0x1E8271U);
+    assert(idx == fake.num_xfers);
+    assert(fake.regs[XENSIV_BGT60TRXX_REG_SFCTL] == 0x10207FU);
+
+    // The same change on an idle sensor leaves it idle
+    fake.num_xfers = 0U;
+    fake.regs[XENSIV_BGT60TRXX_REG_MAIN] = 0x1E8270U;
+    assert(xensiv_bgt60trxx_reconfig(&dev, old_regs, new_regs, len) ==
+           XENSIV_BGT60TRXX_STATUS_OK);
+    expect_single_read(0U, XENSIV_BGT60TRXX_REG_MAIN);
+    idx = expect_soft_reset(1U, 0x1E8270U, stop);
+    expect_single_write(idx++, XENSIV_BGT60TRXX_REG_PACR2, 0x3D4E60U);
+    assert(idx == fake.num_xfers);
+    assert(fake.regs[XENSIV_BGT60TRXX_REG_MAIN] == 0x1E8270U);
+
+    // A FIFO control change is written on the fly, keeping the FIFO limit read from the device
+    memcpy(new_regs, old_regs, sizeof(new_regs));
+    new_regs[2] = TEST_REG(XENSIV_BGT60TRXX_REG_SFCTL, 0x100000U);
+    fake.num_xfers = 0U;
+    fake.regs[XENSIV_BGT60TRXX_REG_SFCTL] = 0x11207FU;
+    assert(xensiv_bgt60trxx_reconfig(&dev, old_regs, new_regs, len) ==
+           XENSIV_BGT60TRXX_STATUS_OK);
+    assert(fake.num_xfers == 2U);
+    expect_single_read(0U, XENSIV_BGT60TRXX_REG_SFCTL);
+    // MISO HS follows the device speed, not the value read back
+    expect_single_write(1U, XENSIV_BGT60TRXX_REG_SFCTL, 0x10007FU);
+
+    // The same for a high speed device
+    fake_init(&dev, true);
+    fake.regs[XENSIV_BGT60TRXX_REG_SFCTL] = 0x10207FU;
+    assert(xensiv_bgt60trxx_reconfig(&dev, old_regs, new_regs, len) ==
+           XENSIV_BGT60TRXX_STATUS_OK);
+    assert(fake.num_xfers == 2U);
+    expect_single_write(1U, XENSIV_BGT60TRXX_REG_SFCTL, 0x11007FU);
+
+    // Without a previous configuration or shadow every register is written
+    fake_init(&dev, false);
+    fake.regs[XENSIV_BGT60TRXX_REG_MAIN] = 0x1E8270U;
+    fake.regs[XENSIV_BGT60TRXX_REG_SFCTL] = 0x10207FU;
+    assert(xensiv_bgt60trxx_reconfig(&dev, NULL, new_regs, len) == XENSIV_BGT60TRXX_STATUS_OK);
+    expect_single_read(0U, XENSIV_BGT60TRXX_REG_MAIN);
+    idx = expect_soft_reset(1U, 0x1E8270U, stop);
+    expect_single_read(idx++, XENSIV_BGT60TRXX_REG_SFCTL);
+    static const uint8_t pacr[] = {0xFF, 0x09, 0x04, 0x00, 0x0A, 0x1B, 0x2C, 0x3D, 0x4E, 0x5F};
+    expect_xfer(idx++, pacr, sizeof(pacr));
+    expect_single_write(idx++, XENSIV_BGT60TRXX_REG_SFCTL, 0x10007FU);
+    expect_single_write(idx++, XENSIV_BGT60TRXX_REG_SADC_CTRL, 0x000555U);
+    assert(idx == fake.num_xfers);
+
+    // With the shadow as the current configuration the FIFO limit is not read back
+    fake_init(&dev, false);
+    xensiv_bgt60trxx_shadow_enable(&dev, &shadow);
+    assert(xensiv_bgt60trxx_config(&dev, old_regs, len) == XENSIV_BGT60TRXX_STATUS_OK);
+    assert(xensiv_bgt60trxx_set_fifo_limit(&dev, 256U) == XENSIV_BGT60TRXX_STATUS_OK);
+    fake.num_xfers = 0U;
+    assert(xensiv_bgt60trxx_reconfig(&dev, NULL, new_regs, len) == XENSIV_BGT60TRXX_STATUS_OK);
+    assert(fake.num_xfers == 1U);
+    expect_single_write(0U, XENSIV_BGT60TRXX_REG_SFCTL, 0x10007FU);
+    assert(fake.regs[XENSIV_BGT60TRXX_REG_SFCTL] == 0x10007FU);
+
+    printf("✓ Reconfiguration write test passed\n");
+    return 0;
+}
+
+/**
+ * @brief Test that a warm start skips a configuration the device holds and writes it otherwise
+ * @return 0 on success, non-zero on failure
+ */
+static int test_config_warm(void)
+{
+    printf("Testing warm start...\n");
+
+    xensiv_bgt60trxx_t dev;
+    xensiv_bgt60trxx_shadow_t shadow;
+    xensiv_bgt60trxx_warm_start_t result;
+    uint32_t data;
+    const uint32_t regs[] = {
+        TEST_REG(XENSIV_BGT60TRXX_REG_PACR1, 0x0A1B2CU),
+        TEST_REG(XENSIV_BGT60TRXX_REG_PACR2, 0x3D4E5FU),
+        TEST_REG(XENSIV_BGT60TRXX_REG_SFCTL, 0x102000U),
+        TEST_REG(XENSIV_BGT60TRXX_REG_SADC_CTRL, 0x000555U),
+    };
+    const uint32_t len = sizeof(regs) / sizeof(regs[0]);
+
+    // Read-back matches apart from the FIFO limit and MISO HS: one burst read, nothing written
+    fake_init(&dev, false);
+    xensiv_bgt60trxx_shadow_enable(&dev, &shadow);
+    fake.regs[XENSIV_BGT60TRXX_REG_PACR1] = 0x0A1B2CU;
+    fake.regs[XENSIV_BGT60TRXX_REG_PACR2] = 0x3D4E5FU;
+    fake.regs[XENSIV_BGT60TRXX_REG_SFCTL] = 0x11207FU;
+    fake.regs[XENSIV_BGT60TRXX_REG_SADC_CTRL] = 0x000555U;
+    assert(xensiv_bgt60trxx_config_warm(&dev, regs, len, &result) == XENSIV_BGT60TRXX_STATUS_OK);
+    assert(result.skipped && (result.num_compared == len) && (result.num_mismatch == 0U));
+    assert(fake.num_xfers == 1U);
+    expect_burst_read(0U, XENSIV_BGT60TRXX_REG_PACR1, len);
+    assert(fake.regs[XENSIV_BGT60TRXX_REG_SFCTL] == 0x11207FU);
+
+    // The shadow is filled from the values read
+    assert(xensiv_bgt60trxx_get_reg(&dev, XENSIV_BGT60TRXX_REG_PACR2, &data) ==
+           XENSIV_BGT60TRXX_STATUS_OK);
+    assert(xensiv_bgt60trxx_set_fifo_limit(&dev, 256U) == XENSIV_BGT60TRXX_STATUS_OK);
+    assert(fake.num_xfers == 3U);
+    expect_single_read(1U, XENSIV_BGT60TRXX_REG_PACR2);
+    expect_single_write(2U, XENSIV_BGT60TRXX_REG_SFCTL, 0x11207FU);
+
+    // Only SFCTL differs, as after init: it is written alone
+    fake_init(&dev, false);
+    fake.regs[XENSIV_BGT60TRXX_REG_PACR1] = 0x0A1B2CU;
+    fake.regs[XENSIV_BGT60TRXX_REG_PACR2] = 0x3D4E5FU;
+    fake.regs[XENSIV_BGT60TRXX_REG_SADC_CTRL] = 0x000555U;
+    assert(xensiv_bgt60trxx_config_warm(&dev, regs, len, &result) == XENSIV_BGT60TRXX_STATUS_OK);
+    assert(result.skipped && (result.num_mismatch == 1U));
+    assert(fake.num_xfers == 2U);
+    expect_single_write(1U, XENSIV_BGT60TRXX_REG_SFCTL, 0x102000U);
+
+    // Any other mismatch falls back to the full configuration
+    fake_init(&dev, false);
+    fake.regs[XENSIV_BGT60TRXX_REG_MAIN] = 0x1E8270U;
+    fake.regs[XENSIV_BGT60TRXX_REG_PACR1] = 0x0A1B2CU;
+    fake.regs[XENSIV_BGT60TRXX_REG_PACR2] = 0x3D4E50U;
+    fake.regs[XENSIV_BGT60TRXX_REG_SFCTL] = 0x102000U;
+    fake.regs[XENSIV_BGT60TRXX_REG_SADC_CTRL] = 0x000444U;
+    assert(xensiv_bgt60trxx_config_warm(&dev, regs, len, &result) == XENSIV_BGT60TRXX_STATUS_OK);
+    assert(!result.skipped && (result.num_compared == len) && (result.num_mismatch == 2U));
+    expect_burst_read(0U, XENSIV_BGT60TRXX_REG_PACR1, len);
+    uint32_t idx = expect_soft_reset(1U, 0x1E8270U, XENSIV_BGT60TRXX_RESET_SW);
+    static const uint8_t run[] = {0xFF, 0x09, 0x04, 0x00, 0x0A, 0x1B, 0x2C, 0x3D, 0x4E, 0x5F};
+    expect_xfer(idx++, run, sizeof(run));
+    expect_single_write(idx++, XENSIV_BGT60TRXX_REG_SFCTL, 0x102000U);
+    expect_single_write(idx++, XENSIV_BGT60TRXX_REG_SADC_CTRL, 0x000555U);
+    assert(idx == fake.num_xfers);
+
+    // A failed read-back changes neither the device nor the shadow
+    fake_init(&dev, false);
+    xensiv_bgt60trxx_shadow_enable(&dev, &shadow);
+    assert(xensiv_bgt60trxx_set_reg(&dev, XENSIV_BGT60TRXX_REG_SFCTL, 0x102000U) ==
+           XENSIV_BGT60TRXX_STATUS_OK);
+    fake.num_xfers = 0U;
+    fake.spi_error = true;
+    assert(xensiv_bgt60trxx_config_warm(&dev, regs, len, &result) ==
+           XENSIV_BGT60TRXX_STATUS_COM_ERROR);
+    fake.spi_error = false;
+    assert(!result.skipped && (result.num_compared == len) && (result.num_mismatch == 0U));
+    assert(fake.num_xfers == 1U);
+    expect_burst_read(0U, XENSIV_BGT60TRXX_REG_PACR1, len);
+    assert((shadow.valid[0] & (1UL << XENSIV_BGT60TRXX_REG_SFCTL)) != 0U);
+
+    printf("✓ Warm start test passed\n");
+    return 0;
+}
+
+/**
+ * @brief Test that read-modify-write operations use the register shadow
+ * @return 0 on success, non-zero on failure
+ */
+static int test_register_shadow(void)
+{
+    printf("Testing register shadow...\n");
+
+    xensiv_bgt60trxx_t dev;
+    xensiv_bgt60trxx_shadow_t shadow;
+    uint32_t hits;
+    uint32_t misses;
+    const uint32_t lfsr_en = XENSIV_BGT60TRXX_REG_SFCTL_LFSR_EN_MSK;
+
+    // Miss: the register is read from the device, the write fills the shadow
+    fake_init(&dev, false);
+    xensiv_bgt60trxx_shadow_enable(&dev, &shadow);
+    fake.regs[XENSIV_BGT60TRXX_REG_SFCTL] = 0x102000U;
+    assert(xensiv_bgt60trxx_enable_data_test_mode(&dev, true) == XENSIV_BGT60TRXX_STATUS_OK);
+    assert(fake.num_xfers == 2U);
+    expect_single_read(0U, XENSIV_BGT60TRXX_REG_SFCTL);
+    expect_single_write(1U, XENSIV_BGT60TRXX_REG_SFCTL, 0x102000U | lfsr_en);
+    xensiv_bgt60trxx_shadow_get_stats(&dev, &hits, &misses);
+    assert((hits == 0U) && (misses == 1U));
+
+    // Hit: only the write reaches the device
+    fake.num_xfers = 0U;
+    assert(xensiv_bgt60trxx_enable_data_test_mode(&dev, false) == XENSIV_BGT60TRXX_STATUS_OK);
+    assert(fake.num_xfers == 1U);
+    expect_single_write(0U, XENSIV_BGT60TRXX_REG_SFCTL, 0x102000U);
+    xensiv_bgt60trxx_shadow_get_stats(&dev, &hits, &misses);
+    assert((hits == 1U) && (misses == 1U));
+
+    // A failed write leaves the shadow untouched
+    fake.num_xfers = 0U;
+    fake.spi_error = true;
+    assert(xensiv_bgt60trxx_enable_data_test_mode(&dev, true) ==
+           XENSIV_BGT60TRXX_STATUS_COM_ERROR);
+    fake.spi_error = false;
+    assert(fake.num_xfers == 1U);
+    assert(shadow.regs[XENSIV_BGT60TRXX_REG_SFCTL] == 0x102000U);
+    xensiv_bgt60trxx_shadow_get_stats(&dev, &hits, &misses);
+    assert((hits == 2U) && (misses == 1U));
+
+    // Invalidation drops every entry: the next access goes to the device again
+    xensiv_bgt60trxx_shadow_invalidate(&dev);
+    for (uint32_t i = 0; i < sizeof(shadow.valid) / sizeof(shadow.valid[0]); ++i) {
+        assert(shadow.valid[i] == 0U);
+    }
+    fake.num_xfers = 0U;
+    assert(xensiv_bgt60trxx_enable_data_test_mode(&dev, false) == XENSIV_BGT60TRXX_STATUS_OK);
+    assert(fake.num_xfers == 2U);
+    expect_single_read(0U, XENSIV_BGT60TRXX_REG_SFCTL);
+    xensiv_bgt60trxx_shadow_get_stats(&dev, &hits, &misses);
+    assert((hits == 2U) && (misses == 2U));
+
+    // Without a shadow every access reads the device and nothing is counted
+    xensiv_bgt60trxx_shadow_enable(&dev, NULL);
+    fake.num_xfers = 0U;
+    assert(xensiv_bgt60trxx_enable_data_test_mode(&dev, false) == XENSIV_BGT60TRXX_STATUS_OK);
+    assert(fake.num_xfers == 2U);
+    xensiv_bgt60trxx_shadow_get_stats(&dev, &hits, &misses);
+    assert((hits == 0U) && (misses == 0U));
+
+    printf("✓ Register shadow test passed\n");
+    return 0;
+}
+
+/**
+ * @brief Test FIFO draining in whole frames from the FSTAT fill level
+ * @return 0 on success, non-zero on failure
+ */
+static int test_drain_fifo(void)
+{
+    printf("Testing FIFO draining...\n");
+
+    static uint16_t data[512];
+    xensiv_bgt60trxx_t dev;
+    uint32_t num_read;
+    fake_init(&dev, false);
+
+    // 80 words = 2.5 frames of 64 samples: two frames are read, half a frame stays
+    fake.regs[FAKE_FSTAT] = XENSIV_BGT60TRXX_REG_FSTAT_CREF_MSK | 80U;
+    assert(xensiv_bgt60trxx_drain_fifo(&dev, data, 512U, 64U, &num_read) ==
+           XENSIV_BGT60TRXX_STATUS_OK);
+    assert(num_read == 128U);
+    assert(fake.num_xfers == 1U);
+    expect_single_read(0U, FAKE_FSTAT);
+    assert(fake.num_fifo_reads == 1U);
+    static const uint8_t fifo_header[] = {0xFF, XENSIV_BGT60TRXX_REG_FIFO_TR13C << 1, 0x00, 0x00};
+    assert(memcmp(fake.fifo_header, fifo_header, sizeof(fifo_header)) == 0);
+    for (uint32_t i = 0; i < 128U; ++i) {
+        assert(data[i] == i);
+    }
+    assert((fake.regs[FAKE_FSTAT] & XENSIV_BGT60TRXX_REG_FSTAT_FILL_STATUS_MSK) == 16U);
+
+    // The remainder is less than a frame: nothing is read
+    fake.num_xfers = 0U;
+    assert(xensiv_bgt60trxx_drain_fifo(&dev, data, 512U, 64U, &num_read) ==
+           XENSIV_BGT60TRXX_STATUS_OK);
+    assert((num_read == 0U) && (fake.num_xfers == 1U) && (fake.num_fifo_reads == 1U));
+
+    // The buffer limits the read to the frames it holds
+    fake.regs[FAKE_FSTAT] = 200U;
+    assert(xensiv_bgt60trxx_drain_fifo(&dev, data, 150U, 64U, &num_read) ==
+           XENSIV_BGT60TRXX_STATUS_OK);
+    assert((num_read == 128U) && (fake.num_fifo_reads == 2U));
+    assert((data[0] == 128U) && (data[127] == 255U));
+    assert((fake.regs[FAKE_FSTAT] & XENSIV_BGT60TRXX_REG_FSTAT_FILL_STATUS_MSK) == 136U);
+
+    // An empty FIFO
+    fake.regs[FAKE_FSTAT] = XENSIV_BGT60TRXX_REG_FSTAT_EMPTY_MSK;
+    assert(xensiv_bgt60trxx_drain_fifo(&dev, data, 512U, 64U, &num_read) ==
+           XENSIV_BGT60TRXX_STATUS_OK);
+    assert((num_read == 0U) && (fake.num_fifo_reads == 2U));
+
+    // FIFO errors in FSTAT stop the drain before any data is read
+    fake.regs[FAKE_FSTAT] = XENSIV_BGT60TRXX_REG_FSTAT_FOF_ERR_MSK | 200U;
+    assert(xensiv_bgt60trxx_drain_fifo(&dev, data, 512U, 64U, &num_read) ==
+           XENSIV_BGT60TRXX_STATUS_FIFO_ERROR);
+    assert((num_read == 0U) && (fake.num_fifo_reads == 2U));
+    fake.regs[FAKE_FSTAT] = XENSIV_BGT60TRXX_REG_FSTAT_FUF_ERR_MSK;
+    assert(xensiv_bgt60trxx_drain_fifo(&dev, data, 512U, 64U, &num_read) ==
+           XENSIV_BGT60TRXX_STATUS_FIFO_ERROR);
+    assert((num_read == 0U) && (fake.num_fifo_reads == 2U));
+
+    // An error reported in GSR0 of the burst leaves nothing read
+    fake.regs[FAKE_FSTAT] = 200U;
+    fake.gsr0 = XENSIV_BGT60TRXX_REG_GSR0_FOU_ERR_MSK;
+    assert(xensiv_bgt60trxx_drain_fifo(&dev, data, 512U, 64U, &num_read) ==
+           XENSIV_BGT60TRXX_STATUS_GSR0_ERROR);
+    assert((num_read == 0U) && (fake.num_fifo_reads == 3U));
+
+    // UTR13D: FSTAT at 0x5f, FIFO at 0x63, the register below the FIFO is something else
+    fake_init_device(&dev,
+                     false,
+                     FAKE_CHIP_ID_UTR13D,
+                     XENSIV_BGT60TRXX_REG_FSTAT_UTR13D,
+                     XENSIV_DEVICE_BGT60UTR13D);
+    fake.regs[XENSIV_BGT60TRXX_REG_FIFO_UTR13D - 1U] = 0xFFFFFFU;
+    fake.regs[FAKE_FSTAT] = 80U;
+    assert(xensiv_bgt60trxx_drain_fifo(&dev, data, 512U, 64U, &num_read) ==
+           XENSIV_BGT60TRXX_STATUS_OK);
+    assert(num_read == 128U);
+    expect_single_read(0U, XENSIV_BGT60TRXX_REG_FSTAT_UTR13D);
+    assert(fake.fifo_header[1] == (XENSIV_BGT60TRXX_REG_FIFO_UTR13D << 1));
+    uint32_t fill;
+    assert(xensiv_bgt60trxx_get_fifo_fill(&dev, &fill) == XENSIV_BGT60TRXX_STATUS_OK);
+    assert(fill == 32U);
+    expect_single_read(1U, XENSIV_BGT60TRXX_REG_FSTAT_UTR13D);
+
+    printf("✓ FIFO draining test passed\n");
+    return 0;
+}
+
+#ifdef ENABLE_LINUX_SUPPORT
+/* Waits up to 2 s for the acquisition thread to have read num_frames frames */
+static void wait_acq_frames(xensiv_bgt60trxx_linux_acq_t *acq, uint32_t num_frames)
+{
+    const struct timespec step = {0, 1000000L};
+    xensiv_bgt60trxx_linux_acq_stats_t stats;
+
+    for (int i = 0; i < 2000; ++i) {
+        xensiv_bgt60trxx_linux_acq_get_stats(acq, &stats);
+        if (stats.frames >= num_frames) {
+            break;
+        }
+        nanosleep(&step, NULL);
+    }
+    assert(stats.frames == num_frames);
+}
+
+/**
+ * @brief Test that the acquisition thread catches up with frames left behind by an IRQ edge
+ * @return 0 on success, non-zero on failure
+ */
+static int test_acq_catch_up(void)
+{
+    printf("Testing acquisition catch-up in IRQ mode...\n");
+
+    xensiv_bgt60trxx_linux_obj_t sensor;
+    xensiv_bgt60trxx_linux_acq_t acq;
+    xensiv_bgt60trxx_linux_acq_stats_t stats;
+    const xensiv_bgt60trxx_linux_acq_config_t config = {
+        .frame_samples = 64U,
+        .num_slots = 4U,
+        .cpu = -1,
+    };
+    const struct timespec settle = {0, 50000000L};
+    int fds[2];
+
+    memset(&sensor, 0, sizeof(sensor));
+    fake_init(&sensor.dev, false);
+    assert(pipe(fds) == 0);
+    sensor.iface.irq_gpio_fd = fds[0];
+
+    // One edge for three frames: the line stays high, the two frames behind it are found by FSTAT
+    struct gpio_v2_line_event event;
+    memset(&event, 0, sizeof(event));
+    event.timestamp_ns = 1000U;
+    event.id = GPIO_V2_LINE_EVENT_RISING_EDGE;
+    assert(write(fds[1], &event, sizeof(event)) == (ssize_t) sizeof(event));
+    fake.regs[FAKE_FSTAT] = 96U;
+    assert(xensiv_bgt60trxx_linux_acq_start(&acq, &sensor, &config) ==
+           XENSIV_BGT60TRXX_STATUS_OK);
+    wait_acq_frames(&acq, 3U);
+
+    for (uint32_t i = 0; i < 3U; ++i) {
+        const xensiv_bgt60trxx_frame_t *frame = xensiv_bgt60trxx_linux_acq_acquire_frame(&acq);
+        assert((frame != NULL) && (frame->seq == i) && (frame->samples[0] == 64U * i));
+        assert((i > 0U) || (frame->timestamp_ns == 1000U));
+        xensiv_bgt60trxx_linux_acq_release_frame(&acq);
+    }
+
+    // The edge of a frame read while catching up is not taken for a new frame
+    event.timestamp_ns = 2000U;
+    assert(write(fds[1], &event, sizeof(event)) == (ssize_t) sizeof(event));
+    nanosleep(&settle, NULL);
+    xensiv_bgt60trxx_linux_acq_get_stats(&acq, &stats);
+    assert((stats.frames == 3U) && (stats.fifo_errors == 0U));
+    assert(stats.status == XENSIV_BGT60TRXX_STATUS_OK);
+    assert(xensiv_bgt60trxx_linux_acq_stop(&acq) == XENSIV_BGT60TRXX_STATUS_OK);
+
+    // No edge at all: the frames are read once the wait for the IRQ line times out
+    fake.regs[FAKE_FSTAT] = 64U;
+    assert(xensiv_bgt60trxx_linux_acq_start(&acq, &sensor, &config) ==
+           XENSIV_BGT60TRXX_STATUS_OK);
+    wait_acq_frames(&acq, 2U);
+    assert(xensiv_bgt60trxx_linux_acq_stop(&acq) == XENSIV_BGT60TRXX_STATUS_OK);
+    assert((fake.regs[FAKE_FSTAT] & XENSIV_BGT60TRXX_REG_FSTAT_FILL_STATUS_MSK) == 0U);
+
+    close(fds[0]);
+    close(fds[1]);
+
+    printf("✓ Acquisition catch-up test passed\n");
+    return 0;
+}
+
+/**
+ * @brief Test that the polling scheduler starts from the rate of the programmed frame geometry
+ * @return 0 on success, non-zero on failure
+ */
+static int test_acq_sched_seed(void)
+{
+    printf("Testing polling scheduler rate seed...\n");
+
+    xensiv_bgt60trxx_linux_obj_t sensor;
+    xensiv_bgt60trxx_linux_acq_t acq;
+    xensiv_bgt60trxx_linux_sched_stats_t stats;
+    xensiv_bgt60trxx_frame_geometry_t geometry;
+    xensiv_bgt60trxx_linux_acq_config_t config = {
+        .frame_samples = 64U,
+        .num_slots = 4U,
+        .cpu = -1,
+    };
+    const struct timespec settle = {0, 50000000L};
+
+    memset(&sensor, 0, sizeof(sensor));
+    fake_init(&sensor.dev, false);
+    sensor.iface.irq_gpio_fd = -1;
+
+    // One sample on RX1 per 10.24 ms frame: the first read is followed by a long sleep
+    fake.regs[XENSIV_BGT60TRXX_REG_ADC0] = 40UL << XENSIV_BGT60TRXX_REG_ADC0_ADC_DIV_POS;
+    fake.regs[XENSIV_BGT60TRXX_REG_CSU1_1] = 0x100000U;
+    fake.regs[XENSIV_BGT60TRXX_REG_CCR1] = (10UL << 8) | 100U;
+    fake.regs[XENSIV_BGT60TRXX_REG_PLL1_3] = 1U;
+    assert(xensiv_bgt60trxx_get_geometry(&sensor.dev, &geometry) == XENSIV_BGT60TRXX_STATUS_OK);
+    assert((geometry.data_rate_sps > 0U) && (geometry.data_rate_sps < 1000U));
+
+    assert(xensiv_bgt60trxx_linux_acq_start(&acq, &sensor, &config) ==
+           XENSIV_BGT60TRXX_STATUS_OK);
+    nanosleep(&settle, NULL);
+    xensiv_bgt60trxx_linux_sched_get_stats(&acq.sched, &stats);
+    assert((stats.reads == 1U) && (stats.rate_sps == (double) geometry.data_rate_sps));
+    assert(xensiv_bgt60trxx_linux_acq_stop(&acq) == XENSIV_BGT60TRXX_STATUS_OK);
+
+    // A configured rate takes precedence over the geometry
+    config.rate_sps = 200U;
+    assert(xensiv_bgt60trxx_linux_acq_start(&acq, &sensor, &config) ==
+           XENSIV_BGT60TRXX_STATUS_OK);
+    nanosleep(&settle, NULL);
+    xensiv_bgt60trxx_linux_sched_get_stats(&acq.sched, &stats);
+    assert((stats.reads == 1U) && (stats.rate_sps == 200.0));
+    assert(xensiv_bgt60trxx_linux_acq_stop(&acq) == XENSIV_BGT60TRXX_STATUS_OK);
+
+    printf("✓ Polling scheduler rate seed test passed\n");
+    return 0;
+}
+#endif /* ENABLE_LINUX_SUPPORT */
+
+int main(void)
+{
+    printf("XENSIV BGT60TRxx Core SPI Protocol Test\n");
+    printf("=======================================\n\n");
+
+    int result = 0;
+
+    result |= test_burst_write();
+    result |= test_burst_read();
+    result |= test_soft_reset();
+    result |= test_reconfig();
+    result |= test_config_warm();
+    result |= test_register_shadow();
+    result |= test_drain_fifo();
+#ifdef ENABLE_LINUX_SUPPORT
+    result |= test_acq_catch_up();
+    result |= test_acq_sched_seed();
+#endif
+
+    if (result == 0) {
+        printf("\n✓ All core SPI protocol tests passed!\n");
+    } else {
+        printf("\n✗ Some core SPI protocol tests failed!\n");
+        return 1;
+    }
+
+    return 0;
+}
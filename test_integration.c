@@ -7,12 +7,36 @@
  */
 
 #include <assert.h>
+#include <fcntl.h>
+#include <math.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <unistd.h>
+#ifdef __linux__
+    #include <linux/gpio.h>
+    #include <pthread.h>
+    #include <sched.h>
+    #include <time.h>
+#endif
 
 // Include the main library header
 #include "xensiv_bgt60trxx.h"
+#include "xensiv_bgt60trxx_angle.h"
+#include "xensiv_bgt60trxx_assembler.h"
+#include "xensiv_bgt60trxx_budget.h"
+#include "xensiv_bgt60trxx_cfar.h"
+#include "xensiv_bgt60trxx_fft.h"
+#include "xensiv_bgt60trxx_cref.h"
+#include "xensiv_bgt60trxx_doppler.h"
+#include "xensiv_bgt60trxx_geometry.h"
+#include "xensiv_bgt60trxx_linux.h"
+#include "xensiv_bgt60trxx_linux_sched.h"
+#include "xensiv_bgt60trxx_platform.h"
+#include "xensiv_bgt60trxx_range.h"
+#include "xensiv_bgt60trxx_ring.h"
+#include "xensiv_bgt60trxx_tracker.h"
+#include "xensiv_bgt60trxx_unpack.h"
 
 /**
  * @brief Test basic library constants and types
@@ -28,6 +52,7 @@ static int test_basic_constants(void)
     assert(XENSIV_BGT60TRXX_STATUS_DEV_ERROR != 0);
     assert(XENSIV_BGT60TRXX_STATUS_TIMEOUT_ERROR != 0);
     assert(XENSIV_BGT60TRXX_STATUS_GSR0_ERROR != 0);
+    assert(XENSIV_BGT60TRXX_STATUS_FIFO_ERROR != XENSIV_BGT60TRXX_STATUS_GSR0_ERROR);
 
     // Test that FIFO constants are reasonable
     assert(XENSIV_BGT60TRXX_NUM_SAMPLES_FIFO_WORD == 2);
@@ -130,6 +155,1697 @@ static int test_function_availability(void)
     return 0;
 }
 
+/**
+ * @brief Scalar reference for the 24-bit FIFO word to 2x12-bit sample unpacking
+ */
+static void reference_unpack(const uint8_t *src, uint16_t *dst, uint32_t num_samples)
+{
+    for (uint32_t i = 0; i < num_samples; i += 2) {
+        uint32_t word = ((uint32_t) src[0] << 16) | ((uint32_t) src[1] << 8) | src[2];
+        dst[i] = (uint16_t) (word >> 12);
+        dst[i + 1] = (uint16_t) (word & 0xFFFU);
+        src += 3;
+    }
+}
+
+/**
+ * @brief Test that every supported unpack kernel is bit-exact against the scalar reference
+ * @return 0 on success, non-zero on failure
+ */
+static int test_fifo_unpack(void)
+{
+    printf("Testing FIFO data unpacking...\n");
+
+    const uint32_t max_samples = 8192U * 2U;
+    uint8_t *packed = malloc(XENSIV_BGT60TRXX_PACKED_SIZE_BYTES(max_samples));
+    uint16_t *expected = malloc(max_samples * sizeof(uint16_t));
+    uint16_t *actual = malloc((max_samples + 1U) * sizeof(uint16_t));
+    assert(packed && expected && actual);
+
+    srand(1234);
+    for (uint32_t i = 0; i < XENSIV_BGT60TRXX_PACKED_SIZE_BYTES(max_samples); ++i) {
+        packed[i] = (uint8_t) rand();
+    }
+
+    const xensiv_bgt60trxx_unpack_impl_t impls[] = {
+        XENSIV_BGT60TRXX_UNPACK_SCALAR,
+        XENSIV_BGT60TRXX_UNPACK_SSSE3,
+        XENSIV_BGT60TRXX_UNPACK_AVX2,
+        XENSIV_BGT60TRXX_UNPACK_NEON,
+    };
+
+    assert(xensiv_bgt60trxx_unpack_impl_supported(xensiv_bgt60trxx_unpack_get_impl()));
+
+    for (size_t k = 0; k < sizeof(impls) / sizeof(impls[0]); ++k) {
+        if (!xensiv_bgt60trxx_unpack_impl_supported(impls[k])) {
+            continue;
+        }
+
+        // Every short length exercises the vector/tail boundaries, then a full FIFO
+        for (uint32_t n = 0; n <= max_samples; n = (n < 256U) ? (n + 2U) : (n * 2U)) {
+            reference_unpack(packed, expected, n);
+            actual[n] = 0xA5A5U;  // guard element must survive
+            xensiv_bgt60trxx_unpack_fifo_data_impl(impls[k], packed, actual, n);
+            assert(memcmp(expected, actual, n * sizeof(uint16_t)) == 0);
+            assert(actual[n] == 0xA5A5U);
+        }
+    }
+
+    // Known vector: 0xABC and 0x123 packed into one FIFO word
+    const uint8_t word[3] = {0xAB, 0xC1, 0x23};
+    xensiv_bgt60trxx_unpack_fifo_data(word, actual, 2);
+    assert(actual[0] == 0xABCU);
+    assert(actual[1] == 0x123U);
+
+    free(packed);
+    free(expected);
+    free(actual);
+
+    printf("✓ FIFO data unpacking test passed\n");
+    return 0;
+}
+
+/**
+ * @brief Test bit error counting against the data test mode LFSR sequence
+ * @return 0 on success, non-zero on failure
+ */
+static int test_data_test_bit_errors(void)
+{
+    printf("Testing data test mode bit error counting...\n");
+
+    // Two ADC channels, the LFSR sequence replaces the first one
+    uint16_t samples[64];
+    uint16_t test_word = XENSIV_BGT60TRXX_INITIAL_TEST_WORD;
+    for (uint32_t i = 0; i < 64U; i += 2U) {
+        samples[i] = test_word;
+        samples[i + 1U] = 0xABCU;
+        test_word = xensiv_bgt60trxx_get_next_test_word(test_word);
+    }
+
+    test_word = XENSIV_BGT60TRXX_INITIAL_TEST_WORD;
+    assert(xensiv_bgt60trxx_count_test_bit_errors(samples, 64U, 2U, &test_word) == 0U);
+
+    // Continuing from the returned state matches the next block
+    uint16_t next = test_word;
+    uint16_t block[2] = {next, 0U};
+    assert(xensiv_bgt60trxx_count_test_bit_errors(block, 2U, 2U, &test_word) == 0U);
+
+    samples[10] ^= 0x801U;
+    samples[11] ^= 0xFFFU; // second channel is not compared
+    test_word = XENSIV_BGT60TRXX_INITIAL_TEST_WORD;
+    assert(xensiv_bgt60trxx_count_test_bit_errors(samples, 64U, 2U, &test_word) == 2U);
+
+    printf("✓ Data test mode bit error counting test passed\n");
+    return 0;
+}
+
+/**
+ * @brief Test the frame ring bookkeeping from a single thread
+ * @return 0 on success, non-zero on failure
+ */
+static int test_frame_ring(void)
+{
+    printf("Testing SPSC frame ring...\n");
+
+    xensiv_bgt60trxx_ring_t ring;
+    xensiv_bgt60trxx_frame_t slots[4];
+    uint16_t storage[4 * 8];
+
+    xensiv_bgt60trxx_ring_init(&ring, slots, 4U, storage, 8U);
+    assert(xensiv_bgt60trxx_ring_read_acquire(&ring) == NULL);
+    assert(xensiv_bgt60trxx_ring_count(&ring) == 0U);
+
+    // Fill the ring, the fifth frame is dropped
+    for (uint32_t i = 0; i < 4U; ++i) {
+        xensiv_bgt60trxx_frame_t *frame = xensiv_bgt60trxx_ring_write_begin(&ring);
+        assert(frame != NULL);
+        assert(frame->samples == &storage[i * 8U]);
+        frame->seq = i;
+        xensiv_bgt60trxx_ring_write_commit(&ring);
+    }
+    assert(xensiv_bgt60trxx_ring_write_begin(&ring) == NULL);
+    assert(xensiv_bgt60trxx_ring_get_dropped(&ring) == 1U);
+    assert(xensiv_bgt60trxx_ring_count(&ring) == 4U);
+
+    // Frames come out in order; a held slot is not handed to the producer
+    const xensiv_bgt60trxx_frame_t *frame = xensiv_bgt60trxx_ring_read_acquire(&ring);
+    assert(frame != NULL && frame->seq == 0U);
+    assert(xensiv_bgt60trxx_ring_write_begin(&ring) == NULL);
+    xensiv_bgt60trxx_ring_read_release(&ring);
+    assert(xensiv_bgt60trxx_ring_write_begin(&ring) == &slots[0]);
+    xensiv_bgt60trxx_ring_write_commit(&ring);
+
+    for (uint32_t i = 1; i < 5U; ++i) {
+        frame = xensiv_bgt60trxx_ring_read_acquire(&ring);
+        assert(frame != NULL);
+        assert(frame->seq == ((i < 4U) ? i : 0U));
+        xensiv_bgt60trxx_ring_read_release(&ring);
+    }
+    assert(xensiv_bgt60trxx_ring_read_acquire(&ring) == NULL);
+    assert(xensiv_bgt60trxx_ring_get_dropped(&ring) == 2U);
+
+    printf("✓ SPSC frame ring test passed\n");
+    return 0;
+}
+
+/**
+ * @brief Test that the adaptive CREF controller follows the observed service latency
+ * @return 0 on success, non-zero on failure
+ */
+static int test_cref_controller(void)
+{
+    printf("Testing adaptive CREF controller...\n");
+
+    const xensiv_bgt60trxx_cref_config_t config = {
+        .quantum_samples = 128U,
+        .min_samples = 100U,
+        .max_samples = 4100U,
+        .fifo_samples = 16384U,
+        .headroom_pct = 25U,
+        .raise_after = 4U,
+    };
+    xensiv_bgt60trxx_cref_ctrl_t ctrl;
+    xensiv_bgt60trxx_cref_init(&ctrl, &config);
+
+    // Bounds are quantized, CREF starts low
+    assert(xensiv_bgt60trxx_cref_get_limit(&ctrl) == 128U);
+    assert(ctrl.config.max_samples == 4096U);
+
+    // A fast host lets CREF climb one quantum per calm run up to the upper bound
+    for (uint32_t i = 0; i < 200U; ++i) {
+        uint32_t cref = xensiv_bgt60trxx_cref_get_limit(&ctrl);
+        bool changed = xensiv_bgt60trxx_cref_update(&ctrl, cref + 64U, false);
+        assert(!changed || (xensiv_bgt60trxx_cref_get_limit(&ctrl) == cref + 128U));
+    }
+    assert(xensiv_bgt60trxx_cref_get_limit(&ctrl) == 4096U);
+
+    // A stall drops CREF at once so the latency peak still fits the headroom
+    assert(xensiv_bgt60trxx_cref_update(&ctrl, 4096U + 10000U, false));
+    assert(xensiv_bgt60trxx_cref_get_limit(&ctrl) == 2176U);
+
+    xensiv_bgt60trxx_cref_point_t point;
+    xensiv_bgt60trxx_cref_get_point(&ctrl, &point);
+    assert(point.cref == 2176U && point.excess_peak == 10000U);
+    assert(point.headroom == 16384U - 2176U - 10000U);
+    assert(point.lowers == 1U && point.raises == 31U);
+
+    // An overflow halves CREF, never below the lower bound, always a multiple of the quantum
+    assert(xensiv_bgt60trxx_cref_update(&ctrl, 0U, true));
+    assert(xensiv_bgt60trxx_cref_get_limit(&ctrl) == 1024U);
+    for (uint32_t i = 0; i < 8U; ++i) {
+        (void) xensiv_bgt60trxx_cref_update(&ctrl, 0U, true);
+    }
+    assert(xensiv_bgt60trxx_cref_get_limit(&ctrl) == 128U);
+    xensiv_bgt60trxx_cref_get_point(&ctrl, &point);
+    assert(point.overflows == 9U);
+
+    // The latency peak decays and CREF recovers once the host keeps up again
+    for (uint32_t i = 0; i < 1000U; ++i) {
+        uint32_t cref = xensiv_bgt60trxx_cref_get_limit(&ctrl);
+        (void) xensiv_bgt60trxx_cref_update(&ctrl, cref, false);
+        assert((xensiv_bgt60trxx_cref_get_limit(&ctrl) % 128U) == 0U);
+    }
+    assert(xensiv_bgt60trxx_cref_get_limit(&ctrl) == 4096U);
+
+    printf("✓ Adaptive CREF controller test passed\n");
+    return 0;
+}
+
+// Configurator register word: 7-bit address in [31:25], 24-bit value in [23:0]
+#define TEST_REG(addr, data) (((uint32_t)(addr) << 25) | (data))
+
+/**
+ * @brief Test that the frame geometry is decoded from register lists and from the shadow
+ * @return 0 on success, non-zero on failure
+ */
+static int test_frame_geometry(void)
+{
+    printf("Testing frame geometry decoding...\n");
+
+    // 2 MHz ADC, shape 1: 32 chirps of 128 samples on RX1-RX3, 53 us per chirp,
+    // 10.24 ms frame end delay; shape 2 is programmed but disabled
+    uint32_t regs[] = {
+        TEST_REG(XENSIV_BGT60TRXX_REG_ADC0, 40UL << XENSIV_BGT60TRXX_REG_ADC0_ADC_DIV_POS),
+        TEST_REG(XENSIV_BGT60TRXX_REG_CSU1_1, 0x700000U),
+        TEST_REG(XENSIV_BGT60TRXX_REG_CSU2_1, 0x100000U),
+        TEST_REG(XENSIV_BGT60TRXX_REG_CCR1, (10UL << 8) | 100U),
+        TEST_REG(XENSIV_BGT60TRXX_REG_CCR2, 0U),
+        TEST_REG(XENSIV_BGT60TRXX_REG_PLL1_2, (10UL << 16) | 500U),
+        TEST_REG(XENSIV_BGT60TRXX_REG_PLL1_3, 128U),
+        TEST_REG(XENSIV_BGT60TRXX_REG_PLL1_6, 20U),
+        TEST_REG(XENSIV_BGT60TRXX_REG_PLL1_7, XENSIV_BGT60TRXX_REG_PLL_7_SH_EN_MSK | 5U),
+        TEST_REG(XENSIV_BGT60TRXX_REG_PLL2_2, 100U),
+        TEST_REG(XENSIV_BGT60TRXX_REG_PLL2_3, 64U),
+        TEST_REG(XENSIV_BGT60TRXX_REG_PLL2_7, 0U),
+    };
+    const uint32_t len = sizeof(regs) / sizeof(regs[0]);
+    xensiv_bgt60trxx_frame_geometry_t geometry;
+
+    assert(xensiv_bgt60trxx_decode_geometry(regs, len, &geometry) ==
+           XENSIV_BGT60TRXX_STATUS_OK);
+    assert(geometry.samples_per_chirp == 128U && geometry.chirps_per_shape == 32U);
+    assert(geometry.rx_mask == 0x7U && geometry.num_rx == 3U);
+    assert(geometry.num_shapes == 1U && geometry.shapes_per_frame == 1U);
+    assert(geometry.adc_rate_hz == 2000000U);
+    assert(geometry.samples_per_frame == 128U * 3U * 32U);
+    assert(geometry.frame_period_us == (53U * 32U) + 10240U);
+    assert(geometry.data_rate_sps == 1029490U);
+
+    // Enabling shape 2 and a second shape group adds its chirp to each of the two groups
+    regs[4] = TEST_REG(XENSIV_BGT60TRXX_REG_CCR2, 1UL << XENSIV_BGT60TRXX_REG_CCR2_FRAME_LEN_POS);
+    regs[11] = TEST_REG(XENSIV_BGT60TRXX_REG_PLL2_7, XENSIV_BGT60TRXX_REG_PLL_7_SH_EN_MSK);
+    assert(xensiv_bgt60trxx_decode_geometry(regs, len, &geometry) ==
+           XENSIV_BGT60TRXX_STATUS_OK);
+    assert(geometry.num_shapes == 2U && geometry.shapes_per_frame == 4U);
+    assert(geometry.samples_per_frame == 2U * ((128U * 3U * 32U) + 64U));
+    assert(geometry.frame_period_us == (2U * ((53U * 32U) + 10U)) + 10240U);
+    assert(geometry.data_rate_sps == 1809551U);
+
+    // A fully cached shadow is decoded without touching the device
+    xensiv_bgt60trxx_shadow_t shadow;
+    memset(&shadow, 0, sizeof(shadow));
+    memset(shadow.valid, 0xff, sizeof(shadow.valid));
+    for (uint32_t i = 0; i < len; ++i) {
+        shadow.regs[regs[i] >> 25] = regs[i] & 0xffffffU;
+    }
+    xensiv_bgt60trxx_t dev;
+    memset(&dev, 0, sizeof(dev));
+    dev.shadow = &shadow;
+    xensiv_bgt60trxx_frame_geometry_t cached;
+    assert(xensiv_bgt60trxx_get_geometry(&dev, &cached) == XENSIV_BGT60TRXX_STATUS_OK);
+    assert(memcmp(&cached, &geometry, sizeof(cached)) == 0);
+
+    // A configuration without sampled channels is rejected
+    regs[1] = TEST_REG(XENSIV_BGT60TRXX_REG_CSU1_1, 0U);
+    regs[11] = TEST_REG(XENSIV_BGT60TRXX_REG_PLL2_7, 0U);
+    assert(xensiv_bgt60trxx_decode_geometry(regs, len, &geometry) ==
+           XENSIV_BGT60TRXX_STATUS_DEV_ERROR);
+
+    printf("✓ Frame geometry decoding test passed\n");
+    return 0;
+}
+
+/**
+ * @brief Test the throughput and timing budget of a configuration on a host
+ * @return 0 on success, non-zero on failure
+ */
+static int test_budget(void)
+{
+    printf("Testing throughput budget...\n");
+
+    xensiv_bgt60trxx_frame_geometry_t geometry;
+    memset(&geometry, 0, sizeof(geometry));
+    geometry.data_rate_sps = 1000000U;
+
+    xensiv_bgt60trxx_host_config_t host = {
+        .spi_clock_hz = 10000000U,
+        .high_speed = false,
+        .transaction_overhead_us = 50U,
+        .service_latency_us = 1000U,
+        .cref_samples = 4096U,
+        .fifo_size = 8192U,
+    };
+    xensiv_bgt60trxx_budget_t budget;
+
+    // A burst of 4096 samples is 4 + 6144 bytes; at 10 MHz it outlasts the 4.096 ms refill
+    assert(xensiv_bgt60trxx_compute_budget(&geometry, &host, &budget) ==
+           XENSIV_BGT60TRXX_STATUS_OK);
+    assert(budget.data_rate_bytes_per_s == 1500000U);
+    assert(budget.fill_to_cref_us == 4096U && budget.fill_to_full_us == 16384U);
+    assert(budget.min_spi_clock_hz == 12156204U);
+    assert(budget.max_spi_clock_hz == XENSIV_BGT60TRXX_SPI_MAX_CLOCK_HZ);
+    assert(budget.max_safe_cref == 16384U - 1050U);
+    assert(budget.host_load_permille > 1000U && !budget.feasible);
+
+    host.spi_clock_hz = 20000000U;
+    assert(xensiv_bgt60trxx_compute_budget(&geometry, &host, &budget) ==
+           XENSIV_BGT60TRXX_STATUS_OK);
+    assert(budget.burst_us == 2509U);
+    assert(budget.bus_load_permille == 600U && budget.host_load_permille == 612U);
+    assert(budget.feasible);
+
+    // Above the normal mode limit the high speed read mode is required
+    host.spi_clock_hz = 40000000U;
+    assert(xensiv_bgt60trxx_compute_budget(&geometry, &host, &budget) ==
+           XENSIV_BGT60TRXX_STATUS_OK);
+    assert(!budget.feasible);
+    host.high_speed = true;
+    assert(xensiv_bgt60trxx_compute_budget(&geometry, &host, &budget) ==
+           XENSIV_BGT60TRXX_STATUS_OK);
+    assert(budget.feasible);
+
+    // A long service latency leaves no room for this CREF, a tiny CREF drowns in overhead
+    host.service_latency_us = 15000U;
+    assert(xensiv_bgt60trxx_compute_budget(&geometry, &host, &budget) ==
+           XENSIV_BGT60TRXX_STATUS_OK);
+    assert(budget.max_safe_cref == 16384U - 15050U && !budget.feasible);
+    host.service_latency_us = 1000U;
+    host.cref_samples = 40U;
+    assert(xensiv_bgt60trxx_compute_budget(&geometry, &host, &budget) ==
+           XENSIV_BGT60TRXX_STATUS_OK);
+    assert(budget.min_spi_clock_hz == UINT32_MAX && !budget.feasible);
+
+    // Odd or oversized CREF and configurations without data are rejected
+    host.cref_samples = 41U;
+    assert(xensiv_bgt60trxx_compute_budget(&geometry, &host, &budget) ==
+           XENSIV_BGT60TRXX_STATUS_DEV_ERROR);
+    host.cref_samples = 16386U;
+    assert(xensiv_bgt60trxx_compute_budget(&geometry, &host, &budget) ==
+           XENSIV_BGT60TRXX_STATUS_DEV_ERROR);
+    host.cref_samples = 4096U;
+    geometry.data_rate_sps = 0U;
+    assert(xensiv_bgt60trxx_compute_budget(&geometry, &host, &budget) ==
+           XENSIV_BGT60TRXX_STATUS_DEV_ERROR);
+
+    printf("✓ Throughput budget test passed\n");
+    return 0;
+}
+
+// Feeds two frames of a numbered stream in uneven chunks and checks every sample's place
+static int check_assembler(xensiv_bgt60trxx_frame_layout_t layout, uint32_t row_align)
+{
+    // Shape 1: 4 chirps of 21 samples on RX1-3 plus 5 down-chirp samples on RX2;
+    // shape 3: 2 chirps of 16 samples on RX1 and RX3; shape 4: 1 chirp of 9 samples on RX1-4
+    xensiv_bgt60trxx_frame_geometry_t geometry;
+    memset(&geometry, 0, sizeof(geometry));
+    geometry.shape_groups = 2U;
+    geometry.shapes[0] = (xensiv_bgt60trxx_shape_geometry_t){4U, 21U, 0x7U, 5U, 0x2U};
+    geometry.shapes[2] = (xensiv_bgt60trxx_shape_geometry_t){2U, 16U, 0x5U, 0U, 0U};
+    geometry.shapes[3] = (xensiv_bgt60trxx_shape_geometry_t){1U, 9U, 0xfU, 0U, 0U};
+    const uint32_t stream_size = 2U * ((4U * ((21U * 3U) + 5U)) + (2U * 16U * 2U) + (9U * 4U));
+
+    xensiv_bgt60trxx_assembler_t assembler;
+    assert(xensiv_bgt60trxx_assembler_init(&assembler, &geometry, layout, row_align) ==
+           XENSIV_BGT60TRXX_STATUS_OK);
+    assert(assembler.num_segments == 4U && assembler.num_groups == 2U);
+    assert((row_align != 0U) || (assembler.frame_size == stream_size));
+
+    uint16_t *stream = malloc(2U * stream_size * sizeof(uint16_t));
+    uint8_t *frames_mem = malloc((2U * assembler.frame_size * sizeof(uint16_t)) + 64U);
+    assert(stream != NULL && frames_mem != NULL);
+    uint16_t *frames = (uint16_t *) (frames_mem + (64U - ((uintptr_t) frames_mem % 64U)));
+    for (uint32_t i = 0; i < 2U * stream_size; ++i) {
+        stream[i] = (uint16_t) (i + 1U);
+    }
+    memset(frames, 0, 2U * assembler.frame_size * sizeof(uint16_t));
+
+    static const uint32_t chunks[] = {1U, 7U, 64U, 3U, 250U, 13U, 500U};
+    uint32_t fed = 0U;
+    uint32_t frame = 0U;
+    xensiv_bgt60trxx_assembler_set_frame(&assembler, frames);
+    for (uint32_t c = 0; fed < 2U * stream_size; ++c) {
+        uint32_t len = chunks[c % (sizeof(chunks) / sizeof(chunks[0]))];
+        len = (len < (2U * stream_size) - fed) ? len : (2U * stream_size) - fed;
+        while (len > 0U) {
+            bool done;
+            uint32_t used = xensiv_bgt60trxx_assembler_feed(&assembler, &stream[fed], len, &done);
+            fed += used;
+            len -= used;
+            if (done) {
+                assert(fed == (frame + 1U) * stream_size);
+                ++frame;
+                xensiv_bgt60trxx_assembler_set_frame(&assembler,
+                                                     &frames[assembler.frame_size * (frame % 2U)]);
+            }
+        }
+    }
+    assert(frame == 2U && assembler.frames == 2U);
+
+    // Walk the stream in FIFO order: group, shape, chirp, direction, sample, RX
+    uint32_t i = 0U;
+    for (uint32_t f = 0; f < 2U; ++f) {
+        uint16_t *buf = &frames[f * assembler.frame_size];
+        for (uint32_t g = 0; g < 2U; ++g) {
+            uint32_t first = 0U;
+            while (first < assembler.num_segments) {
+                uint32_t last = first;
+                while (((last + 1U) < assembler.num_segments) &&
+                       (assembler.segments[last + 1U].shape == assembler.segments[first].shape)) {
+                    ++last;
+                }
+                for (uint32_t chirp = 0; chirp < assembler.segments[first].num_chirps; ++chirp) {
+                    for (uint32_t s = first; s <= last; ++s) {
+                        const xensiv_bgt60trxx_frame_segment_t *seg = &assembler.segments[s];
+                        for (uint32_t n = 0; n < seg->num_samples; ++n) {
+                            for (uint32_t r = 0; r < seg->num_rx; ++r) {
+                                uint16_t got;
+                                if (layout == XENSIV_BGT60TRXX_LAYOUT_PLANAR) {
+                                    got = xensiv_bgt60trxx_assembler_row(&assembler, buf, g, s, r,
+                                                                         chirp)[n];
+                                } else {
+                                    got = buf[(g * assembler.group_size) + seg->offset +
+                                              (((chirp * seg->num_samples) + n) * seg->num_rx) +
+                                              r];
+                                }
+                                assert(got == stream[i]);
+                                ++i;
+                            }
+                        }
+                    }
+                }
+                first = last + 1U;
+            }
+        }
+    }
+    assert(i == 2U * stream_size);
+
+    if ((layout == XENSIV_BGT60TRXX_LAYOUT_PLANAR) && (row_align != 0U)) {
+        for (uint32_t s = 0; s < assembler.num_segments; ++s) {
+            uint16_t *row = xensiv_bgt60trxx_assembler_row(&assembler, frames, 1U, s, 0U, 1U);
+            assert(((uintptr_t) row % row_align) == 0U);
+        }
+    }
+
+    free(frames_mem);
+    free(stream);
+    return 0;
+}
+
+/**
+ * @brief Test that the frame assembler reshapes arbitrarily split FIFO reads into frames
+ * @return 0 on success, non-zero on failure
+ */
+static int test_frame_assembler(void)
+{
+    printf("Testing frame assembler...\n");
+
+    int result = check_assembler(XENSIV_BGT60TRXX_LAYOUT_PLANAR, 0U);
+    result |= check_assembler(XENSIV_BGT60TRXX_LAYOUT_PLANAR, 64U);
+    result |= check_assembler(XENSIV_BGT60TRXX_LAYOUT_INTERLEAVED, 0U);
+
+    // A reset drops the partial frame and restarts at the first sample of a frame
+    xensiv_bgt60trxx_frame_geometry_t geometry;
+    memset(&geometry, 0, sizeof(geometry));
+    geometry.shape_groups = 1U;
+    geometry.shapes[0] = (xensiv_bgt60trxx_shape_geometry_t){2U, 8U, 0x3U, 0U, 0U};
+    xensiv_bgt60trxx_assembler_t assembler;
+    assert(xensiv_bgt60trxx_assembler_init(&assembler, &geometry, XENSIV_BGT60TRXX_LAYOUT_PLANAR,
+                                           0U) == XENSIV_BGT60TRXX_STATUS_OK);
+    uint16_t frame[32];
+    uint16_t data[32];
+    for (uint32_t i = 0; i < 32U; ++i) {
+        data[i] = (uint16_t) i;
+    }
+    bool done;
+    xensiv_bgt60trxx_assembler_set_frame(&assembler, frame);
+    assert(xensiv_bgt60trxx_assembler_feed(&assembler, data, 5U, &done) == 5U && !done);
+    xensiv_bgt60trxx_assembler_reset(&assembler);
+    assert(xensiv_bgt60trxx_assembler_feed(&assembler, data, 32U, &done) == 32U && done);
+    assert(frame[0] == 0U && frame[1] == 2U && frame[8] == 16U && frame[16] == 1U);
+
+    geometry.shapes[0].up_rx_mask = 0U;
+    assert(xensiv_bgt60trxx_assembler_init(&assembler, &geometry, XENSIV_BGT60TRXX_LAYOUT_PLANAR,
+                                           0U) == XENSIV_BGT60TRXX_STATUS_DEV_ERROR);
+
+    if (result == 0) {
+        printf("✓ Frame assembler test passed\n");
+    }
+    return result;
+}
+
+// Largest deviation of a spectrum from the DFT of a real or complex input, relative to its peak
+static double dft_error(const xensiv_bgt60trxx_complex_t *in_c,
+                        const float *in_r,
+                        uint32_t n,
+                        const xensiv_bgt60trxx_complex_t *spectrum,
+                        uint32_t num_bins)
+{
+    const double pi = 3.14159265358979323846;
+    double max_err = 0.0;
+    double peak = 1e-9;
+
+    for (uint32_t k = 0; k < num_bins; ++k) {
+        double re = 0.0;
+        double im = 0.0;
+        for (uint32_t t = 0; t < n; ++t) {
+            double phase = (-2.0 * pi * (double) ((k * t) % n)) / (double) n;
+            double x_re = (in_c != NULL) ? in_c[t].re : in_r[t];
+            double x_im = (in_c != NULL) ? in_c[t].im : 0.0;
+            re += (x_re * cos(phase)) - (x_im * sin(phase));
+            im += (x_re * sin(phase)) + (x_im * cos(phase));
+        }
+        double err = hypot(re - spectrum[k].re, im - spectrum[k].im);
+        max_err = (err > max_err) ? err : max_err;
+        peak = (hypot(re, im) > peak) ? hypot(re, im) : peak;
+    }
+
+    return max_err / peak;
+}
+
+/**
+ * @brief Test the FFT kernels against a direct DFT
+ * @return 0 on success, non-zero on failure
+ */
+static int test_fft(void)
+{
+    printf("Testing FFT kernels...\n");
+
+    static const xensiv_bgt60trxx_fft_algo_t algos[] = {XENSIV_BGT60TRXX_FFT_RADIX2,
+                                                        XENSIV_BGT60TRXX_FFT_RADIX4,
+                                                        XENSIV_BGT60TRXX_FFT_SPLIT_RADIX};
+    static xensiv_bgt60trxx_complex_t input[512];
+    static xensiv_bgt60trxx_complex_t data[512];
+    static uint8_t storage[XENSIV_BGT60TRXX_RFFT_PLAN_STORAGE_BYTES(1024U)];
+
+    srand(7);
+    for (uint32_t i = 0; i < 512U; ++i) {
+        input[i].re = (float) (rand() % 4096) - 2048.0f;
+        input[i].im = (float) (rand() % 4096) - 2048.0f;
+    }
+
+    for (size_t a = 0; a < sizeof(algos) / sizeof(algos[0]); ++a) {
+        for (uint32_t n = 1U; n <= 512U; n <<= 1) {
+            xensiv_bgt60trxx_fft_plan_t plan;
+            xensiv_bgt60trxx_fft_plan_init(&plan, n, algos[a], storage);
+            memcpy(data, input, n * sizeof(data[0]));
+            xensiv_bgt60trxx_fft(&plan, data);
+            assert(dft_error(input, NULL, n, data, n) < 1e-5);
+        }
+
+        // Real input: bins 0..n/2-1, Nyquist packed into bin 0
+        for (uint32_t n = 2U; n <= 1024U; n <<= 1) {
+            const float *real = (const float *) input;
+            xensiv_bgt60trxx_rfft_plan_t plan;
+            xensiv_bgt60trxx_rfft_plan_init(&plan, n, algos[a], storage);
+            xensiv_bgt60trxx_rfft(&plan, real, data);
+            float nyquist = data[0].im;
+            data[0].im = 0.0f;
+            assert(dft_error(NULL, real, n, data, n / 2U) < 1e-5);
+            float expected = 0.0f;
+            for (uint32_t t = 0; t < n; ++t) {
+                expected += ((t % 2U) == 0U) ? real[t] : -real[t];
+            }
+            assert(fabsf(nyquist - expected) <= 1e-4f * (1.0f + fabsf(expected)) * (float) n);
+        }
+    }
+
+    printf("✓ FFT kernels test passed\n");
+    return 0;
+}
+
+/**
+ * @brief Test the range stage on synthetic beat tones
+ * @return 0 on success, non-zero on failure
+ */
+static int test_range_stage(void)
+{
+    printf("Testing range processing...\n");
+
+    const double pi = 3.14159265358979323846;
+
+    // 2 RX, 3 chirps of 50 samples, zero-padded to 64; RX r chirp c beats at bin 5 + 4r + c
+    xensiv_bgt60trxx_frame_geometry_t geometry;
+    memset(&geometry, 0, sizeof(geometry));
+    geometry.shape_groups = 1U;
+    geometry.shapes[0] = (xensiv_bgt60trxx_shape_geometry_t){3U, 50U, 0x3U, 0U, 0U};
+    xensiv_bgt60trxx_assembler_t assembler;
+    assert(xensiv_bgt60trxx_assembler_init(&assembler, &geometry, XENSIV_BGT60TRXX_LAYOUT_PLANAR,
+                                           0U) == XENSIV_BGT60TRXX_STATUS_OK);
+    uint16_t frame[300];
+    for (uint32_t r = 0; r < 2U; ++r) {
+        for (uint32_t c = 0; c < 3U; ++c) {
+            uint16_t *row = xensiv_bgt60trxx_assembler_row(&assembler, frame, 0U, 0U, r, c);
+            for (uint32_t n = 0; n < 50U; ++n) {
+                double tone = cos((2.0 * pi * (5.0 + (4.0 * r) + c) * n) / 64.0);
+                row[n] = (uint16_t) (2048.0 + (1000.0 * tone));
+            }
+        }
+    }
+
+    xensiv_bgt60trxx_range_config_t config = {
+        .window = XENSIV_BGT60TRXX_WINDOW_HANN,
+        .algo = XENSIV_BGT60TRXX_FFT_SPLIT_RADIX,
+        .remove_dc = true,
+        .fft_size = 0U,
+    };
+    static uint8_t storage[4096];
+    size_t needed = xensiv_bgt60trxx_range_storage_size(&assembler, &config);
+    assert(needed <= sizeof(storage));
+
+    xensiv_bgt60trxx_range_t range;
+    assert(xensiv_bgt60trxx_range_init(&range, &assembler, &config, storage, needed - 1U) ==
+           XENSIV_BGT60TRXX_STATUS_DEV_ERROR);
+    config.fft_size = 32U;
+    assert(xensiv_bgt60trxx_range_init(&range, &assembler, &config, storage, sizeof(storage)) ==
+           XENSIV_BGT60TRXX_STATUS_DEV_ERROR);
+    config.fft_size = 0U;
+    assert(xensiv_bgt60trxx_range_init(&range, &assembler, &config, storage, needed) ==
+           XENSIV_BGT60TRXX_STATUS_OK);
+    assert(range.num_plans == 1U && range.frame_bins == 2U * 3U * 32U);
+
+    float magnitude[192];
+    xensiv_bgt60trxx_complex_t profiles[192];
+    xensiv_bgt60trxx_range_process_magnitude(&range, frame, magnitude);
+    xensiv_bgt60trxx_range_process(&range, frame, profiles);
+
+    for (uint32_t r = 0; r < 2U; ++r) {
+        for (uint32_t c = 0; c < 3U; ++c) {
+            uint32_t offset = xensiv_bgt60trxx_range_profile_offset(&range, 0U, 0U, r, c);
+            uint32_t peak = 0U;
+            for (uint32_t bin = 1U; bin < 32U; ++bin) {
+                peak = (magnitude[offset + bin] > magnitude[offset + peak]) ? bin : peak;
+                float mag = hypotf(profiles[offset + bin].re, profiles[offset + bin].im);
+                assert(fabsf(mag - magnitude[offset + bin]) <= 1e-3f * (1.0f + mag));
+            }
+            assert(peak == 5U + (4U * r) + c);
+            // DC removal leaves only the window leakage of the tone in bin 0
+            assert(magnitude[offset] < 0.1f * magnitude[offset + peak]);
+        }
+    }
+
+    // The complex profile is the DFT of the windowed, mean-free, zero-padded chirp
+    const uint16_t *row = xensiv_bgt60trxx_assembler_row(&assembler, frame, 0U, 0U, 1U, 2U);
+    float windowed[64] = {0.0f};
+    float mean = 0.0f;
+    for (uint32_t n = 0; n < 50U; ++n) {
+        mean += (float) row[n] / 50.0f;
+    }
+    for (uint32_t n = 0; n < 50U; ++n) {
+        windowed[n] = ((float) row[n] - mean) * (float) (0.5 - (0.5 * cos((2.0 * pi * n) / 49.0)));
+    }
+    uint32_t offset = xensiv_bgt60trxx_range_profile_offset(&range, 0U, 0U, 1U, 2U);
+    assert(dft_error(NULL, windowed, 64U, &profiles[offset], 32U) < 1e-4);
+
+    printf("✓ Range processing test passed\n");
+    return 0;
+}
+
+/**
+ * @brief Test the Doppler stage on synthetic moving and static targets
+ * @return 0 on success, non-zero on failure
+ */
+static int test_doppler(void)
+{
+    printf("Testing Doppler processing...\n");
+
+    const double pi = 3.14159265358979323846;
+
+    // 2 RX, 12 chirps of 32 samples: 16 range bins, 16 Doppler bins
+    xensiv_bgt60trxx_frame_geometry_t geometry;
+    memset(&geometry, 0, sizeof(geometry));
+    geometry.shape_groups = 1U;
+    geometry.shapes[0] = (xensiv_bgt60trxx_shape_geometry_t){12U, 32U, 0x3U, 0U, 0U};
+    xensiv_bgt60trxx_assembler_t assembler;
+    assert(xensiv_bgt60trxx_assembler_init(&assembler, &geometry, XENSIV_BGT60TRXX_LAYOUT_PLANAR,
+                                           0U) == XENSIV_BGT60TRXX_STATUS_OK);
+    xensiv_bgt60trxx_range_config_t range_config = {
+        .window = XENSIV_BGT60TRXX_WINDOW_RECT,
+        .algo = XENSIV_BGT60TRXX_FFT_RADIX2,
+        .remove_dc = false,
+        .fft_size = 0U,
+    };
+    static uint8_t range_storage[4096];
+    xensiv_bgt60trxx_range_t range;
+    assert(xensiv_bgt60trxx_range_init(&range, &assembler, &range_config, range_storage,
+                                       sizeof(range_storage)) == XENSIV_BGT60TRXX_STATUS_OK);
+    assert(range.frame_bins == 2U * 12U * 16U);
+
+    // Range bin 4 moves at Doppler bin 3 (phase offset per RX), range bin 7 is static clutter
+    static xensiv_bgt60trxx_complex_t profiles[384];
+    memset(profiles, 0, sizeof(profiles));
+    for (uint32_t r = 0; r < 2U; ++r) {
+        for (uint32_t c = 0; c < 12U; ++c) {
+            xensiv_bgt60trxx_complex_t *row =
+                &profiles[xensiv_bgt60trxx_range_profile_offset(&range, 0U, 0U, r, c)];
+            double phase = ((2.0 * pi * 3.0 * c) / 16.0) + (0.5 * r);
+            row[4] = (xensiv_bgt60trxx_complex_t){(float) (100.0 * cos(phase)),
+                                                  (float) (100.0 * sin(phase))};
+            row[7] = (xensiv_bgt60trxx_complex_t){50.0f, -20.0f};
+        }
+    }
+
+    xensiv_bgt60trxx_doppler_config_t config = {
+        .window = XENSIV_BGT60TRXX_WINDOW_RECT,
+        .algo = XENSIV_BGT60TRXX_FFT_RADIX4,
+        .clutter = XENSIV_BGT60TRXX_CLUTTER_NONE,
+        .fft_size = 0U,
+        .center_zero = false,
+        .tile_bins = 0U,
+    };
+    static uint8_t storage[8192];
+    size_t needed = xensiv_bgt60trxx_doppler_storage_size(&range, &config);
+    assert(needed <= sizeof(storage));
+
+    xensiv_bgt60trxx_doppler_t doppler;
+    assert(xensiv_bgt60trxx_doppler_init(&doppler, &range, &config, storage, needed - 1U) ==
+           XENSIV_BGT60TRXX_STATUS_DEV_ERROR);
+    config.fft_size = 8U;
+    assert(xensiv_bgt60trxx_doppler_init(&doppler, &range, &config, storage, sizeof(storage)) ==
+           XENSIV_BGT60TRXX_STATUS_DEV_ERROR);
+    config.fft_size = 0U;
+    assert(xensiv_bgt60trxx_doppler_init(&doppler, &range, &config, storage, needed) ==
+           XENSIV_BGT60TRXX_STATUS_OK);
+    assert(doppler.frame_cells == 2U * 16U * 16U && doppler.frame_nci_cells == 16U * 16U);
+
+    static xensiv_bgt60trxx_complex_t map[512];
+    static xensiv_bgt60trxx_complex_t tiled[512];
+    static float nci[256];
+    xensiv_bgt60trxx_doppler_process(&doppler, profiles, map, nci);
+
+    // Each map row is the DFT of the zero-padded slow-time sequence of its range bin
+    for (uint32_t r = 0; r < 2U; ++r) {
+        for (uint32_t bin = 0; bin < 16U; ++bin) {
+            xensiv_bgt60trxx_complex_t slow[16];
+            memset(slow, 0, sizeof(slow));
+            for (uint32_t c = 0; c < 12U; ++c) {
+                slow[c] = profiles[xensiv_bgt60trxx_range_profile_offset(&range, 0U, 0U, r, c) +
+                                   bin];
+            }
+            const xensiv_bgt60trxx_complex_t *row =
+                &map[xensiv_bgt60trxx_doppler_map_offset(&doppler, 0U, 0U, r, bin)];
+            assert(dft_error(slow, NULL, 16U, row, 16U) < 1e-5);
+        }
+    }
+
+    // Integration sums |X|^2 over the receivers
+    for (uint32_t bin = 0; bin < 16U; ++bin) {
+        const float *acc = &nci[xensiv_bgt60trxx_doppler_nci_offset(&doppler, 0U, 0U, bin)];
+        for (uint32_t d = 0; d < 16U; ++d) {
+            float expected = 0.0f;
+            for (uint32_t r = 0; r < 2U; ++r) {
+                const xensiv_bgt60trxx_complex_t *v =
+                    &map[xensiv_bgt60trxx_doppler_map_offset(&doppler, 0U, 0U, r, bin) + d];
+                expected += (v->re * v->re) + (v->im * v->im);
+            }
+            assert(fabsf(acc[d] - expected) <= 1e-4f * (1.0f + expected));
+        }
+    }
+    const float *moving = &nci[xensiv_bgt60trxx_doppler_nci_offset(&doppler, 0U, 0U, 4U)];
+    for (uint32_t d = 0; d < 16U; ++d) {
+        assert((d == 3U) || (moving[d] < moving[3]));
+    }
+
+    // Smaller tiles and zero-centred output give the same map, shifted by half the FFT
+    config.tile_bins = 3U;
+    config.center_zero = true;
+    assert(xensiv_bgt60trxx_doppler_init(&doppler, &range, &config, storage, sizeof(storage)) ==
+           XENSIV_BGT60TRXX_STATUS_OK);
+    assert(doppler.tile_bins == 3U);
+    xensiv_bgt60trxx_doppler_process(&doppler, profiles, tiled, NULL);
+    for (uint32_t row = 0; row < 32U; ++row) {
+        for (uint32_t d = 0; d < 16U; ++d) {
+            assert(memcmp(&tiled[(row * 16U) + ((d + 8U) % 16U)], &map[(row * 16U) + d],
+                          sizeof(map[0])) == 0);
+        }
+    }
+
+    // Both clutter filters remove the static target and keep the moving one
+    static const xensiv_bgt60trxx_clutter_t filters[] = {XENSIV_BGT60TRXX_CLUTTER_MEAN,
+                                                         XENSIV_BGT60TRXX_CLUTTER_MTI};
+    config.tile_bins = 0U;
+    config.center_zero = false;
+    for (size_t f = 0; f < sizeof(filters) / sizeof(filters[0]); ++f) {
+        config.clutter = filters[f];
+        assert(xensiv_bgt60trxx_doppler_init(&doppler, &range, &config, storage,
+                                             sizeof(storage)) == XENSIV_BGT60TRXX_STATUS_OK);
+        xensiv_bgt60trxx_doppler_process(&doppler, profiles, NULL, nci);
+        const float *clutter = &nci[xensiv_bgt60trxx_doppler_nci_offset(&doppler, 0U, 0U, 7U)];
+        for (uint32_t d = 0; d < 16U; ++d) {
+            assert(clutter[d] < 1e-6f * moving[3]);
+            assert((d == 3U) || (moving[d] < moving[3]));
+        }
+    }
+
+    // A single chirp shape (REPS=0) is passed through unweighted by every window
+    static const xensiv_bgt60trxx_window_t windows[] = {XENSIV_BGT60TRXX_WINDOW_HANN,
+                                                        XENSIV_BGT60TRXX_WINDOW_BLACKMAN_HARRIS};
+    geometry.shapes[0] = (xensiv_bgt60trxx_shape_geometry_t){1U, 32U, 0x3U, 0U, 0U};
+    assert(xensiv_bgt60trxx_assembler_init(&assembler, &geometry, XENSIV_BGT60TRXX_LAYOUT_PLANAR,
+                                           0U) == XENSIV_BGT60TRXX_STATUS_OK);
+    assert(xensiv_bgt60trxx_range_init(&range, &assembler, &range_config, range_storage,
+                                       sizeof(range_storage)) == XENSIV_BGT60TRXX_STATUS_OK);
+    memset(profiles, 0, sizeof(profiles));
+    for (uint32_t r = 0; r < 2U; ++r) {
+        profiles[xensiv_bgt60trxx_range_profile_offset(&range, 0U, 0U, r, 0U) + 4U] =
+            (xensiv_bgt60trxx_complex_t){3.0f, 4.0f};
+    }
+    config.clutter = XENSIV_BGT60TRXX_CLUTTER_NONE;
+    for (size_t w = 0; w < sizeof(windows) / sizeof(windows[0]); ++w) {
+        config.window = windows[w];
+        assert(xensiv_bgt60trxx_doppler_init(&doppler, &range, &config, storage,
+                                             sizeof(storage)) == XENSIV_BGT60TRXX_STATUS_OK);
+        xensiv_bgt60trxx_doppler_process(&doppler, profiles, map, nci);
+        const xensiv_bgt60trxx_complex_t *cell =
+            &map[xensiv_bgt60trxx_doppler_map_offset(&doppler, 0U, 0U, 1U, 4U)];
+        assert((fabsf(cell->re - 3.0f) < 1e-6f) && (fabsf(cell->im - 4.0f) < 1e-6f));
+        assert(fabsf(nci[xensiv_bgt60trxx_doppler_nci_offset(&doppler, 0U, 0U, 4U)] - 50.0f) <
+               1e-4f);
+    }
+
+    printf("✓ Doppler processing test passed\n");
+    return 0;
+}
+
+// Noise estimate of one cell by enumerating its training cells
+static float cfar_reference(const xensiv_bgt60trxx_cfar_config_t *config,
+                            const float *power,
+                            int32_t rows,
+                            int32_t cols,
+                            int32_t i,
+                            int32_t j,
+                            uint32_t rank,
+                            uint32_t num_train)
+{
+    static float cells[1024];
+    const bool profile = (cols == 1);
+    const int32_t n = profile ? rows : cols;
+    const int32_t gr = profile ? 0 : (int32_t) config->guard[0];
+    const int32_t rr = profile ? 0 : (int32_t) (config->guard[0] + config->train[0]);
+    const int32_t gc = (int32_t) config->guard[profile ? 0 : 1];
+    const int32_t rc = gc + (int32_t) config->train[profile ? 0 : 1];
+    const bool wrap = !profile && config->wrap_doppler;
+    const int32_t ci = profile ? j : i;
+    const int32_t cj = profile ? i : j;
+    const int32_t num_rows = profile ? 1 : rows;
+    double sums[2] = {0.0, 0.0};
+    uint32_t counts[2] = {0U, 0U};
+    uint32_t num = 0U;
+
+    for (int32_t r = ci - rr; r <= ci + rr; ++r) {
+        for (int32_t c = cj - rc; c <= cj + rc; ++c) {
+            int32_t col = wrap ? (((c % n) + n) % n) : c;
+            if ((r < 0) || (r >= num_rows) || (col < 0) || (col >= n) ||
+                ((abs(r - ci) <= gr) && (abs(c - cj) <= gc))) {
+                continue;
+            }
+            float val = profile ? power[col] : power[(r * cols) + col];
+            uint32_t half = ((r < ci) || ((r == ci) && (c < cj))) ? 0U : 1U;
+            sums[half] += val;
+            counts[half]++;
+            cells[num++] = val;
+        }
+    }
+
+    switch (config->type) {
+        case XENSIV_BGT60TRXX_CFAR_CA:
+            return (float) ((sums[0] + sums[1]) / (counts[0] + counts[1]));
+        case XENSIV_BGT60TRXX_CFAR_OS: {
+            // Clipped windows scale the rank with their cell count
+            rank = ((rank * num) + (num_train / 2U)) / num_train;
+            rank = (rank == 0U) ? 1U : ((rank > num) ? num : rank);
+            for (uint32_t a = 1; a < num; ++a) {
+                for (uint32_t b = a; (b > 0U) && (cells[b - 1U] > cells[b]); --b) {
+                    float tmp = cells[b];
+                    cells[b] = cells[b - 1U];
+                    cells[b - 1U] = tmp;
+                }
+            }
+            return cells[rank - 1U];
+        }
+        default: {
+            double lead = (counts[0] > 0U) ? sums[0] / counts[0] : sums[1] / counts[1];
+            double lag = (counts[1] > 0U) ? sums[1] / counts[1] : lead;
+            bool go = (config->type == XENSIV_BGT60TRXX_CFAR_GO);
+            return (float) (go ? ((lead > lag) ? lead : lag) : ((lead < lag) ? lead : lag));
+        }
+    }
+}
+
+/**
+ * @brief Test the CFAR detector against a direct evaluation of its windows
+ * @return 0 on success, non-zero on failure
+ */
+static int test_cfar(void)
+{
+    printf("Testing CFAR detection...\n");
+
+    static const xensiv_bgt60trxx_cfar_type_t types[] = {XENSIV_BGT60TRXX_CFAR_CA,
+                                                         XENSIV_BGT60TRXX_CFAR_GO,
+                                                         XENSIV_BGT60TRXX_CFAR_SO,
+                                                         XENSIV_BGT60TRXX_CFAR_OS};
+    static double storage[16384];
+    static float power[96 * 32];
+    static xensiv_bgt60trxx_detection_t detections[96 * 32];
+    xensiv_bgt60trxx_cfar_t cfar;
+
+    // Every cell passes a low threshold, so every noise estimate can be checked
+    srand(11);
+    for (uint32_t i = 0; i < 96U * 32U; ++i) {
+        power[i] = 1.0f + ((float) rand() / (float) RAND_MAX);
+    }
+    for (size_t t = 0; t < sizeof(types) / sizeof(types[0]); ++t) {
+        for (uint32_t wrap = 0; wrap < 2U; ++wrap) {
+            for (uint32_t profile = 0; profile < 2U; ++profile) {
+                xensiv_bgt60trxx_cfar_config_t config = {
+                    .type = types[t],
+                    .guard = {2U, 1U},
+                    .train = {3U, 4U},
+                    .threshold = 0.25f,
+                    .pfa = 0.0f,
+                    .os_rank = 0U,
+                    .wrap_doppler = (wrap != 0U),
+                };
+                const uint32_t rows = (profile != 0U) ? 96U : 24U;
+                const uint32_t cols = (profile != 0U) ? 1U : 32U;
+                assert(xensiv_bgt60trxx_cfar_storage_size(&config, rows, cols) <= sizeof(storage));
+                assert(xensiv_bgt60trxx_cfar_init(&cfar, &config, rows, cols, storage,
+                                                  sizeof(storage)) == XENSIV_BGT60TRXX_STATUS_OK);
+                assert(xensiv_bgt60trxx_cfar_process(&cfar, power, detections, rows * cols) ==
+                       rows * cols);
+                for (uint32_t k = 0; k < rows * cols; ++k) {
+                    const xensiv_bgt60trxx_detection_t *det = &detections[k];
+                    const int32_t i = (int32_t) (k / cols);
+                    const int32_t j = (int32_t) (k % cols);
+                    assert((det->range_bin == i) && (det->doppler_bin == j));
+                    assert(det->power == power[k]);
+
+                    float expected = cfar_reference(&config, power, (int32_t) rows,
+                                                    (int32_t) cols, i, j, cfar.os_rank,
+                                                    cfar.num_train);
+                    assert(fabsf(det->noise - expected) <= 1e-5f * expected);
+                }
+            }
+        }
+    }
+
+    // A target over a flat floor is the only detection, also at the profile edge
+    xensiv_bgt60trxx_cfar_config_t config = {
+        .type = XENSIV_BGT60TRXX_CFAR_CA,
+        .guard = {1U, 1U},
+        .train = {4U, 4U},
+        .threshold = 0.0f,
+        .pfa = 1e-3f,
+        .os_rank = 0U,
+        .wrap_doppler = true,
+    };
+    for (uint32_t i = 0; i < 64U; ++i) {
+        power[i] = ((i == 1U) || (i == 30U)) ? 100.0f : 1.0f;
+    }
+    assert(xensiv_bgt60trxx_cfar_init(&cfar, &config, 64U, 1U, storage, sizeof(storage)) ==
+           XENSIV_BGT60TRXX_STATUS_OK);
+    assert(xensiv_bgt60trxx_cfar_process(&cfar, power, detections, 64U) == 2U);
+    assert((detections[0].range_bin == 1U) && (detections[1].range_bin == 30U));
+    assert(fabsf(detections[1].noise - 1.0f) < 1e-6f);
+    assert(xensiv_bgt60trxx_cfar_process(&cfar, power, detections, 1U) == 1U);
+
+    // The derived thresholds hold the false alarm rate on exponential noise
+    for (size_t t = 0; t < sizeof(types) / sizeof(types[0]); ++t) {
+        config.type = types[t];
+        config.pfa = 1e-2f;
+        assert(xensiv_bgt60trxx_cfar_init(&cfar, &config, 96U, 32U, storage, sizeof(storage)) ==
+               XENSIV_BGT60TRXX_STATUS_OK);
+        uint32_t alarms = 0U;
+        for (uint32_t trial = 0; trial < 8U; ++trial) {
+            for (uint32_t i = 0; i < 96U * 32U; ++i) {
+                power[i] = (float) -log(((double) rand() + 1.0) / ((double) RAND_MAX + 2.0));
+            }
+            alarms += xensiv_bgt60trxx_cfar_process(&cfar, power, detections, 96U * 32U);
+        }
+        double rate = (double) alarms / (8.0 * 96.0 * 32.0);
+        assert((rate > 0.007) && (rate < 0.014));
+    }
+
+    // Invalid configurations
+    config.type = XENSIV_BGT60TRXX_CFAR_OS;
+    assert(xensiv_bgt60trxx_cfar_init(&cfar, &config, 96U, 32U, storage,
+                                      xensiv_bgt60trxx_cfar_storage_size(&config, 96U, 32U) -
+                                      1U) == XENSIV_BGT60TRXX_STATUS_DEV_ERROR);
+    config.os_rank = 1000U;
+    assert(xensiv_bgt60trxx_cfar_init(&cfar, &config, 96U, 32U, storage, sizeof(storage)) ==
+           XENSIV_BGT60TRXX_STATUS_DEV_ERROR);
+    config.os_rank = 0U;
+    config.pfa = 1.0f;
+    assert(xensiv_bgt60trxx_cfar_init(&cfar, &config, 96U, 32U, storage, sizeof(storage)) ==
+           XENSIV_BGT60TRXX_STATUS_DEV_ERROR);
+    config.pfa = 1e-2f;
+    assert(xensiv_bgt60trxx_cfar_init(&cfar, &config, 96U, 8U, storage, sizeof(storage)) ==
+           XENSIV_BGT60TRXX_STATUS_DEV_ERROR);
+    config.train[0] = 0U;
+    config.train[1] = 0U;
+    assert(xensiv_bgt60trxx_cfar_init(&cfar, &config, 96U, 32U, storage, sizeof(storage)) ==
+           XENSIV_BGT60TRXX_STATUS_DEV_ERROR);
+
+    printf("✓ CFAR detection test passed\n");
+    return 0;
+}
+
+// Snapshots of one plane wave from (az, el) on the given antennas, with a random phase each
+static void plane_wave(const xensiv_bgt60trxx_antenna_t *antennas,
+                       uint32_t num_rx,
+                       double az,
+                       double el,
+                       xensiv_bgt60trxx_complex_t *snapshots,
+                       uint32_t num_snapshots)
+{
+    const double pi = 3.14159265358979323846;
+
+    for (uint32_t k = 0; k < num_snapshots; ++k) {
+        double start = (2.0 * pi * rand()) / RAND_MAX;
+        for (uint32_t n = 0; n < num_rx; ++n) {
+            double phase = start + (2.0 * pi * ((antennas[n].x * sin(az) * cos(el)) +
+                                                (antennas[n].y * sin(el))));
+            snapshots[(k * num_rx) + n].re = (float) (cos(phase) + (0.01 * rand() / RAND_MAX));
+            snapshots[(k * num_rx) + n].im = (float) (sin(phase) + (0.01 * rand() / RAND_MAX));
+        }
+    }
+}
+
+/**
+ * @brief Test the angle estimators on plane waves and on a Doppler stage map
+ * @return 0 on success, non-zero on failure
+ */
+static int test_angle(void)
+{
+    printf("Testing angle of arrival...\n");
+
+    const float deg = 3.14159265f / 180.0f;
+    static const xensiv_bgt60trxx_angle_method_t methods[] = {XENSIV_BGT60TRXX_ANGLE_PHASE,
+                                                              XENSIV_BGT60TRXX_ANGLE_DBF,
+                                                              XENSIV_BGT60TRXX_ANGLE_CAPON};
+    static xensiv_bgt60trxx_complex_t storage[121 * 61 * 3];
+    static float spectra[2][121 * 61];
+    xensiv_bgt60trxx_complex_t snapshots[16 * 3];
+    xensiv_bgt60trxx_complex_t covariance[9];
+    xensiv_bgt60trxx_angle_estimate_t estimate;
+    xensiv_bgt60trxx_angle_t angle;
+
+    // L-shaped array with half wavelength baselines, 1 degree grid
+    xensiv_bgt60trxx_angle_config_t config = {
+        .method = XENSIV_BGT60TRXX_ANGLE_PHASE,
+        .num_rx = 3U,
+        .azimuth_min = -60.0f * deg,
+        .azimuth_max = 60.0f * deg,
+        .azimuth_steps = 121U,
+        .elevation_min = -30.0f * deg,
+        .elevation_max = 30.0f * deg,
+        .elevation_steps = 61U,
+        .neighbours = 1U,
+        .loading = 0.01f,
+        .antennas = {{0.0f, 0.0f}, {0.5f, 0.0f}, {0.0f, 0.5f}},
+    };
+    assert(xensiv_bgt60trxx_angle_storage_size(&config) == sizeof(storage));
+
+    srand(5);
+    plane_wave(config.antennas, 3U, 23.4 * deg, -11.7 * deg, snapshots, 16U);
+    for (size_t m = 0; m < sizeof(methods) / sizeof(methods[0]); ++m) {
+        config.method = methods[m];
+        assert(xensiv_bgt60trxx_angle_init(&angle, &config, storage, sizeof(storage)) ==
+               XENSIV_BGT60TRXX_STATUS_OK);
+        xensiv_bgt60trxx_angle_covariance(&angle, snapshots, 16U, covariance);
+        xensiv_bgt60trxx_angle_estimate(&angle, covariance, &estimate);
+        assert(fabsf(estimate.azimuth - (23.4f * deg)) < 0.5f * deg);
+        assert(fabsf(estimate.elevation + (11.7f * deg)) < 0.5f * deg);
+        if (methods[m] != XENSIV_BGT60TRXX_ANGLE_PHASE) {
+            xensiv_bgt60trxx_angle_spectrum(&angle, covariance, spectra[m - 1U]);
+        }
+    }
+
+    // Capon falls off faster than beamforming: 15 degrees off the peak at (23, -12) degrees
+    const uint32_t peak = (18U * 121U) + 83U;
+    assert((spectra[1][peak - 15U] / spectra[1][peak]) <
+           (0.5f * (spectra[0][peak - 15U] / spectra[0][peak])));
+
+    // End to end: a target in range bin 6 of every chirp, read back from the Doppler map
+    xensiv_bgt60trxx_frame_geometry_t geometry;
+    memset(&geometry, 0, sizeof(geometry));
+    geometry.shape_groups = 1U;
+    geometry.shapes[0] = (xensiv_bgt60trxx_shape_geometry_t){16U, 32U, 0x7U, 0U, 0U};
+    xensiv_bgt60trxx_assembler_t assembler;
+    assert(xensiv_bgt60trxx_assembler_init(&assembler, &geometry, XENSIV_BGT60TRXX_LAYOUT_PLANAR,
+                                           0U) == XENSIV_BGT60TRXX_STATUS_OK);
+    xensiv_bgt60trxx_range_config_t range_config = {
+        .window = XENSIV_BGT60TRXX_WINDOW_RECT,
+        .algo = XENSIV_BGT60TRXX_FFT_RADIX2,
+        .remove_dc = false,
+        .fft_size = 0U,
+    };
+    static uint8_t range_storage[4096];
+    xensiv_bgt60trxx_range_t range;
+    assert(xensiv_bgt60trxx_range_init(&range, &assembler, &range_config, range_storage,
+                                       sizeof(range_storage)) == XENSIV_BGT60TRXX_STATUS_OK);
+
+    static xensiv_bgt60trxx_complex_t profiles[3 * 16 * 16];
+    memset(profiles, 0, sizeof(profiles));
+    for (uint32_t c = 0; c < 16U; ++c) {
+        plane_wave(config.antennas, 3U, -35.0 * deg, 8.0 * deg, snapshots, 1U);
+        for (uint32_t r = 0; r < 3U; ++r) {
+            profiles[xensiv_bgt60trxx_range_profile_offset(&range, 0U, 0U, r, c) + 6U] =
+                snapshots[r];
+        }
+    }
+
+    xensiv_bgt60trxx_doppler_config_t doppler_config = {
+        .window = XENSIV_BGT60TRXX_WINDOW_RECT,
+        .algo = XENSIV_BGT60TRXX_FFT_RADIX2,
+        .clutter = XENSIV_BGT60TRXX_CLUTTER_NONE,
+        .fft_size = 0U,
+        .center_zero = false,
+        .tile_bins = 0U,
+    };
+    static uint8_t doppler_storage[8192];
+    static xensiv_bgt60trxx_complex_t map[3 * 16 * 16];
+    xensiv_bgt60trxx_doppler_t doppler;
+    assert(xensiv_bgt60trxx_doppler_init(&doppler, &range, &doppler_config, doppler_storage,
+                                         sizeof(doppler_storage)) == XENSIV_BGT60TRXX_STATUS_OK);
+    xensiv_bgt60trxx_doppler_process(&doppler, profiles, map, NULL);
+
+    // The random phase per chirp spreads the target over all Doppler bins of range bin 6
+    const xensiv_bgt60trxx_detection_t detections[2] = {{6U, 0U, 0.0f, 0.0f},
+                                                        {6U, 9U, 0.0f, 0.0f}};
+    xensiv_bgt60trxx_angle_estimate_t estimates[2];
+    for (size_t m = 0; m < sizeof(methods) / sizeof(methods[0]); ++m) {
+        config.method = methods[m];
+        assert(xensiv_bgt60trxx_angle_init(&angle, &config, storage, sizeof(storage)) ==
+               XENSIV_BGT60TRXX_STATUS_OK);
+        xensiv_bgt60trxx_angle_process(&angle, &doppler, map, 0U, 0U, detections, 2U, estimates);
+        for (uint32_t i = 0; i < 2U; ++i) {
+            assert(fabsf(estimates[i].azimuth + (35.0f * deg)) < 1.0f * deg);
+            assert(fabsf(estimates[i].elevation - (8.0f * deg)) < 1.0f * deg);
+        }
+    }
+
+    // Invalid configurations
+    assert(xensiv_bgt60trxx_angle_init(&angle, &config, storage, sizeof(storage) - 1U) ==
+           XENSIV_BGT60TRXX_STATUS_DEV_ERROR);
+    config.loading = 0.0f;
+    assert(xensiv_bgt60trxx_angle_init(&angle, &config, storage, sizeof(storage)) ==
+           XENSIV_BGT60TRXX_STATUS_DEV_ERROR);
+    config.method = XENSIV_BGT60TRXX_ANGLE_PHASE;
+    config.antennas[1] = (xensiv_bgt60trxx_antenna_t){0.5f, 0.5f};
+    config.antennas[2] = (xensiv_bgt60trxx_antenna_t){1.0f, 1.0f};
+    assert(xensiv_bgt60trxx_angle_init(&angle, &config, storage, sizeof(storage)) ==
+           XENSIV_BGT60TRXX_STATUS_DEV_ERROR);
+
+    printf("✓ Angle of arrival test passed\n");
+    return 0;
+}
+
+static const xensiv_bgt60trxx_track_t *find_track(const xensiv_bgt60trxx_tracker_t *tracker,
+                                                  uint32_t id)
+{
+    for (uint32_t t = 0; t < tracker->config.max_tracks; ++t) {
+        if ((tracker->tracks[t].state != XENSIV_BGT60TRXX_TRACK_FREE) &&
+            (tracker->tracks[t].id == id)) {
+            return &tracker->tracks[t];
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Test DBSCAN clustering, Kalman tracking and data association
+ * @return 0 on success, non-zero on failure
+ */
+static int test_tracker(void)
+{
+    printf("Testing multi-target tracker...\n");
+
+    static uint32_t storage[8192];
+    static xensiv_bgt60trxx_point_t points[64];
+    xensiv_bgt60trxx_tracker_t tracker;
+    xensiv_bgt60trxx_tracker_config_t config = {
+        .model = XENSIV_BGT60TRXX_MOTION_CV,
+        .association = XENSIV_BGT60TRXX_ASSOC_HUNGARIAN,
+        .max_points = 64U,
+        .max_clusters = 64U,
+        .max_tracks = 4U,
+        .cluster_eps = 0.5f,
+        .cluster_min_points = 3U,
+        .dt = 0.1f,
+        .process_noise = 0.5f,
+        .measurement_noise = 0.01f,
+        .initial_velocity_var = 4.0f,
+        .initial_accel_var = 4.0f,
+        .gate = 16.0f,
+        .confirm_hits = 3U,
+        .max_misses = 3U,
+    };
+    assert(xensiv_bgt60trxx_tracker_storage_size(&config) <= sizeof(storage));
+    assert(xensiv_bgt60trxx_tracker_init(&tracker, &config, storage, sizeof(storage)) ==
+           XENSIV_BGT60TRXX_STATUS_OK);
+
+    // Three blobs of five points, one border point of the first blob and two isolated points
+    static const float centres[3][2] = {{0.0f, 0.0f}, {5.0f, 0.0f}, {0.0f, 5.0f}};
+    static const float offsets[5][2] = {{0.0f, 0.0f}, {0.2f, 0.0f}, {-0.2f, 0.0f},
+                                        {0.0f, 0.2f}, {0.0f, -0.2f}};
+    uint32_t n = 0U;
+    for (uint32_t b = 0; b < 3U; ++b) {
+        for (uint32_t k = 0; k < 5U; ++k) {
+            points[n++] = (xensiv_bgt60trxx_point_t){centres[b][0] + offsets[k][0],
+                                                     centres[b][1] + offsets[k][1], 1.0f};
+        }
+    }
+    points[n++] = (xensiv_bgt60trxx_point_t){0.65f, 0.0f, 1.0f};
+    points[n++] = (xensiv_bgt60trxx_point_t){2.5f, 2.5f, 1.0f};
+    points[n++] = (xensiv_bgt60trxx_point_t){-3.0f, -3.0f, 1.0f};
+    assert(xensiv_bgt60trxx_tracker_cluster(&tracker, points, n) == 3U);
+    assert(tracker.clusters[0].num_points == 6U);
+    assert(tracker.clusters[1].num_points == 5U);
+    assert(tracker.clusters[2].num_points == 5U);
+    assert(fabsf(tracker.clusters[0].x - (0.65f / 6.0f)) < 1e-5f);
+    assert(fabsf(tracker.clusters[1].x - 5.0f) < 1e-5f);
+    assert(fabsf(tracker.clusters[2].y - 5.0f) < 1e-5f);
+    assert(fabsf(tracker.clusters[0].power - 6.0f) < 1e-5f);
+    assert((tracker.labels[15] == 0) && (tracker.labels[16] == -1) && (tracker.labels[17] == -1));
+
+    // With one point per core, clusters are the connected components of the eps graph
+    config.cluster_min_points = 1U;
+    assert(xensiv_bgt60trxx_tracker_init(&tracker, &config, storage, sizeof(storage)) ==
+           XENSIV_BGT60TRXX_STATUS_OK);
+    srand(11);
+    for (uint32_t i = 0; i < 64U; ++i) {
+        points[i] = (xensiv_bgt60trxx_point_t){(6.0f * rand() / RAND_MAX) - 3.0f,
+                                               6.0f * rand() / RAND_MAX, 1.0f};
+    }
+    uint32_t component[64];
+    for (uint32_t i = 0; i < 64U; ++i) {
+        component[i] = i;
+    }
+    for (int changed = 1; changed != 0;) {
+        changed = 0;
+        for (uint32_t i = 0; i < 64U; ++i) {
+            for (uint32_t j = 0; j < 64U; ++j) {
+                float dx = points[i].x - points[j].x;
+                float dy = points[i].y - points[j].y;
+                if ((((dx * dx) + (dy * dy)) <= 0.25f) && (component[j] < component[i])) {
+                    component[i] = component[j];
+                    changed = 1;
+                }
+            }
+        }
+    }
+    uint32_t num_components = 0U;
+    for (uint32_t i = 0; i < 64U; ++i) {
+        num_components += (component[i] == i) ? 1U : 0U;
+    }
+    assert(xensiv_bgt60trxx_tracker_cluster(&tracker, points, 64U) == num_components);
+    for (uint32_t i = 0; i < 64U; ++i) {
+        for (uint32_t j = 0; j < 64U; ++j) {
+            assert((component[i] == component[j]) == (tracker.labels[i] == tracker.labels[j]));
+        }
+    }
+
+    // Two targets passing 1.5 m apart keep their tracks with either model and association
+    config.cluster_min_points = 3U;
+    for (uint32_t m = 0; m < 4U; ++m) {
+        config.model = ((m & 1U) != 0U) ? XENSIV_BGT60TRXX_MOTION_CA : XENSIV_BGT60TRXX_MOTION_CV;
+        config.association = ((m & 2U) != 0U) ? XENSIV_BGT60TRXX_ASSOC_GNN
+                                              : XENSIV_BGT60TRXX_ASSOC_HUNGARIAN;
+        assert(xensiv_bgt60trxx_tracker_init(&tracker, &config, storage, sizeof(storage)) ==
+               XENSIV_BGT60TRXX_STATUS_OK);
+        for (uint32_t f = 0; f < 40U; ++f) {
+            const float t = (float) f * config.dt;
+            const float targets[2][2] = {{-3.0f + (2.0f * t), 1.0f}, {3.0f - (2.0f * t), 2.5f}};
+            n = 0U;
+            // Target B disappears after 30 frames
+            for (uint32_t k = 0; k < ((f < 30U) ? 2U : 1U); ++k) {
+                for (uint32_t p = 0; p < 4U; ++p) {
+                    points[n++] = (xensiv_bgt60trxx_point_t){
+                        targets[k][0] + offsets[p + 1U][0] * (float) (1U + (f % 3U)) * 0.5f,
+                        targets[k][1] + offsets[p + 1U][1], 1.0f};
+                }
+            }
+            xensiv_bgt60trxx_tracker_update(&tracker, points, n);
+
+            if (f == 29U) {
+                const xensiv_bgt60trxx_track_t *a = find_track(&tracker, 1U);
+                const xensiv_bgt60trxx_track_t *b = find_track(&tracker, 2U);
+                assert((a != NULL) && (b != NULL) && (tracker.next_id == 3U));
+                assert((a->state == XENSIV_BGT60TRXX_TRACK_CONFIRMED) && (a->hits == 30U));
+                assert(fabsf(a->x[0][0] - (-3.0f + (2.0f * t))) < 0.1f);
+                assert(fabsf(a->x[0][1] - 2.0f) < 0.3f);
+                assert(fabsf(a->x[1][1]) < 0.3f);
+                assert(fabsf(b->x[0][0] - (3.0f - (2.0f * t))) < 0.1f);
+                assert(fabsf(b->x[0][1] + 2.0f) < 0.3f);
+            }
+        }
+        // Deleted after max_misses frames without a detection
+        assert(find_track(&tracker, 2U) == NULL);
+        assert(find_track(&tracker, 1U)->age == 40U);
+        assert(tracker.next_id == 3U);
+    }
+
+    // Hungarian assigns both tracks where nearest first steals the closer track's detection
+    config.model = XENSIV_BGT60TRXX_MOTION_CV;
+    config.cluster_min_points = 1U;
+    config.cluster_eps = 0.2f;
+    config.process_noise = 1e-6f;
+    config.initial_velocity_var = 0.0f;
+    config.gate = 50.0f;
+    for (uint32_t m = 0; m < 2U; ++m) {
+        config.association = (m == 0U) ? XENSIV_BGT60TRXX_ASSOC_HUNGARIAN
+                                       : XENSIV_BGT60TRXX_ASSOC_GNN;
+        assert(xensiv_bgt60trxx_tracker_init(&tracker, &config, storage, sizeof(storage)) ==
+               XENSIV_BGT60TRXX_STATUS_OK);
+        points[0] = (xensiv_bgt60trxx_point_t){0.0f, 0.0f, 1.0f};
+        points[1] = (xensiv_bgt60trxx_point_t){1.0f, 0.0f, 1.0f};
+        xensiv_bgt60trxx_tracker_update(&tracker, points, 2U);
+        points[0].x = 0.6f;
+        points[1].x = 1.7f;
+        xensiv_bgt60trxx_tracker_update(&tracker, points, 2U);
+        if (m == 0U) {
+            // Squared distances 18 + 24.5 against 8 + 144.5, gain 0.5
+            assert(tracker.next_id == 3U);
+            assert(fabsf(find_track(&tracker, 1U)->x[0][0] - 0.3f) < 0.01f);
+            assert(fabsf(find_track(&tracker, 2U)->x[0][0] - 1.35f) < 0.01f);
+        } else {
+            // The tentative track 1 misses and a new track starts on the far detection
+            assert(tracker.next_id == 4U);
+            assert(find_track(&tracker, 1U) == NULL);
+            assert(fabsf(find_track(&tracker, 2U)->x[0][0] - 0.8f) < 0.01f);
+            assert(fabsf(find_track(&tracker, 3U)->x[0][0] - 1.7f) < 1e-5f);
+        }
+    }
+
+    // No track birth beyond the fixed number of slots
+    for (uint32_t i = 0; i < 6U; ++i) {
+        points[i] = (xensiv_bgt60trxx_point_t){(float) i, 0.0f, 1.0f};
+    }
+    assert(xensiv_bgt60trxx_tracker_init(&tracker, &config, storage, sizeof(storage)) ==
+           XENSIV_BGT60TRXX_STATUS_OK);
+    xensiv_bgt60trxx_tracker_update(&tracker, points, 6U);
+    assert(tracker.num_clusters == 6U);
+    assert(tracker.next_id == 5U);
+    for (uint32_t t = 0; t < config.max_tracks; ++t) {
+        assert(tracker.tracks[t].state == XENSIV_BGT60TRXX_TRACK_TENTATIVE);
+    }
+    xensiv_bgt60trxx_tracker_update(&tracker, NULL, 0U);
+    assert(find_track(&tracker, 1U) == NULL);
+
+    // Invalid configurations
+    assert(xensiv_bgt60trxx_tracker_init(&tracker, &config, storage,
+                                         xensiv_bgt60trxx_tracker_storage_size(&config) - 1U) ==
+           XENSIV_BGT60TRXX_STATUS_DEV_ERROR);
+    config.cluster_eps = 0.0f;
+    assert(xensiv_bgt60trxx_tracker_init(&tracker, &config, storage, sizeof(storage)) ==
+           XENSIV_BGT60TRXX_STATUS_DEV_ERROR);
+    config.cluster_eps = 0.5f;
+    config.max_tracks = 0U;
+    assert(xensiv_bgt60trxx_tracker_init(&tracker, &config, storage, sizeof(storage)) ==
+           XENSIV_BGT60TRXX_STATUS_DEV_ERROR);
+
+    printf("✓ Multi-target tracker test passed\n");
+    return 0;
+}
+
+#ifdef __linux__
+#define RING_STRESS_FRAMES (50000U)
+#define RING_STRESS_SAMPLES (16U)
+
+static void *ring_stress_producer(void *arg)
+{
+    xensiv_bgt60trxx_ring_t *ring = arg;
+
+    // Retry on a full ring so that every frame goes through the ring
+    for (uint32_t seq = 0; seq < RING_STRESS_FRAMES; ++seq) {
+        xensiv_bgt60trxx_frame_t *frame;
+        while ((frame = xensiv_bgt60trxx_ring_write_begin(ring)) == NULL) {
+            sched_yield();
+        }
+
+        for (uint32_t i = 0; i < RING_STRESS_SAMPLES; ++i) {
+            frame->samples[i] = (uint16_t) (seq + i);
+        }
+        frame->num_samples = RING_STRESS_SAMPLES;
+        frame->seq = seq;
+        xensiv_bgt60trxx_ring_write_commit(ring);
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Test the frame ring with a concurrent producer and consumer
+ * @return 0 on success, non-zero on failure
+ */
+static int test_frame_ring_threads(void)
+{
+    printf("Testing SPSC frame ring with two threads...\n");
+
+    static xensiv_bgt60trxx_ring_t ring;
+    static xensiv_bgt60trxx_frame_t slots[8];
+    static uint16_t storage[8 * RING_STRESS_SAMPLES];
+    xensiv_bgt60trxx_ring_init(&ring, slots, 8U, storage, RING_STRESS_SAMPLES);
+
+    pthread_t producer;
+    assert(pthread_create(&producer, NULL, ring_stress_producer, &ring) == 0);
+
+    // Every frame must arrive complete and in order
+    uint32_t received = 0;
+    while (received < RING_STRESS_FRAMES) {
+        const xensiv_bgt60trxx_frame_t *frame = xensiv_bgt60trxx_ring_read_acquire(&ring);
+        if (frame == NULL) {
+            sched_yield();
+            continue;
+        }
+
+        assert(frame->seq == received);
+        assert(frame->num_samples == RING_STRESS_SAMPLES);
+        for (uint32_t i = 0; i < RING_STRESS_SAMPLES; ++i) {
+            assert(frame->samples[i] == (uint16_t) (frame->seq + i));
+        }
+        ++received;
+        xensiv_bgt60trxx_ring_read_release(&ring);
+    }
+
+    pthread_join(producer, NULL);
+    assert(xensiv_bgt60trxx_ring_read_acquire(&ring) == NULL);
+
+    printf("✓ SPSC frame ring with two threads test passed\n");
+    return 0;
+}
+
+/* Linux interface without any open device, as left by deinit */
+static void init_linux_iface(xensiv_bgt60trxx_linux_t *iface)
+{
+    memset(iface, 0, sizeof(*iface));
+    iface->spi_fd = -1;
+    iface->gpio_chip_fd = -1;
+    iface->rst_gpio_fd = -1;
+    iface->cs_gpio_fd = -1;
+    iface->irq_gpio_fd = -1;
+}
+
+/**
+ * @brief Test that the Linux FIFO transfer buffers are allocated once and then reused
+ * @return 0 on success, non-zero on failure
+ */
+static int test_linux_fifo_buffers(void)
+{
+    printf("Testing Linux FIFO transfer buffers...\n");
+
+    xensiv_bgt60trxx_linux_t iface;
+    init_linux_iface(&iface);
+
+    assert(xensiv_bgt60trxx_linux_alloc_buffers(&iface, 2048U, false) ==
+           XENSIV_BGT60TRXX_STATUS_OK);
+    assert(iface.buf_allocs == 1U);
+    assert(iface.buf_size >= 2048U * XENSIV_BGT60TRXX_FIFO_WORD_SIZE_BYTES);
+    assert(((uintptr_t) iface.tx_buf % 4096U) == 0U);
+    assert(iface.tx_buf[iface.buf_size - 1U] == 0xFFU);
+
+    // Reads up to the allocated size reuse the buffers, a larger one grows them once
+    uint8_t *tx_buf = iface.tx_buf;
+    for (int i = 0; i < 4; ++i) {
+        assert(xensiv_bgt60trxx_linux_alloc_buffers(&iface, 1024U, false) ==
+               XENSIV_BGT60TRXX_STATUS_OK);
+    }
+    assert((iface.buf_allocs == 1U) && (iface.tx_buf == tx_buf));
+    for (int i = 0; i < 4; ++i) {
+        assert(xensiv_bgt60trxx_linux_alloc_buffers(&iface, 8192U, false) ==
+               XENSIV_BGT60TRXX_STATUS_OK);
+    }
+    assert(iface.buf_allocs == 2U);
+    assert(iface.buf_size >= 8192U * XENSIV_BGT60TRXX_FIFO_WORD_SIZE_BYTES);
+    assert(iface.tx_buf[iface.buf_size - 1U] == 0xFFU);
+
+    // deinit releases the buffers
+    xensiv_bgt60trxx_linux_deinit(&iface);
+    assert((iface.tx_buf == NULL) && (iface.rx_buf == NULL) && (iface.buf_size == 0U));
+
+    printf("✓ Linux FIFO transfer buffers test passed\n");
+    return 0;
+}
+
+/* spidev check of a message: each transfer rounded up to ARCH_DMA_MINALIGN, summed */
+static uint32_t spidev_aligned_len(uint32_t len)
+{
+    return ((len + 127U) / 128U) * 128U;
+}
+
+/**
+ * @brief Test the split of FIFO reads into messages that spidev accepts
+ * @return 0 on success, non-zero on failure
+ */
+static int test_linux_fifo_chunks(void)
+{
+    printf("Testing Linux FIFO read chunks...\n");
+
+    xensiv_bgt60trxx_linux_t iface;
+    init_linux_iface(&iface);
+
+    // Default bufsiz: the header costs a whole alignment unit of the first message
+    iface.spi_bufsiz = 4096U;
+    assert(xensiv_bgt60trxx_linux_fifo_chunk_size(&iface, true) == 3968U);
+    assert(xensiv_bgt60trxx_linux_fifo_chunk_size(&iface, false) == 4096U);
+
+    // A full 8192 word FIFO read: every message fits once spidev has aligned its transfers
+    const uint32_t bufsizes[] = {4096U, 5000U, 8192U, 65536U};
+    for (uint32_t b = 0; b < sizeof(bufsizes) / sizeof(bufsizes[0]); ++b) {
+        iface.spi_bufsiz = bufsizes[b];
+        uint32_t offset = 0U;
+        uint32_t num_messages = 0U;
+        while (offset < 8192U * XENSIV_BGT60TRXX_FIFO_WORD_SIZE_BYTES) {
+            bool header = (offset == 0U);
+            uint32_t chunk = xensiv_bgt60trxx_linux_fifo_chunk_size(&iface, header);
+            uint32_t remaining = (8192U * XENSIV_BGT60TRXX_FIFO_WORD_SIZE_BYTES) - offset;
+            chunk = (chunk < remaining) ? chunk : remaining;
+            assert((header ? spidev_aligned_len(XENSIV_BGT60TRXX_SPI_BURST_HEADER_SIZE_BYTES)
+                           : 0U) + spidev_aligned_len(chunk) <= bufsizes[b]);
+            offset += chunk;
+            ++num_messages;
+        }
+        // 24 KiB at bufsiz 4096: 3968 bytes after the header, five full 4096 byte chunks, 128
+        assert((bufsizes[b] != 4096U) || (num_messages == 7U));
+    }
+    iface.spi_bufsiz = 5000U;
+    assert(xensiv_bgt60trxx_linux_fifo_chunk_size(&iface, true) == 4864U);
+    assert(xensiv_bgt60trxx_linux_fifo_chunk_size(&iface, false) == 4992U);
+
+    // Below one alignment unit the plain byte budget is all there is
+    iface.spi_bufsiz = 64U;
+    assert(xensiv_bgt60trxx_linux_fifo_chunk_size(&iface, true) == 60U);
+    assert(xensiv_bgt60trxx_linux_fifo_chunk_size(&iface, false) == 64U);
+
+    printf("✓ Linux FIFO read chunks test passed\n");
+    return 0;
+}
+
+/**
+ * @brief Test IRQ event waiting with a pipe standing in for the GPIO line event fd
+ * @return 0 on success, non-zero on failure
+ */
+static int test_linux_irq_events(void)
+{
+    printf("Testing Linux IRQ event handling...\n");
+
+    xensiv_bgt60trxx_linux_t iface;
+    init_linux_iface(&iface);
+
+    uint64_t timestamp = 0;
+    assert(xensiv_bgt60trxx_linux_get_irq_fd(&iface) == -1);
+    assert(xensiv_bgt60trxx_linux_wait_fifo(&iface, 0, &timestamp) ==
+           XENSIV_BGT60TRXX_STATUS_COM_ERROR);
+
+    int fds[2];
+    assert(pipe(fds) == 0);
+    iface.irq_gpio_fd = fds[0];
+    assert(xensiv_bgt60trxx_linux_get_irq_fd(&iface) == fds[0]);
+
+    // Nothing pending
+    assert(xensiv_bgt60trxx_linux_wait_fifo(&iface, 0, &timestamp) ==
+           XENSIV_BGT60TRXX_STATUS_TIMEOUT_ERROR);
+
+    // Two queued rising edges are consumed one at a time, in order
+    struct gpio_v2_line_event events[2];
+    memset(events, 0, sizeof(events));
+    events[0].timestamp_ns = 1000U;
+    events[0].id = GPIO_V2_LINE_EVENT_RISING_EDGE;
+    events[1].timestamp_ns = 2000U;
+    events[1].id = GPIO_V2_LINE_EVENT_RISING_EDGE;
+    assert(write(fds[1], events, sizeof(events)) == (ssize_t) sizeof(events));
+
+    assert(xensiv_bgt60trxx_linux_wait_fifo(&iface, 100, &timestamp) ==
+           XENSIV_BGT60TRXX_STATUS_OK);
+    assert(timestamp == 1000U);
+    assert(xensiv_bgt60trxx_linux_wait_fifo(&iface, 100, NULL) == XENSIV_BGT60TRXX_STATUS_OK);
+    assert(xensiv_bgt60trxx_linux_wait_fifo(&iface, 0, &timestamp) ==
+           XENSIV_BGT60TRXX_STATUS_TIMEOUT_ERROR);
+
+    // deinit releases the IRQ line fd
+    close(fds[1]);
+    xensiv_bgt60trxx_linux_deinit(&iface);
+    assert(fcntl(fds[0], F_GETFD) == -1);
+
+    printf("✓ Linux IRQ event handling test passed\n");
+    return 0;
+}
+
+static uint64_t elapsed_us(const struct timespec *start)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    int64_t ns = ((int64_t) (now.tv_sec - start->tv_sec) * 1000000000) +
+                 (int64_t) (now.tv_nsec - start->tv_nsec);
+    return (uint64_t) (ns / 1000);
+}
+
+/**
+ * @brief Test that the microsecond delay never returns early, spinning or sleeping
+ * @return 0 on success, non-zero on failure
+ */
+static int test_linux_delay_us(void)
+{
+    printf("Testing Linux microsecond delay...\n");
+
+    static const uint32_t delays_us[] = {0U, 1U, 20U, 200U, 2000U};
+    for (uint32_t i = 0; i < sizeof(delays_us) / sizeof(delays_us[0]); ++i) {
+        struct timespec start;
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        xensiv_bgt60trxx_platform_delay_us(delays_us[i]);
+        uint64_t waited = elapsed_us(&start);
+        assert(waited >= delays_us[i]);
+        assert(waited < (uint64_t) delays_us[i] + 1000000U);
+    }
+
+    printf("✓ Linux microsecond delay test passed\n");
+    return 0;
+}
+
+/**
+ * @brief Test the fill level prediction of the FIFO polling scheduler
+ * @return 0 on success, non-zero on failure
+ */
+static int test_linux_fifo_sched(void)
+{
+    printf("Testing Linux FIFO polling scheduler...\n");
+
+    const xensiv_bgt60trxx_linux_sched_config_t config = {
+        .cref_samples = 1000U,
+        .lead_us = 100U,
+        .min_sleep_us = 10U,
+        .fallback_us = 1000U,
+    };
+    xensiv_bgt60trxx_linux_sched_t sched;
+    assert(xensiv_bgt60trxx_linux_sched_init(&sched, &config) == XENSIV_BGT60TRXX_STATUS_OK);
+    assert(fcntl(sched.timer_fd, F_GETFD) != -1);
+
+    // Rate unknown: poll with the fallback period
+    const uint64_t t0 = 1000000000ULL;
+    assert(xensiv_bgt60trxx_linux_sched_observe(&sched, t0, 0U) == t0 + 1000000U);
+
+    // 100 samples in 1ms: 100k samples/s, 900 samples to go in 9ms, minus the lead
+    uint64_t wake = xensiv_bgt60trxx_linux_sched_observe(&sched, t0 + 1000000U, 100U);
+    assert(wake == t0 + 1000000U + 9000000U - 100000U);
+
+    // A read at the predicted time finds the data late by the lead, the rate holds
+    wake = xensiv_bgt60trxx_linux_sched_observe(&sched, wake, 990U);
+    assert(wake >= t0 + 9900000U + 10000U && wake <= t0 + 9900000U + 20000U);
+
+    // Reaching the limit asks for an immediate read, consumption moves the anchor back
+    assert(xensiv_bgt60trxx_linux_sched_observe(&sched, t0 + 10000000U, 1000U) ==
+           t0 + 10000000U);
+    xensiv_bgt60trxx_linux_sched_consumed(&sched, 1000U);
+    assert(sched.last_fill == 0U);
+
+    // A faster producer is picked up gradually, never overshooting the observation
+    for (uint32_t i = 1; i <= 50U; ++i) {
+        (void) xensiv_bgt60trxx_linux_sched_observe(&sched, t0 + 10000000U + (i * 1000000U),
+                                                    i * 200U);
+    }
+    xensiv_bgt60trxx_linux_sched_stats_t stats;
+    xensiv_bgt60trxx_linux_sched_get_stats(&sched, &stats);
+    assert(stats.rate_sps > 195000.0 && stats.rate_sps <= 200000.0);
+    assert(stats.reads == 54U && stats.late_samples == 9000U);
+
+    xensiv_bgt60trxx_linux_sched_deinit(&sched);
+    assert(sched.timer_fd == -1);
+
+    printf("✓ Linux FIFO polling scheduler test passed\n");
+    return 0;
+}
+#endif
+
 /**
  * @brief Main test function
  * @return 0 on success, non-zero on failure
@@ -147,6 +1863,27 @@ int main(void)
     result |= test_reset_commands();
     result |= test_structure_init();
     result |= test_function_availability();
+    result |= test_fifo_unpack();
+    result |= test_data_test_bit_errors();
+    result |= test_frame_ring();
+    result |= test_cref_controller();
+    result |= test_frame_geometry();
+    result |= test_budget();
+    result |= test_frame_assembler();
+    result |= test_fft();
+    result |= test_range_stage();
+    result |= test_doppler();
+    result |= test_cfar();
+    result |= test_angle();
+    result |= test_tracker();
+#ifdef __linux__
+    result |= test_linux_fifo_buffers();
+    result |= test_linux_fifo_chunks();
+    result |= test_linux_irq_events();
+    result |= test_linux_delay_us();
+    result |= test_linux_fifo_sched();
+    result |= test_frame_ring_threads();
+#endif
 
     if (result == 0) {
         printf("\n✓ All integration tests passed!\n");
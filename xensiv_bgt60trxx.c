@@ -26,20 +26,16 @@
 #include "xensiv_bgt60trxx.h"
 
 #include <stddef.h>
+#include <string.h>
 
 #include "xensiv_bgt60trxx_platform.h"
 
 #define XENSIV_BGT60TRXX_SPI_REG_XFER_LEN_BYTES (4U)
-#define XENSIV_BGT60TRXX_SOFT_RESET_DELAY_MS (10U)
 
 #define XENSIV_BGT60TRXX_SPI_WR_OP_MSK (0x01000000UL)
 #define XENSIV_BGT60TRXX_SPI_WR_OP_POS (24U)
 #define XENSIV_BGT60TRXX_SPI_GSR0_MSK (0x0F000000UL)
 #define XENSIV_BGT60TRXX_SPI_GSR0_POS (24U)
-#define XENSIV_BGT60TRXX_SPI_REGADR_MSK (0xFE000000UL)
-#define XENSIV_BGT60TRXX_SPI_REGADR_POS (25U)
-#define XENSIV_BGT60TRXX_SPI_DATA_MSK (0x00FFFFFFUL)
-#define XENSIV_BGT60TRXX_SPI_DATA_POS (0U)
 #define XENSIV_BGT60TRXX_SPI_BURST_MODE_CMD (0xFF000000UL)
 #define XENSIV_BGT60TRXX_SPI_BURST_MODE_SADR_MSK (0x00FE0000UL)
 #define XENSIV_BGT60TRXX_SPI_BURST_MODE_SADR_POS (17U)
@@ -48,24 +44,274 @@
 #define XENSIV_BGT60TRXX_SPI_BURST_MODE_LEN_MSK (0x0000FE00UL)
 #define XENSIV_BGT60TRXX_SPI_BURST_MODE_LEN_POS (9U)
 
+#define XENSIV_BGT60TRXX_NUM_REG_ADDR (128U) /* 7-bit register address space */
+
+#if (XENSIV_BGT60TRXX_SPI_BURST_MAX_REGS < 2U) || (XENSIV_BGT60TRXX_SPI_BURST_MAX_REGS > 127U)
+    #error "XENSIV_BGT60TRXX_SPI_BURST_MAX_REGS must fit the 7-bit burst LEN field"
+#endif
+
 
 struct xensiv_bgt60trxx_type {
     uint32_t fifo_addr;
+    uint32_t fstat_addr; /* not always next to the FIFO, see the UTR13D */
     uint16_t fifo_size;
     xensiv_bgt60trxx_device_t device;
 };
 
 static const struct xensiv_bgt60trxx_type bgt60trxx_types[] = {
     {.fifo_addr = XENSIV_BGT60TRXX_REG_FIFO_TR13C,
+     .fstat_addr = XENSIV_BGT60TRXX_REG_FSTAT_TR13C,
      .fifo_size = 8192U,
      .device = XENSIV_DEVICE_BGT60TR13C},
     {.fifo_addr = XENSIV_BGT60TRXX_REG_FIFO_UTR13D,
+     .fstat_addr = XENSIV_BGT60TRXX_REG_FSTAT_UTR13D,
      .fifo_size = 8192U,
      .device = XENSIV_DEVICE_BGT60UTR13D},
     {.fifo_addr = XENSIV_BGT60TRXX_REG_FIFO_UTR11,
+     .fstat_addr = XENSIV_BGT60TRXX_REG_FSTAT_UTR11,
      .fifo_size = 2048U,
      .device = XENSIV_DEVICE_BGT60UTR11}};
 
+/* Register shadow: only writable registers are cached, the self-clearing MAIN bits never are */
+#define XENSIV_BGT60TRXX_SHADOW_MAIN_VOLATILE_MSK \
+    (XENSIV_BGT60TRXX_REG_MAIN_FRAME_START_MSK | XENSIV_BGT60TRXX_REG_MAIN_RESET_MSK)
+
+static bool shadow_cacheable(uint32_t reg_addr)
+{
+    return (reg_addr < XENSIV_BGT60TRXX_SHADOW_NUM_REGS) &&
+           (reg_addr != XENSIV_BGT60TRXX_REG_CHIP_ID) && (reg_addr != XENSIV_BGT60TRXX_REG_STAT1);
+}
+
+
+static void shadow_store(const xensiv_bgt60trxx_t *dev, uint32_t reg_addr, uint32_t data)
+{
+    xensiv_bgt60trxx_shadow_t *shadow = dev->shadow;
+
+    if ((shadow != NULL) && shadow_cacheable(reg_addr)) {
+        if (reg_addr == XENSIV_BGT60TRXX_REG_MAIN) {
+            data &= (uint32_t) ~XENSIV_BGT60TRXX_SHADOW_MAIN_VOLATILE_MSK;
+        }
+
+        shadow->regs[reg_addr] = data & XENSIV_BGT60TRXX_SPI_DATA_MSK;
+        shadow->valid[reg_addr / 32U] |= (1UL << (reg_addr % 32U));
+    }
+}
+
+
+/* Register read for read-modify-write operations, served from the shadow when possible */
+static int32_t get_reg_cached(const xensiv_bgt60trxx_t *dev, uint32_t reg_addr, uint32_t *data)
+{
+    xensiv_bgt60trxx_shadow_t *shadow = dev->shadow;
+    int32_t status = XENSIV_BGT60TRXX_STATUS_OK;
+
+    if ((shadow != NULL) && shadow_cacheable(reg_addr) &&
+        ((shadow->valid[reg_addr / 32U] & (1UL << (reg_addr % 32U))) != 0U)) {
+        *data = shadow->regs[reg_addr];
+        ++shadow->hits;
+    } else {
+        status = xensiv_bgt60trxx_get_reg(dev, reg_addr, data);
+        if (shadow != NULL) {
+            ++shadow->misses;
+            if (XENSIV_BGT60TRXX_STATUS_OK == status) {
+                shadow_store(dev, reg_addr, *data);
+            }
+        }
+    }
+
+    return status;
+}
+
+
+static int32_t write_regs_burst(const xensiv_bgt60trxx_t *dev,
+                                uint32_t start_addr,
+                                const uint32_t *data,
+                                uint32_t count)
+{
+    uint8_t buf[XENSIV_BGT60TRXX_SPI_BURST_HEADER_SIZE_BYTES +
+                (XENSIV_BGT60TRXX_SPI_BURST_MAX_REGS * XENSIV_BGT60TRXX_FIFO_WORD_SIZE_BYTES)];
+
+    uint32_t header = XENSIV_BGT60TRXX_SPI_BURST_MODE_CMD |
+                      ((start_addr << XENSIV_BGT60TRXX_SPI_BURST_MODE_SADR_POS) &
+                       XENSIV_BGT60TRXX_SPI_BURST_MODE_SADR_MSK) |
+                      XENSIV_BGT60TRXX_SPI_BURST_MODE_RWB_MSK |
+                      ((count << XENSIV_BGT60TRXX_SPI_BURST_MODE_LEN_POS) &
+                       XENSIV_BGT60TRXX_SPI_BURST_MODE_LEN_MSK);
+    header = xensiv_bgt60trxx_platform_word_reverse(header);
+    memcpy(buf, &header, XENSIV_BGT60TRXX_SPI_BURST_HEADER_SIZE_BYTES);
+
+    /* Register payloads follow the header as 24-bit words, MSB first */
+    uint8_t *p = &buf[XENSIV_BGT60TRXX_SPI_BURST_HEADER_SIZE_BYTES];
+    for (uint32_t i = 0; i < count; ++i) {
+        *p++ = (uint8_t) (data[i] >> 16);
+        *p++ = (uint8_t) (data[i] >> 8);
+        *p++ = (uint8_t) data[i];
+    }
+
+    xensiv_bgt60trxx_platform_spi_cs_set(dev->iface, false);
+    int32_t status =
+        xensiv_bgt60trxx_platform_spi_transfer(dev->iface, buf, NULL, (uint32_t) (p - buf));
+    xensiv_bgt60trxx_platform_spi_cs_set(dev->iface, true);
+
+    if (XENSIV_BGT60TRXX_STATUS_OK == status) {
+        for (uint32_t i = 0; i < count; ++i) {
+            shadow_store(dev, start_addr + i, data[i]);
+        }
+    }
+
+    return status;
+}
+
+
+static int32_t read_regs_burst(const xensiv_bgt60trxx_t *dev,
+                               uint32_t start_addr,
+                               uint32_t *data,
+                               uint32_t count,
+                               uint8_t *gsr0)
+{
+    uint8_t tx_buf[XENSIV_BGT60TRXX_SPI_BURST_HEADER_SIZE_BYTES +
+                   (XENSIV_BGT60TRXX_SPI_BURST_MAX_REGS * XENSIV_BGT60TRXX_FIFO_WORD_SIZE_BYTES)];
+    uint8_t rx_buf[sizeof(tx_buf)];
+    uint32_t xfer_len = XENSIV_BGT60TRXX_SPI_BURST_HEADER_SIZE_BYTES +
+                        (count * XENSIV_BGT60TRXX_FIFO_WORD_SIZE_BYTES);
+
+    uint32_t header = XENSIV_BGT60TRXX_SPI_BURST_MODE_CMD |
+                      ((start_addr << XENSIV_BGT60TRXX_SPI_BURST_MODE_SADR_POS) &
+                       XENSIV_BGT60TRXX_SPI_BURST_MODE_SADR_MSK) |
+                      ((count << XENSIV_BGT60TRXX_SPI_BURST_MODE_LEN_POS) &
+                       XENSIV_BGT60TRXX_SPI_BURST_MODE_LEN_MSK);
+    header = xensiv_bgt60trxx_platform_word_reverse(header);
+    memcpy(tx_buf, &header, XENSIV_BGT60TRXX_SPI_BURST_HEADER_SIZE_BYTES);
+    memset(&tx_buf[XENSIV_BGT60TRXX_SPI_BURST_HEADER_SIZE_BYTES],
+           0xFF,
+           xfer_len - XENSIV_BGT60TRXX_SPI_BURST_HEADER_SIZE_BYTES);
+
+    xensiv_bgt60trxx_platform_spi_cs_set(dev->iface, false);
+    int32_t status = xensiv_bgt60trxx_platform_spi_transfer(dev->iface, tx_buf, rx_buf, xfer_len);
+    xensiv_bgt60trxx_platform_spi_cs_set(dev->iface, true);
+
+    if (XENSIV_BGT60TRXX_STATUS_OK == status) {
+        const uint8_t *p = &rx_buf[XENSIV_BGT60TRXX_SPI_BURST_HEADER_SIZE_BYTES];
+        for (uint32_t i = 0; i < count; ++i) {
+            data[i] = ((uint32_t) p[0] << 16) | ((uint32_t) p[1] << 8) | (uint32_t) p[2];
+            p += XENSIV_BGT60TRXX_FIFO_WORD_SIZE_BYTES;
+        }
+
+        if (gsr0 != NULL) {
+            *gsr0 = rx_buf[0];
+        }
+    }
+
+    return status;
+}
+
+
+/* Writes a run of consecutive registers, single writes are cheaper than a one-register burst */
+static int32_t write_regs(const xensiv_bgt60trxx_t *dev,
+                          uint32_t start_addr,
+                          const uint32_t *data,
+                          uint32_t count)
+{
+    int32_t status = XENSIV_BGT60TRXX_STATUS_OK;
+
+    if (count == 1U) {
+        status = xensiv_bgt60trxx_set_reg(dev, start_addr, data[0]);
+    } else if (count > 1U) {
+        status = write_regs_burst(dev, start_addr, data, count);
+    }
+
+    return status;
+}
+
+
+static uint32_t config_reg_addr(uint32_t val)
+{
+    return (val & XENSIV_BGT60TRXX_SPI_REGADR_MSK) >> XENSIV_BGT60TRXX_SPI_REGADR_POS;
+}
+
+
+static uint32_t config_reg_data(uint32_t val)
+{
+    return (val & XENSIV_BGT60TRXX_SPI_DATA_MSK) >> XENSIV_BGT60TRXX_SPI_DATA_POS;
+}
+
+
+/* Register value without the bits this library manages itself, used to compare profiles */
+static uint32_t normalize_reg_value(uint32_t reg_addr, uint32_t reg_data)
+{
+    if (reg_addr == XENSIV_BGT60TRXX_REG_MAIN) {
+        reg_data &= (uint32_t) ~XENSIV_BGT60TRXX_SHADOW_MAIN_VOLATILE_MSK;
+    } else if (reg_addr == XENSIV_BGT60TRXX_REG_SFCTL) {
+        reg_data &= (uint32_t) ~(XENSIV_BGT60TRXX_REG_SFCTL_FIFO_CREF_MSK |
+                                 XENSIV_BGT60TRXX_REG_SFCTL_MISO_HS_READ_MSK);
+    } else {
+        /* Other registers are compared as they are */
+    }
+
+    return reg_data;
+}
+
+
+/* Writes the configurator register list, only the addresses set in write_mask if not NULL.
+   Consecutive addresses are coalesced into burst writes. SFCTL gets the given FIFO limit and
+   the high speed mode of the device. */
+static int32_t write_reg_list(const xensiv_bgt60trxx_t *dev,
+                              const uint32_t *regs,
+                              uint32_t len,
+                              const uint32_t *write_mask,
+                              uint32_t sfctl_cref)
+{
+    int32_t status = XENSIV_BGT60TRXX_STATUS_OK;
+    uint32_t run_data[XENSIV_BGT60TRXX_SPI_BURST_MAX_REGS];
+    uint32_t run_addr = 0U;
+    uint32_t run_len = 0U;
+
+    for (uint32_t reg_idx = 0; reg_idx < len; ++reg_idx) {
+        uint32_t reg_addr = config_reg_addr(regs[reg_idx]);
+        uint32_t reg_data = config_reg_data(regs[reg_idx]);
+
+        if ((write_mask != NULL) &&
+            ((write_mask[reg_addr / 32U] & (1UL << (reg_addr % 32U))) == 0U)) {
+            continue;
+        }
+
+        if (reg_addr == XENSIV_BGT60TRXX_REG_SFCTL) {
+            reg_data &= (uint32_t) ~XENSIV_BGT60TRXX_REG_SFCTL_FIFO_CREF_MSK;
+            reg_data |= sfctl_cref & XENSIV_BGT60TRXX_REG_SFCTL_FIFO_CREF_MSK;
+            if (dev->high_speed) {
+                reg_data |= (uint32_t) XENSIV_BGT60TRXX_REG_SFCTL_MISO_HS_READ_MSK;
+            } else {
+                reg_data &= (uint32_t) ~XENSIV_BGT60TRXX_REG_SFCTL_MISO_HS_READ_MSK;
+            }
+
+            /* SFCTL controls the SPI read timing, never change it in the middle of a burst */
+            status = write_regs(dev, run_addr, run_data, run_len);
+            run_len = 0U;
+            if (XENSIV_BGT60TRXX_STATUS_OK == status) {
+                status = xensiv_bgt60trxx_set_reg(dev, reg_addr, reg_data);
+            }
+        } else if ((run_len > 0U) && (reg_addr == (run_addr + run_len)) &&
+                   (run_len < XENSIV_BGT60TRXX_SPI_BURST_MAX_REGS)) {
+            run_data[run_len++] = reg_data;
+        } else {
+            status = write_regs(dev, run_addr, run_data, run_len);
+            run_addr = reg_addr;
+            run_data[0] = reg_data;
+            run_len = 1U;
+        }
+
+        if (status != XENSIV_BGT60TRXX_STATUS_OK) {
+            break;
+        }
+    }
+
+    if (XENSIV_BGT60TRXX_STATUS_OK == status) {
+        status = write_regs(dev, run_addr, run_data, run_len);
+    }
+
+    return status;
+}
+
+
 static xensiv_bgt60trxx_device_t detect_device_type(uint32_t chipid)
 {
     uint32_t chip_id_digital = (chipid & XENSIV_BGT60TRXX_REG_CHIP_ID_DIGITAL_ID_MSK) >>
@@ -97,6 +343,7 @@ int32_t xensiv_bgt60trxx_init(xensiv_bgt60trxx_t *dev, void *iface, bool high_sp
 
     dev->iface = iface;
     dev->high_speed = high_speed;
+    dev->shadow = NULL;
 
     // xensiv_bgt60trxx_hard_reset(dev);
 
@@ -136,32 +383,175 @@ int32_t xensiv_bgt60trxx_config(xensiv_bgt60trxx_t *dev, const uint32_t *regs, u
     int32_t status = xensiv_bgt60trxx_soft_reset(dev, XENSIV_BGT60TRXX_RESET_SW);
 
     if (XENSIV_BGT60TRXX_STATUS_OK == status) {
-        /* Apply register configuration */
+        /* FIFO limit set by user */
+        status = write_reg_list(dev, regs, len, NULL, 0U);
+    }
+
+    return status;
+}
+
+
+int32_t xensiv_bgt60trxx_reconfig(xensiv_bgt60trxx_t *dev,
+                                  const uint32_t *old_regs,
+                                  const uint32_t *new_regs,
+                                  uint32_t len)
+{
+    xensiv_bgt60trxx_platform_assert(dev != NULL);
+    xensiv_bgt60trxx_platform_assert(new_regs != NULL);
+
+    uint32_t old_val[XENSIV_BGT60TRXX_NUM_REG_ADDR];
+    uint32_t known[XENSIV_BGT60TRXX_NUM_REG_ADDR / 32U] = {0U};
+    uint32_t changed[XENSIV_BGT60TRXX_NUM_REG_ADDR / 32U] = {0U};
+
+    /* Current register values: the previous profile, else the shadow, else unknown */
+    if (old_regs != NULL) {
         for (uint32_t reg_idx = 0; reg_idx < len; ++reg_idx) {
-            uint32_t val = regs[reg_idx];
-            uint32_t reg_addr =
-                ((val & XENSIV_BGT60TRXX_SPI_REGADR_MSK) >> XENSIV_BGT60TRXX_SPI_REGADR_POS);
-            uint32_t reg_data =
-                ((val & XENSIV_BGT60TRXX_SPI_DATA_MSK) >> XENSIV_BGT60TRXX_SPI_DATA_POS);
+            uint32_t reg_addr = config_reg_addr(old_regs[reg_idx]);
+            old_val[reg_addr] = normalize_reg_value(reg_addr, config_reg_data(old_regs[reg_idx]));
+            known[reg_addr / 32U] |= (1UL << (reg_addr % 32U));
+        }
+    } else if (dev->shadow != NULL) {
+        for (uint32_t reg_addr = 0; reg_addr < XENSIV_BGT60TRXX_SHADOW_NUM_REGS; ++reg_addr) {
+            if ((dev->shadow->valid[reg_addr / 32U] & (1UL << (reg_addr % 32U))) != 0U) {
+                old_val[reg_addr] = normalize_reg_value(reg_addr, dev->shadow->regs[reg_addr]);
+                known[reg_addr / 32U] |= (1UL << (reg_addr % 32U));
+            }
+        }
+    }
+
+    bool stop_fsm = false;
+    bool sfctl_changed = false;
+    uint32_t num_changed = 0U;
+
+    for (uint32_t reg_idx = 0; reg_idx < len; ++reg_idx) {
+        uint32_t reg_addr = config_reg_addr(new_regs[reg_idx]);
+        uint32_t reg_data = normalize_reg_value(reg_addr, config_reg_data(new_regs[reg_idx]));
 
+        if (((known[reg_addr / 32U] & (1UL << (reg_addr % 32U))) == 0U) ||
+            (old_val[reg_addr] != reg_data)) {
+            changed[reg_addr / 32U] |= (1UL << (reg_addr % 32U));
+            ++num_changed;
+
+            /* Only the FIFO control can change while the FSM runs the frame sequence */
             if (reg_addr == XENSIV_BGT60TRXX_REG_SFCTL) {
-                /* FIFO limit set by user */
-                reg_data &= (uint32_t) ~XENSIV_BGT60TRXX_REG_SFCTL_FIFO_CREF_MSK;
-                if (dev->high_speed) {
-                    reg_data |= (uint32_t) XENSIV_BGT60TRXX_REG_SFCTL_MISO_HS_READ_MSK;
-                } else {
-                    reg_data &= (uint32_t) ~XENSIV_BGT60TRXX_REG_SFCTL_MISO_HS_READ_MSK;
+                sfctl_changed = true;
+            } else {
+                stop_fsm = true;
+            }
+        }
+    }
+
+    int32_t status = XENSIV_BGT60TRXX_STATUS_OK;
+
+    if (num_changed > 0U) {
+        uint32_t cref = 0U;
+        uint32_t main = 0U;
+
+        /* Stop the FSM and drop the samples of the old profile, the frame generation is only
+           restarted if it was running: FRAME_START stays set until the sequence ends */
+        if (stop_fsm) {
+            status = xensiv_bgt60trxx_get_reg(dev, XENSIV_BGT60TRXX_REG_MAIN, &main);
+            if (XENSIV_BGT60TRXX_STATUS_OK == status) {
+                status = xensiv_bgt60trxx_soft_reset(
+                    dev,
+                    (xensiv_bgt60trxx_reset_t) (XENSIV_BGT60TRXX_RESET_FSM |
+                                                XENSIV_BGT60TRXX_RESET_FIFO));
+            }
+        }
+
+        /* Keep the FIFO limit set by the user */
+        if ((XENSIV_BGT60TRXX_STATUS_OK == status) && sfctl_changed) {
+            status = get_reg_cached(dev, XENSIV_BGT60TRXX_REG_SFCTL, &cref);
+            cref &= XENSIV_BGT60TRXX_REG_SFCTL_FIFO_CREF_MSK;
+        }
+
+        if (XENSIV_BGT60TRXX_STATUS_OK == status) {
+            status = write_reg_list(dev, new_regs, len, changed, cref);
+        }
+
+        if ((XENSIV_BGT60TRXX_STATUS_OK == status) && stop_fsm &&
+            ((main & XENSIV_BGT60TRXX_REG_MAIN_FRAME_START_MSK) != 0U)) {
+            status = xensiv_bgt60trxx_start_frame(dev, true);
+        }
+    }
+
+    return status;
+}
+
+
+int32_t xensiv_bgt60trxx_config_warm(xensiv_bgt60trxx_t *dev,
+                                     const uint32_t *regs,
+                                     uint32_t len,
+                                     xensiv_bgt60trxx_warm_start_t *result)
+{
+    xensiv_bgt60trxx_platform_assert(dev != NULL);
+    xensiv_bgt60trxx_platform_assert(regs != NULL);
+
+    uint32_t device_regs[XENSIV_BGT60TRXX_NUM_REG_ADDR];
+    uint32_t sfctl_mask[XENSIV_BGT60TRXX_NUM_REG_ADDR / 32U] = {0U};
+    uint32_t first_addr = XENSIV_BGT60TRXX_NUM_REG_ADDR - 1U;
+    uint32_t last_addr = 0U;
+    uint32_t num_mismatch = 0U;
+    bool sfctl_mismatch = false;
+    int32_t status = XENSIV_BGT60TRXX_STATUS_OK;
+
+    for (uint32_t reg_idx = 0; reg_idx < len; ++reg_idx) {
+        uint32_t reg_addr = config_reg_addr(regs[reg_idx]);
+        first_addr = (reg_addr < first_addr) ? reg_addr : first_addr;
+        last_addr = (reg_addr > last_addr) ? reg_addr : last_addr;
+    }
+
+    /* One burst over the configured register window */
+    if (len > 0U) {
+        status = xensiv_bgt60trxx_get_regs(dev,
+                                           first_addr,
+                                           &device_regs[first_addr],
+                                           (last_addr - first_addr) + 1U);
+    }
+
+    if (XENSIV_BGT60TRXX_STATUS_OK == status) {
+        for (uint32_t reg_idx = 0; reg_idx < len; ++reg_idx) {
+            uint32_t reg_addr = config_reg_addr(regs[reg_idx]);
+
+            if (normalize_reg_value(reg_addr, config_reg_data(regs[reg_idx])) !=
+                normalize_reg_value(reg_addr, device_regs[reg_addr])) {
+                ++num_mismatch;
+                if (reg_addr == XENSIV_BGT60TRXX_REG_SFCTL) {
+                    sfctl_mismatch = true;
                 }
             }
+        }
+    }
+
+    bool skipped = false;
 
-            status = xensiv_bgt60trxx_set_reg(dev, reg_addr, reg_data);
+    if (XENSIV_BGT60TRXX_STATUS_OK == status) {
+        if ((num_mismatch == 0U) || ((num_mismatch == 1U) && sfctl_mismatch)) {
+            skipped = true;
 
-            if (status != XENSIV_BGT60TRXX_STATUS_OK) {
-                break;
+            if (len > 0U) {
+                xensiv_bgt60trxx_shadow_invalidate(dev);
+                for (uint32_t reg_addr = first_addr; reg_addr <= last_addr; ++reg_addr) {
+                    shadow_store(dev, reg_addr, device_regs[reg_addr]);
+                }
             }
+
+            if (sfctl_mismatch) {
+                sfctl_mask[XENSIV_BGT60TRXX_REG_SFCTL / 32U] =
+                    (1UL << (XENSIV_BGT60TRXX_REG_SFCTL % 32U));
+                status = write_reg_list(dev, regs, len, sfctl_mask, 0U);
+            }
+        } else {
+            status = xensiv_bgt60trxx_config(dev, regs, len);
         }
     }
 
+    if (result != NULL) {
+        result->skipped = skipped;
+        result->num_compared = len;
+        result->num_mismatch = num_mismatch;
+    }
+
     return status;
 }
 
@@ -182,6 +572,10 @@ int32_t xensiv_bgt60trxx_set_reg(const xensiv_bgt60trxx_t *dev, uint32_t reg_add
         dev->iface, (uint8_t *) &temp, NULL, XENSIV_BGT60TRXX_SPI_REG_XFER_LEN_BYTES);
     xensiv_bgt60trxx_platform_spi_cs_set(dev->iface, 1);
 
+    if (XENSIV_BGT60TRXX_STATUS_OK == status) {
+        shadow_store(dev, reg_addr, data);
+    }
+
     return status;
 }
 
@@ -210,12 +604,153 @@ int32_t xensiv_bgt60trxx_get_reg(const xensiv_bgt60trxx_t *dev, uint32_t reg_add
 }
 
 
+int32_t xensiv_bgt60trxx_get_regs(const xensiv_bgt60trxx_t *dev,
+                                  uint32_t start_addr,
+                                  uint32_t *data,
+                                  uint32_t count)
+{
+    xensiv_bgt60trxx_platform_assert(dev != NULL);
+    xensiv_bgt60trxx_platform_assert(data != NULL);
+
+    int32_t status = XENSIV_BGT60TRXX_STATUS_OK;
+
+    while ((XENSIV_BGT60TRXX_STATUS_OK == status) && (count > 0U)) {
+        uint32_t chunk = (count < XENSIV_BGT60TRXX_SPI_BURST_MAX_REGS)
+                             ? count
+                             : XENSIV_BGT60TRXX_SPI_BURST_MAX_REGS;
+
+        status = read_regs_burst(dev, start_addr, data, chunk, NULL);
+        start_addr += chunk;
+        data += chunk;
+        count -= chunk;
+    }
+
+    return status;
+}
+
+
+int32_t xensiv_bgt60trxx_get_status_snapshot(const xensiv_bgt60trxx_t *dev,
+                                             xensiv_bgt60trxx_status_snapshot_t *snapshot)
+{
+    xensiv_bgt60trxx_platform_assert(dev != NULL);
+    xensiv_bgt60trxx_platform_assert(snapshot != NULL);
+
+    /* MAIN .. STAT1 and STAT0 .. FSTAT are two contiguous register windows. FSTAT is at 0x5f or
+       0x63 depending on the device, the second window ends there and never reaches the FIFO
+       (on the UTR13D the FIFO is 0x63 with unrelated registers in between) */
+    uint32_t low[XENSIV_BGT60TRXX_REG_STAT1 + 1U];
+    uint32_t high[XENSIV_BGT60TRXX_SPI_BURST_MAX_REGS];
+    uint32_t fstat_addr = dev->type->fstat_addr;
+    uint32_t high_len = fstat_addr - XENSIV_BGT60TRXX_REG_STAT0 + 1U;
+
+    int32_t status =
+        read_regs_burst(dev, XENSIV_BGT60TRXX_REG_MAIN, low, XENSIV_BGT60TRXX_REG_STAT1 + 1U, NULL);
+
+    if (XENSIV_BGT60TRXX_STATUS_OK == status) {
+        status =
+            read_regs_burst(dev, XENSIV_BGT60TRXX_REG_STAT0, high, high_len, &snapshot->gsr0);
+    }
+
+    if (XENSIV_BGT60TRXX_STATUS_OK == status) {
+        snapshot->main = low[XENSIV_BGT60TRXX_REG_MAIN];
+        snapshot->stat1 = low[XENSIV_BGT60TRXX_REG_STAT1];
+        snapshot->stat0 = high[0];
+        snapshot->fstat = high[high_len - 1U];
+    }
+
+    return status;
+}
+
+
 uint16_t xensiv_bgt60trxx_get_fifo_size(const xensiv_bgt60trxx_t *dev)
 {
     return (dev->type->fifo_size);
 }
 
 
+void xensiv_bgt60trxx_shadow_enable(xensiv_bgt60trxx_t *dev, xensiv_bgt60trxx_shadow_t *shadow)
+{
+    xensiv_bgt60trxx_platform_assert(dev != NULL);
+
+    dev->shadow = shadow;
+    if (shadow != NULL) {
+        memset(shadow, 0, sizeof(*shadow));
+    }
+}
+
+
+void xensiv_bgt60trxx_shadow_invalidate(const xensiv_bgt60trxx_t *dev)
+{
+    xensiv_bgt60trxx_platform_assert(dev != NULL);
+
+    if (dev->shadow != NULL) {
+        memset(dev->shadow->valid, 0, sizeof(dev->shadow->valid));
+    }
+}
+
+
+int32_t xensiv_bgt60trxx_shadow_resync(const xensiv_bgt60trxx_t *dev)
+{
+    xensiv_bgt60trxx_platform_assert(dev != NULL);
+
+    int32_t status = XENSIV_BGT60TRXX_STATUS_OK;
+
+    if (dev->shadow != NULL) {
+        uint32_t regs[XENSIV_BGT60TRXX_SHADOW_NUM_REGS];
+
+        xensiv_bgt60trxx_shadow_invalidate(dev);
+        status = xensiv_bgt60trxx_get_regs(dev, 0U, regs, XENSIV_BGT60TRXX_SHADOW_NUM_REGS);
+        if (XENSIV_BGT60TRXX_STATUS_OK == status) {
+            for (uint32_t reg_addr = 0U; reg_addr < XENSIV_BGT60TRXX_SHADOW_NUM_REGS; ++reg_addr) {
+                shadow_store(dev, reg_addr, regs[reg_addr]);
+            }
+        }
+    }
+
+    return status;
+}
+
+
+void xensiv_bgt60trxx_shadow_get_stats(const xensiv_bgt60trxx_t *dev,
+                                       uint32_t *hits,
+                                       uint32_t *misses)
+{
+    xensiv_bgt60trxx_platform_assert(dev != NULL);
+
+    if (hits != NULL) {
+        *hits = (dev->shadow != NULL) ? dev->shadow->hits : 0U;
+    }
+    if (misses != NULL) {
+        *misses = (dev->shadow != NULL) ? dev->shadow->misses : 0U;
+    }
+}
+
+
+int32_t xensiv_bgt60trxx_set_high_speed(xensiv_bgt60trxx_t *dev, bool high_speed)
+{
+    xensiv_bgt60trxx_platform_assert(dev != NULL);
+
+    uint32_t tmp;
+    int32_t status = get_reg_cached(dev, XENSIV_BGT60TRXX_REG_SFCTL, &tmp);
+
+    if (XENSIV_BGT60TRXX_STATUS_OK == status) {
+        if (high_speed) {
+            tmp |= XENSIV_BGT60TRXX_REG_SFCTL_MISO_HS_READ_MSK;
+        } else {
+            tmp &= (uint32_t) ~XENSIV_BGT60TRXX_REG_SFCTL_MISO_HS_READ_MSK;
+        }
+
+        status = xensiv_bgt60trxx_set_reg(dev, XENSIV_BGT60TRXX_REG_SFCTL, tmp);
+    }
+
+    if (XENSIV_BGT60TRXX_STATUS_OK == status) {
+        dev->high_speed = high_speed;
+    }
+
+    return status;
+}
+
+
 xensiv_bgt60trxx_device_t xensiv_bgt60trxx_get_device(const xensiv_bgt60trxx_t *dev)
 {
     return (dev->type->device);
@@ -229,7 +764,7 @@ int32_t xensiv_bgt60trxx_set_fifo_limit(const xensiv_bgt60trxx_t *dev, uint32_t
     xensiv_bgt60trxx_platform_assert((num_samples / 2U) <= dev->type->fifo_size);
 
     uint32_t tmp;
-    int32_t retval = xensiv_bgt60trxx_get_reg(dev, XENSIV_BGT60TRXX_REG_SFCTL, &tmp);
+    int32_t retval = get_reg_cached(dev, XENSIV_BGT60TRXX_REG_SFCTL, &tmp);
 
     if (XENSIV_BGT60TRXX_STATUS_OK == retval) {
         tmp &= (uint32_t) ~XENSIV_BGT60TRXX_REG_SFCTL_FIFO_CREF_MSK;
@@ -251,33 +786,21 @@ int32_t xensiv_bgt60trxx_get_fifo_data(const xensiv_bgt60trxx_t *dev,
     xensiv_bgt60trxx_platform_assert((num_samples % 2U) == 0U);
     xensiv_bgt60trxx_platform_assert((num_samples / 2U) <= dev->type->fifo_size);
 
-    uint32_t gsr0;
+    uint8_t gsr0[XENSIV_BGT60TRXX_SPI_BURST_HEADER_SIZE_BYTES];
     uint32_t reg_addr = XENSIV_BGT60TRXX_SPI_BURST_MODE_CMD |
                         (dev->type->fifo_addr << XENSIV_BGT60TRXX_SPI_BURST_MODE_SADR_POS);
 
     reg_addr = xensiv_bgt60trxx_platform_word_reverse(reg_addr);
 
-    /* SPI read burst mode command */
-    xensiv_bgt60trxx_platform_spi_cs_set(dev->iface, false);
-
-    int32_t retval =
-        xensiv_bgt60trxx_platform_spi_transfer(dev->iface,
-                                               (uint8_t *) &reg_addr,
-                                               (uint8_t *) &gsr0,
-                                               XENSIV_BGT60TRXX_SPI_REG_XFER_LEN_BYTES);
+    /* SPI read burst mode command and FIFO payload in one CS assertion */
+    int32_t retval = xensiv_bgt60trxx_platform_spi_fifo_burst_read(
+        dev->iface, (uint8_t *) &reg_addr, gsr0, data, num_samples);
 
-    if (XENSIV_BGT60TRXX_STATUS_OK == retval) {
-        if ((gsr0 &
-             (XENSIV_BGT60TRXX_REG_GSR0_FOU_ERR_MSK | XENSIV_BGT60TRXX_REG_GSR0_SPI_BURST_ERR_MSK |
-              XENSIV_BGT60TRXX_REG_GSR0_CLK_NUM_ERR_MSK)) == 0U) {
-            retval = xensiv_bgt60trxx_platform_spi_fifo_read(dev->iface, data, num_samples);
-        } else {
-            retval = XENSIV_BGT60TRXX_STATUS_GSR0_ERROR;
-        }
+    if ((XENSIV_BGT60TRXX_STATUS_OK == retval) &&
+        ((gsr0[0] & XENSIV_BGT60TRXX_REG_GSR0_ERR_MSK) != 0U)) {
+        retval = XENSIV_BGT60TRXX_STATUS_GSR0_ERROR;
     }
 
-    xensiv_bgt60trxx_platform_spi_cs_set(dev->iface, true);
-
     return retval;
 }
 
@@ -287,12 +810,73 @@ int32_t xensiv_bgt60trxx_get_fifo_status(const xensiv_bgt60trxx_t *dev, uint32_t
     xensiv_bgt60trxx_platform_assert(dev != NULL);
     xensiv_bgt60trxx_platform_assert(status != NULL);
 
-    int32_t retval = xensiv_bgt60trxx_get_reg(dev, dev->type->fifo_addr - 1U, status);
+    int32_t retval = xensiv_bgt60trxx_get_reg(dev, dev->type->fstat_addr, status);
     *status &= (uint32_t) ~XENSIV_BGT60TRXX_REG_FSTAT_FILL_STATUS_MSK;
     return retval;
 }
 
 
+int32_t xensiv_bgt60trxx_get_fifo_fill(const xensiv_bgt60trxx_t *dev, uint32_t *num_samples)
+{
+    xensiv_bgt60trxx_platform_assert(dev != NULL);
+    xensiv_bgt60trxx_platform_assert(num_samples != NULL);
+
+    uint32_t fstat = 0U;
+    int32_t retval = xensiv_bgt60trxx_get_reg(dev, dev->type->fstat_addr, &fstat);
+    *num_samples = ((fstat & XENSIV_BGT60TRXX_REG_FSTAT_FILL_STATUS_MSK) >>
+                    XENSIV_BGT60TRXX_REG_FSTAT_FILL_STATUS_POS) *
+                   XENSIV_BGT60TRXX_NUM_SAMPLES_FIFO_WORD;
+    return retval;
+}
+
+
+int32_t xensiv_bgt60trxx_drain_fifo(const xensiv_bgt60trxx_t *dev,
+                                    uint16_t *data,
+                                    uint32_t max_samples,
+                                    uint32_t frame_samples,
+                                    uint32_t *num_read)
+{
+    xensiv_bgt60trxx_platform_assert(dev != NULL);
+    xensiv_bgt60trxx_platform_assert(data != NULL);
+    xensiv_bgt60trxx_platform_assert(num_read != NULL);
+    xensiv_bgt60trxx_platform_assert(frame_samples > 0U);
+    xensiv_bgt60trxx_platform_assert((frame_samples % 2U) == 0U);
+
+    uint32_t fstat = 0U;
+
+    *num_read = 0U;
+
+    /* Fill level and error flags in one register read */
+    int32_t retval = xensiv_bgt60trxx_get_reg(dev, dev->type->fstat_addr, &fstat);
+
+    if ((XENSIV_BGT60TRXX_STATUS_OK == retval) &&
+        ((fstat & (XENSIV_BGT60TRXX_REG_FSTAT_FOF_ERR_MSK | XENSIV_BGT60TRXX_REG_FSTAT_FUF_ERR_MSK |
+                   XENSIV_BGT60TRXX_REG_FSTAT_SPI_BURST_ERR_MSK |
+                   XENSIV_BGT60TRXX_REG_FSTAT_CLK_NUM_ERR_MSK)) != 0U)) {
+        retval = XENSIV_BGT60TRXX_STATUS_FIFO_ERROR;
+    }
+
+    if (XENSIV_BGT60TRXX_STATUS_OK == retval) {
+        uint32_t num_samples = ((fstat & XENSIV_BGT60TRXX_REG_FSTAT_FILL_STATUS_MSK) >>
+                                XENSIV_BGT60TRXX_REG_FSTAT_FILL_STATUS_POS) *
+                               XENSIV_BGT60TRXX_NUM_SAMPLES_FIFO_WORD;
+        if (num_samples > max_samples) {
+            num_samples = max_samples;
+        }
+        num_samples -= num_samples % frame_samples;
+
+        if (num_samples > 0U) {
+            retval = xensiv_bgt60trxx_get_fifo_data(dev, data, num_samples);
+            if (XENSIV_BGT60TRXX_STATUS_OK == retval) {
+                *num_read = num_samples;
+            }
+        }
+    }
+
+    return retval;
+}
+
+
 int32_t xensiv_bgt60trxx_start_frame(const xensiv_bgt60trxx_t *dev, bool start)
 {
     xensiv_bgt60trxx_platform_assert(dev != NULL);
@@ -301,7 +885,7 @@ int32_t xensiv_bgt60trxx_start_frame(const xensiv_bgt60trxx_t *dev, bool start)
     int32_t status;
 
     if (start) {
-        status = xensiv_bgt60trxx_get_reg(dev, XENSIV_BGT60TRXX_REG_MAIN, &tmp);
+        status = get_reg_cached(dev, XENSIV_BGT60TRXX_REG_MAIN, &tmp);
         if (status == XENSIV_BGT60TRXX_STATUS_OK) {
             tmp |= XENSIV_BGT60TRXX_REG_MAIN_FRAME_START_MSK;
             status = xensiv_bgt60trxx_set_reg(dev, XENSIV_BGT60TRXX_REG_MAIN, tmp);
@@ -323,28 +907,49 @@ int32_t xensiv_bgt60trxx_soft_reset(const xensiv_bgt60trxx_t *dev,
     uint32_t tmp;
     int32_t status;
 
-    status = xensiv_bgt60trxx_get_reg(dev, XENSIV_BGT60TRXX_REG_MAIN, &tmp);
+    status = get_reg_cached(dev, XENSIV_BGT60TRXX_REG_MAIN, &tmp);
     if (XENSIV_BGT60TRXX_STATUS_OK == status) {
         tmp |= (uint32_t) reset_type;
         status = xensiv_bgt60trxx_set_reg(dev, XENSIV_BGT60TRXX_REG_MAIN, tmp);
     }
 
-    uint32_t timeout = XENSIV_BGT60TRXX_RESET_WAIT_TIMEOUT;
-    if (XENSIV_BGT60TRXX_STATUS_OK == status) {
-        while (timeout > 0U) {
-            status = xensiv_bgt60trxx_get_reg(dev, XENSIV_BGT60TRXX_REG_MAIN, &tmp);
-            if ((XENSIV_BGT60TRXX_STATUS_OK == status) && ((tmp & (uint32_t) reset_type) == 0U)) {
-                break;
-            }
-            --timeout;
+    /* A software reset restores the register defaults */
+    if ((reset_type & XENSIV_BGT60TRXX_RESET_SW) != 0) {
+        xensiv_bgt60trxx_shadow_invalidate(dev);
+    }
+
+    /* Poll with a bounded exponential backoff: a FSM or FIFO reset completes within a few
+       microseconds, the sleep budget only matters for a device that does not respond. There is
+       no platform clock, so the budget counts the sleeps and not the SPI polls between them;
+       with the backoff capped it also bounds the number of polls. */
+    uint32_t slept_us = 0U;
+    uint32_t backoff_us = 1U;
+    bool done = false;
+    bool polling = (XENSIV_BGT60TRXX_STATUS_OK == status);
+    while (polling) {
+        status = xensiv_bgt60trxx_get_reg(dev, XENSIV_BGT60TRXX_REG_MAIN, &tmp);
+        done = (XENSIV_BGT60TRXX_STATUS_OK == status) && ((tmp & (uint32_t) reset_type) == 0U);
+
+        if (done || (slept_us >= XENSIV_BGT60TRXX_RESET_SLEEP_BUDGET_US)) {
+            polling = false;
+        } else {
+            xensiv_bgt60trxx_platform_delay_us(backoff_us);
+            slept_us += backoff_us;
+            backoff_us = ((2U * backoff_us) < XENSIV_BGT60TRXX_RESET_POLL_MAX_US)
+                         ? (2U * backoff_us)
+                         : XENSIV_BGT60TRXX_RESET_POLL_MAX_US;
         }
     }
 
     if (XENSIV_BGT60TRXX_STATUS_OK == status) {
-        if (timeout == 0U) {
+        if (!done) {
             status = XENSIV_BGT60TRXX_STATUS_TIMEOUT_ERROR;
+        } else if ((reset_type & XENSIV_BGT60TRXX_RESET_SW) != 0) {
+            /* FSM and FIFO resets are done once their bit clears, only a software reset
+               needs a settle time */
+            xensiv_bgt60trxx_platform_delay_us(XENSIV_BGT60TRXX_SOFT_RESET_SETTLE_US);
         } else {
-            xensiv_bgt60trxx_platform_delay(XENSIV_BGT60TRXX_SOFT_RESET_DELAY_MS);
+            /* No settle time */
         }
     }
 
@@ -359,7 +964,7 @@ int32_t xensiv_bgt60trxx_enable_data_test_mode(const xensiv_bgt60trxx_t *dev, bo
     uint32_t tmp;
     int32_t status;
 
-    status = xensiv_bgt60trxx_get_reg(dev, XENSIV_BGT60TRXX_REG_SFCTL, &tmp);
+    status = get_reg_cached(dev, XENSIV_BGT60TRXX_REG_SFCTL, &tmp);
     if (XENSIV_BGT60TRXX_STATUS_OK == status) {
         if (enable) {
             tmp |= XENSIV_BGT60TRXX_REG_SFCTL_LFSR_EN_MSK;
@@ -385,18 +990,20 @@ void xensiv_bgt60trxx_hard_reset(const xensiv_bgt60trxx_t *dev)
     xensiv_bgt60trxx_platform_assert(dev != NULL);
     xensiv_bgt60trxx_platform_assert(dev->iface != NULL);
 
+    xensiv_bgt60trxx_shadow_invalidate(dev);
+
     xensiv_bgt60trxx_platform_rst_set(dev->iface, true);
     xensiv_bgt60trxx_platform_spi_cs_set(dev->iface, true);
 
-    xensiv_bgt60trxx_platform_delay(1U);
+    xensiv_bgt60trxx_platform_delay_us(XENSIV_BGT60TRXX_HARD_RESET_PULSE_US);
 
     xensiv_bgt60trxx_platform_rst_set(dev->iface, false);
 
-    xensiv_bgt60trxx_platform_delay(1U);
+    xensiv_bgt60trxx_platform_delay_us(XENSIV_BGT60TRXX_HARD_RESET_PULSE_US);
 
     xensiv_bgt60trxx_platform_rst_set(dev->iface, true);
 
-    xensiv_bgt60trxx_platform_delay(1U);
+    xensiv_bgt60trxx_platform_delay_us(XENSIV_BGT60TRXX_HARD_RESET_SETTLE_US);
 }
 
 
@@ -408,3 +1015,30 @@ uint16_t xensiv_bgt60trxx_get_next_test_word(uint16_t cur_test_word)
 
     return next_value;
 }
+
+
+uint32_t xensiv_bgt60trxx_count_test_bit_errors(const uint16_t *samples,
+                                                uint32_t num_samples,
+                                                uint32_t channel_stride,
+                                                uint16_t *test_word)
+{
+    xensiv_bgt60trxx_platform_assert(samples != NULL);
+    xensiv_bgt60trxx_platform_assert(test_word != NULL);
+    xensiv_bgt60trxx_platform_assert(channel_stride > 0U);
+
+    uint32_t bit_errors = 0U;
+    uint16_t expected = *test_word;
+
+    for (uint32_t idx = 0; idx < num_samples; idx += channel_stride) {
+        uint32_t diff = (uint32_t) (samples[idx] ^ expected) & 0x0FFFU;
+        while (diff != 0U) {
+            diff &= diff - 1U;
+            ++bit_errors;
+        }
+
+        expected = xensiv_bgt60trxx_get_next_test_word(expected);
+    }
+
+    *test_word = expected;
+    return bit_errors;
+}
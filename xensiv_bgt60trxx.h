@@ -33,6 +33,7 @@
  * The library allows:
  * - sensor initialization
  * - set/get individual registers of the sensor
+ * - read register windows and status snapshots with SPI burst transfers
  * - start/stop the frame generation
  * - read the digitized IF signal from the sensor FIFO
  * - set the FIFO level-filling threshold
@@ -61,6 +62,8 @@
 #define XENSIV_BGT60TRXX_STATUS_TIMEOUT_ERROR (3)
 /** Result code indicating that an error occurred while reading from FIFO. */
 #define XENSIV_BGT60TRXX_STATUS_GSR0_ERROR (4)
+/** Result code indicating a FIFO overflow, underflow or burst error reported by FSTAT. */
+#define XENSIV_BGT60TRXX_STATUS_FIFO_ERROR (5)
 
 /** Initial value of the LFSR test sequence generator. */
 #define XENSIV_BGT60TRXX_INITIAL_TEST_WORD (0x0001U)
@@ -74,11 +77,44 @@
 /** Size of the header in the SPI burst transfer. */
 #define XENSIV_BGT60TRXX_SPI_BURST_HEADER_SIZE_BYTES (4U)
 
-/** Timeout for wait on software reset done. */
-#ifndef XENSIV_BGT60TRXX_RESET_WAIT_TIMEOUT
-    #define XENSIV_BGT60TRXX_RESET_WAIT_TIMEOUT (0xFFFFFFFFU)
+/** Total time slept between the polls of a pending software reset before giving up, in
+    microseconds. The SPI polls themselves are not counted: a reset that never completes
+    returns after this budget plus at most budget / XENSIV_BGT60TRXX_RESET_POLL_MAX_US +
+    log2(XENSIV_BGT60TRXX_RESET_POLL_MAX_US) + 2 register reads of MAIN. */
+#ifndef XENSIV_BGT60TRXX_RESET_SLEEP_BUDGET_US
+    #define XENSIV_BGT60TRXX_RESET_SLEEP_BUDGET_US (10000U)
 #endif
 
+/** Longest delay between two polls of a pending software reset, in microseconds. The delay
+    starts at 1us and doubles after each poll up to this bound. */
+#ifndef XENSIV_BGT60TRXX_RESET_POLL_MAX_US
+    #define XENSIV_BGT60TRXX_RESET_POLL_MAX_US (64U)
+#endif
+
+/** Low time of the reset line during a hard reset, in microseconds (at least 1000ns). */
+#ifndef XENSIV_BGT60TRXX_HARD_RESET_PULSE_US
+    #define XENSIV_BGT60TRXX_HARD_RESET_PULSE_US (1U)
+#endif
+
+/** Settle time after a hard reset, in microseconds. Override for a measured device value. */
+#ifndef XENSIV_BGT60TRXX_HARD_RESET_SETTLE_US
+    #define XENSIV_BGT60TRXX_HARD_RESET_SETTLE_US (1000U)
+#endif
+
+/** Settle time after a software reset has completed, in microseconds. Override for a measured
+    device value. */
+#ifndef XENSIV_BGT60TRXX_SOFT_RESET_SETTLE_US
+    #define XENSIV_BGT60TRXX_SOFT_RESET_SETTLE_US (10000U)
+#endif
+
+/** Maximum number of registers written by xensiv_bgt60trxx_config() in one SPI burst. */
+#ifndef XENSIV_BGT60TRXX_SPI_BURST_MAX_REGS
+    #define XENSIV_BGT60TRXX_SPI_BURST_MAX_REGS (32U)
+#endif
+
+/** Number of register addresses covered by the register shadow (all registers below STAT0). */
+#define XENSIV_BGT60TRXX_SHADOW_NUM_REGS (XENSIV_BGT60TRXX_REG_STAT0)
+
 /********************************* Type definitions **************************************/
 
 /** enum defining the different reset commands passed to \ref xensiv_bgt60trxx_soft_reset() */
@@ -106,6 +142,30 @@ typedef enum {
     XENSIV_DEVICE_UNKNOWN = -1     /**< Unknown not supported device */
 } xensiv_bgt60trxx_device_t;
 
+/** Snapshot of the sensor status registers, see \ref xensiv_bgt60trxx_get_status_snapshot() */
+typedef struct {
+    uint32_t main;  /**< MAIN register (frame start and reset bits) */
+    uint32_t stat1; /**< STAT1 register (shape group and frame counters) */
+    uint32_t stat0; /**< STAT0 register (ADC, LDO and power mode status) */
+    uint32_t fstat; /**< FSTAT register (FIFO fill level and error flags) */
+    uint8_t gsr0;   /**< GSR0 global status byte returned with the burst */
+} xensiv_bgt60trxx_status_snapshot_t;
+
+/** Register shadow storage, see \ref xensiv_bgt60trxx_shadow_enable() */
+typedef struct {
+    uint32_t regs[XENSIV_BGT60TRXX_SHADOW_NUM_REGS];               /**< Register values */
+    uint32_t valid[(XENSIV_BGT60TRXX_SHADOW_NUM_REGS + 31U) / 32U]; /**< Valid entry bitmap */
+    uint32_t hits;   /**< Register reads served from the shadow */
+    uint32_t misses; /**< Register reads that had to go to the device */
+} xensiv_bgt60trxx_shadow_t;
+
+/** Outcome of a warm start, see \ref xensiv_bgt60trxx_config_warm() */
+typedef struct {
+    bool skipped;          /**< Soft reset and reprogramming skipped, device kept its config */
+    uint32_t num_compared; /**< Configuration registers compared with the device */
+    uint32_t num_mismatch; /**< Registers that differed, ignoring bits managed by the library */
+} xensiv_bgt60trxx_warm_start_t;
+
 /** \cond INTERNAL */
 /* Forward declaration of structure holding device specific type info */
 struct xensiv_bgt60trxx_type;
@@ -122,6 +182,7 @@ typedef struct {
                       xensiv_bgt60trxx_platform_spi_transfer function */
     const struct xensiv_bgt60trxx_type *type; /**< Device type detected during initialization */
     bool high_speed;                          /**< SPI speed mode */
+    xensiv_bgt60trxx_shadow_t *shadow;        /**< Register shadow, NULL if disabled */
 } xensiv_bgt60trxx_t;
 
 /******************************* Function prototypes *************************************/
@@ -147,6 +208,65 @@ extern "C" {
  */
 int32_t xensiv_bgt60trxx_init(xensiv_bgt60trxx_t *dev, void *iface, bool high_speed);
 
+/**
+ * @brief Switches the MISO high speed read mode of the sensor device.
+ * Updates the SFCTL register and the device object so that later calls to
+ * xensiv_bgt60trxx_config() keep the selected mode.
+ *
+ * @param[inout] dev Pointer to the XENSIV(TM) BGT60TRxx sensor device object.
+ * @param[in] high_speed Enable/disable the high speed read mode.
+ * @return XENSIV_BGT60TRXX_STATUS_OK if switching the mode was successful; else an error
+ * indicating what went wrong.
+ */
+int32_t xensiv_bgt60trxx_set_high_speed(xensiv_bgt60trxx_t *dev, bool high_speed);
+
+/**
+ * @brief Enables the write-through register shadow of the sensor device.
+ * The shadow keeps the last value written to or read from each writable register, so that the
+ * read-modify-write operations of this library (FIFO limit, frame start, resets, data test mode,
+ * high speed mode) cost a single SPI write instead of a read and a write.
+ *
+ * The shadow is filled by xensiv_bgt60trxx_config(), xensiv_bgt60trxx_set_reg() and the burst
+ * writes, and on demand by read-modify-write operations. The self-clearing MAIN bits (FRAME_START
+ * and the reset bits) are never stored; the read-only CHIP_ID and STAT1 and the status registers
+ * from STAT0 up are never cached. A software or hard reset invalidates the shadow.
+ * xensiv_bgt60trxx_get_reg() always reads the device.
+ *
+ * @note Register writes that bypass this library (e.g. by another driver instance) must be
+ * followed by \ref xensiv_bgt60trxx_shadow_invalidate or \ref xensiv_bgt60trxx_shadow_resync.
+ *
+ * @param[inout] dev Pointer to the XENSIV(TM) BGT60TRxx sensor device object.
+ * @param[in] shadow Shadow storage owned by the caller, NULL to disable the shadow.
+ */
+void xensiv_bgt60trxx_shadow_enable(xensiv_bgt60trxx_t *dev, xensiv_bgt60trxx_shadow_t *shadow);
+
+/**
+ * @brief Marks all register shadow entries as invalid.
+ *
+ * @param[in] dev Pointer to the XENSIV(TM) BGT60TRxx sensor device object.
+ */
+void xensiv_bgt60trxx_shadow_invalidate(const xensiv_bgt60trxx_t *dev);
+
+/**
+ * @brief Reloads the register shadow from the device using burst reads.
+ *
+ * @param[in] dev Pointer to the XENSIV(TM) BGT60TRxx sensor device object.
+ * @return XENSIV_BGT60TRXX_STATUS_OK if reading the registers was successful; else an error
+ * indicating what went wrong.
+ */
+int32_t xensiv_bgt60trxx_shadow_resync(const xensiv_bgt60trxx_t *dev);
+
+/**
+ * @brief Obtains the register shadow hit and miss counters.
+ *
+ * @param[in] dev Pointer to the XENSIV(TM) BGT60TRxx sensor device object.
+ * @param[out] hits Register reads served from the shadow, may be NULL.
+ * @param[out] misses Register reads that had to go to the device, may be NULL.
+ */
+void xensiv_bgt60trxx_shadow_get_stats(const xensiv_bgt60trxx_t *dev,
+                                       uint32_t *hits,
+                                       uint32_t *misses);
+
 /**
  * @brief Obtains the detected sensor device name.
  *
@@ -159,6 +279,8 @@ xensiv_bgt60trxx_device_t xensiv_bgt60trxx_get_device(const xensiv_bgt60trxx_t *
  * @brief Configures the XENSIV(TM) BGT60TRxx radar sensor device.
  * It performs a SW reset and applies the sensor configurator given in the regs array
  * The register configuration can be generated using the BGT60TRxx configurator tool.
+ * Runs of consecutive register addresses are written with SPI burst writes of up to
+ * XENSIV_BGT60TRXX_SPI_BURST_MAX_REGS registers; SFCTL is always written on its own.
  *
  * @param[in] dev Pointer to the XENSIV(TM) BGT60TRxx sensor device object.
  * @param[in] regs Pointer to the configuration registers list.
@@ -168,6 +290,57 @@ xensiv_bgt60trxx_device_t xensiv_bgt60trxx_get_device(const xensiv_bgt60trxx_t *
  */
 int32_t xensiv_bgt60trxx_config(xensiv_bgt60trxx_t *dev, const uint32_t *regs, uint32_t len);
 
+/**
+ * @brief Switches a running XENSIV(TM) BGT60TRxx radar sensor device to another configuration.
+ * Unlike xensiv_bgt60trxx_config() no software reset is done and only the registers whose value
+ * differs from the current configuration are written, coalescing consecutive addresses into
+ * burst writes. A change of the FIFO control (SFCTL) alone is applied on the fly, keeping the
+ * FIFO limit set by the user. Any other change stops the frame generation with an FSM and FIFO
+ * reset, which also discards samples of the old configuration. The frame generation is
+ * restarted after the writes only if MAIN.FRAME_START showed it running; an idle sensor stays
+ * idle.
+ *
+ * The current configuration is taken from old_regs, or from the register shadow if old_regs is
+ * NULL (see \ref xensiv_bgt60trxx_shadow_enable). Registers of unknown value are written.
+ * Both lists come from the BGT60TRxx configurator tool; registers set by the old configuration
+ * must also be present in the new one since they are not reset to their defaults.
+ *
+ * @param[in] dev Pointer to the XENSIV(TM) BGT60TRxx sensor device object.
+ * @param[in] old_regs Configuration currently applied, NULL to use the register shadow.
+ * @param[in] new_regs Configuration to apply.
+ * @param[in] len Length of the configuration registers lists.
+ * @return XENSIV_BGT60TRXX_STATUS_OK if the reconfiguration was successful; else an error
+ * indicating what went wrong.
+ */
+int32_t xensiv_bgt60trxx_reconfig(xensiv_bgt60trxx_t *dev,
+                                  const uint32_t *old_regs,
+                                  const uint32_t *new_regs,
+                                  uint32_t len);
+
+/**
+ * @brief Configures a XENSIV(TM) BGT60TRxx radar sensor device unless it already holds the
+ * configuration, e.g. after a restart of the application while the sensor stayed powered.
+ * The register window covered by the configuration is read in a single burst and compared
+ * with it, ignoring the frame start, reset, FIFO limit and MISO high speed bits. If only the
+ * FIFO control (SFCTL) differs it is written alone, as \ref xensiv_bgt60trxx_init() clears
+ * it. Any other difference falls back to \ref xensiv_bgt60trxx_config().
+ *
+ * When the configuration is kept, neither the FSM nor the FIFO is touched: a running frame
+ * sequence continues. The FIFO limit must be set again by the user in any case. The register
+ * shadow, if enabled, is filled from the values read.
+ *
+ * @param[in] dev Pointer to the XENSIV(TM) BGT60TRxx sensor device object.
+ * @param[in] regs Configuration registers list from the BGT60TRxx configurator tool.
+ * @param[in] len Length of the configuration registers list.
+ * @param[out] result What was compared and skipped, may be NULL.
+ * @return XENSIV_BGT60TRXX_STATUS_OK if the device holds the configuration; else an error
+ * indicating what went wrong.
+ */
+int32_t xensiv_bgt60trxx_config_warm(xensiv_bgt60trxx_t *dev,
+                                     const uint32_t *regs,
+                                     uint32_t len,
+                                     xensiv_bgt60trxx_warm_start_t *result);
+
 /**
  * @brief Writes the given data buffer into the sensor device.
  * Writes the given data buffer to the sensor register map starting at the register address.
@@ -193,6 +366,35 @@ int32_t xensiv_bgt60trxx_set_reg(const xensiv_bgt60trxx_t *dev, uint32_t reg_add
  */
 int32_t xensiv_bgt60trxx_get_reg(const xensiv_bgt60trxx_t *dev, uint32_t reg_addr, uint32_t *data);
 
+/**
+ * @brief Reads a window of consecutive registers from the sensor device.
+ * Uses SPI burst reads so that up to XENSIV_BGT60TRXX_SPI_BURST_MAX_REGS registers are fetched in
+ * a single transaction; larger windows are split into several bursts.
+ *
+ * @param[in] dev Pointer to the XENSIV(TM) BGT60TRxx sensor device object.
+ * @param[in] start_addr Address of the first register.
+ * @param[out] data Buffer receiving count register values (24-bit payloads).
+ * @param[in] count Number of registers to read.
+ * @return XENSIV_BGT60TRXX_STATUS_OK if reading the registers was successful; else an error
+ * indicating what went wrong.
+ */
+int32_t xensiv_bgt60trxx_get_regs(const xensiv_bgt60trxx_t *dev,
+                                  uint32_t start_addr,
+                                  uint32_t *data,
+                                  uint32_t count);
+
+/**
+ * @brief Reads MAIN, STAT1, STAT0, FSTAT and GSR0 in two burst transactions.
+ * Cheap enough to poll the sensor health every frame.
+ *
+ * @param[in] dev Pointer to the XENSIV(TM) BGT60TRxx sensor device object.
+ * @param[out] snapshot Pointer to populate with the status registers.
+ * @return XENSIV_BGT60TRXX_STATUS_OK if reading the status was successful; else an error
+ * indicating what went wrong.
+ */
+int32_t xensiv_bgt60trxx_get_status_snapshot(const xensiv_bgt60trxx_t *dev,
+                                             xensiv_bgt60trxx_status_snapshot_t *snapshot);
+
 /**
  * @brief Obtains the sensor device FIFO size.
  *
@@ -214,6 +416,17 @@ uint16_t xensiv_bgt60trxx_get_fifo_size(const xensiv_bgt60trxx_t *dev);
  */
 int32_t xensiv_bgt60trxx_get_fifo_status(const xensiv_bgt60trxx_t *dev, uint32_t *status);
 
+/**
+ * @brief Obtains the number of samples waiting in the sensor device FIFO.
+ * The FSTAT fill level counts FIFO words of two samples each.
+ *
+ * @param[in] dev Pointer to the XENSIV(TM) BGT60TRxx sensor device object.
+ * @param[out] num_samples Pointer to populate with the number of samples in the FIFO.
+ * @return XENSIV_BGT60TRXX_STATUS_OK if reading the FIFO status was successful; else
+ * an error indicating what went wrong.
+ */
+int32_t xensiv_bgt60trxx_get_fifo_fill(const xensiv_bgt60trxx_t *dev, uint32_t *num_samples);
+
 /**
  * @brief Sets the FIFO compare reference value.
  * The beat signal signal is sampled, digitized, and stored into the sensor FIFO.
@@ -244,6 +457,31 @@ int32_t xensiv_bgt60trxx_get_fifo_data(const xensiv_bgt60trxx_t *dev,
                                        uint16_t *data,
                                        uint32_t num_samples);
 
+/**
+ * @brief Reads everything available in the sensor device FIFO, in whole frames.
+ * The fill level and the error flags are read together from FSTAT, then as many complete
+ * frames as are available and fit into the buffer are read in one burst. A single call thus
+ * catches up with a backlog left by a stall of the caller instead of letting it grow until
+ * the FIFO overflows. Samples of an incomplete frame stay in the FIFO for the next call.
+ *
+ * @param[in] dev Pointer to the XENSIV(TM) BGT60TRxx sensor device object.
+ * @param[out] data Pointer to a data buffer.
+ * @param[in] max_samples Capacity of the data buffer in samples.
+ * @param[in] frame_samples Number of samples per frame, the read is a multiple of it.
+ * @note Should be an even number
+ * @param[out] num_read Number of samples read, zero if less than a frame was available.
+ * @return XENSIV_BGT60TRXX_STATUS_OK if reading from the FIFO was successful;
+ * XENSIV_BGT60TRXX_STATUS_FIFO_ERROR if FSTAT reports an overflow, underflow or SPI burst
+ * error, in which case nothing is read and the FIFO should be reset;
+ * XENSIV_BGT60TRXX_STATUS_GSR0_ERROR if GSR0 reports an error during the burst; else an error
+ * indicating what went wrong.
+ */
+int32_t xensiv_bgt60trxx_drain_fifo(const xensiv_bgt60trxx_t *dev,
+                                    uint16_t *data,
+                                    uint32_t max_samples,
+                                    uint32_t frame_samples,
+                                    uint32_t *num_read);
+
 /**
  * @brief Starts/stops radar frame generation.
  *
@@ -304,6 +542,22 @@ void xensiv_bgt60trxx_hard_reset(const xensiv_bgt60trxx_t *dev);
  */
 uint16_t xensiv_bgt60trxx_get_next_test_word(uint16_t cur_test_word);
 
+/**
+ * @brief Counts the bit errors of FIFO data read while data test mode is enabled.
+ * The test sequence replaces the samples of the first ADC channel, so with several channels
+ * enabled only every channel_stride-th sample is compared against the LFSR sequence.
+ *
+ * @param[in] samples FIFO samples starting with a first ADC channel sample.
+ * @param[in] num_samples Number of samples in the buffer.
+ * @param[in] channel_stride Number of enabled ADC channels.
+ * @param[inout] test_word State of the LFSR generator, advanced past the compared samples.
+ * @return Number of differing bits between the samples and the expected test sequence.
+ */
+uint32_t xensiv_bgt60trxx_count_test_bit_errors(const uint16_t *samples,
+                                                uint32_t num_samples,
+                                                uint32_t channel_stride,
+                                                uint16_t *test_word);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,466 @@
+/***********************************************************************************************/ /**
+                                                                                                   * \file xensiv_bgt60trxx_angle.c
+                                                                                                   *
+                                                                                                   * \brief
+                                                                                                   * This file contains the angle of arrival stage of the XENSIV(TM) BGT60TRxx radar sensor library:
+                                                                                                   * phase comparison, digital beamforming and Capon estimation on detected cells.
+                                                                                                   *
+                                                                                                   ***************************************************************************************************
+                                                                                                   * \copyright
+                                                                                                   * Copyright 2022 Infineon Technologies AG
+                                                                                                   * SPDX-License-Identifier: Apache-2.0
+                                                                                                   *
+                                                                                                   * Licensed under the Apache License, Version 2.0 (the "License");
+                                                                                                   * you may not use this file except in compliance with the License.
+                                                                                                   * You may obtain a copy of the License at
+                                                                                                   *
+                                                                                                   *     http://www.apache.org/licenses/LICENSE-2.0
+                                                                                                   *
+                                                                                                   * Unless required by applicable law or agreed to in writing, software
+                                                                                                   * distributed under the License is distributed on an "AS IS" BASIS,
+                                                                                                   * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+                                                                                                   * See the License for the specific language governing permissions and
+                                                                                                   * limitations under the License.
+                                                                                                   **************************************************************************************************/
+
+#include "xensiv_bgt60trxx_angle.h"
+
+#include <math.h>
+#include <string.h>
+
+#include "xensiv_bgt60trxx.h"
+#include "xensiv_bgt60trxx_platform.h"
+
+/* Squared baseline length below which an axis is considered absent */
+#define XENSIV_BGT60TRXX_ANGLE_EPSILON (1e-9)
+
+#define XENSIV_BGT60TRXX_ANGLE_MAX_RX_SQ \
+    (XENSIV_BGT60TRXX_ANGLE_MAX_RX * XENSIV_BGT60TRXX_ANGLE_MAX_RX)
+
+static const double pi = 3.14159265358979323846;
+
+static float grid_value(float min, float max, uint32_t steps, uint32_t index)
+{
+    return (steps > 1U) ? (min + (((max - min) * (float) index) / (float) (steps - 1U))) : min;
+}
+
+
+size_t xensiv_bgt60trxx_angle_storage_size(const xensiv_bgt60trxx_angle_config_t *config)
+{
+    xensiv_bgt60trxx_platform_assert(config != NULL);
+
+    return (size_t) config->azimuth_steps * config->elevation_steps * config->num_rx *
+           sizeof(xensiv_bgt60trxx_complex_t);
+}
+
+
+/* Least squares solution of the phase differences to antenna 0 for the direction cosines */
+static bool init_phase_fit(xensiv_bgt60trxx_angle_t *angle)
+{
+    const xensiv_bgt60trxx_antenna_t *antennas = angle->config.antennas;
+    double sxx = 0.0;
+    double sxy = 0.0;
+    double syy = 0.0;
+
+    for (uint32_t n = 1U; n < angle->config.num_rx; ++n) {
+        double bx = (double) antennas[n].x - antennas[0].x;
+        double by = (double) antennas[n].y - antennas[0].y;
+        sxx += bx * bx;
+        sxy += bx * by;
+        syy += by * by;
+    }
+
+    double det = (sxx * syy) - (sxy * sxy);
+    memset(angle->phase_fit, 0, sizeof(angle->phase_fit));
+    if (det > XENSIV_BGT60TRXX_ANGLE_EPSILON) {
+        angle->phase_fit[0][0] = (float) (syy / det);
+        angle->phase_fit[0][1] = (float) (-sxy / det);
+        angle->phase_fit[1][0] = (float) (-sxy / det);
+        angle->phase_fit[1][1] = (float) (sxx / det);
+    } else if ((syy <= XENSIV_BGT60TRXX_ANGLE_EPSILON) && (sxx > XENSIV_BGT60TRXX_ANGLE_EPSILON)) {
+        angle->phase_fit[0][0] = (float) (1.0 / sxx);
+    } else if ((sxx <= XENSIV_BGT60TRXX_ANGLE_EPSILON) && (syy > XENSIV_BGT60TRXX_ANGLE_EPSILON)) {
+        angle->phase_fit[1][1] = (float) (1.0 / syy);
+    } else {
+        /* No baseline, or a single slanted line of antennas */
+        return false;
+    }
+
+    return true;
+}
+
+
+int32_t xensiv_bgt60trxx_angle_init(xensiv_bgt60trxx_angle_t *angle,
+                                    const xensiv_bgt60trxx_angle_config_t *config,
+                                    void *storage,
+                                    size_t storage_size)
+{
+    xensiv_bgt60trxx_platform_assert(angle != NULL);
+    xensiv_bgt60trxx_platform_assert(config != NULL);
+    xensiv_bgt60trxx_platform_assert(storage != NULL);
+
+    if ((config->num_rx == 0U) || (config->num_rx > XENSIV_BGT60TRXX_ANGLE_MAX_RX) ||
+        (config->azimuth_steps == 0U) || (config->elevation_steps == 0U) ||
+        (storage_size < xensiv_bgt60trxx_angle_storage_size(config)) ||
+        ((config->method == XENSIV_BGT60TRXX_ANGLE_CAPON) && !(config->loading > 0.0f))) {
+        return XENSIV_BGT60TRXX_STATUS_DEV_ERROR;
+    }
+
+    memset(angle, 0, sizeof(*angle));
+    angle->config = *config;
+    if ((config->method == XENSIV_BGT60TRXX_ANGLE_PHASE) && !init_phase_fit(angle)) {
+        return XENSIV_BGT60TRXX_STATUS_DEV_ERROR;
+    }
+
+    angle->steering = (xensiv_bgt60trxx_complex_t *) storage;
+    xensiv_bgt60trxx_complex_t *vec = angle->steering;
+    for (uint32_t e = 0; e < config->elevation_steps; ++e) {
+        double el = grid_value(config->elevation_min, config->elevation_max,
+                               config->elevation_steps, e);
+        for (uint32_t a = 0; a < config->azimuth_steps; ++a) {
+            double az = grid_value(config->azimuth_min, config->azimuth_max,
+                                   config->azimuth_steps, a);
+            double u = sin(az) * cos(el);
+            double v = sin(el);
+            for (uint32_t n = 0; n < config->num_rx; ++n) {
+                double phase = 2.0 * pi * ((config->antennas[n].x * u) +
+                                           (config->antennas[n].y * v));
+                vec->re = (float) cos(phase);
+                vec->im = (float) sin(phase);
+                ++vec;
+            }
+        }
+    }
+
+    return XENSIV_BGT60TRXX_STATUS_OK;
+}
+
+
+/* Adds x x^H of one snapshot to an unnormalised covariance */
+static void accumulate(xensiv_bgt60trxx_complex_t *covariance,
+                       const xensiv_bgt60trxx_complex_t *x,
+                       uint32_t num_rx)
+{
+    for (uint32_t m = 0; m < num_rx; ++m) {
+        for (uint32_t n = 0; n < num_rx; ++n) {
+            covariance[(m * num_rx) + n].re += (x[m].re * x[n].re) + (x[m].im * x[n].im);
+            covariance[(m * num_rx) + n].im += (x[m].im * x[n].re) - (x[m].re * x[n].im);
+        }
+    }
+}
+
+
+static void normalise(xensiv_bgt60trxx_complex_t *covariance, uint32_t num_rx, uint32_t count)
+{
+    for (uint32_t i = 0; i < num_rx * num_rx; ++i) {
+        covariance[i].re /= (float) count;
+        covariance[i].im /= (float) count;
+    }
+}
+
+
+void xensiv_bgt60trxx_angle_covariance(const xensiv_bgt60trxx_angle_t *angle,
+                                       const xensiv_bgt60trxx_complex_t *snapshots,
+                                       uint32_t num_snapshots,
+                                       xensiv_bgt60trxx_complex_t *covariance)
+{
+    xensiv_bgt60trxx_platform_assert(angle != NULL);
+    xensiv_bgt60trxx_platform_assert(snapshots != NULL);
+    xensiv_bgt60trxx_platform_assert(covariance != NULL);
+    xensiv_bgt60trxx_platform_assert(num_snapshots > 0U);
+
+    const uint32_t num_rx = angle->config.num_rx;
+
+    memset(covariance, 0, num_rx * num_rx * sizeof(covariance[0]));
+    for (uint32_t k = 0; k < num_snapshots; ++k) {
+        accumulate(covariance, &snapshots[k * num_rx], num_rx);
+    }
+    normalise(covariance, num_rx, num_snapshots);
+}
+
+
+/* Inverse of the diagonally loaded covariance by Gauss-Jordan elimination in double */
+static void loaded_inverse(const xensiv_bgt60trxx_angle_t *angle,
+                           const xensiv_bgt60trxx_complex_t *covariance,
+                           xensiv_bgt60trxx_complex_t *inverse)
+{
+    const uint32_t num_rx = angle->config.num_rx;
+    double a_re[XENSIV_BGT60TRXX_ANGLE_MAX_RX_SQ];
+    double a_im[XENSIV_BGT60TRXX_ANGLE_MAX_RX_SQ];
+    double b_re[XENSIV_BGT60TRXX_ANGLE_MAX_RX_SQ] = {0.0};
+    double b_im[XENSIV_BGT60TRXX_ANGLE_MAX_RX_SQ] = {0.0};
+    double trace = 0.0;
+
+    for (uint32_t n = 0; n < num_rx; ++n) {
+        trace += covariance[(n * num_rx) + n].re;
+    }
+    double loading = ((double) angle->config.loading * trace) / num_rx;
+    loading = (loading > 0.0) ? loading : XENSIV_BGT60TRXX_ANGLE_EPSILON;
+
+    for (uint32_t i = 0; i < num_rx * num_rx; ++i) {
+        a_re[i] = covariance[i].re;
+        a_im[i] = covariance[i].im;
+    }
+    for (uint32_t n = 0; n < num_rx; ++n) {
+        a_re[(n * num_rx) + n] += loading;
+        b_re[(n * num_rx) + n] = 1.0;
+    }
+
+    /* The loaded covariance is Hermitian positive definite, so no pivoting is needed */
+    for (uint32_t p = 0; p < num_rx; ++p) {
+        double pivot = a_re[(p * num_rx) + p];
+        for (uint32_t c = 0; c < num_rx; ++c) {
+            a_re[(p * num_rx) + c] /= pivot;
+            a_im[(p * num_rx) + c] /= pivot;
+            b_re[(p * num_rx) + c] /= pivot;
+            b_im[(p * num_rx) + c] /= pivot;
+        }
+        for (uint32_t r = 0; r < num_rx; ++r) {
+            if (r == p) {
+                continue;
+            }
+            double f_re = a_re[(r * num_rx) + p];
+            double f_im = a_im[(r * num_rx) + p];
+            for (uint32_t c = 0; c < num_rx; ++c) {
+                const uint32_t rc = (r * num_rx) + c;
+                const uint32_t pc = (p * num_rx) + c;
+                a_re[rc] -= (f_re * a_re[pc]) - (f_im * a_im[pc]);
+                a_im[rc] -= (f_re * a_im[pc]) + (f_im * a_re[pc]);
+                b_re[rc] -= (f_re * b_re[pc]) - (f_im * b_im[pc]);
+                b_im[rc] -= (f_re * b_im[pc]) + (f_im * b_re[pc]);
+            }
+        }
+    }
+
+    for (uint32_t i = 0; i < num_rx * num_rx; ++i) {
+        inverse[i].re = (float) b_re[i];
+        inverse[i].im = (float) b_im[i];
+    }
+}
+
+
+/* a^H M a for a Hermitian M */
+static float quadratic_form(const xensiv_bgt60trxx_complex_t *vec,
+                            const xensiv_bgt60trxx_complex_t *matrix,
+                            uint32_t num_rx)
+{
+    float sum = 0.0f;
+
+    for (uint32_t m = 0; m < num_rx; ++m) {
+        /* (M a)_m */
+        float re = 0.0f;
+        float im = 0.0f;
+        for (uint32_t n = 0; n < num_rx; ++n) {
+            const xensiv_bgt60trxx_complex_t *c = &matrix[(m * num_rx) + n];
+            re += (c->re * vec[n].re) - (c->im * vec[n].im);
+            im += (c->re * vec[n].im) + (c->im * vec[n].re);
+        }
+        sum += (vec[m].re * re) + (vec[m].im * im);
+    }
+
+    return sum;
+}
+
+
+/* Spectrum value at one grid point; matrix is the covariance or its loaded inverse */
+static float grid_power(const xensiv_bgt60trxx_angle_t *angle,
+                        const xensiv_bgt60trxx_complex_t *matrix,
+                        uint32_t a,
+                        uint32_t e)
+{
+    const uint32_t num_rx = angle->config.num_rx;
+    const xensiv_bgt60trxx_complex_t *vec =
+        &angle->steering[((e * angle->config.azimuth_steps) + a) * num_rx];
+    float q = quadratic_form(vec, matrix, num_rx);
+
+    if (angle->config.method == XENSIV_BGT60TRXX_ANGLE_CAPON) {
+        return 1.0f / q;
+    }
+
+    return q / (float) (num_rx * num_rx);
+}
+
+
+static const xensiv_bgt60trxx_complex_t *scan_matrix(const xensiv_bgt60trxx_angle_t *angle,
+                                                     const xensiv_bgt60trxx_complex_t *covariance,
+                                                     xensiv_bgt60trxx_complex_t *inverse)
+{
+    if (angle->config.method == XENSIV_BGT60TRXX_ANGLE_CAPON) {
+        loaded_inverse(angle, covariance, inverse);
+        return inverse;
+    }
+
+    return covariance;
+}
+
+
+void xensiv_bgt60trxx_angle_spectrum(const xensiv_bgt60trxx_angle_t *angle,
+                                     const xensiv_bgt60trxx_complex_t *covariance,
+                                     float *spectrum)
+{
+    xensiv_bgt60trxx_platform_assert(angle != NULL);
+    xensiv_bgt60trxx_platform_assert(covariance != NULL);
+    xensiv_bgt60trxx_platform_assert(spectrum != NULL);
+
+    xensiv_bgt60trxx_complex_t inverse[XENSIV_BGT60TRXX_ANGLE_MAX_RX_SQ];
+    const xensiv_bgt60trxx_complex_t *matrix = scan_matrix(angle, covariance, inverse);
+
+    for (uint32_t e = 0; e < angle->config.elevation_steps; ++e) {
+        for (uint32_t a = 0; a < angle->config.azimuth_steps; ++a) {
+            *spectrum++ = grid_power(angle, matrix, a, e);
+        }
+    }
+}
+
+
+/* Offset of the vertex of the parabola through three equally spaced points, in steps */
+static float parabolic_offset(float before, float peak, float after)
+{
+    float curvature = before - (2.0f * peak) + after;
+
+    return (curvature < 0.0f) ? ((0.5f * (before - after)) / curvature) : 0.0f;
+}
+
+
+static void estimate_phase(const xensiv_bgt60trxx_angle_t *angle,
+                           const xensiv_bgt60trxx_complex_t *covariance,
+                           xensiv_bgt60trxx_angle_estimate_t *estimate)
+{
+    const uint32_t num_rx = angle->config.num_rx;
+    const xensiv_bgt60trxx_antenna_t *antennas = angle->config.antennas;
+    double sx = 0.0;
+    double sy = 0.0;
+    float power = 0.0f;
+
+    for (uint32_t n = 0; n < num_rx; ++n) {
+        power += covariance[(n * num_rx) + n].re;
+        if (n > 0U) {
+            /* Phase of x_n relative to x_0 */
+            const xensiv_bgt60trxx_complex_t *c = &covariance[n * num_rx];
+            double phase = atan2(c->im, c->re) / (2.0 * pi);
+            sx += ((double) antennas[n].x - antennas[0].x) * phase;
+            sy += ((double) antennas[n].y - antennas[0].y) * phase;
+        }
+    }
+
+    double u = (angle->phase_fit[0][0] * sx) + (angle->phase_fit[0][1] * sy);
+    double v = (angle->phase_fit[1][0] * sx) + (angle->phase_fit[1][1] * sy);
+    v = (v > 1.0) ? 1.0 : ((v < -1.0) ? -1.0 : v);
+    double el = asin(v);
+    double cos_el = cos(el);
+    u = (cos_el > 0.0) ? (u / cos_el) : 0.0;
+    u = (u > 1.0) ? 1.0 : ((u < -1.0) ? -1.0 : u);
+
+    estimate->azimuth = (float) asin(u);
+    estimate->elevation = (float) el;
+    estimate->power = power / (float) num_rx;
+}
+
+
+void xensiv_bgt60trxx_angle_estimate(const xensiv_bgt60trxx_angle_t *angle,
+                                     const xensiv_bgt60trxx_complex_t *covariance,
+                                     xensiv_bgt60trxx_angle_estimate_t *estimate)
+{
+    xensiv_bgt60trxx_platform_assert(angle != NULL);
+    xensiv_bgt60trxx_platform_assert(covariance != NULL);
+    xensiv_bgt60trxx_platform_assert(estimate != NULL);
+
+    const xensiv_bgt60trxx_angle_config_t *config = &angle->config;
+
+    if (config->method == XENSIV_BGT60TRXX_ANGLE_PHASE) {
+        estimate_phase(angle, covariance, estimate);
+        return;
+    }
+
+    xensiv_bgt60trxx_complex_t inverse[XENSIV_BGT60TRXX_ANGLE_MAX_RX_SQ];
+    const xensiv_bgt60trxx_complex_t *matrix = scan_matrix(angle, covariance, inverse);
+    const uint32_t num_az = config->azimuth_steps;
+    const uint32_t num_el = config->elevation_steps;
+    uint32_t best_a = 0U;
+    uint32_t best_e = 0U;
+    float best = -1.0f;
+
+    for (uint32_t e = 0; e < num_el; ++e) {
+        for (uint32_t a = 0; a < num_az; ++a) {
+            float power = grid_power(angle, matrix, a, e);
+            if (power > best) {
+                best = power;
+                best_a = a;
+                best_e = e;
+            }
+        }
+    }
+
+    float a_off = 0.0f;
+    float e_off = 0.0f;
+    if ((best_a > 0U) && (best_a < (num_az - 1U))) {
+        a_off = parabolic_offset(grid_power(angle, matrix, best_a - 1U, best_e), best,
+                                 grid_power(angle, matrix, best_a + 1U, best_e));
+    }
+    if ((best_e > 0U) && (best_e < (num_el - 1U))) {
+        e_off = parabolic_offset(grid_power(angle, matrix, best_a, best_e - 1U), best,
+                                 grid_power(angle, matrix, best_a, best_e + 1U));
+    }
+
+    float az_step = (num_az > 1U) ? ((config->azimuth_max - config->azimuth_min) /
+                                     (float) (num_az - 1U)) : 0.0f;
+    float el_step = (num_el > 1U) ? ((config->elevation_max - config->elevation_min) /
+                                     (float) (num_el - 1U)) : 0.0f;
+    estimate->azimuth = grid_value(config->azimuth_min, config->azimuth_max, num_az, best_a) +
+                        (a_off * az_step);
+    estimate->elevation = grid_value(config->elevation_min, config->elevation_max, num_el,
+                                     best_e) + (e_off * el_step);
+    estimate->power = best;
+}
+
+
+void xensiv_bgt60trxx_angle_process(const xensiv_bgt60trxx_angle_t *angle,
+                                    const xensiv_bgt60trxx_doppler_t *doppler,
+                                    const xensiv_bgt60trxx_complex_t *map,
+                                    uint32_t group,
+                                    uint32_t segment,
+                                    const xensiv_bgt60trxx_detection_t *detections,
+                                    uint32_t num_detections,
+                                    xensiv_bgt60trxx_angle_estimate_t *estimates)
+{
+    xensiv_bgt60trxx_platform_assert(angle != NULL);
+    xensiv_bgt60trxx_platform_assert(doppler != NULL);
+    xensiv_bgt60trxx_platform_assert(map != NULL);
+    xensiv_bgt60trxx_platform_assert((detections != NULL) || (num_detections == 0U));
+    xensiv_bgt60trxx_platform_assert((estimates != NULL) || (num_detections == 0U));
+
+    const xensiv_bgt60trxx_range_t *range = doppler->range;
+    const uint32_t num_rx = angle->config.num_rx;
+    xensiv_bgt60trxx_platform_assert(segment < range->assembler->num_segments);
+    xensiv_bgt60trxx_platform_assert(range->assembler->segments[segment].num_rx == num_rx);
+
+    const int32_t num_bins = (int32_t) (range->plans[range->segment_plan[segment]].fft_size / 2U);
+    const int32_t fft_size = (int32_t) doppler->plans[doppler->segment_plan[segment]].fft_size;
+    const int32_t reach = (int32_t) angle->config.neighbours;
+
+    for (uint32_t i = 0; i < num_detections; ++i) {
+        xensiv_bgt60trxx_complex_t covariance[XENSIV_BGT60TRXX_ANGLE_MAX_RX_SQ] = {{0.0f, 0.0f}};
+        xensiv_bgt60trxx_complex_t x[XENSIV_BGT60TRXX_ANGLE_MAX_RX];
+        uint32_t count = 0U;
+
+        for (int32_t r = (int32_t) detections[i].range_bin - reach;
+             r <= ((int32_t) detections[i].range_bin + reach); ++r) {
+            if ((r < 0) || (r >= num_bins)) {
+                continue;
+            }
+            for (int32_t d = (int32_t) detections[i].doppler_bin - reach;
+                 d <= ((int32_t) detections[i].doppler_bin + reach); ++d) {
+                const int32_t col = ((d % fft_size) + fft_size) % fft_size;
+                for (uint32_t n = 0; n < num_rx; ++n) {
+                    x[n] = map[xensiv_bgt60trxx_doppler_map_offset(doppler, group, segment, n,
+                                                                   (uint32_t) r) + col];
+                }
+                accumulate(covariance, x, num_rx);
+                ++count;
+            }
+        }
+
+        normalise(covariance, num_rx, count);
+        xensiv_bgt60trxx_angle_estimate(angle, covariance, &estimates[i]);
+    }
+}
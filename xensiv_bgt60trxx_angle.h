@@ -0,0 +1,206 @@
+/***********************************************************************************************/ /**
+                                                                                                   * \file xensiv_bgt60trxx_angle.h
+                                                                                                   *
+                                                                                                   * \brief
+                                                                                                   * This file contains the angle of arrival stage of the XENSIV(TM) BGT60TRxx radar sensor library:
+                                                                                                   * phase comparison, digital beamforming and Capon estimation on detected cells.
+                                                                                                   *
+                                                                                                   ***************************************************************************************************
+                                                                                                   * \copyright
+                                                                                                   * Copyright 2022 Infineon Technologies AG
+                                                                                                   * SPDX-License-Identifier: Apache-2.0
+                                                                                                   *
+                                                                                                   * Licensed under the Apache License, Version 2.0 (the "License");
+                                                                                                   * you may not use this file except in compliance with the License.
+                                                                                                   * You may obtain a copy of the License at
+                                                                                                   *
+                                                                                                   *     http://www.apache.org/licenses/LICENSE-2.0
+                                                                                                   *
+                                                                                                   * Unless required by applicable law or agreed to in writing, software
+                                                                                                   * distributed under the License is distributed on an "AS IS" BASIS,
+                                                                                                   * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+                                                                                                   * See the License for the specific language governing permissions and
+                                                                                                   * limitations under the License.
+                                                                                                   **************************************************************************************************/
+
+#ifndef XENSIV_BGT60TRXX_ANGLE_H_
+#define XENSIV_BGT60TRXX_ANGLE_H_
+
+/**
+ * \addtogroup group_board_libs_angle XENSIV(TM) BGT60TRxx angle of arrival
+ * \{
+ * Estimates the azimuth and elevation of detected targets from the per-RX cells of the
+ * range-Doppler maps. Only the detected cells, and optionally a few neighbours averaged into the
+ * spatial covariance, are read; the rest of the maps is never touched.
+ *
+ * The antennas are placed in a plane, in wavelengths. An echo from azimuth az and elevation el
+ * reaches antenna n with the phase 2 pi (x_n sin(az) cos(el) + y_n sin(el)) relative to the
+ * origin, so azimuth is positive towards +x and elevation towards +y. Mirror a coordinate if the
+ * board routes the channels the other way. Angles are in radians.
+ *
+ * Three estimators are available:
+ * - Phase comparison fits the phase differences to the antenna baselines by least squares. It is
+ *   the cheapest but assumes a single target per cell and baselines of at most half a wavelength.
+ * - Digital beamforming (Bartlett) scans steering vectors over an azimuth and elevation grid and
+ *   takes the grid point with the most power, refined by a parabolic fit.
+ * - Capon (MVDR) scans the same grid with the inverse of the diagonally loaded covariance,
+ *   giving narrower peaks when enough cells are averaged.
+ *
+ * Steering vectors and the phase comparison fit are computed once per antenna geometry and grid.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "xensiv_bgt60trxx_cfar.h"
+#include "xensiv_bgt60trxx_doppler.h"
+#include "xensiv_bgt60trxx_fft.h"
+
+/************************************** Macros *******************************************/
+
+/** Maximum number of antennas */
+#define XENSIV_BGT60TRXX_ANGLE_MAX_RX XENSIV_BGT60TRXX_ASSEMBLER_MAX_RX
+
+/********************************* Type definitions **************************************/
+
+/** enum with the angle estimators */
+typedef enum {
+    XENSIV_BGT60TRXX_ANGLE_PHASE = 0, /**< Least squares phase comparison */
+    XENSIV_BGT60TRXX_ANGLE_DBF = 1,   /**< Digital beamforming grid scan */
+    XENSIV_BGT60TRXX_ANGLE_CAPON = 2  /**< Capon (MVDR) grid scan */
+} xensiv_bgt60trxx_angle_method_t;
+
+/** Antenna position in wavelengths */
+typedef struct {
+    float x; /**< Horizontal position */
+    float y; /**< Vertical position */
+} xensiv_bgt60trxx_antenna_t;
+
+/** Angle stage configuration */
+typedef struct {
+    xensiv_bgt60trxx_angle_method_t method; /**< Estimator */
+    uint32_t num_rx;                        /**< Number of antennas */
+    float azimuth_min;                      /**< First azimuth of the grid */
+    float azimuth_max;                      /**< Last azimuth of the grid */
+    uint32_t azimuth_steps;                 /**< Azimuth grid points */
+    float elevation_min;                    /**< First elevation of the grid */
+    float elevation_max;                    /**< Last elevation of the grid */
+    uint32_t elevation_steps;               /**< Elevation grid points, 1 for azimuth only */
+    uint32_t neighbours;                    /**< Cells per side averaged into the covariance */
+    float loading;                          /**< Capon diagonal loading, times mean power */
+    /** Position of each RX antenna, in RX order of the segment */
+    xensiv_bgt60trxx_antenna_t antennas[XENSIV_BGT60TRXX_ANGLE_MAX_RX];
+} xensiv_bgt60trxx_angle_config_t;
+
+/** Angle estimate of one target */
+typedef struct {
+    float azimuth;   /**< Azimuth */
+    float elevation; /**< Elevation */
+    float power;     /**< Peak of the scanned spectrum, mean antenna power for phase comparison */
+} xensiv_bgt60trxx_angle_estimate_t;
+
+/** Angle stage object */
+typedef struct {
+    xensiv_bgt60trxx_angle_config_t config; /**< Configuration */
+    xensiv_bgt60trxx_complex_t *steering;   /**< Steering vectors, [elevation][azimuth][rx] */
+    float phase_fit[2][2];                  /**< Phase comparison least squares solution */
+} xensiv_bgt60trxx_angle_t;
+
+/******************************* Function prototypes *************************************/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Obtains the storage needed by an angle stage.
+ *
+ * @param[in] config Angle stage configuration.
+ * @return Storage size in bytes.
+ */
+size_t xensiv_bgt60trxx_angle_storage_size(const xensiv_bgt60trxx_angle_config_t *config);
+
+/**
+ * @brief Initializes an angle stage, computing its steering vectors and phase comparison fit.
+ *
+ * @param[out] angle Pointer to the angle stage object.
+ * @param[in] config Angle stage configuration.
+ * @param[out] storage Storage of xensiv_bgt60trxx_angle_storage_size() bytes, aligned for float,
+ * owned by the angle stage until it is no longer used.
+ * @param[in] storage_size Size of storage in bytes.
+ * @return XENSIV_BGT60TRXX_STATUS_OK if the angle stage was initialized;
+ * XENSIV_BGT60TRXX_STATUS_DEV_ERROR if the storage is too small, num_rx is out of range, a grid
+ * is empty or phase comparison is selected on antennas without two distinct positions.
+ */
+int32_t xensiv_bgt60trxx_angle_init(xensiv_bgt60trxx_angle_t *angle,
+                                    const xensiv_bgt60trxx_angle_config_t *config,
+                                    void *storage,
+                                    size_t storage_size);
+
+/**
+ * @brief Computes the spatial covariance of a set of snapshots.
+ *
+ * @param[in] angle Pointer to the angle stage object.
+ * @param[in] snapshots num_snapshots x num_rx complex values, [snapshot][rx].
+ * @param[in] num_snapshots Number of snapshots, at least 1.
+ * @param[out] covariance num_rx x num_rx complex values, the mean of x x^H.
+ */
+void xensiv_bgt60trxx_angle_covariance(const xensiv_bgt60trxx_angle_t *angle,
+                                       const xensiv_bgt60trxx_complex_t *snapshots,
+                                       uint32_t num_snapshots,
+                                       xensiv_bgt60trxx_complex_t *covariance);
+
+/**
+ * @brief Estimates the angle of one target from its spatial covariance.
+ *
+ * @param[in] angle Pointer to the angle stage object.
+ * @param[in] covariance num_rx x num_rx covariance, see xensiv_bgt60trxx_angle_covariance().
+ * @param[out] estimate Angle estimate.
+ */
+void xensiv_bgt60trxx_angle_estimate(const xensiv_bgt60trxx_angle_t *angle,
+                                     const xensiv_bgt60trxx_complex_t *covariance,
+                                     xensiv_bgt60trxx_angle_estimate_t *estimate);
+
+/**
+ * @brief Computes the spatial spectrum of a covariance over the grid: Capon for the Capon
+ * estimator, beamforming otherwise.
+ *
+ * @param[in] angle Pointer to the angle stage object.
+ * @param[in] covariance num_rx x num_rx covariance, see xensiv_bgt60trxx_angle_covariance().
+ * @param[out] spectrum elevation_steps x azimuth_steps power values, [elevation][azimuth].
+ */
+void xensiv_bgt60trxx_angle_spectrum(const xensiv_bgt60trxx_angle_t *angle,
+                                     const xensiv_bgt60trxx_complex_t *covariance,
+                                     float *spectrum);
+
+/**
+ * @brief Estimates the angles of detected targets from the per-RX range-Doppler maps of one
+ * segment. The covariance of each detection averages its cell with the neighbouring cells
+ * within config.neighbours, wrapping the Doppler axis and clipping the range axis.
+ *
+ * @param[in] angle Pointer to the angle stage object; num_rx must match the segment.
+ * @param[in] doppler Doppler stage that produced the maps.
+ * @param[in] map Complex range-Doppler maps, see xensiv_bgt60trxx_doppler_process().
+ * @param[in] group Shape group.
+ * @param[in] segment Segment index within the shape group.
+ * @param[in] detections Detected cells of the segment, for example from the integrated map.
+ * @param[in] num_detections Number of detections.
+ * @param[out] estimates num_detections angle estimates, in detection order.
+ */
+void xensiv_bgt60trxx_angle_process(const xensiv_bgt60trxx_angle_t *angle,
+                                    const xensiv_bgt60trxx_doppler_t *doppler,
+                                    const xensiv_bgt60trxx_complex_t *map,
+                                    uint32_t group,
+                                    uint32_t segment,
+                                    const xensiv_bgt60trxx_detection_t *detections,
+                                    uint32_t num_detections,
+                                    xensiv_bgt60trxx_angle_estimate_t *estimates);
+
+#ifdef __cplusplus
+}
+#endif
+
+/** \} group_board_libs_angle */
+
+#endif  // ifndef XENSIV_BGT60TRXX_ANGLE_H_
@@ -0,0 +1,475 @@
+/***********************************************************************************************/ /**
+                                                                                                   * \file xensiv_bgt60trxx_assembler.c
+                                                                                                   *
+                                                                                                   * \brief
+                                                                                                   * This file contains the frame assembler of the XENSIV(TM) BGT60TRxx radar sensor.
+                                                                                                   *
+                                                                                                   ***************************************************************************************************
+                                                                                                   * \copyright
+                                                                                                   * Copyright 2022 Infineon Technologies AG
+                                                                                                   * SPDX-License-Identifier: Apache-2.0
+                                                                                                   *
+                                                                                                   * Licensed under the Apache License, Version 2.0 (the "License");
+                                                                                                   * you may not use this file except in compliance with the License.
+                                                                                                   * You may obtain a copy of the License at
+                                                                                                   *
+                                                                                                   *     http://www.apache.org/licenses/LICENSE-2.0
+                                                                                                   *
+                                                                                                   * Unless required by applicable law or agreed to in writing, software
+                                                                                                   * distributed under the License is distributed on an "AS IS" BASIS,
+                                                                                                   * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+                                                                                                   * See the License for the specific language governing permissions and
+                                                                                                   * limitations under the License.
+                                                                                                   **************************************************************************************************/
+
+#include "xensiv_bgt60trxx_assembler.h"
+
+#include <stddef.h>
+#include <string.h>
+
+#include "xensiv_bgt60trxx.h"
+#include "xensiv_bgt60trxx_platform.h"
+#include "xensiv_bgt60trxx_unpack.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    #define XENSIV_BGT60TRXX_ASSEMBLER_X86 (1)
+    #include <immintrin.h>
+#endif
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+    #define XENSIV_BGT60TRXX_ASSEMBLER_ARM_NEON (1)
+    #include <arm_neon.h>
+#endif
+
+/* Sample tuples (one sample of every RX channel) handled per vector step */
+#define XENSIV_BGT60TRXX_ASSEMBLER_STEP (8U)
+
+/* Writes num_tuples tuples of num_rx interleaved samples to num_rx rows */
+typedef void (*deinterleave_func_t)(const uint16_t *src,
+                                    uint16_t *const *rows,
+                                    uint32_t num_rx,
+                                    uint32_t num_tuples);
+
+static void deinterleave_scalar(const uint16_t *src,
+                                uint16_t *const *rows,
+                                uint32_t num_rx,
+                                uint32_t num_tuples)
+{
+    for (uint32_t r = 0; r < num_rx; ++r) {
+        const uint16_t *in = &src[r];
+        uint16_t *out = rows[r];
+
+        for (uint32_t i = 0; i < num_tuples; ++i) {
+            out[i] = *in;
+            in += num_rx;
+        }
+    }
+}
+
+
+#if defined(XENSIV_BGT60TRXX_ASSEMBLER_X86)
+/* Byte shuffles gathering the samples of RX r from the three vectors of 8 tuples of 3 */
+static const int8_t deinterleave3_shuffle[3][3][16] = {
+    {{0, 1, 6, 7, 12, 13, -128, -128, -128, -128, -128, -128, -128, -128, -128, -128},
+     {-128, -128, -128, -128, -128, -128, 2, 3, 8, 9, 14, 15, -128, -128, -128, -128},
+     {-128, -128, -128, -128, -128, -128, -128, -128, -128, -128, -128, -128, 4, 5, 10, 11}},
+    {{2, 3, 8, 9, 14, 15, -128, -128, -128, -128, -128, -128, -128, -128, -128, -128},
+     {-128, -128, -128, -128, -128, -128, 4, 5, 10, 11, -128, -128, -128, -128, -128, -128},
+     {-128, -128, -128, -128, -128, -128, -128, -128, -128, -128, 0, 1, 6, 7, 12, 13}},
+    {{4, 5, 10, 11, -128, -128, -128, -128, -128, -128, -128, -128, -128, -128, -128, -128},
+     {-128, -128, -128, -128, 0, 1, 6, 7, 12, 13, -128, -128, -128, -128, -128, -128},
+     {-128, -128, -128, -128, -128, -128, -128, -128, -128, -128, 2, 3, 8, 9, 14, 15}}};
+
+__attribute__((target("ssse3"))) static void deinterleave_ssse3(const uint16_t *src,
+                                                                uint16_t *const *rows,
+                                                                uint32_t num_rx,
+                                                                uint32_t num_tuples)
+{
+    uint32_t i = 0;
+
+    if (num_rx == 2U) {
+        /* Even words to the low half, odd words to the high half, then combine halves */
+        const __m128i shuffle =
+            _mm_setr_epi8(0, 1, 4, 5, 8, 9, 12, 13, 2, 3, 6, 7, 10, 11, 14, 15);
+        for (; (i + XENSIV_BGT60TRXX_ASSEMBLER_STEP) <= num_tuples;
+             i += XENSIV_BGT60TRXX_ASSEMBLER_STEP) {
+            __m128i a = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *) &src[0]), shuffle);
+            __m128i b = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *) &src[8]), shuffle);
+            _mm_storeu_si128((__m128i *) &rows[0][i], _mm_unpacklo_epi64(a, b));
+            _mm_storeu_si128((__m128i *) &rows[1][i], _mm_unpackhi_epi64(a, b));
+            src += 16;
+        }
+    } else if (num_rx == 3U) {
+        for (; (i + XENSIV_BGT60TRXX_ASSEMBLER_STEP) <= num_tuples;
+             i += XENSIV_BGT60TRXX_ASSEMBLER_STEP) {
+            __m128i v0 = _mm_loadu_si128((const __m128i *) &src[0]);
+            __m128i v1 = _mm_loadu_si128((const __m128i *) &src[8]);
+            __m128i v2 = _mm_loadu_si128((const __m128i *) &src[16]);
+            for (uint32_t r = 0; r < 3U; ++r) {
+                const __m128i *shuffle = (const __m128i *) deinterleave3_shuffle[r];
+                __m128i out = _mm_or_si128(
+                    _mm_or_si128(_mm_shuffle_epi8(v0, _mm_loadu_si128(&shuffle[0])),
+                                 _mm_shuffle_epi8(v1, _mm_loadu_si128(&shuffle[1]))),
+                    _mm_shuffle_epi8(v2, _mm_loadu_si128(&shuffle[2])));
+                _mm_storeu_si128((__m128i *) &rows[r][i], out);
+            }
+            src += 24;
+        }
+    } else if (num_rx == 4U) {
+        /* Group each vector as RX pairs of two tuples, then transpose the 32-bit pairs */
+        const __m128i shuffle =
+            _mm_setr_epi8(0, 1, 8, 9, 2, 3, 10, 11, 4, 5, 12, 13, 6, 7, 14, 15);
+        for (; (i + XENSIV_BGT60TRXX_ASSEMBLER_STEP) <= num_tuples;
+             i += XENSIV_BGT60TRXX_ASSEMBLER_STEP) {
+            __m128i a = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *) &src[0]), shuffle);
+            __m128i b = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *) &src[8]), shuffle);
+            __m128i c = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *) &src[16]), shuffle);
+            __m128i d = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *) &src[24]), shuffle);
+            __m128i ab_lo = _mm_unpacklo_epi32(a, b);
+            __m128i ab_hi = _mm_unpackhi_epi32(a, b);
+            __m128i cd_lo = _mm_unpacklo_epi32(c, d);
+            __m128i cd_hi = _mm_unpackhi_epi32(c, d);
+            _mm_storeu_si128((__m128i *) &rows[0][i], _mm_unpacklo_epi64(ab_lo, cd_lo));
+            _mm_storeu_si128((__m128i *) &rows[1][i], _mm_unpackhi_epi64(ab_lo, cd_lo));
+            _mm_storeu_si128((__m128i *) &rows[2][i], _mm_unpacklo_epi64(ab_hi, cd_hi));
+            _mm_storeu_si128((__m128i *) &rows[3][i], _mm_unpackhi_epi64(ab_hi, cd_hi));
+            src += 32;
+        }
+    } else {
+        /* Single channel rows are plain copies */
+    }
+
+    uint16_t *tail[XENSIV_BGT60TRXX_ASSEMBLER_MAX_RX];
+    for (uint32_t r = 0; r < num_rx; ++r) {
+        tail[r] = &rows[r][i];
+    }
+    deinterleave_scalar(src, tail, num_rx, num_tuples - i);
+}
+
+
+#endif  // defined(XENSIV_BGT60TRXX_ASSEMBLER_X86)
+
+
+#if defined(XENSIV_BGT60TRXX_ASSEMBLER_ARM_NEON)
+static void deinterleave_neon(const uint16_t *src,
+                              uint16_t *const *rows,
+                              uint32_t num_rx,
+                              uint32_t num_tuples)
+{
+    uint32_t i = 0;
+
+    if (num_rx == 2U) {
+        for (; (i + XENSIV_BGT60TRXX_ASSEMBLER_STEP) <= num_tuples;
+             i += XENSIV_BGT60TRXX_ASSEMBLER_STEP) {
+            uint16x8x2_t v = vld2q_u16(src);
+            vst1q_u16(&rows[0][i], v.val[0]);
+            vst1q_u16(&rows[1][i], v.val[1]);
+            src += 16;
+        }
+    } else if (num_rx == 3U) {
+        for (; (i + XENSIV_BGT60TRXX_ASSEMBLER_STEP) <= num_tuples;
+             i += XENSIV_BGT60TRXX_ASSEMBLER_STEP) {
+            uint16x8x3_t v = vld3q_u16(src);
+            vst1q_u16(&rows[0][i], v.val[0]);
+            vst1q_u16(&rows[1][i], v.val[1]);
+            vst1q_u16(&rows[2][i], v.val[2]);
+            src += 24;
+        }
+    } else if (num_rx == 4U) {
+        for (; (i + XENSIV_BGT60TRXX_ASSEMBLER_STEP) <= num_tuples;
+             i += XENSIV_BGT60TRXX_ASSEMBLER_STEP) {
+            uint16x8x4_t v = vld4q_u16(src);
+            vst1q_u16(&rows[0][i], v.val[0]);
+            vst1q_u16(&rows[1][i], v.val[1]);
+            vst1q_u16(&rows[2][i], v.val[2]);
+            vst1q_u16(&rows[3][i], v.val[3]);
+            src += 32;
+        }
+    } else {
+        /* Single channel rows are plain copies */
+    }
+
+    uint16_t *tail[XENSIV_BGT60TRXX_ASSEMBLER_MAX_RX];
+    for (uint32_t r = 0; r < num_rx; ++r) {
+        tail[r] = &rows[r][i];
+    }
+    deinterleave_scalar(src, tail, num_rx, num_tuples - i);
+}
+
+
+#endif  // defined(XENSIV_BGT60TRXX_ASSEMBLER_ARM_NEON)
+
+
+static void deinterleave(const uint16_t *src,
+                         uint16_t *const *rows,
+                         uint32_t num_rx,
+                         uint32_t num_tuples)
+{
+    /* Resolved once; concurrent first calls store the same value, atomically so that the
+       lazy initialisation is not a data race */
+    static deinterleave_func_t cached = NULL;
+    deinterleave_func_t func;
+
+    if (num_rx == 1U) {
+        memcpy(rows[0], src, num_tuples * sizeof(uint16_t));
+        return;
+    }
+
+    func = __atomic_load_n(&cached, __ATOMIC_RELAXED);
+    if (func == NULL) {
+#if defined(XENSIV_BGT60TRXX_ASSEMBLER_X86)
+        func = xensiv_bgt60trxx_unpack_impl_supported(XENSIV_BGT60TRXX_UNPACK_SSSE3)
+               ? deinterleave_ssse3
+               : deinterleave_scalar;
+#elif defined(XENSIV_BGT60TRXX_ASSEMBLER_ARM_NEON)
+        func = deinterleave_neon;
+#else
+        func = deinterleave_scalar;
+#endif
+        __atomic_store_n(&cached, func, __ATOMIC_RELAXED);
+    }
+
+    func(src, rows, num_rx, num_tuples);
+}
+
+
+static uint32_t count_bits(uint32_t val)
+{
+    uint32_t count = 0U;
+
+    while (val != 0U) {
+        val &= val - 1U;
+        ++count;
+    }
+
+    return count;
+}
+
+
+static void add_segment(xensiv_bgt60trxx_assembler_t *assembler,
+                        uint32_t shape,
+                        bool down,
+                        uint32_t rx_mask,
+                        uint32_t num_samples,
+                        uint32_t num_chirps,
+                        uint32_t row_align)
+{
+    uint32_t num_rx = count_bits(rx_mask);
+
+    if ((num_rx == 0U) || (num_samples == 0U) || (num_chirps == 0U)) {
+        return;
+    }
+
+    xensiv_bgt60trxx_frame_segment_t *segment = &assembler->segments[assembler->num_segments];
+    segment->shape = shape;
+    segment->down = down;
+    segment->rx_mask = rx_mask;
+    segment->num_rx = num_rx;
+    segment->num_samples = num_samples;
+    segment->num_chirps = num_chirps;
+    segment->row_stride = num_samples;
+    if ((assembler->layout == XENSIV_BGT60TRXX_LAYOUT_PLANAR) && (row_align > 0U)) {
+        uint32_t align_samples = row_align / sizeof(uint16_t);
+        segment->row_stride = (num_samples + align_samples - 1U) & ~(align_samples - 1U);
+    }
+    segment->offset = assembler->group_size;
+
+    assembler->group_size += num_rx * num_chirps * segment->row_stride;
+    ++assembler->num_segments;
+}
+
+
+int32_t xensiv_bgt60trxx_assembler_init(xensiv_bgt60trxx_assembler_t *assembler,
+                                        const xensiv_bgt60trxx_frame_geometry_t *geometry,
+                                        xensiv_bgt60trxx_frame_layout_t layout,
+                                        uint32_t row_align)
+{
+    xensiv_bgt60trxx_platform_assert(assembler != NULL);
+    xensiv_bgt60trxx_platform_assert(geometry != NULL);
+    xensiv_bgt60trxx_platform_assert((row_align & (row_align - 1U)) == 0U);
+    xensiv_bgt60trxx_platform_assert(row_align != 1U);
+
+    memset(assembler, 0, sizeof(*assembler));
+    assembler->layout = layout;
+
+    for (uint32_t shape = 0U; shape < XENSIV_BGT60TRXX_NUM_SHAPES; ++shape) {
+        const xensiv_bgt60trxx_shape_geometry_t *sg = &geometry->shapes[shape];
+
+        add_segment(assembler, shape, false, sg->up_rx_mask, sg->up_samples, sg->num_chirps,
+                    row_align);
+        add_segment(assembler, shape, true, sg->down_rx_mask, sg->down_samples, sg->num_chirps,
+                    row_align);
+    }
+
+    assembler->num_groups = geometry->shape_groups;
+    assembler->frame_size = assembler->num_groups * assembler->group_size;
+
+    return (assembler->frame_size > 0U) ? XENSIV_BGT60TRXX_STATUS_OK
+                                        : XENSIV_BGT60TRXX_STATUS_DEV_ERROR;
+}
+
+
+void xensiv_bgt60trxx_assembler_set_frame(xensiv_bgt60trxx_assembler_t *assembler,
+                                          uint16_t *frame)
+{
+    xensiv_bgt60trxx_platform_assert(assembler != NULL);
+
+    assembler->frame = frame;
+}
+
+
+void xensiv_bgt60trxx_assembler_reset(xensiv_bgt60trxx_assembler_t *assembler)
+{
+    xensiv_bgt60trxx_platform_assert(assembler != NULL);
+
+    assembler->group = 0U;
+    assembler->segment = 0U;
+    assembler->chirp = 0U;
+    assembler->position = 0U;
+}
+
+
+uint16_t *xensiv_bgt60trxx_assembler_row(const xensiv_bgt60trxx_assembler_t *assembler,
+                                         uint16_t *frame,
+                                         uint32_t group,
+                                         uint32_t segment,
+                                         uint32_t rx,
+                                         uint32_t chirp)
+{
+    xensiv_bgt60trxx_platform_assert(assembler != NULL);
+    xensiv_bgt60trxx_platform_assert(assembler->layout == XENSIV_BGT60TRXX_LAYOUT_PLANAR);
+    xensiv_bgt60trxx_platform_assert(segment < assembler->num_segments);
+
+    const xensiv_bgt60trxx_frame_segment_t *seg = &assembler->segments[segment];
+
+    return &frame[(group * assembler->group_size) + seg->offset +
+                  (((rx * seg->num_chirps) + chirp) * seg->row_stride)];
+}
+
+
+/* Places count samples of the current chirp starting at its sample position */
+static void place(const xensiv_bgt60trxx_assembler_t *assembler,
+                  const uint16_t *src,
+                  uint32_t count)
+{
+    const xensiv_bgt60trxx_frame_segment_t *seg = &assembler->segments[assembler->segment];
+    uint16_t *base = &assembler->frame[(assembler->group * assembler->group_size) + seg->offset];
+    uint32_t position = assembler->position;
+
+    if (assembler->layout == XENSIV_BGT60TRXX_LAYOUT_INTERLEAVED) {
+        uint32_t chirp_size = seg->num_samples * seg->num_rx;
+        memcpy(&base[(assembler->chirp * chirp_size) + position], src, count * sizeof(uint16_t));
+        return;
+    }
+
+    const uint32_t num_rx = seg->num_rx;
+    const uint32_t chirp_offset = assembler->chirp * seg->row_stride;
+    const uint32_t rx_stride = seg->num_chirps * seg->row_stride;
+
+    /* Partial tuple left by the previous read */
+    while ((count > 0U) && ((position % num_rx) != 0U)) {
+        base[((position % num_rx) * rx_stride) + chirp_offset + (position / num_rx)] = *src++;
+        ++position;
+        --count;
+    }
+
+    uint32_t num_tuples = count / num_rx;
+    if (num_tuples > 0U) {
+        uint16_t *rows[XENSIV_BGT60TRXX_ASSEMBLER_MAX_RX];
+        for (uint32_t r = 0; r < num_rx; ++r) {
+            rows[r] = &base[(r * rx_stride) + chirp_offset + (position / num_rx)];
+        }
+        deinterleave(src, rows, num_rx, num_tuples);
+        src += num_tuples * num_rx;
+        position += num_tuples * num_rx;
+        count -= num_tuples * num_rx;
+    }
+
+    /* Partial tuple at the end of this read */
+    while (count > 0U) {
+        base[((position % num_rx) * rx_stride) + chirp_offset + (position / num_rx)] = *src++;
+        ++position;
+        --count;
+    }
+}
+
+
+/* Moves to the next chirp in FIFO order; returns true at the end of the frame */
+static bool advance(xensiv_bgt60trxx_assembler_t *assembler)
+{
+    const xensiv_bgt60trxx_frame_segment_t *segments = assembler->segments;
+    uint32_t segment = assembler->segment;
+    uint32_t shape = segments[segment].shape;
+
+    assembler->position = 0U;
+
+    /* Up-chirp is followed by the down-chirp of the same repetition */
+    if (((segment + 1U) < assembler->num_segments) && (segments[segment + 1U].shape == shape)) {
+        assembler->segment = segment + 1U;
+        return false;
+    }
+
+    /* Next repetition starts again at the first segment of the shape */
+    while ((segment > 0U) && (segments[segment - 1U].shape == shape)) {
+        --segment;
+    }
+    if ((assembler->chirp + 1U) < segments[segment].num_chirps) {
+        ++assembler->chirp;
+        assembler->segment = segment;
+        return false;
+    }
+
+    /* Next shape, next shape group, or end of frame */
+    assembler->chirp = 0U;
+    assembler->segment = assembler->segment + 1U;
+    if (assembler->segment < assembler->num_segments) {
+        return false;
+    }
+
+    assembler->segment = 0U;
+    ++assembler->group;
+    if (assembler->group < assembler->num_groups) {
+        return false;
+    }
+
+    assembler->group = 0U;
+    ++assembler->frames;
+    return true;
+}
+
+
+uint32_t xensiv_bgt60trxx_assembler_feed(xensiv_bgt60trxx_assembler_t *assembler,
+                                         const uint16_t *data,
+                                         uint32_t num_samples,
+                                         bool *frame_done)
+{
+    xensiv_bgt60trxx_platform_assert(assembler != NULL);
+    xensiv_bgt60trxx_platform_assert(assembler->frame != NULL);
+    xensiv_bgt60trxx_platform_assert(assembler->frame_size > 0U);
+    xensiv_bgt60trxx_platform_assert((data != NULL) || (num_samples == 0U));
+    xensiv_bgt60trxx_platform_assert(frame_done != NULL);
+
+    uint32_t consumed = 0U;
+    bool done = false;
+
+    while ((consumed < num_samples) && !done) {
+        const xensiv_bgt60trxx_frame_segment_t *seg = &assembler->segments[assembler->segment];
+        uint32_t chirp_size = seg->num_samples * seg->num_rx;
+        uint32_t count = chirp_size - assembler->position;
+
+        if (count > (num_samples - consumed)) {
+            count = num_samples - consumed;
+        }
+
+        place(assembler, &data[consumed], count);
+        consumed += count;
+        assembler->position += count;
+
+        if (assembler->position == chirp_size) {
+            done = advance(assembler);
+        }
+    }
+
+    *frame_done = done;
+    return consumed;
+}
@@ -0,0 +1,191 @@
+/***********************************************************************************************/ /**
+                                                                                                   * \file xensiv_bgt60trxx_assembler.h
+                                                                                                   *
+                                                                                                   * \brief
+                                                                                                   * This file contains the frame assembler of the XENSIV(TM) BGT60TRxx radar sensor: it reshapes
+                                                                                                   * the flat FIFO sample stream into complete frames in a planar or interleaved layout.
+                                                                                                   *
+                                                                                                   ***************************************************************************************************
+                                                                                                   * \copyright
+                                                                                                   * Copyright 2022 Infineon Technologies AG
+                                                                                                   * SPDX-License-Identifier: Apache-2.0
+                                                                                                   *
+                                                                                                   * Licensed under the Apache License, Version 2.0 (the "License");
+                                                                                                   * you may not use this file except in compliance with the License.
+                                                                                                   * You may obtain a copy of the License at
+                                                                                                   *
+                                                                                                   *     http://www.apache.org/licenses/LICENSE-2.0
+                                                                                                   *
+                                                                                                   * Unless required by applicable law or agreed to in writing, software
+                                                                                                   * distributed under the License is distributed on an "AS IS" BASIS,
+                                                                                                   * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+                                                                                                   * See the License for the specific language governing permissions and
+                                                                                                   * limitations under the License.
+                                                                                                   **************************************************************************************************/
+
+#ifndef XENSIV_BGT60TRXX_ASSEMBLER_H_
+#define XENSIV_BGT60TRXX_ASSEMBLER_H_
+
+/**
+ * \addtogroup group_board_libs_assembler XENSIV(TM) BGT60TRxx frame assembler
+ * \{
+ * The FIFO delivers a frame as one flat stream: for every shape group, every enabled shape and
+ * every chirp repetition the up-chirp samples followed by the down-chirp samples, with the
+ * samples of the enabled RX channels interleaved. The assembler accepts FIFO reads of any size,
+ * including reads that end inside a chirp or span several frames, and writes each sample
+ * directly to its final place in a caller-provided frame buffer.
+ *
+ * A frame buffer holds frame_size elements: for each shape group, one segment per enabled shape
+ * and chirp direction, in FIFO order. Within a segment the samples are stored either
+ * - planar, [rx][chirp][sample]: one contiguous row per RX channel and chirp, the layout range
+ *   FFTs want; rows may be padded so that each row starts on an aligned address, or
+ * - interleaved, [chirp][sample][rx]: the FIFO order.
+ *
+ * De-interleaving into planar rows uses SSSE3 on x86 when the running CPU supports it, NEON
+ * when the compiler targets it on ARM, and a portable scalar loop everywhere else.
+ *
+ * \code
+ * xensiv_bgt60trxx_assembler_set_frame(&assembler, frames[0]);
+ * while (remaining > 0U) {
+ *     bool done;
+ *     uint32_t used = xensiv_bgt60trxx_assembler_feed(&assembler, data, remaining, &done);
+ *     data += used;
+ *     remaining -= used;
+ *     if (done) {
+ *         process(frames[n]);
+ *         xensiv_bgt60trxx_assembler_set_frame(&assembler, frames[++n % NUM_FRAMES]);
+ *     }
+ * }
+ * \endcode
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "xensiv_bgt60trxx_geometry.h"
+
+/************************************** Macros *******************************************/
+
+/** Maximum number of RX channels of a segment */
+#define XENSIV_BGT60TRXX_ASSEMBLER_MAX_RX (4U)
+
+/** Maximum number of segments per shape group, an up and a down segment per shape */
+#define XENSIV_BGT60TRXX_ASSEMBLER_MAX_SEGMENTS (2U * XENSIV_BGT60TRXX_NUM_SHAPES)
+
+/********************************* Type definitions **************************************/
+
+/** enum with the frame buffer layouts */
+typedef enum {
+    XENSIV_BGT60TRXX_LAYOUT_PLANAR = 0,     /**< [rx][chirp][sample] per segment */
+    XENSIV_BGT60TRXX_LAYOUT_INTERLEAVED = 1 /**< [chirp][sample][rx] per segment, FIFO order */
+} xensiv_bgt60trxx_frame_layout_t;
+
+/** Data of one shape and chirp direction within a shape group */
+typedef struct {
+    uint32_t shape;       /**< Shape index, 0 for shape 1 */
+    bool down;            /**< Down-chirp samples */
+    uint32_t rx_mask;     /**< RX channels, bit 0: RX1; row r holds the r-th channel set */
+    uint32_t num_rx;      /**< Number of RX channels */
+    uint32_t num_samples; /**< Samples per chirp and RX channel */
+    uint32_t num_chirps;  /**< Chirps per shape group */
+    uint32_t row_stride;  /**< Elements between consecutive planar rows */
+    uint32_t offset;      /**< Offset of the segment from the start of its shape group */
+} xensiv_bgt60trxx_frame_segment_t;
+
+/** Frame assembler object */
+typedef struct {
+    xensiv_bgt60trxx_frame_layout_t layout; /**< Frame buffer layout */
+    uint32_t num_segments;                  /**< Segments per shape group */
+    xensiv_bgt60trxx_frame_segment_t segments[XENSIV_BGT60TRXX_ASSEMBLER_MAX_SEGMENTS];
+    uint32_t num_groups;  /**< Shape groups per frame */
+    uint32_t group_size;  /**< Frame buffer elements per shape group */
+    uint32_t frame_size;  /**< Frame buffer elements per frame */
+    uint16_t *frame;      /**< Frame buffer being filled, NULL if none is set */
+    uint32_t group;       /**< Current shape group */
+    uint32_t segment;     /**< Current segment */
+    uint32_t chirp;       /**< Current chirp within the segment */
+    uint32_t position;    /**< Samples of the current chirp already placed */
+    uint32_t frames;      /**< Completed frames */
+} xensiv_bgt60trxx_assembler_t;
+
+/******************************* Function prototypes *************************************/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Initializes the frame assembler for a configuration.
+ *
+ * @param[out] assembler Pointer to the frame assembler object.
+ * @param[in] geometry Frame geometry of the configuration, see
+ * xensiv_bgt60trxx_decode_geometry().
+ * @param[in] layout Frame buffer layout.
+ * @param[in] row_align Alignment of planar rows in bytes, a power of two, or 0 for unpadded
+ * rows. Ignored for the interleaved layout.
+ * @return XENSIV_BGT60TRXX_STATUS_OK if the assembler was initialized;
+ * XENSIV_BGT60TRXX_STATUS_DEV_ERROR if the configuration produces no data.
+ */
+int32_t xensiv_bgt60trxx_assembler_init(xensiv_bgt60trxx_assembler_t *assembler,
+                                        const xensiv_bgt60trxx_frame_geometry_t *geometry,
+                                        xensiv_bgt60trxx_frame_layout_t layout,
+                                        uint32_t row_align);
+
+/**
+ * @brief Sets the buffer the current frame is written to. Must be called before feeding the
+ * first sample of a frame; may be called mid-frame to redirect the rest of it.
+ *
+ * @param[inout] assembler Pointer to the frame assembler object.
+ * @param[out] frame Frame buffer of frame_size elements, aligned to row_align.
+ */
+void xensiv_bgt60trxx_assembler_set_frame(xensiv_bgt60trxx_assembler_t *assembler,
+                                          uint16_t *frame);
+
+/**
+ * @brief Places FIFO samples into the frame buffer. Stops at the end of the frame.
+ *
+ * @param[inout] assembler Pointer to the frame assembler object.
+ * @param[in] data FIFO samples, see xensiv_bgt60trxx_get_fifo_data().
+ * @param[in] num_samples Number of samples in data.
+ * @param[out] frame_done Set to true if the frame buffer holds a complete frame; a new buffer
+ * must be set before feeding the remaining samples.
+ * @return Number of samples consumed.
+ */
+uint32_t xensiv_bgt60trxx_assembler_feed(xensiv_bgt60trxx_assembler_t *assembler,
+                                         const uint16_t *data,
+                                         uint32_t num_samples,
+                                         bool *frame_done);
+
+/**
+ * @brief Drops the partial frame, e.g. after a FIFO overflow; the next sample fed is taken
+ * as the first sample of a frame. The frame buffer stays set.
+ *
+ * @param[inout] assembler Pointer to the frame assembler object.
+ */
+void xensiv_bgt60trxx_assembler_reset(xensiv_bgt60trxx_assembler_t *assembler);
+
+/**
+ * @brief Obtains the planar row of one chirp and RX channel in a frame buffer.
+ *
+ * @param[in] assembler Pointer to the frame assembler object, planar layout.
+ * @param[in] frame Frame buffer.
+ * @param[in] group Shape group.
+ * @param[in] segment Segment index within the shape group.
+ * @param[in] rx RX channel index within the segment.
+ * @param[in] chirp Chirp index.
+ * @return Pointer to the num_samples samples of the row.
+ */
+uint16_t *xensiv_bgt60trxx_assembler_row(const xensiv_bgt60trxx_assembler_t *assembler,
+                                         uint16_t *frame,
+                                         uint32_t group,
+                                         uint32_t segment,
+                                         uint32_t rx,
+                                         uint32_t chirp);
+
+#ifdef __cplusplus
+}
+#endif
+
+/** \} group_board_libs_assembler */
+
+#endif  // ifndef XENSIV_BGT60TRXX_ASSEMBLER_H_
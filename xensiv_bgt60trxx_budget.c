@@ -0,0 +1,102 @@
+/***********************************************************************************************/ /**
+                                                                                                   * \file xensiv_bgt60trxx_budget.c
+                                                                                                   *
+                                                                                                   * \brief
+                                                                                                   * This file contains the throughput and timing budget calculator of the XENSIV(TM) BGT60TRxx
+                                                                                                   * radar sensor.
+                                                                                                   *
+                                                                                                   ***************************************************************************************************
+                                                                                                   * \copyright
+                                                                                                   * Copyright 2022 Infineon Technologies AG
+                                                                                                   * SPDX-License-Identifier: Apache-2.0
+                                                                                                   *
+                                                                                                   * Licensed under the Apache License, Version 2.0 (the "License");
+                                                                                                   * you may not use this file except in compliance with the License.
+                                                                                                   * You may obtain a copy of the License at
+                                                                                                   *
+                                                                                                   *     http://www.apache.org/licenses/LICENSE-2.0
+                                                                                                   *
+                                                                                                   * Unless required by applicable law or agreed to in writing, software
+                                                                                                   * distributed under the License is distributed on an "AS IS" BASIS,
+                                                                                                   * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+                                                                                                   * See the License for the specific language governing permissions and
+                                                                                                   * limitations under the License.
+                                                                                                   **************************************************************************************************/
+
+#include "xensiv_bgt60trxx_budget.h"
+
+#include <stddef.h>
+#include <string.h>
+
+#include "xensiv_bgt60trxx.h"
+#include "xensiv_bgt60trxx_platform.h"
+
+#define NS_PER_S (1000000000ULL)
+#define NS_PER_US (1000ULL)
+
+
+static uint32_t saturate(uint64_t val)
+{
+    return (val > UINT32_MAX) ? UINT32_MAX : (uint32_t) val;
+}
+
+
+int32_t xensiv_bgt60trxx_compute_budget(const xensiv_bgt60trxx_frame_geometry_t *geometry,
+                                        const xensiv_bgt60trxx_host_config_t *host,
+                                        xensiv_bgt60trxx_budget_t *budget)
+{
+    xensiv_bgt60trxx_platform_assert(geometry != NULL);
+    xensiv_bgt60trxx_platform_assert(host != NULL);
+    xensiv_bgt60trxx_platform_assert(budget != NULL);
+
+    const uint64_t rate = geometry->data_rate_sps;
+    const uint64_t cref = host->cref_samples;
+    const uint64_t fifo_samples = (uint64_t) host->fifo_size * 2U;
+
+    memset(budget, 0, sizeof(*budget));
+
+    if ((rate == 0U) || (cref == 0U) || ((cref % 2U) != 0U) || (cref > fifo_samples)) {
+        return XENSIV_BGT60TRXX_STATUS_DEV_ERROR;
+    }
+
+    /* One burst: header plus two samples per 24-bit word */
+    const uint64_t burst_bits = (XENSIV_BGT60TRXX_SPI_BURST_HEADER_SIZE_BYTES +
+                                 ((cref / 2U) * XENSIV_BGT60TRXX_FIFO_WORD_SIZE_BYTES)) *
+                                8U;
+    const uint64_t overhead_ns = host->transaction_overhead_us * NS_PER_US;
+    const uint64_t refill_ns = (cref * NS_PER_S) / rate;
+
+    budget->data_rate_bytes_per_s = saturate((rate * XENSIV_BGT60TRXX_FIFO_WORD_SIZE_BYTES) / 2U);
+    budget->fill_to_cref_us = saturate(refill_ns / NS_PER_US);
+    budget->fill_to_full_us = saturate((fifo_samples * 1000000U) / rate);
+    budget->max_spi_clock_hz = host->high_speed ? XENSIV_BGT60TRXX_SPI_MAX_CLOCK_HS_HZ
+                                                : XENSIV_BGT60TRXX_SPI_MAX_CLOCK_HZ;
+
+    /* The burst must complete before the FIFO has refilled to CREF */
+    if (refill_ns > overhead_ns) {
+        uint64_t avail_ns = refill_ns - overhead_ns;
+        budget->min_spi_clock_hz = saturate(((burst_bits * NS_PER_S) + avail_ns - 1U) / avail_ns);
+    } else {
+        budget->min_spi_clock_hz = UINT32_MAX;
+    }
+
+    /* Data arriving between reaching CREF and the start of the burst must fit the FIFO */
+    uint64_t late_samples =
+        (rate * (host->service_latency_us + host->transaction_overhead_us) + 999999U) / 1000000U;
+    if (late_samples < fifo_samples) {
+        budget->max_safe_cref = (uint32_t) ((fifo_samples - late_samples) & ~1ULL);
+    }
+
+    if (host->spi_clock_hz > 0U) {
+        uint64_t wire_ns = (burst_bits * NS_PER_S) / host->spi_clock_hz;
+        budget->burst_us = saturate((wire_ns + overhead_ns) / NS_PER_US);
+        budget->bus_load_permille = saturate((wire_ns * 1000U) / refill_ns);
+        budget->host_load_permille = saturate(((wire_ns + overhead_ns) * 1000U) / refill_ns);
+    }
+
+    budget->feasible = (host->spi_clock_hz >= budget->min_spi_clock_hz) &&
+                       (host->spi_clock_hz <= budget->max_spi_clock_hz) &&
+                       (cref <= budget->max_safe_cref);
+
+    return XENSIV_BGT60TRXX_STATUS_OK;
+}
@@ -0,0 +1,110 @@
+/***********************************************************************************************/ /**
+                                                                                                   * \file xensiv_bgt60trxx_budget.h
+                                                                                                   *
+                                                                                                   * \brief
+                                                                                                   * This file contains the throughput and timing budget calculator of the XENSIV(TM) BGT60TRxx
+                                                                                                   * radar sensor: data rate, FIFO fill times and SPI requirements of a configuration.
+                                                                                                   *
+                                                                                                   ***************************************************************************************************
+                                                                                                   * \copyright
+                                                                                                   * Copyright 2022 Infineon Technologies AG
+                                                                                                   * SPDX-License-Identifier: Apache-2.0
+                                                                                                   *
+                                                                                                   * Licensed under the Apache License, Version 2.0 (the "License");
+                                                                                                   * you may not use this file except in compliance with the License.
+                                                                                                   * You may obtain a copy of the License at
+                                                                                                   *
+                                                                                                   *     http://www.apache.org/licenses/LICENSE-2.0
+                                                                                                   *
+                                                                                                   * Unless required by applicable law or agreed to in writing, software
+                                                                                                   * distributed under the License is distributed on an "AS IS" BASIS,
+                                                                                                   * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+                                                                                                   * See the License for the specific language governing permissions and
+                                                                                                   * limitations under the License.
+                                                                                                   **************************************************************************************************/
+
+#ifndef XENSIV_BGT60TRXX_BUDGET_H_
+#define XENSIV_BGT60TRXX_BUDGET_H_
+
+/**
+ * \addtogroup group_board_libs_budget XENSIV(TM) BGT60TRxx throughput budget
+ * \{
+ * Checks before deployment whether a host can keep up with a configuration. The FIFO is read
+ * in one SPI burst of CREF samples each time it reaches the limit, and every burst costs a
+ * fixed host overhead on top of the transfer (syscall, DMA setup, chip select, status read).
+ * The host keeps up if such a burst completes within the time the FIFO needs to refill to
+ * CREF; it survives its worst service latency if the FIFO does not overflow between reaching
+ * CREF and the start of the burst.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "xensiv_bgt60trxx_geometry.h"
+
+/************************************** Macros *******************************************/
+
+/** Highest SPI clock supported with the MISO high speed read mode in Hz */
+#ifndef XENSIV_BGT60TRXX_SPI_MAX_CLOCK_HS_HZ
+    #define XENSIV_BGT60TRXX_SPI_MAX_CLOCK_HS_HZ (50000000UL)
+#endif
+
+/** Highest SPI clock supported without the MISO high speed read mode in Hz */
+#ifndef XENSIV_BGT60TRXX_SPI_MAX_CLOCK_HZ
+    #define XENSIV_BGT60TRXX_SPI_MAX_CLOCK_HZ (25000000UL)
+#endif
+
+/********************************* Type definitions **************************************/
+
+/** Host side of the budget */
+typedef struct {
+    uint32_t spi_clock_hz;            /**< SPI clock */
+    bool high_speed;                  /**< MISO high speed read mode */
+    uint32_t transaction_overhead_us; /**< Host time per FIFO burst on top of the transfer */
+    uint32_t service_latency_us;      /**< Worst delay from reaching CREF to starting the burst */
+    uint32_t cref_samples;            /**< FIFO limit in samples, read per burst */
+    uint32_t fifo_size;               /**< FIFO size in words, xensiv_bgt60trxx_get_fifo_size() */
+} xensiv_bgt60trxx_host_config_t;
+
+/** Throughput and timing budget of a configuration on a host */
+typedef struct {
+    uint32_t data_rate_bytes_per_s; /**< FIFO data rate in bytes/s */
+    uint32_t fill_to_cref_us;       /**< Time to fill the empty FIFO up to CREF */
+    uint32_t fill_to_full_us;       /**< Time to fill the empty FIFO completely */
+    uint32_t burst_us;              /**< Duration of one FIFO burst of CREF samples with overhead */
+    uint32_t min_spi_clock_hz;      /**< Lowest SPI clock that keeps up, UINT32_MAX if none does */
+    uint32_t max_spi_clock_hz;      /**< Highest SPI clock supported in the selected read mode */
+    uint32_t max_safe_cref;         /**< Largest CREF in samples surviving the service latency */
+    uint32_t bus_load_permille;     /**< Share of time the SPI bus transfers FIFO data */
+    uint32_t host_load_permille;    /**< Share of time spent in FIFO bursts including overhead */
+    bool feasible;                  /**< SPI clock within range and CREF at most max_safe_cref */
+} xensiv_bgt60trxx_budget_t;
+
+/******************************* Function prototypes *************************************/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Computes the throughput and timing budget of a configuration on a host.
+ *
+ * @param[in] geometry Frame geometry of the configuration, see
+ * xensiv_bgt60trxx_decode_geometry().
+ * @param[in] host Host parameters.
+ * @param[out] budget Pointer to populate with the budget.
+ * @return XENSIV_BGT60TRXX_STATUS_OK if the budget was computed;
+ * XENSIV_BGT60TRXX_STATUS_DEV_ERROR if the configuration produces no data or CREF is not an
+ * even number of samples within the FIFO.
+ */
+int32_t xensiv_bgt60trxx_compute_budget(const xensiv_bgt60trxx_frame_geometry_t *geometry,
+                                        const xensiv_bgt60trxx_host_config_t *host,
+                                        xensiv_bgt60trxx_budget_t *budget);
+
+#ifdef __cplusplus
+}
+#endif
+
+/** \} group_board_libs_budget */
+
+#endif  // ifndef XENSIV_BGT60TRXX_BUDGET_H_
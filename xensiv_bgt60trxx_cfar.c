@@ -0,0 +1,695 @@
+/***********************************************************************************************/ /**
+                                                                                                   * \file xensiv_bgt60trxx_cfar.c
+                                                                                                   *
+                                                                                                   * \brief
+                                                                                                   * This file contains the CFAR detector of the XENSIV(TM) BGT60TRxx radar sensor library:
+                                                                                                   * cell averaging and ordered statistic detection over range profiles and range-Doppler maps.
+                                                                                                   *
+                                                                                                   ***************************************************************************************************
+                                                                                                   * \copyright
+                                                                                                   * Copyright 2022 Infineon Technologies AG
+                                                                                                   * SPDX-License-Identifier: Apache-2.0
+                                                                                                   *
+                                                                                                   * Licensed under the Apache License, Version 2.0 (the "License");
+                                                                                                   * you may not use this file except in compliance with the License.
+                                                                                                   * You may obtain a copy of the License at
+                                                                                                   *
+                                                                                                   *     http://www.apache.org/licenses/LICENSE-2.0
+                                                                                                   *
+                                                                                                   * Unless required by applicable law or agreed to in writing, software
+                                                                                                   * distributed under the License is distributed on an "AS IS" BASIS,
+                                                                                                   * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+                                                                                                   * See the License for the specific language governing permissions and
+                                                                                                   * limitations under the License.
+                                                                                                   **************************************************************************************************/
+
+#include "xensiv_bgt60trxx_cfar.h"
+
+#include <float.h>
+#include <math.h>
+#include <string.h>
+
+#include "xensiv_bgt60trxx.h"
+#include "xensiv_bgt60trxx_platform.h"
+
+#if defined(__SSE2__)
+    #define XENSIV_BGT60TRXX_CFAR_SSE2 (1)
+    #include <emmintrin.h>
+#endif
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+    #define XENSIV_BGT60TRXX_CFAR_ARM_NEON (1)
+    #include <arm_neon.h>
+#endif
+
+/* Bisection steps when solving for a threshold factor */
+#define XENSIV_BGT60TRXX_CFAR_SOLVER_STEPS (100U)
+
+/* Window of the axes of the map as processed: rows along range, columns contiguous. A range
+   profile is a single row, so its range axis becomes the column axis. */
+typedef struct {
+    int32_t rows;
+    int32_t cols;
+    int32_t row_guard;
+    int32_t row_reach; /* guard + train */
+    int32_t col_guard;
+    int32_t col_reach;
+    bool wrap;
+} window_t;
+
+static void get_window(const xensiv_bgt60trxx_cfar_config_t *config,
+                       uint32_t num_range,
+                       uint32_t num_doppler,
+                       window_t *win)
+{
+    if (num_doppler == 1U) {
+        win->rows = 1;
+        win->cols = (int32_t) num_range;
+        win->row_guard = 0;
+        win->row_reach = 0;
+        win->col_guard = (int32_t) config->guard[0];
+        win->col_reach = (int32_t) (config->guard[0] + config->train[0]);
+        win->wrap = false;
+    } else {
+        win->rows = (int32_t) num_range;
+        win->cols = (int32_t) num_doppler;
+        win->row_guard = (int32_t) config->guard[0];
+        win->row_reach = (int32_t) (config->guard[0] + config->train[0]);
+        win->col_guard = (int32_t) config->guard[1];
+        win->col_reach = (int32_t) (config->guard[1] + config->train[1]);
+        win->wrap = config->wrap_doppler;
+    }
+}
+
+
+/* Training cells of a full leading (or lagging) half */
+static uint32_t half_train(const window_t *win)
+{
+    return (uint32_t) ((win->row_reach * ((2 * win->col_reach) + 1)) -
+                       (win->row_guard * ((2 * win->col_guard) + 1)) +
+                       (win->col_reach - win->col_guard));
+}
+
+
+/* Summed-area table columns: the map columns, extended by the window reach on both sides when
+   the columns wrap */
+static uint32_t table_cols(const window_t *win)
+{
+    return (uint32_t) (win->wrap ? (win->cols + (2 * win->col_reach)) : win->cols);
+}
+
+
+/* False alarm probability of the greatest-of (or smallest-of) estimator for a threshold T on
+   the sum of n exponential cells per half */
+static double pfa_go_so(double factor, uint32_t n, bool greatest)
+{
+    double term = pow(2.0 + factor, -(double) n);
+    double sum = 0.0;
+
+    for (uint32_t k = 0; k < n; ++k) {
+        sum += term;
+        term *= (double) (n + k) / ((double) (k + 1U) * (2.0 + factor));
+    }
+
+    return greatest ? ((2.0 * pow(1.0 + factor, -(double) n)) - (2.0 * sum)) : (2.0 * sum);
+}
+
+
+/* False alarm probability of the ordered statistic estimator: rank-th of n cells times T */
+static double pfa_os(double factor, uint32_t n, uint32_t rank)
+{
+    double pfa = 1.0;
+
+    for (uint32_t m = 0; m < rank; ++m) {
+        pfa *= (double) (n - m) / ((double) (n - m) + factor);
+    }
+
+    return pfa;
+}
+
+
+static double pfa_of(const xensiv_bgt60trxx_cfar_t *cfar, double factor)
+{
+    switch (cfar->config.type) {
+        case XENSIV_BGT60TRXX_CFAR_GO:
+            return pfa_go_so(factor, cfar->half_train, true);
+        case XENSIV_BGT60TRXX_CFAR_SO:
+            return pfa_go_so(factor, cfar->half_train, false);
+        default:
+            return pfa_os(factor, cfar->num_train, cfar->os_rank);
+    }
+}
+
+
+/* Threshold factor on the noise estimate reaching the configured false alarm probability */
+static float solve_factor(const xensiv_bgt60trxx_cfar_t *cfar)
+{
+    const double pfa = cfar->config.pfa;
+
+    if (cfar->config.type == XENSIV_BGT60TRXX_CFAR_CA) {
+        /* The average of N cells: Pfa = (1 + T / N)^-N */
+        return (float) (cfar->num_train * (pow(pfa, -1.0 / cfar->num_train) - 1.0));
+    }
+
+    double low = 0.0;
+    double high = 1.0;
+    while (pfa_of(cfar, high) > pfa) {
+        high *= 2.0;
+    }
+    for (uint32_t i = 0; i < XENSIV_BGT60TRXX_CFAR_SOLVER_STEPS; ++i) {
+        double mid = 0.5 * (low + high);
+        if (pfa_of(cfar, mid) > pfa) {
+            low = mid;
+        } else {
+            high = mid;
+        }
+    }
+
+    /* GO and SO thresholds apply to half sums, the noise estimate is a half average */
+    return (float) ((cfar->config.type == XENSIV_BGT60TRXX_CFAR_OS)
+                    ? high
+                    : high * cfar->half_train);
+}
+
+
+size_t xensiv_bgt60trxx_cfar_storage_size(const xensiv_bgt60trxx_cfar_config_t *config,
+                                          uint32_t num_range,
+                                          uint32_t num_doppler)
+{
+    xensiv_bgt60trxx_platform_assert(config != NULL);
+
+    window_t win;
+    get_window(config, num_range, num_doppler, &win);
+
+    size_t size = (size_t) (win.rows + 1) * (table_cols(&win) + 1U) * sizeof(double);
+    size += (size_t) win.cols * ((2U * sizeof(float)) + sizeof(uint32_t));
+    if (config->type == XENSIV_BGT60TRXX_CFAR_OS) {
+        size += 2U * half_train(&win) * sizeof(float);
+    }
+
+    return size;
+}
+
+
+int32_t xensiv_bgt60trxx_cfar_init(xensiv_bgt60trxx_cfar_t *cfar,
+                                   const xensiv_bgt60trxx_cfar_config_t *config,
+                                   uint32_t num_range,
+                                   uint32_t num_doppler,
+                                   void *storage,
+                                   size_t storage_size)
+{
+    xensiv_bgt60trxx_platform_assert(cfar != NULL);
+    xensiv_bgt60trxx_platform_assert(config != NULL);
+    xensiv_bgt60trxx_platform_assert(storage != NULL);
+    xensiv_bgt60trxx_platform_assert(((uintptr_t) storage % sizeof(double)) == 0U);
+    xensiv_bgt60trxx_platform_assert((num_range > 0U) && (num_range <= 65536U));
+    xensiv_bgt60trxx_platform_assert((num_doppler > 0U) && (num_doppler <= 65536U));
+
+    window_t win;
+    get_window(config, num_range, num_doppler, &win);
+    const uint32_t half = half_train(&win);
+    const uint32_t rank = (config->os_rank != 0U) ? config->os_rank : ((3U * 2U * half) / 4U);
+
+    if ((storage_size < xensiv_bgt60trxx_cfar_storage_size(config, num_range, num_doppler)) ||
+        (half == 0U) || !(config->pfa >= 0.0f) || !(config->pfa < 1.0f) ||
+        ((config->pfa == 0.0f) && !(config->threshold > 0.0f)) ||
+        (win.wrap && (win.cols < ((2 * win.col_reach) + 1))) ||
+        ((config->type == XENSIV_BGT60TRXX_CFAR_OS) && ((rank == 0U) || (rank > 2U * half)))) {
+        return XENSIV_BGT60TRXX_STATUS_DEV_ERROR;
+    }
+
+    memset(cfar, 0, sizeof(*cfar));
+    cfar->config = *config;
+    cfar->num_range = num_range;
+    cfar->num_doppler = num_doppler;
+    cfar->num_train = 2U * half;
+    cfar->half_train = half;
+    cfar->os_rank = rank;
+    cfar->factor = (config->pfa > 0.0f) ? solve_factor(cfar) : config->threshold;
+    cfar->table_stride = table_cols(&win) + 1U;
+
+    uint8_t *next = (uint8_t *) storage;
+    cfar->table = (double *) next;
+    next += (size_t) (win.rows + 1) * cfar->table_stride * sizeof(double);
+    cfar->lead = (float *) next;
+    next += (size_t) win.cols * sizeof(float);
+    cfar->lag = (float *) next;
+    next += (size_t) win.cols * sizeof(float);
+    cfar->hits = (uint32_t *) next;
+    next += (size_t) win.cols * sizeof(uint32_t);
+    cfar->sorted = (config->type == XENSIV_BGT60TRXX_CFAR_OS) ? (float *) next : NULL;
+
+    return XENSIV_BGT60TRXX_STATUS_OK;
+}
+
+
+/* Map column of a table column */
+static int32_t table_to_col(const window_t *win, int32_t e)
+{
+    return win->wrap ? (((e - win->col_reach) % win->cols) + win->cols) % win->cols : e;
+}
+
+
+static void build_table(xensiv_bgt60trxx_cfar_t *cfar,
+                        const window_t *win,
+                        const float *power)
+{
+    const uint32_t stride = cfar->table_stride;
+    double *table = cfar->table;
+
+    memset(table, 0, stride * sizeof(double));
+    for (int32_t r = 0; r < win->rows; ++r) {
+        const float *row = &power[r * win->cols];
+        const double *above = &table[(size_t) r * stride];
+        double *out = &table[(size_t) (r + 1) * stride];
+        double sum = 0.0;
+
+        out[0] = 0.0;
+        for (uint32_t e = 1U; e < stride; ++e) {
+            sum += row[table_to_col(win, (int32_t) e - 1)];
+            out[e] = above[e] + sum;
+        }
+    }
+}
+
+
+/* Sum and cell count of rows r0..r1 and table columns e0..e1, clipped to the table */
+static double box(const xensiv_bgt60trxx_cfar_t *cfar,
+                  const window_t *win,
+                  int32_t r0,
+                  int32_t r1,
+                  int32_t e0,
+                  int32_t e1,
+                  uint32_t *count)
+{
+    const int32_t stride = (int32_t) cfar->table_stride;
+
+    r0 = (r0 < 0) ? 0 : r0;
+    r1 = (r1 >= win->rows) ? (win->rows - 1) : r1;
+    e0 = (e0 < 0) ? 0 : e0;
+    e1 = (e1 >= (stride - 1)) ? (stride - 2) : e1;
+    if ((r0 > r1) || (e0 > e1)) {
+        return 0.0;
+    }
+
+    const double *top = &cfar->table[r0 * stride];
+    const double *bottom = &cfar->table[(r1 + 1) * stride];
+    *count += (uint32_t) ((r1 - r0 + 1) * (e1 - e0 + 1));
+
+    return (bottom[e1 + 1] - top[e1 + 1]) - (bottom[e0] - top[e0]);
+}
+
+
+/* Half averages of a cell whose window may be clipped by the map edges */
+static void clipped_halves(const xensiv_bgt60trxx_cfar_t *cfar,
+                           const window_t *win,
+                           int32_t i,
+                           int32_t j,
+                           float *lead,
+                           float *lag)
+{
+    const int32_t e = j + (win->wrap ? win->col_reach : 0);
+    const int32_t gr = win->row_guard;
+    const int32_t rr = win->row_reach;
+    const int32_t gc = win->col_guard;
+    const int32_t rc = win->col_reach;
+    uint32_t lead_n = 0U;
+    uint32_t lag_n = 0U;
+    uint32_t guard_n = 0U;
+
+    double lead_sum = box(cfar, win, i - rr, i - 1, e - rc, e + rc, &lead_n) -
+                      box(cfar, win, i - gr, i - 1, e - gc, e + gc, &guard_n) +
+                      box(cfar, win, i, i, e - rc, e - gc - 1, &lead_n);
+    lead_n -= guard_n;
+    guard_n = 0U;
+    double lag_sum = box(cfar, win, i + 1, i + rr, e - rc, e + rc, &lag_n) -
+                     box(cfar, win, i + 1, i + gr, e - gc, e + gc, &guard_n) +
+                     box(cfar, win, i, i, e + gc + 1, e + rc, &lag_n);
+    lag_n -= guard_n;
+
+    if (cfar->config.type == XENSIV_BGT60TRXX_CFAR_CA) {
+        *lead = ((lead_n + lag_n) > 0U) ? (float) ((lead_sum + lag_sum) / (lead_n + lag_n))
+                                         : FLT_MAX;
+    } else {
+        /* A missing half takes the other one */
+        *lead = (lead_n > 0U) ? (float) (lead_sum / lead_n) : FLT_MAX;
+        *lag = (lag_n > 0U) ? (float) (lag_sum / lag_n) : *lead;
+        *lead = (lead_n > 0U) ? *lead : *lag;
+    }
+}
+
+
+/* Half averages of the columns j0..j1 of row i, whose windows all lie within the map */
+static void full_halves(const xensiv_bgt60trxx_cfar_t *cfar,
+                        const window_t *win,
+                        int32_t i,
+                        int32_t j0,
+                        int32_t j1,
+                        float *lead,
+                        float *lag)
+{
+    const size_t stride = cfar->table_stride;
+    const int32_t gc = win->col_guard;
+    const int32_t rc = win->col_reach;
+    const int32_t offset = win->wrap ? rc : 0;
+
+    /* Row bands of the table: t_b - t_a covers the leading rows, t_c - t_b the row itself */
+    const double *t_a = &cfar->table[(size_t) (i - win->row_reach) * stride];
+    const double *t_d = &cfar->table[(size_t) (i - win->row_guard) * stride];
+    const double *t_b = &cfar->table[(size_t) i * stride];
+    const double *t_c = &cfar->table[(size_t) (i + 1) * stride];
+    const double *t_e = &cfar->table[(size_t) (i + 1 + win->row_guard) * stride];
+    const double *t_f = &cfar->table[(size_t) (i + 1 + win->row_reach) * stride];
+    const double scale = (cfar->config.type == XENSIV_BGT60TRXX_CFAR_CA)
+                         ? 1.0 / cfar->num_train
+                         : 1.0 / cfar->half_train;
+
+    for (int32_t j = j0; j <= j1; ++j) {
+        const int32_t o0 = j + offset - rc;      /* first window column */
+        const int32_t o1 = j + offset + rc + 1;  /* past the last window column */
+        const int32_t g0 = j + offset - gc;      /* first guard column */
+        const int32_t g1 = j + offset + gc + 1;  /* past the last guard column */
+
+        double lead_sum = ((t_b[o1] - t_a[o1]) - (t_b[o0] - t_a[o0])) -
+                          ((t_b[g1] - t_d[g1]) - (t_b[g0] - t_d[g0])) +
+                          ((t_c[g0] - t_b[g0]) - (t_c[o0] - t_b[o0]));
+        double lag_sum = ((t_f[o1] - t_c[o1]) - (t_f[o0] - t_c[o0])) -
+                         ((t_e[g1] - t_c[g1]) - (t_e[g0] - t_c[g0])) +
+                         ((t_c[o1] - t_b[o1]) - (t_c[g1] - t_b[g1]));
+
+        if (cfar->config.type == XENSIV_BGT60TRXX_CFAR_CA) {
+            lead[j] = (float) ((lead_sum + lag_sum) * scale);
+        } else {
+            lead[j] = (float) (lead_sum * scale);
+            lag[j] = (float) (lag_sum * scale);
+        }
+    }
+}
+
+
+/* Index of the first value of sorted not below val; branch free so the search does not stall on
+   mispredictions */
+static uint32_t lower_bound(const float *sorted, uint32_t count, float val)
+{
+    const float *base = sorted;
+
+    if (count == 0U) {
+        return 0U;
+    }
+    while (count > 1U) {
+        uint32_t half = count / 2U;
+        base = (base[half] < val) ? &base[half] : base;
+        count -= half;
+    }
+
+    return (uint32_t) (base - sorted) + ((*base < val) ? 1U : 0U);
+}
+
+
+/* Replaces a value leaving the training window by one entering it; either may be absent when
+   the window is clipped. Shifting only the values between the two keeps the update short. */
+static void sorted_replace(float *sorted,
+                           uint32_t *count,
+                           const float *out,
+                           const float *in)
+{
+    if (out == NULL) {
+        if (in != NULL) {
+            uint32_t pos = lower_bound(sorted, *count, *in);
+            memmove(&sorted[pos + 1U], &sorted[pos], (*count - pos) * sizeof(float));
+            sorted[pos] = *in;
+            ++(*count);
+        }
+        return;
+    }
+
+    uint32_t pos = lower_bound(sorted, *count, *out);
+    xensiv_bgt60trxx_platform_assert((pos < *count) && (sorted[pos] == *out));
+    if (in == NULL) {
+        --(*count);
+        memmove(&sorted[pos], &sorted[pos + 1U], (*count - pos) * sizeof(float));
+    } else if (*in > *out) {
+        uint32_t dst = lower_bound(sorted, *count, *in) - 1U;
+        memmove(&sorted[pos], &sorted[pos + 1U], (dst - pos) * sizeof(float));
+        sorted[dst] = *in;
+    } else {
+        uint32_t dst = lower_bound(sorted, pos, *in);
+        memmove(&sorted[dst + 1U], &sorted[dst], (pos - dst) * sizeof(float));
+        sorted[dst] = *in;
+    }
+}
+
+
+/* Cell of row r and column col of the map, or NULL outside of it */
+static const float *os_cell(const window_t *win, const float *power, int32_t r, int32_t col)
+{
+    /* Columns are at most one window reach outside the map, which is wider than a window */
+    if ((col < 0) || (col >= win->cols)) {
+        if (!win->wrap) {
+            return NULL;
+        }
+        col += (col < 0) ? win->cols : -win->cols;
+    }
+
+    return &power[(r * win->cols) + col];
+}
+
+
+/* Ordered statistic of every cell of row i */
+static void os_row(xensiv_bgt60trxx_cfar_t *cfar,
+                   const window_t *win,
+                   const float *power,
+                   int32_t i,
+                   float *noise)
+{
+    const int32_t gr = win->row_guard;
+    const int32_t gc = win->col_guard;
+    const int32_t rc = win->col_reach;
+    const int32_t r0 = ((i - win->row_reach) < 0) ? 0 : (i - win->row_reach);
+    const int32_t r1 = ((i + win->row_reach) >= win->rows) ? (win->rows - 1) : (i + win->row_reach);
+    float *sorted = cfar->sorted;
+    uint32_t count = 0U;
+
+    for (int32_t r = r0; r <= r1; ++r) {
+        const bool guard_row = (r >= (i - gr)) && (r <= (i + gr));
+        for (int32_t off = -rc; off <= rc; ++off) {
+            if (!guard_row || (off < -gc) || (off > gc)) {
+                sorted_replace(sorted, &count, NULL, os_cell(win, power, r, off));
+            }
+        }
+    }
+
+    for (int32_t j = 0; j < win->cols; ++j) {
+        if (count > 0U) {
+            /* Clipped windows keep the relative rank */
+            uint32_t rank = ((cfar->os_rank * count) + (cfar->num_train / 2U)) / cfar->num_train;
+            rank = (rank == 0U) ? 1U : ((rank > count) ? count : rank);
+            noise[j] = sorted[rank - 1U];
+        } else {
+            noise[j] = FLT_MAX;
+        }
+        if ((j + 1) == win->cols) {
+            break;
+        }
+
+        /* Slide to j + 1: the window edges move in every row where they are training cells,
+           the guard edges in the guard rows */
+        for (int32_t r = r0; r <= r1; ++r) {
+            const bool guard_row = (r >= (i - gr)) && (r <= (i + gr));
+            if (!guard_row || (rc > gc)) {
+                sorted_replace(sorted, &count, os_cell(win, power, r, j - rc),
+                               os_cell(win, power, r, j + rc + 1));
+            }
+            if (guard_row && (rc > gc)) {
+                sorted_replace(sorted, &count, os_cell(win, power, r, j + gc + 1),
+                               os_cell(win, power, r, j - gc));
+            }
+        }
+    }
+}
+
+
+/* Combines the half averages into the noise estimate (in lead) and lists the columns whose power
+   exceeds factor times the noise estimate */
+static uint32_t threshold_scalar(const float *power,
+                                 float *lead,
+                                 const float *lag,
+                                 uint32_t num,
+                                 xensiv_bgt60trxx_cfar_type_t type,
+                                 float factor,
+                                 uint32_t *hits)
+{
+    uint32_t num_hits = 0U;
+
+    for (uint32_t j = 0; j < num; ++j) {
+        float noise = lead[j];
+        if (type == XENSIV_BGT60TRXX_CFAR_GO) {
+            noise = (lag[j] > noise) ? lag[j] : noise;
+        } else if (type == XENSIV_BGT60TRXX_CFAR_SO) {
+            noise = (lag[j] < noise) ? lag[j] : noise;
+        } else {
+            /* CA and OS estimates are complete */
+        }
+        lead[j] = noise;
+        if (power[j] > (noise * factor)) {
+            hits[num_hits++] = j;
+        }
+    }
+
+    return num_hits;
+}
+
+
+#if defined(XENSIV_BGT60TRXX_CFAR_SSE2)
+static uint32_t threshold_simd(const float *power,
+                               float *lead,
+                               const float *lag,
+                               uint32_t num,
+                               xensiv_bgt60trxx_cfar_type_t type,
+                               float factor,
+                               uint32_t *hits)
+{
+    const __m128 scale = _mm_set1_ps(factor);
+    uint32_t num_hits = 0U;
+    uint32_t j = 0U;
+
+    for (; (j + 4U) <= num; j += 4U) {
+        __m128 noise = _mm_loadu_ps(&lead[j]);
+        if (type == XENSIV_BGT60TRXX_CFAR_GO) {
+            noise = _mm_max_ps(noise, _mm_loadu_ps(&lag[j]));
+        } else if (type == XENSIV_BGT60TRXX_CFAR_SO) {
+            noise = _mm_min_ps(noise, _mm_loadu_ps(&lag[j]));
+        } else {
+            /* CA and OS estimates are complete */
+        }
+        _mm_storeu_ps(&lead[j], noise);
+
+        uint32_t mask = (uint32_t) _mm_movemask_ps(
+            _mm_cmpgt_ps(_mm_loadu_ps(&power[j]), _mm_mul_ps(noise, scale)));
+        while (mask != 0U) {
+            hits[num_hits++] = j + (uint32_t) __builtin_ctz(mask);
+            mask &= mask - 1U;
+        }
+    }
+
+    uint32_t tail = threshold_scalar(&power[j], &lead[j], &lag[j], num - j, type, factor,
+                                     &hits[num_hits]);
+    for (uint32_t k = 0; k < tail; ++k) {
+        hits[num_hits++] += j;
+    }
+
+    return num_hits;
+}
+
+
+#elif defined(XENSIV_BGT60TRXX_CFAR_ARM_NEON)
+static uint32_t threshold_simd(const float *power,
+                               float *lead,
+                               const float *lag,
+                               uint32_t num,
+                               xensiv_bgt60trxx_cfar_type_t type,
+                               float factor,
+                               uint32_t *hits)
+{
+    const float32x4_t scale = vdupq_n_f32(factor);
+    uint32_t num_hits = 0U;
+    uint32_t j = 0U;
+
+    for (; (j + 4U) <= num; j += 4U) {
+        float32x4_t noise = vld1q_f32(&lead[j]);
+        if (type == XENSIV_BGT60TRXX_CFAR_GO) {
+            noise = vmaxq_f32(noise, vld1q_f32(&lag[j]));
+        } else if (type == XENSIV_BGT60TRXX_CFAR_SO) {
+            noise = vminq_f32(noise, vld1q_f32(&lag[j]));
+        } else {
+            /* CA and OS estimates are complete */
+        }
+        vst1q_f32(&lead[j], noise);
+
+        uint32x4_t above = vcgtq_f32(vld1q_f32(&power[j]), vmulq_f32(noise, scale));
+        uint32x2_t any = vorr_u32(vget_low_u32(above), vget_high_u32(above));
+        if (vget_lane_u32(vpmax_u32(any, any), 0) != 0U) {
+            uint32_t lanes[4];
+            vst1q_u32(lanes, above);
+            for (uint32_t k = 0; k < 4U; ++k) {
+                if (lanes[k] != 0U) {
+                    hits[num_hits++] = j + k;
+                }
+            }
+        }
+    }
+
+    uint32_t tail = threshold_scalar(&power[j], &lead[j], &lag[j], num - j, type, factor,
+                                     &hits[num_hits]);
+    for (uint32_t k = 0; k < tail; ++k) {
+        hits[num_hits++] += j;
+    }
+
+    return num_hits;
+}
+
+
+#else
+#define threshold_simd threshold_scalar
+#endif
+
+
+uint32_t xensiv_bgt60trxx_cfar_process(xensiv_bgt60trxx_cfar_t *cfar,
+                                       const float *power,
+                                       xensiv_bgt60trxx_detection_t *detections,
+                                       uint32_t max_detections)
+{
+    xensiv_bgt60trxx_platform_assert(cfar != NULL);
+    xensiv_bgt60trxx_platform_assert(power != NULL);
+    xensiv_bgt60trxx_platform_assert((detections != NULL) || (max_detections == 0U));
+
+    window_t win;
+    get_window(&cfar->config, cfar->num_range, cfar->num_doppler, &win);
+    const bool profile = (cfar->num_doppler == 1U);
+    const bool os = (cfar->config.type == XENSIV_BGT60TRXX_CFAR_OS);
+    uint32_t num_detections = 0U;
+
+    if (!os) {
+        build_table(cfar, &win, power);
+    }
+
+    for (int32_t i = 0; i < win.rows; ++i) {
+        const float *row = &power[i * win.cols];
+
+        if (os) {
+            os_row(cfar, &win, power, i, cfar->lead);
+        } else {
+            /* Columns whose windows lie within the map take the fast path */
+            const bool full_rows = ((i - win.row_reach) >= 0) &&
+                                   ((i + win.row_reach) < win.rows);
+            int32_t j0 = win.wrap ? 0 : win.col_reach;
+            int32_t j1 = win.wrap ? (win.cols - 1) : (win.cols - 1 - win.col_reach);
+            if (!full_rows || (j0 > j1)) {
+                j0 = win.cols;
+                j1 = win.cols - 1;
+            }
+
+            for (int32_t j = 0; j < win.cols; ++j) {
+                if ((j < j0) || (j > j1)) {
+                    clipped_halves(cfar, &win, i, j, &cfar->lead[j], &cfar->lag[j]);
+                }
+            }
+            if (j0 <= j1) {
+                full_halves(cfar, &win, i, j0, j1, cfar->lead, cfar->lag);
+            }
+        }
+
+        uint32_t num_hits = threshold_simd(row, cfar->lead, cfar->lag, (uint32_t) win.cols,
+                                           cfar->config.type, cfar->factor, cfar->hits);
+        for (uint32_t h = 0; (h < num_hits) && (num_detections < max_detections); ++h) {
+            const uint32_t j = cfar->hits[h];
+            xensiv_bgt60trxx_detection_t *det = &detections[num_detections++];
+            det->range_bin = (uint16_t) (profile ? j : (uint32_t) i);
+            det->doppler_bin = (uint16_t) (profile ? 0U : j);
+            det->power = row[j];
+            det->noise = cfar->lead[j];
+        }
+    }
+
+    return num_detections;
+}
@@ -0,0 +1,163 @@
+/***********************************************************************************************/ /**
+                                                                                                   * \file xensiv_bgt60trxx_cfar.h
+                                                                                                   *
+                                                                                                   * \brief
+                                                                                                   * This file contains the CFAR detector of the XENSIV(TM) BGT60TRxx radar sensor library:
+                                                                                                   * cell averaging and ordered statistic detection over range profiles and range-Doppler maps.
+                                                                                                   *
+                                                                                                   ***************************************************************************************************
+                                                                                                   * \copyright
+                                                                                                   * Copyright 2022 Infineon Technologies AG
+                                                                                                   * SPDX-License-Identifier: Apache-2.0
+                                                                                                   *
+                                                                                                   * Licensed under the Apache License, Version 2.0 (the "License");
+                                                                                                   * you may not use this file except in compliance with the License.
+                                                                                                   * You may obtain a copy of the License at
+                                                                                                   *
+                                                                                                   *     http://www.apache.org/licenses/LICENSE-2.0
+                                                                                                   *
+                                                                                                   * Unless required by applicable law or agreed to in writing, software
+                                                                                                   * distributed under the License is distributed on an "AS IS" BASIS,
+                                                                                                   * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+                                                                                                   * See the License for the specific language governing permissions and
+                                                                                                   * limitations under the License.
+                                                                                                   **************************************************************************************************/
+
+#ifndef XENSIV_BGT60TRXX_CFAR_H_
+#define XENSIV_BGT60TRXX_CFAR_H_
+
+/**
+ * \addtogroup group_board_libs_cfar XENSIV(TM) BGT60TRxx CFAR detection
+ * \{
+ * Constant false alarm rate detection over power maps, either a single range profile or a
+ * [range bin][Doppler bin] map such as the integrated output of the Doppler stage. A cell is
+ * detected when its power exceeds the threshold factor times a noise estimate taken from the
+ * training cells around it, skipping the guard cells next to it.
+ *
+ * The training cells of a 2D map form a rectangle of (guard + train) cells on each side along
+ * each axis, minus the guard rectangle. The leading half holds the rows before the cell under
+ * test and the cells of its own row before it; the lagging half holds the rest. CA averages
+ * both halves, GO takes the greater and SO the smaller of their averages. The half sums come
+ * from a summed-area table, so the cost per cell does not depend on the window size. OS takes
+ * the os_rank-th smallest training cell from a sorted window that is updated incrementally as
+ * it slides along the Doppler axis.
+ *
+ * Windows are clipped at the range edges and at the Doppler edges unless wrap_doppler is set,
+ * in which case they wrap around as the Doppler spectrum does. Clipped windows keep the
+ * threshold factor of a full window. When pfa is set, the threshold factor is derived for
+ * exponentially distributed noise power, that is the square-law output of Gaussian noise.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/********************************* Type definitions **************************************/
+
+/** enum with the CFAR noise estimators */
+typedef enum {
+    XENSIV_BGT60TRXX_CFAR_CA = 0, /**< Cell averaging over both halves */
+    XENSIV_BGT60TRXX_CFAR_GO = 1, /**< Greater of the two half averages */
+    XENSIV_BGT60TRXX_CFAR_SO = 2, /**< Smaller of the two half averages */
+    XENSIV_BGT60TRXX_CFAR_OS = 3  /**< Ordered statistic of all training cells */
+} xensiv_bgt60trxx_cfar_type_t;
+
+/** CFAR configuration; index 0 of guard and train is the range axis, index 1 the Doppler axis */
+typedef struct {
+    xensiv_bgt60trxx_cfar_type_t type; /**< Noise estimator */
+    uint32_t guard[2];                 /**< Guard cells on each side of the cell under test */
+    uint32_t train[2];                 /**< Training cells on each side beyond the guard cells */
+    float threshold;                   /**< Factor on the noise estimate, used if pfa is 0 */
+    float pfa;                         /**< Target false alarm probability, 0 to use threshold */
+    uint32_t os_rank;                  /**< OS rank from 1, 0 for 3/4 of the training cells */
+    bool wrap_doppler;                 /**< Wrap windows around the Doppler axis */
+} xensiv_bgt60trxx_cfar_config_t;
+
+/** Detected cell */
+typedef struct {
+    uint16_t range_bin;   /**< Range bin, or the index in a range profile */
+    uint16_t doppler_bin; /**< Doppler bin, 0 for a range profile */
+    float power;          /**< Power of the cell */
+    float noise;          /**< Noise estimate of the cell, without the threshold factor */
+} xensiv_bgt60trxx_detection_t;
+
+/** CFAR detector object */
+typedef struct {
+    xensiv_bgt60trxx_cfar_config_t config; /**< Configuration */
+    uint32_t num_range;                    /**< Range bins of the map */
+    uint32_t num_doppler;                  /**< Doppler bins of the map, 1 for a range profile */
+    uint32_t num_train;                    /**< Training cells of a full window */
+    uint32_t half_train;                   /**< Training cells of a full leading half */
+    uint32_t os_rank;                      /**< OS rank of a full window */
+    float factor;                          /**< Threshold factor on the noise estimate */
+    uint32_t table_stride;                 /**< Summed-area table row length */
+    double *table;                         /**< Summed-area table */
+    float *lead;                           /**< Noise estimate scratch row */
+    float *lag;                            /**< Lagging half scratch row */
+    uint32_t *hits;                        /**< Detected column scratch row */
+    float *sorted;                         /**< OS sorted training window */
+} xensiv_bgt60trxx_cfar_t;
+
+/******************************* Function prototypes *************************************/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Obtains the storage needed by a CFAR detector.
+ *
+ * @param[in] config CFAR configuration.
+ * @param[in] num_range Range bins of the maps.
+ * @param[in] num_doppler Doppler bins of the maps, 1 to detect over range profiles.
+ * @return Storage size in bytes.
+ */
+size_t xensiv_bgt60trxx_cfar_storage_size(const xensiv_bgt60trxx_cfar_config_t *config,
+                                          uint32_t num_range,
+                                          uint32_t num_doppler);
+
+/**
+ * @brief Initializes a CFAR detector and derives its threshold factor.
+ *
+ * @param[out] cfar Pointer to the CFAR detector object.
+ * @param[in] config CFAR configuration. The Doppler guard and training cells are ignored for
+ * range profiles.
+ * @param[in] num_range Range bins of the maps, at most 65536.
+ * @param[in] num_doppler Doppler bins of the maps, 1 to detect over range profiles, at most 65536.
+ * @param[out] storage Storage of xensiv_bgt60trxx_cfar_storage_size() bytes, aligned for double,
+ * owned by the CFAR detector until it is no longer used.
+ * @param[in] storage_size Size of storage in bytes.
+ * @return XENSIV_BGT60TRXX_STATUS_OK if the CFAR detector was initialized;
+ * XENSIV_BGT60TRXX_STATUS_DEV_ERROR if the storage is too small, the window has no training
+ * cells, os_rank exceeds them, pfa is not below 1, the threshold factor is not positive or a
+ * wrapped window is wider than the Doppler axis.
+ */
+int32_t xensiv_bgt60trxx_cfar_init(xensiv_bgt60trxx_cfar_t *cfar,
+                                   const xensiv_bgt60trxx_cfar_config_t *config,
+                                   uint32_t num_range,
+                                   uint32_t num_doppler,
+                                   void *storage,
+                                   size_t storage_size);
+
+/**
+ * @brief Detects the cells of a power map. Uses the scratch rows, so a CFAR detector must not
+ * process two maps at the same time.
+ *
+ * @param[inout] cfar Pointer to the CFAR detector object.
+ * @param[in] power num_range x num_doppler power values, [range bin][Doppler bin].
+ * @param[out] detections Detected cells in range bin then Doppler bin order.
+ * @param[in] max_detections Capacity of detections; further detections are dropped.
+ * @return Number of detections written.
+ */
+uint32_t xensiv_bgt60trxx_cfar_process(xensiv_bgt60trxx_cfar_t *cfar,
+                                       const float *power,
+                                       xensiv_bgt60trxx_detection_t *detections,
+                                       uint32_t max_detections);
+
+#ifdef __cplusplus
+}
+#endif
+
+/** \} group_board_libs_cfar */
+
+#endif  // ifndef XENSIV_BGT60TRXX_CFAR_H_
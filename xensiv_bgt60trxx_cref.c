@@ -0,0 +1,169 @@
+/***********************************************************************************************/ /**
+                                                                                                   * \file xensiv_bgt60trxx_cref.c
+                                                                                                   *
+                                                                                                   * \brief
+                                                                                                   * This file contains the adaptive FIFO compare reference (CREF) controller for the
+                                                                                                   * XENSIV(TM) BGT60TRxx radar sensor.
+                                                                                                   *
+                                                                                                   ***************************************************************************************************
+                                                                                                   * \copyright
+                                                                                                   * Copyright 2022 Infineon Technologies AG
+                                                                                                   * SPDX-License-Identifier: Apache-2.0
+                                                                                                   *
+                                                                                                   * Licensed under the Apache License, Version 2.0 (the "License");
+                                                                                                   * you may not use this file except in compliance with the License.
+                                                                                                   * You may obtain a copy of the License at
+                                                                                                   *
+                                                                                                   *     http://www.apache.org/licenses/LICENSE-2.0
+                                                                                                   *
+                                                                                                   * Unless required by applicable law or agreed to in writing, software
+                                                                                                   * distributed under the License is distributed on an "AS IS" BASIS,
+                                                                                                   * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+                                                                                                   * See the License for the specific language governing permissions and
+                                                                                                   * limitations under the License.
+                                                                                                   **************************************************************************************************/
+
+#include "xensiv_bgt60trxx_cref.h"
+
+#include <stddef.h>
+
+#include "xensiv_bgt60trxx_platform.h"
+
+static uint32_t quantize(const xensiv_bgt60trxx_cref_config_t *config, uint32_t samples)
+{
+    return samples - (samples % config->quantum_samples);
+}
+
+
+static uint32_t clamp(const xensiv_bgt60trxx_cref_config_t *config, uint32_t samples)
+{
+    if (samples < config->min_samples) {
+        samples = config->min_samples;
+    } else if (samples > config->max_samples) {
+        samples = config->max_samples;
+    } else {
+        /* Within bounds */
+    }
+
+    return samples;
+}
+
+
+/* Largest CREF that keeps the headroom free when the latency peak adds to it */
+static uint32_t target_cref(const xensiv_bgt60trxx_cref_ctrl_t *ctrl)
+{
+    const xensiv_bgt60trxx_cref_config_t *config = &ctrl->config;
+    uint32_t fill_limit =
+        (uint32_t) (((uint64_t) config->fifo_samples * (100U - config->headroom_pct)) / 100U);
+    uint32_t target = (fill_limit > ctrl->excess_peak) ? (fill_limit - ctrl->excess_peak) : 0U;
+
+    return clamp(config, quantize(config, target));
+}
+
+
+void xensiv_bgt60trxx_cref_init(xensiv_bgt60trxx_cref_ctrl_t *ctrl,
+                                const xensiv_bgt60trxx_cref_config_t *config)
+{
+    xensiv_bgt60trxx_platform_assert(ctrl != NULL);
+    xensiv_bgt60trxx_platform_assert(config != NULL);
+    xensiv_bgt60trxx_platform_assert(config->quantum_samples > 0U);
+    xensiv_bgt60trxx_platform_assert((config->quantum_samples % 2U) == 0U);
+    xensiv_bgt60trxx_platform_assert(config->headroom_pct < 100U);
+
+    ctrl->config = *config;
+    ctrl->config.min_samples = quantize(config, config->min_samples + config->quantum_samples - 1U);
+    if (ctrl->config.min_samples == 0U) {
+        ctrl->config.min_samples = config->quantum_samples;
+    }
+    ctrl->config.max_samples = quantize(config, config->max_samples);
+    xensiv_bgt60trxx_platform_assert(ctrl->config.min_samples <= ctrl->config.max_samples);
+    xensiv_bgt60trxx_platform_assert(ctrl->config.max_samples <= config->fifo_samples);
+
+    ctrl->cref = ctrl->config.min_samples;
+    ctrl->excess_peak = 0U;
+    ctrl->calm = 0U;
+    ctrl->raises = 0U;
+    ctrl->lowers = 0U;
+    ctrl->overflows = 0U;
+}
+
+
+bool xensiv_bgt60trxx_cref_update(xensiv_bgt60trxx_cref_ctrl_t *ctrl,
+                                  uint32_t fill_samples,
+                                  bool overflow)
+{
+    xensiv_bgt60trxx_platform_assert(ctrl != NULL);
+
+    const xensiv_bgt60trxx_cref_config_t *config = &ctrl->config;
+    uint32_t cref = ctrl->cref;
+
+    if (overflow) {
+        /* The data arriving during the latency did not fit: at least the free FIFO space */
+        uint32_t excess = config->fifo_samples - cref;
+        if (excess > ctrl->excess_peak) {
+            ctrl->excess_peak = excess;
+        }
+
+        ++ctrl->overflows;
+        ctrl->calm = 0U;
+        cref = clamp(config, quantize(config, cref / 2U));
+    } else {
+        uint32_t excess = (fill_samples > cref) ? (fill_samples - cref) : 0U;
+
+        ctrl->excess_peak -= ctrl->excess_peak >> XENSIV_BGT60TRXX_CREF_PEAK_DECAY_SHIFT;
+        if (excess > ctrl->excess_peak) {
+            ctrl->excess_peak = excess;
+        }
+
+        uint32_t target = target_cref(ctrl);
+        if (target < cref) {
+            ctrl->calm = 0U;
+            cref = target;
+        } else if (target > cref) {
+            if (++ctrl->calm >= config->raise_after) {
+                ctrl->calm = 0U;
+                cref += config->quantum_samples;
+            }
+        } else {
+            ctrl->calm = 0U;
+        }
+    }
+
+    bool changed = (cref != ctrl->cref);
+    if (cref > ctrl->cref) {
+        ++ctrl->raises;
+    } else if (cref < ctrl->cref) {
+        ++ctrl->lowers;
+    } else {
+        /* Unchanged */
+    }
+    ctrl->cref = cref;
+
+    return changed;
+}
+
+
+uint32_t xensiv_bgt60trxx_cref_get_limit(const xensiv_bgt60trxx_cref_ctrl_t *ctrl)
+{
+    xensiv_bgt60trxx_platform_assert(ctrl != NULL);
+
+    return ctrl->cref;
+}
+
+
+void xensiv_bgt60trxx_cref_get_point(const xensiv_bgt60trxx_cref_ctrl_t *ctrl,
+                                     xensiv_bgt60trxx_cref_point_t *point)
+{
+    xensiv_bgt60trxx_platform_assert(ctrl != NULL);
+    xensiv_bgt60trxx_platform_assert(point != NULL);
+
+    uint32_t used = ctrl->cref + ctrl->excess_peak;
+
+    point->cref = ctrl->cref;
+    point->target = target_cref(ctrl);
+    point->excess_peak = ctrl->excess_peak;
+    point->headroom = (ctrl->config.fifo_samples > used) ? (ctrl->config.fifo_samples - used) : 0U;
+    point->raises = ctrl->raises;
+    point->lowers = ctrl->lowers;
+    point->overflows = ctrl->overflows;
+}
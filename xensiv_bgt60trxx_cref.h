@@ -0,0 +1,143 @@
+/***********************************************************************************************/ /**
+                                                                                                   * \file xensiv_bgt60trxx_cref.h
+                                                                                                   *
+                                                                                                   * \brief
+                                                                                                   * This file contains an adaptive controller for the XENSIV(TM) BGT60TRxx FIFO compare
+                                                                                                   * reference (CREF), trading interrupt rate against FIFO overflow risk at runtime.
+                                                                                                   *
+                                                                                                   ***************************************************************************************************
+                                                                                                   * \copyright
+                                                                                                   * Copyright 2022 Infineon Technologies AG
+                                                                                                   * SPDX-License-Identifier: Apache-2.0
+                                                                                                   *
+                                                                                                   * Licensed under the Apache License, Version 2.0 (the "License");
+                                                                                                   * you may not use this file except in compliance with the License.
+                                                                                                   * You may obtain a copy of the License at
+                                                                                                   *
+                                                                                                   *     http://www.apache.org/licenses/LICENSE-2.0
+                                                                                                   *
+                                                                                                   * Unless required by applicable law or agreed to in writing, software
+                                                                                                   * distributed under the License is distributed on an "AS IS" BASIS,
+                                                                                                   * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+                                                                                                   * See the License for the specific language governing permissions and
+                                                                                                   * limitations under the License.
+                                                                                                   **************************************************************************************************/
+
+#ifndef XENSIV_BGT60TRXX_CREF_H_
+#define XENSIV_BGT60TRXX_CREF_H_
+
+/**
+ * \addtogroup group_board_libs_cref XENSIV(TM) BGT60TRxx adaptive FIFO limit
+ * \{
+ * Retunes the FIFO compare reference between configurable bounds from what the host observes
+ * each time it services the FIFO. The fill level found beyond CREF at service time is the data
+ * that arrived during the service latency; the controller keeps a decaying peak of it and
+ * picks the largest CREF that still leaves the requested share of the FIFO free at that peak.
+ * A large CREF means fewer interrupts and SPI bursts, a small one lower latency and more room
+ * for host stalls.
+ *
+ * Decreases are applied at once and an overflow halves CREF; increases go one quantum at a
+ * time after a run of calm observations. CREF always stays a multiple of the quantum, which
+ * should be the frame or chirp size so that every interrupt covers whole blocks.
+ *
+ * The controller does no I/O: after xensiv_bgt60trxx_cref_update() reports a change, apply it
+ * with xensiv_bgt60trxx_set_fifo_limit().
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/************************************** Macros *******************************************/
+
+/** The service latency peak decays by 1/2^shift of its value per observation. */
+#ifndef XENSIV_BGT60TRXX_CREF_PEAK_DECAY_SHIFT
+    #define XENSIV_BGT60TRXX_CREF_PEAK_DECAY_SHIFT (4U)
+#endif
+
+/********************************* Type definitions **************************************/
+
+/** Controller configuration */
+typedef struct {
+    uint32_t quantum_samples; /**< CREF granularity in samples, the frame or chirp size (even) */
+    uint32_t min_samples;     /**< Lowest CREF in samples, rounded up to the quantum */
+    uint32_t max_samples;     /**< Highest CREF in samples, rounded down to the quantum */
+    uint32_t fifo_samples;    /**< FIFO capacity in samples */
+    uint32_t headroom_pct;    /**< Share of the FIFO to keep free at the latency peak, 0-99 */
+    uint32_t raise_after;     /**< Calm observations before CREF is raised by one quantum */
+} xensiv_bgt60trxx_cref_config_t;
+
+/** Controller object, content initialized using \ref xensiv_bgt60trxx_cref_init */
+typedef struct {
+    xensiv_bgt60trxx_cref_config_t config; /**< Configuration with the bounds quantized */
+    uint32_t cref;                         /**< Current FIFO limit in samples */
+    uint32_t excess_peak;                  /**< Decaying peak of the fill beyond CREF */
+    uint32_t calm;                         /**< Consecutive observations allowing a raise */
+    uint32_t raises;                       /**< Number of CREF increases */
+    uint32_t lowers;                       /**< Number of CREF decreases, overflows included */
+    uint32_t overflows;                    /**< Number of reported FIFO overflows */
+} xensiv_bgt60trxx_cref_ctrl_t;
+
+/** Operating point of the controller, see \ref xensiv_bgt60trxx_cref_get_point */
+typedef struct {
+    uint32_t cref;        /**< Current FIFO limit in samples */
+    uint32_t target;      /**< CREF the controller is heading for in samples */
+    uint32_t excess_peak; /**< Peak of the data arriving during service latency in samples */
+    uint32_t headroom;    /**< FIFO space left free at the latency peak in samples */
+    uint32_t raises;      /**< Number of CREF increases */
+    uint32_t lowers;      /**< Number of CREF decreases, overflows included */
+    uint32_t overflows;   /**< Number of reported FIFO overflows */
+} xensiv_bgt60trxx_cref_point_t;
+
+/******************************* Function prototypes *************************************/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Initializes the controller. CREF starts at the lower bound and grows while the
+ * observed latency allows it.
+ *
+ * @param[out] ctrl Pointer to the controller object.
+ * @param[in] config Controller configuration.
+ */
+void xensiv_bgt60trxx_cref_init(xensiv_bgt60trxx_cref_ctrl_t *ctrl,
+                                const xensiv_bgt60trxx_cref_config_t *config);
+
+/**
+ * @brief Feeds one FIFO service to the controller.
+ *
+ * @param[inout] ctrl Pointer to the controller object.
+ * @param[in] fill_samples FIFO fill level in samples when the service started, e.g. from
+ * xensiv_bgt60trxx_get_fifo_fill().
+ * @param[in] overflow True if the FIFO overflowed since the previous service.
+ * @return True if CREF changed and must be applied with xensiv_bgt60trxx_set_fifo_limit().
+ */
+bool xensiv_bgt60trxx_cref_update(xensiv_bgt60trxx_cref_ctrl_t *ctrl,
+                                  uint32_t fill_samples,
+                                  bool overflow);
+
+/**
+ * @brief Obtains the current FIFO limit.
+ *
+ * @param[in] ctrl Pointer to the controller object.
+ * @return FIFO limit in samples.
+ */
+uint32_t xensiv_bgt60trxx_cref_get_limit(const xensiv_bgt60trxx_cref_ctrl_t *ctrl);
+
+/**
+ * @brief Obtains the operating point of the controller.
+ *
+ * @param[in] ctrl Pointer to the controller object.
+ * @param[out] point Pointer to populate with the operating point.
+ */
+void xensiv_bgt60trxx_cref_get_point(const xensiv_bgt60trxx_cref_ctrl_t *ctrl,
+                                     xensiv_bgt60trxx_cref_point_t *point);
+
+#ifdef __cplusplus
+}
+#endif
+
+/** \} group_board_libs_cref */
+
+#endif  // ifndef XENSIV_BGT60TRXX_CREF_H_
@@ -0,0 +1,343 @@
+/***********************************************************************************************/ /**
+                                                                                                   * \file xensiv_bgt60trxx_doppler.c
+                                                                                                   *
+                                                                                                   * \brief
+                                                                                                   * This file contains the Doppler processing stage of the XENSIV(TM) BGT60TRxx radar sensor.
+                                                                                                   *
+                                                                                                   ***************************************************************************************************
+                                                                                                   * \copyright
+                                                                                                   * Copyright 2022 Infineon Technologies AG
+                                                                                                   * SPDX-License-Identifier: Apache-2.0
+                                                                                                   *
+                                                                                                   * Licensed under the Apache License, Version 2.0 (the "License");
+                                                                                                   * you may not use this file except in compliance with the License.
+                                                                                                   * You may obtain a copy of the License at
+                                                                                                   *
+                                                                                                   *     http://www.apache.org/licenses/LICENSE-2.0
+                                                                                                   *
+                                                                                                   * Unless required by applicable law or agreed to in writing, software
+                                                                                                   * distributed under the License is distributed on an "AS IS" BASIS,
+                                                                                                   * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+                                                                                                   * See the License for the specific language governing permissions and
+                                                                                                   * limitations under the License.
+                                                                                                   **************************************************************************************************/
+
+#include "xensiv_bgt60trxx_doppler.h"
+
+#include <string.h>
+
+#include "xensiv_bgt60trxx.h"
+#include "xensiv_bgt60trxx_platform.h"
+
+static uint32_t next_pow2(uint32_t val)
+{
+    uint32_t size = 1U;
+
+    while (size < val) {
+        size <<= 1;
+    }
+
+    return size;
+}
+
+
+static uint32_t plan_fft_size(const xensiv_bgt60trxx_doppler_config_t *config,
+                              uint32_t num_chirps)
+{
+    return (config->fft_size != 0U) ? config->fft_size : next_pow2(num_chirps);
+}
+
+
+static uint32_t range_bins(const xensiv_bgt60trxx_range_t *range, uint32_t segment)
+{
+    return range->plans[range->segment_plan[segment]].fft_size / 2U;
+}
+
+
+/* Returns the first segment with this chirp count among the first num_segments segments, or
+   num_segments if there is none */
+static uint32_t find_plan(const xensiv_bgt60trxx_assembler_t *assembler, uint32_t num_segments,
+                          uint32_t num_chirps)
+{
+    uint32_t seg = 0U;
+
+    while ((seg < num_segments) && (assembler->segments[seg].num_chirps != num_chirps)) {
+        ++seg;
+    }
+
+    return seg;
+}
+
+
+/* Largest FFT size and range bin count over all segments */
+static void max_sizes(const xensiv_bgt60trxx_range_t *range,
+                      const xensiv_bgt60trxx_doppler_config_t *config,
+                      uint32_t *max_fft_size,
+                      uint32_t *max_bins)
+{
+    const xensiv_bgt60trxx_assembler_t *assembler = range->assembler;
+
+    *max_fft_size = 0U;
+    *max_bins = 0U;
+    for (uint32_t seg = 0; seg < assembler->num_segments; ++seg) {
+        uint32_t fft_size = plan_fft_size(config, assembler->segments[seg].num_chirps);
+        uint32_t bins = range_bins(range, seg);
+        *max_fft_size = (fft_size > *max_fft_size) ? fft_size : *max_fft_size;
+        *max_bins = (bins > *max_bins) ? bins : *max_bins;
+    }
+}
+
+
+static uint32_t tile_bins(const xensiv_bgt60trxx_range_t *range,
+                          const xensiv_bgt60trxx_doppler_config_t *config)
+{
+    uint32_t max_fft_size;
+    uint32_t max_bins;
+    uint32_t bins = config->tile_bins;
+
+    max_sizes(range, config, &max_fft_size, &max_bins);
+    if (bins == 0U) {
+        bins = XENSIV_BGT60TRXX_DOPPLER_TILE_BYTES /
+               (max_fft_size * (uint32_t) sizeof(xensiv_bgt60trxx_complex_t));
+    }
+    bins = (bins > max_bins) ? max_bins : bins;
+
+    return (bins > 0U) ? bins : 1U;
+}
+
+
+size_t xensiv_bgt60trxx_doppler_storage_size(const xensiv_bgt60trxx_range_t *range,
+                                             const xensiv_bgt60trxx_doppler_config_t *config)
+{
+    xensiv_bgt60trxx_platform_assert(range != NULL);
+    xensiv_bgt60trxx_platform_assert(config != NULL);
+
+    const xensiv_bgt60trxx_assembler_t *assembler = range->assembler;
+    size_t size = 0U;
+    uint32_t max_fft_size;
+    uint32_t max_bins;
+
+    for (uint32_t seg = 0; seg < assembler->num_segments; ++seg) {
+        uint32_t num_chirps = assembler->segments[seg].num_chirps;
+
+        if (find_plan(assembler, seg, num_chirps) == seg) {
+            size += (num_chirps * sizeof(float)) +
+                    XENSIV_BGT60TRXX_FFT_PLAN_STORAGE_BYTES(plan_fft_size(config, num_chirps));
+        }
+    }
+
+    max_sizes(range, config, &max_fft_size, &max_bins);
+
+    return size + ((size_t) tile_bins(range, config) * max_fft_size *
+                   sizeof(xensiv_bgt60trxx_complex_t));
+}
+
+
+int32_t xensiv_bgt60trxx_doppler_init(xensiv_bgt60trxx_doppler_t *doppler,
+                                      const xensiv_bgt60trxx_range_t *range,
+                                      const xensiv_bgt60trxx_doppler_config_t *config,
+                                      void *storage,
+                                      size_t storage_size)
+{
+    xensiv_bgt60trxx_platform_assert(doppler != NULL);
+    xensiv_bgt60trxx_platform_assert(range != NULL);
+    xensiv_bgt60trxx_platform_assert(config != NULL);
+    xensiv_bgt60trxx_platform_assert(storage != NULL);
+
+    const xensiv_bgt60trxx_assembler_t *assembler = range->assembler;
+
+    if (storage_size < xensiv_bgt60trxx_doppler_storage_size(range, config)) {
+        return XENSIV_BGT60TRXX_STATUS_DEV_ERROR;
+    }
+
+    for (uint32_t seg = 0; seg < assembler->num_segments; ++seg) {
+        uint32_t num_chirps = assembler->segments[seg].num_chirps;
+        uint32_t fft_size = plan_fft_size(config, num_chirps);
+        if (((fft_size & (fft_size - 1U)) != 0U) || (fft_size < num_chirps)) {
+            return XENSIV_BGT60TRXX_STATUS_DEV_ERROR;
+        }
+    }
+
+    memset(doppler, 0, sizeof(*doppler));
+    doppler->config = *config;
+    doppler->range = range;
+    doppler->tile_bins = tile_bins(range, config);
+
+    uint8_t *next = (uint8_t *) storage;
+
+    for (uint32_t seg = 0; seg < assembler->num_segments; ++seg) {
+        const xensiv_bgt60trxx_frame_segment_t *segment = &assembler->segments[seg];
+        uint32_t first = find_plan(assembler, seg, segment->num_chirps);
+
+        if (first == seg) {
+            xensiv_bgt60trxx_doppler_plan_t *plan = &doppler->plans[doppler->num_plans];
+
+            plan->num_chirps = segment->num_chirps;
+            plan->fft_size = plan_fft_size(config, segment->num_chirps);
+            plan->window = (float *) next;
+            xensiv_bgt60trxx_window_init(plan->window, plan->num_chirps, config->window);
+            next += plan->num_chirps * sizeof(float);
+            xensiv_bgt60trxx_fft_plan_init(&plan->plan, plan->fft_size, config->algo, next);
+            next += XENSIV_BGT60TRXX_FFT_PLAN_STORAGE_BYTES(plan->fft_size);
+
+            doppler->segment_plan[seg] = doppler->num_plans;
+            ++doppler->num_plans;
+        } else {
+            doppler->segment_plan[seg] = doppler->segment_plan[first];
+        }
+
+        uint32_t row_cells = range_bins(range, seg) *
+                             doppler->plans[doppler->segment_plan[seg]].fft_size;
+        doppler->segment_offset[seg] = doppler->group_cells;
+        doppler->nci_offset[seg] = doppler->group_nci_cells;
+        doppler->group_cells += segment->num_rx * row_cells;
+        doppler->group_nci_cells += row_cells;
+    }
+
+    doppler->tile = (xensiv_bgt60trxx_complex_t *) next;
+    doppler->frame_cells = doppler->group_cells * assembler->num_groups;
+    doppler->frame_nci_cells = doppler->group_nci_cells * assembler->num_groups;
+
+    return XENSIV_BGT60TRXX_STATUS_OK;
+}
+
+
+uint32_t xensiv_bgt60trxx_doppler_map_offset(const xensiv_bgt60trxx_doppler_t *doppler,
+                                             uint32_t group,
+                                             uint32_t segment,
+                                             uint32_t rx,
+                                             uint32_t bin)
+{
+    xensiv_bgt60trxx_platform_assert(doppler != NULL);
+    xensiv_bgt60trxx_platform_assert(segment < doppler->range->assembler->num_segments);
+
+    uint32_t fft_size = doppler->plans[doppler->segment_plan[segment]].fft_size;
+
+    return (group * doppler->group_cells) + doppler->segment_offset[segment] +
+           (((rx * range_bins(doppler->range, segment)) + bin) * fft_size);
+}
+
+
+uint32_t xensiv_bgt60trxx_doppler_nci_offset(const xensiv_bgt60trxx_doppler_t *doppler,
+                                             uint32_t group,
+                                             uint32_t segment,
+                                             uint32_t bin)
+{
+    xensiv_bgt60trxx_platform_assert(doppler != NULL);
+    xensiv_bgt60trxx_platform_assert(segment < doppler->range->assembler->num_segments);
+
+    uint32_t fft_size = doppler->plans[doppler->segment_plan[segment]].fft_size;
+
+    return (group * doppler->group_nci_cells) + doppler->nci_offset[segment] + (bin * fft_size);
+}
+
+
+/* Clutter filter, window and zero padding of one tile row of num_chirps values */
+static void condition_row(const xensiv_bgt60trxx_doppler_t *doppler,
+                          const xensiv_bgt60trxx_doppler_plan_t *plan,
+                          xensiv_bgt60trxx_complex_t *row)
+{
+    const uint32_t num_chirps = plan->num_chirps;
+
+    if (doppler->config.clutter == XENSIV_BGT60TRXX_CLUTTER_MEAN) {
+        float re = 0.0f;
+        float im = 0.0f;
+        for (uint32_t c = 0; c < num_chirps; ++c) {
+            re += row[c].re;
+            im += row[c].im;
+        }
+        re /= (float) num_chirps;
+        im /= (float) num_chirps;
+        for (uint32_t c = 0; c < num_chirps; ++c) {
+            row[c].re -= re;
+            row[c].im -= im;
+        }
+    } else if (doppler->config.clutter == XENSIV_BGT60TRXX_CLUTTER_MTI) {
+        for (uint32_t c = num_chirps - 1U; c > 0U; --c) {
+            row[c].re -= row[c - 1U].re;
+            row[c].im -= row[c - 1U].im;
+        }
+        row[0].re = 0.0f;
+        row[0].im = 0.0f;
+    } else {
+        /* Unfiltered */
+    }
+
+    for (uint32_t c = 0; c < num_chirps; ++c) {
+        row[c].re *= plan->window[c];
+        row[c].im *= plan->window[c];
+    }
+    memset(&row[num_chirps], 0, (plan->fft_size - num_chirps) * sizeof(row[0]));
+}
+
+
+void xensiv_bgt60trxx_doppler_process(xensiv_bgt60trxx_doppler_t *doppler,
+                                      const xensiv_bgt60trxx_complex_t *profiles,
+                                      xensiv_bgt60trxx_complex_t *map,
+                                      float *nci)
+{
+    xensiv_bgt60trxx_platform_assert(doppler != NULL);
+    xensiv_bgt60trxx_platform_assert(profiles != NULL);
+
+    const xensiv_bgt60trxx_range_t *range = doppler->range;
+    const xensiv_bgt60trxx_assembler_t *assembler = range->assembler;
+    xensiv_bgt60trxx_complex_t *tile = doppler->tile;
+
+    for (uint32_t group = 0; group < assembler->num_groups; ++group) {
+        for (uint32_t seg = 0; seg < assembler->num_segments; ++seg) {
+            const xensiv_bgt60trxx_frame_segment_t *segment = &assembler->segments[seg];
+            const xensiv_bgt60trxx_doppler_plan_t *plan =
+                &doppler->plans[doppler->segment_plan[seg]];
+            const uint32_t fft_size = plan->fft_size;
+            const uint32_t shift = doppler->config.center_zero ? (fft_size / 2U) : 0U;
+            const uint32_t bins = range_bins(range, seg);
+
+            if (nci != NULL) {
+                memset(&nci[xensiv_bgt60trxx_doppler_nci_offset(doppler, group, seg, 0U)], 0,
+                       (size_t) bins * fft_size * sizeof(float));
+            }
+
+            for (uint32_t rx = 0; rx < segment->num_rx; ++rx) {
+                const xensiv_bgt60trxx_complex_t *src =
+                    &profiles[xensiv_bgt60trxx_range_profile_offset(range, group, seg, rx, 0U)];
+
+                for (uint32_t bin0 = 0; bin0 < bins; bin0 += doppler->tile_bins) {
+                    uint32_t num_bins = bins - bin0;
+                    num_bins = (num_bins > doppler->tile_bins) ? doppler->tile_bins : num_bins;
+
+                    /* Corner turn: one contiguous run of num_bins values per chirp */
+                    for (uint32_t c = 0; c < plan->num_chirps; ++c) {
+                        const xensiv_bgt60trxx_complex_t *run = &src[(c * bins) + bin0];
+                        for (uint32_t t = 0; t < num_bins; ++t) {
+                            tile[(t * fft_size) + c] = run[t];
+                        }
+                    }
+
+                    for (uint32_t t = 0; t < num_bins; ++t) {
+                        xensiv_bgt60trxx_complex_t *row = &tile[t * fft_size];
+                        condition_row(doppler, plan, row);
+                        xensiv_bgt60trxx_fft(&plan->plan, row);
+
+                        if (map != NULL) {
+                            xensiv_bgt60trxx_complex_t *dst = &map[
+                                xensiv_bgt60trxx_doppler_map_offset(doppler, group, seg, rx,
+                                                                    bin0 + t)];
+                            memcpy(&dst[shift], row, (fft_size - shift) * sizeof(row[0]));
+                            memcpy(dst, &row[fft_size - shift], shift * sizeof(row[0]));
+                        }
+
+                        if (nci != NULL) {
+                            float *acc = &nci[xensiv_bgt60trxx_doppler_nci_offset(doppler, group,
+                                                                                  seg, bin0 + t)];
+                            for (uint32_t d = 0; d < fft_size; ++d) {
+                                const xensiv_bgt60trxx_complex_t *v = &row[(d + fft_size - shift) %
+                                                                           fft_size];
+                                acc[d] += (v->re * v->re) + (v->im * v->im);
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
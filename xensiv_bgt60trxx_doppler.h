@@ -0,0 +1,187 @@
+/***********************************************************************************************/ /**
+                                                                                                   * \file xensiv_bgt60trxx_doppler.h
+                                                                                                   *
+                                                                                                   * \brief
+                                                                                                   * This file contains the Doppler processing stage of the XENSIV(TM) BGT60TRxx radar sensor:
+                                                                                                   * range-Doppler maps per RX channel and a non-coherent integrated map from range profiles.
+                                                                                                   *
+                                                                                                   ***************************************************************************************************
+                                                                                                   * \copyright
+                                                                                                   * Copyright 2022 Infineon Technologies AG
+                                                                                                   * SPDX-License-Identifier: Apache-2.0
+                                                                                                   *
+                                                                                                   * Licensed under the Apache License, Version 2.0 (the "License");
+                                                                                                   * you may not use this file except in compliance with the License.
+                                                                                                   * You may obtain a copy of the License at
+                                                                                                   *
+                                                                                                   *     http://www.apache.org/licenses/LICENSE-2.0
+                                                                                                   *
+                                                                                                   * Unless required by applicable law or agreed to in writing, software
+                                                                                                   * distributed under the License is distributed on an "AS IS" BASIS,
+                                                                                                   * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+                                                                                                   * See the License for the specific language governing permissions and
+                                                                                                   * limitations under the License.
+                                                                                                   **************************************************************************************************/
+
+#ifndef XENSIV_BGT60TRXX_DOPPLER_H_
+#define XENSIV_BGT60TRXX_DOPPLER_H_
+
+/**
+ * \addtogroup group_board_libs_doppler XENSIV(TM) BGT60TRxx Doppler processing
+ * \{
+ * Runs an FFT across the chirps of every range bin and RX channel of the range stage output.
+ * The range profiles are stored chirp by chirp, so the values of one range bin are a full
+ * profile apart. Instead of gathering them one bin at a time, the stage turns a tile of
+ * neighbouring range bins at once: each chirp contributes one short contiguous run per tile,
+ * the tile is transformed in a scratch buffer small enough to stay in the L1 cache, and the
+ * results are written row by row. The scratch size is set by the tile, not by the frame.
+ *
+ * For every shape group and segment the stage writes a complex map per RX channel,
+ * [rx][range bin][Doppler bin], and a non-coherent integration over the RX channels,
+ * [range bin][Doppler bin], holding the summed power. Either output can be skipped.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "xensiv_bgt60trxx_fft.h"
+#include "xensiv_bgt60trxx_range.h"
+
+/************************************** Macros *******************************************/
+
+/** Default scratch tile size in bytes, sized to stay within the L1 data cache */
+#ifndef XENSIV_BGT60TRXX_DOPPLER_TILE_BYTES
+    #define XENSIV_BGT60TRXX_DOPPLER_TILE_BYTES (16384U)
+#endif
+
+/********************************* Type definitions **************************************/
+
+/** enum with the static clutter filters applied across chirps */
+typedef enum {
+    XENSIV_BGT60TRXX_CLUTTER_NONE = 0, /**< No filter */
+    XENSIV_BGT60TRXX_CLUTTER_MEAN = 1, /**< Subtract the mean over the chirps of each bin */
+    XENSIV_BGT60TRXX_CLUTTER_MTI = 2   /**< Two-pulse canceller; the first chirp is zeroed */
+} xensiv_bgt60trxx_clutter_t;
+
+/** Doppler stage configuration */
+typedef struct {
+    xensiv_bgt60trxx_window_t window;   /**< Window applied across the chirps */
+    xensiv_bgt60trxx_fft_algo_t algo;   /**< FFT kernel */
+    xensiv_bgt60trxx_clutter_t clutter; /**< Static clutter filter */
+    uint32_t fft_size;                  /**< FFT size, 0 for the next power of two of the chirps */
+    bool center_zero;                   /**< Put zero Doppler at fft_size / 2 */
+    uint32_t tile_bins;                 /**< Range bins per tile, 0 for the default tile size */
+} xensiv_bgt60trxx_doppler_config_t;
+
+/** Window and FFT plan shared by all segments with the same number of chirps */
+typedef struct {
+    uint32_t num_chirps;              /**< Chirps per shape group */
+    uint32_t fft_size;                /**< FFT size, Doppler bins per row */
+    float *window;                    /**< num_chirps window coefficients */
+    xensiv_bgt60trxx_fft_plan_t plan; /**< Complex FFT plan */
+} xensiv_bgt60trxx_doppler_plan_t;
+
+/** Doppler stage object */
+typedef struct {
+    xensiv_bgt60trxx_doppler_config_t config; /**< Configuration */
+    const xensiv_bgt60trxx_range_t *range;    /**< Range stage producing the input */
+    uint32_t tile_bins;                       /**< Range bins per tile */
+    xensiv_bgt60trxx_complex_t *tile;         /**< Scratch tile */
+    uint32_t group_cells;                     /**< Complex map cells per shape group */
+    uint32_t frame_cells;                     /**< Complex map cells per frame */
+    uint32_t group_nci_cells;                 /**< Integrated map cells per shape group */
+    uint32_t frame_nci_cells;                 /**< Integrated map cells per frame */
+    uint32_t num_plans;                       /**< Distinct chirp counts */
+    xensiv_bgt60trxx_doppler_plan_t plans[XENSIV_BGT60TRXX_ASSEMBLER_MAX_SEGMENTS];
+    uint32_t segment_plan[XENSIV_BGT60TRXX_ASSEMBLER_MAX_SEGMENTS];   /**< Plan per segment */
+    uint32_t segment_offset[XENSIV_BGT60TRXX_ASSEMBLER_MAX_SEGMENTS]; /**< Map offset */
+    uint32_t nci_offset[XENSIV_BGT60TRXX_ASSEMBLER_MAX_SEGMENTS];     /**< Integrated offset */
+} xensiv_bgt60trxx_doppler_t;
+
+/******************************* Function prototypes *************************************/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Obtains the storage needed by a Doppler stage.
+ *
+ * @param[in] range Range stage producing the input.
+ * @param[in] config Doppler stage configuration.
+ * @return Storage size in bytes.
+ */
+size_t xensiv_bgt60trxx_doppler_storage_size(const xensiv_bgt60trxx_range_t *range,
+                                             const xensiv_bgt60trxx_doppler_config_t *config);
+
+/**
+ * @brief Initializes a Doppler stage, building its windows and FFT plans.
+ *
+ * @param[out] doppler Pointer to the Doppler stage object.
+ * @param[in] range Range stage producing the input. Must outlive the Doppler stage.
+ * @param[in] config Doppler stage configuration.
+ * @param[out] storage Storage of xensiv_bgt60trxx_doppler_storage_size() bytes, aligned for
+ * float, owned by the Doppler stage until it is no longer used.
+ * @param[in] storage_size Size of storage in bytes.
+ * @return XENSIV_BGT60TRXX_STATUS_OK if the Doppler stage was initialized;
+ * XENSIV_BGT60TRXX_STATUS_DEV_ERROR if the storage is too small or fft_size is not a power of
+ * two covering every chirp.
+ */
+int32_t xensiv_bgt60trxx_doppler_init(xensiv_bgt60trxx_doppler_t *doppler,
+                                      const xensiv_bgt60trxx_range_t *range,
+                                      const xensiv_bgt60trxx_doppler_config_t *config,
+                                      void *storage,
+                                      size_t storage_size);
+
+/**
+ * @brief Computes the range-Doppler maps of a frame. Uses the scratch tile, so a Doppler
+ * stage must not process two frames at the same time.
+ *
+ * @param[inout] doppler Pointer to the Doppler stage object.
+ * @param[in] profiles Complex range profiles, see xensiv_bgt60trxx_range_process().
+ * @param[out] map frame_cells complex cells, or NULL to skip the per-RX maps.
+ * @param[out] nci frame_nci_cells power values, or NULL to skip the integrated map.
+ */
+void xensiv_bgt60trxx_doppler_process(xensiv_bgt60trxx_doppler_t *doppler,
+                                      const xensiv_bgt60trxx_complex_t *profiles,
+                                      xensiv_bgt60trxx_complex_t *map,
+                                      float *nci);
+
+/**
+ * @brief Obtains the offset of the Doppler row of one range bin and RX channel in the map.
+ *
+ * @param[in] doppler Pointer to the Doppler stage object.
+ * @param[in] group Shape group.
+ * @param[in] segment Segment index within the shape group.
+ * @param[in] rx RX channel index within the segment.
+ * @param[in] bin Range bin.
+ * @return Offset of the first Doppler bin in elements.
+ */
+uint32_t xensiv_bgt60trxx_doppler_map_offset(const xensiv_bgt60trxx_doppler_t *doppler,
+                                             uint32_t group,
+                                             uint32_t segment,
+                                             uint32_t rx,
+                                             uint32_t bin);
+
+/**
+ * @brief Obtains the offset of the Doppler row of one range bin in the integrated map.
+ *
+ * @param[in] doppler Pointer to the Doppler stage object.
+ * @param[in] group Shape group.
+ * @param[in] segment Segment index within the shape group.
+ * @param[in] bin Range bin.
+ * @return Offset of the first Doppler bin in elements.
+ */
+uint32_t xensiv_bgt60trxx_doppler_nci_offset(const xensiv_bgt60trxx_doppler_t *doppler,
+                                             uint32_t group,
+                                             uint32_t segment,
+                                             uint32_t bin);
+
+#ifdef __cplusplus
+}
+#endif
+
+/** \} group_board_libs_doppler */
+
+#endif  // ifndef XENSIV_BGT60TRXX_DOPPLER_H_
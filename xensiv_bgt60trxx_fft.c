@@ -0,0 +1,284 @@
+/***********************************************************************************************/ /**
+                                                                                                   * \file xensiv_bgt60trxx_fft.c
+                                                                                                   *
+                                                                                                   * \brief
+                                                                                                   * This file contains the FFT kernels used by the XENSIV(TM) BGT60TRxx radar processing stages.
+                                                                                                   *
+                                                                                                   ***************************************************************************************************
+                                                                                                   * \copyright
+                                                                                                   * Copyright 2022 Infineon Technologies AG
+                                                                                                   * SPDX-License-Identifier: Apache-2.0
+                                                                                                   *
+                                                                                                   * Licensed under the Apache License, Version 2.0 (the "License");
+                                                                                                   * you may not use this file except in compliance with the License.
+                                                                                                   * You may obtain a copy of the License at
+                                                                                                   *
+                                                                                                   *     http://www.apache.org/licenses/LICENSE-2.0
+                                                                                                   *
+                                                                                                   * Unless required by applicable law or agreed to in writing, software
+                                                                                                   * distributed under the License is distributed on an "AS IS" BASIS,
+                                                                                                   * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+                                                                                                   * See the License for the specific language governing permissions and
+                                                                                                   * limitations under the License.
+                                                                                                   **************************************************************************************************/
+
+#include "xensiv_bgt60trxx_fft.h"
+
+#include <math.h>
+#include <string.h>
+
+#include "xensiv_bgt60trxx_platform.h"
+
+typedef xensiv_bgt60trxx_complex_t cplx_t;
+
+static inline cplx_t cadd(cplx_t a, cplx_t b)
+{
+    return (cplx_t){a.re + b.re, a.im + b.im};
+}
+
+
+static inline cplx_t csub(cplx_t a, cplx_t b)
+{
+    return (cplx_t){a.re - b.re, a.im - b.im};
+}
+
+
+static inline cplx_t cmul(cplx_t a, cplx_t b)
+{
+    return (cplx_t){(a.re * b.re) - (a.im * b.im), (a.re * b.im) + (a.im * b.re)};
+}
+
+
+/* Multiplication by -i */
+static inline cplx_t cmul_neg_i(cplx_t a)
+{
+    return (cplx_t){a.im, -a.re};
+}
+
+
+static void fill_twiddles(cplx_t *twiddles, uint32_t count, uint32_t size)
+{
+    const double pi = 3.14159265358979323846;
+
+    for (uint32_t k = 0; k < count; ++k) {
+        double phase = (-2.0 * pi * (double) k) / (double) size;
+        twiddles[k].re = (float) cos(phase);
+        twiddles[k].im = (float) sin(phase);
+    }
+}
+
+
+static void permute(const xensiv_bgt60trxx_fft_plan_t *plan, cplx_t *data)
+{
+    for (uint32_t i = 0; i < plan->size; ++i) {
+        uint32_t j = plan->bitrev[i];
+        if (i < j) {
+            cplx_t tmp = data[i];
+            data[i] = data[j];
+            data[j] = tmp;
+        }
+    }
+}
+
+
+static void radix2_pass(const xensiv_bgt60trxx_fft_plan_t *plan, cplx_t *data, uint32_t len)
+{
+    const uint32_t half = len / 2U;
+    const uint32_t step = plan->size / len;
+
+    for (uint32_t block = 0; block < plan->size; block += len) {
+        cplx_t *x = &data[block];
+        for (uint32_t k = 0; k < half; ++k) {
+            cplx_t t = cmul(x[k + half], plan->twiddles[k * step]);
+            x[k + half] = csub(x[k], t);
+            x[k] = cadd(x[k], t);
+        }
+    }
+}
+
+
+static void fft_radix2(const xensiv_bgt60trxx_fft_plan_t *plan, cplx_t *data)
+{
+    for (uint32_t len = 2U; len <= plan->size; len <<= 1) {
+        radix2_pass(plan, data, len);
+    }
+}
+
+
+/* After bit reversal the quarters of a block of len points hold the sub-spectra of the inputs
+   congruent to 0, 2, 1 and 3 modulo 4 */
+static void fft_radix4(const xensiv_bgt60trxx_fft_plan_t *plan, cplx_t *data)
+{
+    uint32_t len = 4U;
+
+    if ((plan->log2_size % 2U) != 0U) {
+        radix2_pass(plan, data, 2U);
+        len = 8U;
+    }
+
+    for (; len <= plan->size; len <<= 2) {
+        const uint32_t quarter = len / 4U;
+        const uint32_t step = plan->size / len;
+
+        for (uint32_t block = 0; block < plan->size; block += len) {
+            cplx_t *x = &data[block];
+            for (uint32_t k = 0; k < quarter; ++k) {
+                cplx_t a = x[k];
+                cplx_t b = cmul(x[k + quarter], plan->twiddles[2U * k * step]);
+                cplx_t c = cmul(x[k + (2U * quarter)], plan->twiddles[k * step]);
+                cplx_t d = cmul(x[k + (3U * quarter)], plan->twiddles[3U * k * step]);
+                cplx_t ab_sum = cadd(a, b);
+                cplx_t ab_diff = csub(a, b);
+                cplx_t cd_sum = cadd(c, d);
+                cplx_t cd_diff = cmul_neg_i(csub(c, d));
+
+                x[k] = cadd(ab_sum, cd_sum);
+                x[k + quarter] = cadd(ab_diff, cd_diff);
+                x[k + (2U * quarter)] = csub(ab_sum, cd_sum);
+                x[k + (3U * quarter)] = csub(ab_diff, cd_diff);
+            }
+        }
+    }
+}
+
+
+/* Bit reversed input: the first half holds the even inputs, the last two quarters the inputs
+   congruent to 1 and 3 modulo 4, each transformed recursively and combined in place */
+static void split_radix(const xensiv_bgt60trxx_fft_plan_t *plan, cplx_t *x, uint32_t n)
+{
+    if (n == 2U) {
+        cplx_t t = x[1];
+        x[1] = csub(x[0], t);
+        x[0] = cadd(x[0], t);
+        return;
+    }
+    if (n < 2U) {
+        return;
+    }
+
+    const uint32_t quarter = n / 4U;
+    const uint32_t step = plan->size / n;
+
+    split_radix(plan, x, n / 2U);
+    split_radix(plan, &x[2U * quarter], quarter);
+    split_radix(plan, &x[3U * quarter], quarter);
+
+    for (uint32_t k = 0; k < quarter; ++k) {
+        cplx_t z1 = cmul(x[k + (2U * quarter)], plan->twiddles[k * step]);
+        cplx_t z3 = cmul(x[k + (3U * quarter)], plan->twiddles[3U * k * step]);
+        cplx_t sum = cadd(z1, z3);
+        cplx_t diff = cmul_neg_i(csub(z1, z3));
+        cplx_t u0 = x[k];
+        cplx_t u1 = x[k + quarter];
+
+        x[k] = cadd(u0, sum);
+        x[k + (2U * quarter)] = csub(u0, sum);
+        x[k + quarter] = cadd(u1, diff);
+        x[k + (3U * quarter)] = csub(u1, diff);
+    }
+}
+
+
+void xensiv_bgt60trxx_fft_plan_init(xensiv_bgt60trxx_fft_plan_t *plan,
+                                    uint32_t size,
+                                    xensiv_bgt60trxx_fft_algo_t algo,
+                                    void *storage)
+{
+    xensiv_bgt60trxx_platform_assert(plan != NULL);
+    xensiv_bgt60trxx_platform_assert(storage != NULL);
+    xensiv_bgt60trxx_platform_assert((size > 0U) && ((size & (size - 1U)) == 0U));
+
+    plan->size = size;
+    plan->algo = algo;
+    plan->log2_size = 0U;
+    while ((1UL << plan->log2_size) < size) {
+        ++plan->log2_size;
+    }
+
+    plan->twiddles = (cplx_t *) storage;
+    plan->bitrev = (uint32_t *) &plan->twiddles[size];
+
+    fill_twiddles(plan->twiddles, size, size);
+
+    for (uint32_t i = 0; i < size; ++i) {
+        uint32_t rev = 0U;
+        for (uint32_t bit = 0; bit < plan->log2_size; ++bit) {
+            rev |= ((i >> bit) & 1U) << (plan->log2_size - 1U - bit);
+        }
+        plan->bitrev[i] = rev;
+    }
+}
+
+
+void xensiv_bgt60trxx_fft(const xensiv_bgt60trxx_fft_plan_t *plan,
+                          xensiv_bgt60trxx_complex_t *data)
+{
+    xensiv_bgt60trxx_platform_assert(plan != NULL);
+    xensiv_bgt60trxx_platform_assert(data != NULL);
+
+    permute(plan, data);
+
+    switch (plan->algo) {
+        case XENSIV_BGT60TRXX_FFT_RADIX4:
+            fft_radix4(plan, data);
+            break;
+        case XENSIV_BGT60TRXX_FFT_SPLIT_RADIX:
+            split_radix(plan, data, plan->size);
+            break;
+        default:
+            fft_radix2(plan, data);
+            break;
+    }
+}
+
+
+void xensiv_bgt60trxx_rfft_plan_init(xensiv_bgt60trxx_rfft_plan_t *plan,
+                                     uint32_t size,
+                                     xensiv_bgt60trxx_fft_algo_t algo,
+                                     void *storage)
+{
+    xensiv_bgt60trxx_platform_assert(plan != NULL);
+    xensiv_bgt60trxx_platform_assert(storage != NULL);
+    xensiv_bgt60trxx_platform_assert((size >= 2U) && ((size & (size - 1U)) == 0U));
+
+    plan->size = size;
+    xensiv_bgt60trxx_fft_plan_init(&plan->half, size / 2U, algo, storage);
+    plan->twiddles = (cplx_t *) ((uint8_t *) storage +
+                                 XENSIV_BGT60TRXX_FFT_PLAN_STORAGE_BYTES(size / 2U));
+    fill_twiddles(plan->twiddles, size / 2U, size);
+}
+
+
+void xensiv_bgt60trxx_rfft(const xensiv_bgt60trxx_rfft_plan_t *plan,
+                           const float *in,
+                           xensiv_bgt60trxx_complex_t *out)
+{
+    xensiv_bgt60trxx_platform_assert(plan != NULL);
+    xensiv_bgt60trxx_platform_assert((in != NULL) && (out != NULL));
+
+    const uint32_t half = plan->size / 2U;
+
+    /* Even samples as real parts, odd samples as imaginary parts */
+    if ((const void *) in != (const void *) out) {
+        memcpy(out, in, plan->size * sizeof(float));
+    }
+    xensiv_bgt60trxx_fft(&plan->half, out);
+
+    /* Separate the spectra of the even and odd samples and combine them, pairing k and half-k */
+    cplx_t z0 = out[0];
+    out[0] = (cplx_t){z0.re + z0.im, z0.re - z0.im};
+
+    for (uint32_t k = 1U; k <= (half / 2U); ++k) {
+        cplx_t zk = out[k];
+        cplx_t zn = out[half - k];
+        cplx_t even = {0.5f * (zk.re + zn.re), 0.5f * (zk.im - zn.im)};
+        cplx_t odd = {0.5f * (zk.im + zn.im), -0.5f * (zk.re - zn.re)};
+        cplx_t t = cmul(odd, plan->twiddles[k]);
+
+        out[k] = cadd(even, t);
+        if (k != (half - k)) {
+            cplx_t m = csub(even, t);
+            out[half - k] = (cplx_t){m.re, -m.im};
+        }
+    }
+}
@@ -0,0 +1,153 @@
+/***********************************************************************************************/ /**
+                                                                                                   * \file xensiv_bgt60trxx_fft.h
+                                                                                                   *
+                                                                                                   * \brief
+                                                                                                   * This file contains the FFT kernels used by the XENSIV(TM) BGT60TRxx radar processing stages:
+                                                                                                   * radix-2, radix-4 and split-radix complex FFTs and a real-input FFT on precomputed plans.
+                                                                                                   *
+                                                                                                   ***************************************************************************************************
+                                                                                                   * \copyright
+                                                                                                   * Copyright 2022 Infineon Technologies AG
+                                                                                                   * SPDX-License-Identifier: Apache-2.0
+                                                                                                   *
+                                                                                                   * Licensed under the Apache License, Version 2.0 (the "License");
+                                                                                                   * you may not use this file except in compliance with the License.
+                                                                                                   * You may obtain a copy of the License at
+                                                                                                   *
+                                                                                                   *     http://www.apache.org/licenses/LICENSE-2.0
+                                                                                                   *
+                                                                                                   * Unless required by applicable law or agreed to in writing, software
+                                                                                                   * distributed under the License is distributed on an "AS IS" BASIS,
+                                                                                                   * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+                                                                                                   * See the License for the specific language governing permissions and
+                                                                                                   * limitations under the License.
+                                                                                                   **************************************************************************************************/
+
+#ifndef XENSIV_BGT60TRXX_FFT_H_
+#define XENSIV_BGT60TRXX_FFT_H_
+
+/**
+ * \addtogroup group_board_libs_fft XENSIV(TM) BGT60TRxx FFT
+ * \{
+ * Single precision, in-place, forward FFTs of power-of-two sizes without external
+ * dependencies. A plan holds the twiddle factors and the bit reversal permutation of one size;
+ * it is built once into caller-provided storage and can then be shared by any number of
+ * transforms, including concurrent ones, since transforms never write to it.
+ *
+ * Three complex kernels are available:
+ * - radix-2: one butterfly pass per bit of the size,
+ * - radix-4: two bits per pass, with one radix-2 pass first for odd powers of two,
+ * - split-radix: radix-2 for the even outputs and radix-4 for the odd ones, the lowest
+ *   arithmetic count of the three.
+ *
+ * The real-input FFT runs a complex FFT of half the size on the even/odd samples packed as
+ * real/imaginary parts and separates the spectra in one extra pass.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+/************************************** Macros *******************************************/
+
+/** Storage in bytes needed by a complex FFT plan of the given size */
+#define XENSIV_BGT60TRXX_FFT_PLAN_STORAGE_BYTES(size) \
+    ((size_t) (size) * (sizeof(xensiv_bgt60trxx_complex_t) + sizeof(uint32_t)))
+
+/** Storage in bytes needed by a real-input FFT plan of the given size */
+#define XENSIV_BGT60TRXX_RFFT_PLAN_STORAGE_BYTES(size)    \
+    (XENSIV_BGT60TRXX_FFT_PLAN_STORAGE_BYTES((size) / 2U) + \
+     (((size_t) (size) / 2U) * sizeof(xensiv_bgt60trxx_complex_t)))
+
+/********************************* Type definitions **************************************/
+
+/** Single precision complex value */
+typedef struct {
+    float re; /**< Real part */
+    float im; /**< Imaginary part */
+} xensiv_bgt60trxx_complex_t;
+
+/** enum with the complex FFT kernels */
+typedef enum {
+    XENSIV_BGT60TRXX_FFT_RADIX2 = 0,     /**< Radix-2 decimation in time */
+    XENSIV_BGT60TRXX_FFT_RADIX4 = 1,     /**< Radix-4 decimation in time, radix-2 for odd sizes */
+    XENSIV_BGT60TRXX_FFT_SPLIT_RADIX = 2 /**< Split-radix decimation in time */
+} xensiv_bgt60trxx_fft_algo_t;
+
+/** Complex FFT plan */
+typedef struct {
+    uint32_t size;                        /**< Number of complex points, a power of two */
+    uint32_t log2_size;                   /**< log2(size) */
+    xensiv_bgt60trxx_fft_algo_t algo;     /**< Kernel */
+    xensiv_bgt60trxx_complex_t *twiddles; /**< exp(-2*pi*i*k/size) for k < size */
+    uint32_t *bitrev;                     /**< Bit reversal permutation */
+} xensiv_bgt60trxx_fft_plan_t;
+
+/** Real-input FFT plan */
+typedef struct {
+    uint32_t size;                        /**< Number of real input points, a power of two */
+    xensiv_bgt60trxx_fft_plan_t half;     /**< Complex plan of size / 2 */
+    xensiv_bgt60trxx_complex_t *twiddles; /**< exp(-2*pi*i*k/size) for k < size / 2 */
+} xensiv_bgt60trxx_rfft_plan_t;
+
+/******************************* Function prototypes *************************************/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Builds a complex FFT plan.
+ *
+ * @param[out] plan Pointer to the plan object.
+ * @param[in] size Number of complex points, a power of two of at least 1.
+ * @param[in] algo Kernel.
+ * @param[out] storage XENSIV_BGT60TRXX_FFT_PLAN_STORAGE_BYTES(size) bytes, aligned for float,
+ * owned by the plan until it is no longer used.
+ */
+void xensiv_bgt60trxx_fft_plan_init(xensiv_bgt60trxx_fft_plan_t *plan,
+                                    uint32_t size,
+                                    xensiv_bgt60trxx_fft_algo_t algo,
+                                    void *storage);
+
+/**
+ * @brief Computes the forward complex FFT of size points in place, unnormalized.
+ *
+ * @param[in] plan Pointer to the plan.
+ * @param[inout] data size complex points, replaced by their spectrum.
+ */
+void xensiv_bgt60trxx_fft(const xensiv_bgt60trxx_fft_plan_t *plan,
+                          xensiv_bgt60trxx_complex_t *data);
+
+/**
+ * @brief Builds a real-input FFT plan.
+ *
+ * @param[out] plan Pointer to the plan object.
+ * @param[in] size Number of real points, a power of two of at least 2.
+ * @param[in] algo Kernel of the inner complex FFT.
+ * @param[out] storage XENSIV_BGT60TRXX_RFFT_PLAN_STORAGE_BYTES(size) bytes, aligned for float.
+ */
+void xensiv_bgt60trxx_rfft_plan_init(xensiv_bgt60trxx_rfft_plan_t *plan,
+                                     uint32_t size,
+                                     xensiv_bgt60trxx_fft_algo_t algo,
+                                     void *storage);
+
+/**
+ * @brief Computes the forward FFT of size real points, unnormalized.
+ * Bins 0 to size/2 - 1 are returned; bin 0 and the Nyquist bin are real, so the Nyquist bin is
+ * returned in the imaginary part of bin 0.
+ *
+ * @param[in] plan Pointer to the plan.
+ * @param[in] in size real points. May be the memory of out for an in-place transform.
+ * @param[out] out size/2 complex bins.
+ */
+void xensiv_bgt60trxx_rfft(const xensiv_bgt60trxx_rfft_plan_t *plan,
+                           const float *in,
+                           xensiv_bgt60trxx_complex_t *out);
+
+#ifdef __cplusplus
+}
+#endif
+
+/** \} group_board_libs_fft */
+
+#endif  // ifndef XENSIV_BGT60TRXX_FFT_H_
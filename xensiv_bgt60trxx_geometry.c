@@ -0,0 +1,178 @@
+/***********************************************************************************************/ /**
+                                                                                                   * \file xensiv_bgt60trxx_geometry.c
+                                                                                                   *
+                                                                                                   * \brief
+                                                                                                   * This file contains the frame geometry decoder of the XENSIV(TM) BGT60TRxx radar sensor.
+                                                                                                   *
+                                                                                                   ***************************************************************************************************
+                                                                                                   * \copyright
+                                                                                                   * Copyright 2022 Infineon Technologies AG
+                                                                                                   * SPDX-License-Identifier: Apache-2.0
+                                                                                                   *
+                                                                                                   * Licensed under the Apache License, Version 2.0 (the "License");
+                                                                                                   * you may not use this file except in compliance with the License.
+                                                                                                   * You may obtain a copy of the License at
+                                                                                                   *
+                                                                                                   *     http://www.apache.org/licenses/LICENSE-2.0
+                                                                                                   *
+                                                                                                   * Unless required by applicable law or agreed to in writing, software
+                                                                                                   * distributed under the License is distributed on an "AS IS" BASIS,
+                                                                                                   * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+                                                                                                   * See the License for the specific language governing permissions and
+                                                                                                   * limitations under the License.
+                                                                                                   **************************************************************************************************/
+
+#include "xensiv_bgt60trxx_geometry.h"
+
+#include <stddef.h>
+#include <string.h>
+
+#include "xensiv_bgt60trxx_platform.h"
+
+/* Registers from MAIN up to the shape control of shape 4 */
+#define XENSIV_BGT60TRXX_GEOMETRY_NUM_REGS (XENSIV_BGT60TRXX_REG_PLL4_7 + 1U)
+
+/* Address distance between the registers of consecutive shapes */
+#define PLL_STRIDE (XENSIV_BGT60TRXX_REG_PLL2_0 - XENSIV_BGT60TRXX_REG_PLL1_0)
+#define CS_STRIDE (XENSIV_BGT60TRXX_REG_CSU2_1 - XENSIV_BGT60TRXX_REG_CSU1_1)
+
+#define FIELD(val, name) (((val) & name##_MSK) >> name##_POS)
+
+
+static uint32_t count_bits(uint32_t val)
+{
+    uint32_t count = 0U;
+
+    while (val != 0U) {
+        val &= val - 1U;
+        ++count;
+    }
+
+    return count;
+}
+
+
+static int32_t decode(const uint32_t *regs, xensiv_bgt60trxx_frame_geometry_t *geometry)
+{
+    uint64_t group_samples = 0U;
+    uint64_t group_ticks = 0U;
+
+    memset(geometry, 0, sizeof(*geometry));
+
+    for (uint32_t shape = 0U; shape < XENSIV_BGT60TRXX_NUM_SHAPES; ++shape) {
+        const uint32_t *pll = &regs[XENSIV_BGT60TRXX_REG_PLL1_0 + (shape * PLL_STRIDE)];
+        uint32_t csu_1 = regs[XENSIV_BGT60TRXX_REG_CSU1_1 + (shape * CS_STRIDE)];
+        uint32_t csd_1 = regs[XENSIV_BGT60TRXX_REG_CSD1_1 + (shape * CS_STRIDE)];
+
+        if ((shape > 0U) && (FIELD(pll[7], XENSIV_BGT60TRXX_REG_PLL_7_SH_EN) == 0U)) {
+            continue;
+        }
+
+        uint32_t reps = 1UL << FIELD(pll[7], XENSIV_BGT60TRXX_REG_PLL_7_REPS);
+        uint32_t up_rx = FIELD(csu_1, XENSIV_BGT60TRXX_REG_CS_1_BBCH_SEL);
+        uint32_t down_rx = FIELD(csd_1, XENSIV_BGT60TRXX_REG_CS_1_BBCH_SEL);
+        uint32_t apu = FIELD(pll[3], XENSIV_BGT60TRXX_REG_PLL_3_APU);
+        uint32_t apd = FIELD(pll[3], XENSIV_BGT60TRXX_REG_PLL_3_APD);
+        uint32_t chirp_ticks = FIELD(pll[2], XENSIV_BGT60TRXX_REG_PLL_2_RTU) +
+                               FIELD(pll[2], XENSIV_BGT60TRXX_REG_PLL_2_TEDU) +
+                               FIELD(pll[6], XENSIV_BGT60TRXX_REG_PLL_6_RTD) +
+                               FIELD(pll[6], XENSIV_BGT60TRXX_REG_PLL_6_TEDD);
+
+        geometry->shapes[shape].num_chirps = reps;
+        geometry->shapes[shape].up_samples = apu;
+        geometry->shapes[shape].up_rx_mask = up_rx;
+        geometry->shapes[shape].down_samples = apd;
+        geometry->shapes[shape].down_rx_mask = down_rx;
+
+        if (shape == 0U) {
+            geometry->samples_per_chirp = apu;
+            geometry->chirps_per_shape = reps;
+            geometry->rx_mask = up_rx;
+            geometry->num_rx = count_bits(up_rx);
+        }
+
+        uint32_t chirp_samples = (apu * count_bits(up_rx)) + (apd * count_bits(down_rx));
+
+        ++geometry->num_shapes;
+        group_samples += (uint64_t) reps * chirp_samples;
+        group_ticks += (uint64_t) reps * chirp_ticks;
+    }
+
+    uint32_t ccr1 = regs[XENSIV_BGT60TRXX_REG_CCR1];
+    uint32_t ccr2 = regs[XENSIV_BGT60TRXX_REG_CCR2];
+    uint32_t groups = FIELD(ccr2, XENSIV_BGT60TRXX_REG_CCR2_FRAME_LEN) + 1U;
+    uint64_t fed_ticks = (uint64_t) FIELD(ccr1, XENSIV_BGT60TRXX_REG_CCR1_TR_FED)
+                         << FIELD(ccr1, XENSIV_BGT60TRXX_REG_CCR1_TR_FED_MUL);
+    uint64_t frame_ticks = (groups * group_ticks) + fed_ticks;
+    uint32_t adc_div = FIELD(regs[XENSIV_BGT60TRXX_REG_ADC0], XENSIV_BGT60TRXX_REG_ADC0_ADC_DIV);
+
+    geometry->shape_groups = groups;
+    geometry->shapes_per_frame = geometry->num_shapes * groups;
+    geometry->samples_per_frame = (uint32_t) (groups * group_samples);
+    geometry->adc_rate_hz = (adc_div > 0U) ? (XENSIV_BGT60TRXX_SYS_CLK_HZ / adc_div) : 0U;
+    geometry->frame_period_us =
+        (uint32_t) ((frame_ticks * XENSIV_BGT60TRXX_TIMER_UNIT_CYCLES * 1000000U) /
+                    XENSIV_BGT60TRXX_SYS_CLK_HZ);
+    if (geometry->frame_period_us > 0U) {
+        geometry->data_rate_sps =
+            (uint32_t) (((uint64_t) geometry->samples_per_frame * 1000000U) /
+                        geometry->frame_period_us);
+    }
+
+    return (geometry->samples_per_frame > 0U) ? XENSIV_BGT60TRXX_STATUS_OK
+                                              : XENSIV_BGT60TRXX_STATUS_DEV_ERROR;
+}
+
+
+int32_t xensiv_bgt60trxx_decode_geometry(const uint32_t *regs,
+                                         uint32_t len,
+                                         xensiv_bgt60trxx_frame_geometry_t *geometry)
+{
+    xensiv_bgt60trxx_platform_assert(regs != NULL);
+    xensiv_bgt60trxx_platform_assert(geometry != NULL);
+
+    uint32_t values[XENSIV_BGT60TRXX_GEOMETRY_NUM_REGS] = {0U};
+
+    for (uint32_t reg_idx = 0; reg_idx < len; ++reg_idx) {
+        uint32_t reg_addr = FIELD(regs[reg_idx], XENSIV_BGT60TRXX_SPI_REGADR);
+        if (reg_addr < XENSIV_BGT60TRXX_GEOMETRY_NUM_REGS) {
+            values[reg_addr] = FIELD(regs[reg_idx], XENSIV_BGT60TRXX_SPI_DATA);
+        }
+    }
+
+    return decode(values, geometry);
+}
+
+
+int32_t xensiv_bgt60trxx_get_geometry(const xensiv_bgt60trxx_t *dev,
+                                      xensiv_bgt60trxx_frame_geometry_t *geometry)
+{
+    xensiv_bgt60trxx_platform_assert(dev != NULL);
+    xensiv_bgt60trxx_platform_assert(geometry != NULL);
+
+    const xensiv_bgt60trxx_shadow_t *shadow = dev->shadow;
+    uint32_t values[XENSIV_BGT60TRXX_GEOMETRY_NUM_REGS];
+    bool cached = (shadow != NULL);
+
+    /* CHIP_ID and STAT1 are never cached but play no part in the geometry */
+    for (uint32_t reg_addr = 0U; cached && (reg_addr < XENSIV_BGT60TRXX_GEOMETRY_NUM_REGS);
+         ++reg_addr) {
+        if ((reg_addr != XENSIV_BGT60TRXX_REG_CHIP_ID) &&
+            (reg_addr != XENSIV_BGT60TRXX_REG_STAT1)) {
+            cached = (shadow->valid[reg_addr / 32U] & (1UL << (reg_addr % 32U))) != 0U;
+        }
+    }
+
+    int32_t status = XENSIV_BGT60TRXX_STATUS_OK;
+    if (cached) {
+        memcpy(values, shadow->regs, sizeof(values));
+    } else {
+        status = xensiv_bgt60trxx_get_regs(dev, 0U, values, XENSIV_BGT60TRXX_GEOMETRY_NUM_REGS);
+    }
+
+    if (XENSIV_BGT60TRXX_STATUS_OK == status) {
+        status = decode(values, geometry);
+    }
+
+    return status;
+}
@@ -0,0 +1,127 @@
+/***********************************************************************************************/ /**
+                                                                                                   * \file xensiv_bgt60trxx_geometry.h
+                                                                                                   *
+                                                                                                   * \brief
+                                                                                                   * This file contains the frame geometry decoder of the XENSIV(TM) BGT60TRxx radar sensor:
+                                                                                                   * samples, chirps, shapes, RX channels and timing derived from the register configuration.
+                                                                                                   *
+                                                                                                   ***************************************************************************************************
+                                                                                                   * \copyright
+                                                                                                   * Copyright 2022 Infineon Technologies AG
+                                                                                                   * SPDX-License-Identifier: Apache-2.0
+                                                                                                   *
+                                                                                                   * Licensed under the Apache License, Version 2.0 (the "License");
+                                                                                                   * you may not use this file except in compliance with the License.
+                                                                                                   * You may obtain a copy of the License at
+                                                                                                   *
+                                                                                                   *     http://www.apache.org/licenses/LICENSE-2.0
+                                                                                                   *
+                                                                                                   * Unless required by applicable law or agreed to in writing, software
+                                                                                                   * distributed under the License is distributed on an "AS IS" BASIS,
+                                                                                                   * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+                                                                                                   * See the License for the specific language governing permissions and
+                                                                                                   * limitations under the License.
+                                                                                                   **************************************************************************************************/
+
+#ifndef XENSIV_BGT60TRXX_GEOMETRY_H_
+#define XENSIV_BGT60TRXX_GEOMETRY_H_
+
+#include "xensiv_bgt60trxx.h"
+
+/**
+ * \addtogroup group_board_libs_geometry XENSIV(TM) BGT60TRxx frame geometry
+ * \{
+ * Decodes the shape, channel set and frame control registers into the layout of the data the
+ * sensor writes to its FIFO, so that buffers, frame assembly and the FIFO limit can be sized
+ * exactly instead of from hand-computed constants.
+ *
+ * A frame consists of FRAME_LEN + 1 shape groups. A shape group runs every enabled shape
+ * (PLLx_7 SH_EN, shape 1 always runs) 2^REPS times. Each repetition samples APU points on the
+ * up-chirp and APD points on the down-chirp for every RX channel selected in BBCH_SEL of the
+ * matching channel set. The timing covers the ramps, the ramp end delays and the frame end
+ * delay; power mode transitions between shapes are not included, so the frame period is a
+ * lower bound when power saving modes are configured.
+ */
+
+#include <stdint.h>
+
+/************************************** Macros *******************************************/
+
+/** Reference clock of the sensor FSM and ADC divider in Hz. */
+#ifndef XENSIV_BGT60TRXX_SYS_CLK_HZ
+    #define XENSIV_BGT60TRXX_SYS_CLK_HZ (80000000UL)
+#endif
+
+/** Number of FSM clock cycles per unit of the ramp and delay timer fields. */
+#define XENSIV_BGT60TRXX_TIMER_UNIT_CYCLES (8U)
+
+/** Number of chirp shapes of the FSM. */
+#define XENSIV_BGT60TRXX_NUM_SHAPES (4U)
+
+/********************************* Type definitions **************************************/
+
+/** Data produced by one shape per shape group */
+typedef struct {
+    uint32_t num_chirps;   /**< Repetitions per shape group, 0 if the shape is disabled */
+    uint32_t up_samples;   /**< ADC samples per up-chirp and RX channel */
+    uint32_t up_rx_mask;   /**< RX channels sampled on the up-chirp */
+    uint32_t down_samples; /**< ADC samples per down-chirp and RX channel */
+    uint32_t down_rx_mask; /**< RX channels sampled on the down-chirp */
+} xensiv_bgt60trxx_shape_geometry_t;
+
+/** Layout and timing of the frames produced by a register configuration */
+typedef struct {
+    uint32_t samples_per_chirp; /**< ADC samples per up-chirp and RX channel of shape 1 */
+    uint32_t chirps_per_shape;  /**< Repetitions of shape 1 per shape group */
+    uint32_t num_shapes;        /**< Enabled shapes */
+    uint32_t shapes_per_frame;  /**< Shape runs per frame, enabled shapes times shape groups */
+    uint32_t rx_mask;           /**< RX channels sampled on the up-chirp of shape 1, bit 0: RX1 */
+    uint32_t num_rx;            /**< Number of RX channels in rx_mask */
+    uint32_t adc_rate_hz;       /**< ADC sample rate in Hz */
+    uint32_t samples_per_frame; /**< FIFO samples per frame over all shapes and channels */
+    uint32_t frame_period_us;   /**< Frame period in microseconds */
+    uint32_t data_rate_sps;     /**< Average FIFO data rate in samples/s */
+    uint32_t shape_groups;      /**< Shape groups per frame */
+    xensiv_bgt60trxx_shape_geometry_t shapes[XENSIV_BGT60TRXX_NUM_SHAPES]; /**< Per shape */
+} xensiv_bgt60trxx_frame_geometry_t;
+
+/******************************* Function prototypes *************************************/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Decodes the frame geometry of a register list from the BGT60TRxx configurator tool.
+ * Registers not in the list are taken as zero.
+ *
+ * @param[in] regs Configuration registers list.
+ * @param[in] len Length of the configuration registers list.
+ * @param[out] geometry Pointer to populate with the frame geometry.
+ * @return XENSIV_BGT60TRXX_STATUS_OK if decoding was successful;
+ * XENSIV_BGT60TRXX_STATUS_DEV_ERROR if the configuration acquires no samples.
+ */
+int32_t xensiv_bgt60trxx_decode_geometry(const uint32_t *regs,
+                                         uint32_t len,
+                                         xensiv_bgt60trxx_frame_geometry_t *geometry);
+
+/**
+ * @brief Decodes the frame geometry of the configuration held by the device.
+ * The register shadow is used if it holds every register needed (see
+ * \ref xensiv_bgt60trxx_shadow_enable), otherwise the registers are read from the device.
+ *
+ * @param[in] dev Pointer to the XENSIV(TM) BGT60TRxx sensor device object.
+ * @param[out] geometry Pointer to populate with the frame geometry.
+ * @return XENSIV_BGT60TRXX_STATUS_OK if decoding was successful; else an error indicating
+ * what went wrong.
+ */
+int32_t xensiv_bgt60trxx_get_geometry(const xensiv_bgt60trxx_t *dev,
+                                      xensiv_bgt60trxx_frame_geometry_t *geometry);
+
+#ifdef __cplusplus
+}
+#endif
+
+/** \} group_board_libs_geometry */
+
+#endif  // ifndef XENSIV_BGT60TRXX_GEOMETRY_H_
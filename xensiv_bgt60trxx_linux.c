@@ -38,16 +38,19 @@
     #include <fcntl.h>
     #include <linux/gpio.h>
     #include <linux/spi/spidev.h>
+    #include <poll.h>
     #include <stdbool.h>
     #include <stdint.h>
     #include <stdio.h>
     #include <stdlib.h>
     #include <string.h>
     #include <sys/ioctl.h>
+    #include <sys/mman.h>
     #include <time.h>
     #include <unistd.h>
 
     #include "xensiv_bgt60trxx_platform.h"
+    #include "xensiv_bgt60trxx_unpack.h"
 
     /*******************************************************************************
      * Macros
@@ -56,6 +59,26 @@
     #define XENSIV_BGT60TRXX_SPI_BITS_PER_WORD (8)
     #define XENSIV_BGT60TRXX_SPI_MAX_SPEED_HZ (10000000) /* 10 MHz */
     #define XENSIV_BGT60TRXX_GPIO_CONSUMER "xensiv_bgt60trxx"
+    #define XENSIV_BGT60TRXX_SPIDEV_BUFSIZ_PATH "/sys/module/spidev/parameters/bufsiz"
+    #define XENSIV_BGT60TRXX_SPIDEV_BUFSIZ_DEFAULT (4096U) /* spidev module default */
+    #define XENSIV_BGT60TRXX_SPIDEV_BUFSIZ_MIN (64U)
+    #define XENSIV_BGT60TRXX_SPIDEV_XFER_ALIGN (128U) /* largest ARCH_DMA_MINALIGN (arm64) */
+    #define XENSIV_BGT60TRXX_IRQ_EVENT_BUFFER (16U) /* kernel side queue of edge events */
+    #define XENSIV_BGT60TRXX_LINK_DEFAULT_WORDS (1024U)
+    #define XENSIV_BGT60TRXX_LINK_DEFAULT_TRIALS (4U)
+    #define XENSIV_BGT60TRXX_LINK_DEFAULT_MARGIN (1U)
+    #define XENSIV_BGT60TRXX_LINK_CREF_POLLS (1000U) /* 1 ms per poll */
+    #define XENSIV_BGT60TRXX_SAMPLE_BITS (12U)
+    #define XENSIV_BGT60TRXX_LINUX_DELAY_SPIN_US (50U) /* below: busy wait instead of sleep */
+
+/*******************************************************************************
+ * Local Variables
+ *******************************************************************************/
+
+/* Default link training candidates, up to the 50 MHz SPI limit of the sensor */
+static const uint32_t link_default_speeds_hz[] = {
+    10000000U, 15000000U, 20000000U, 25000000U, 30000000U, 40000000U, 50000000U
+};
 
 /*******************************************************************************
  * Local Functions
@@ -87,14 +110,239 @@ static int configure_gpio_output(int gpio_chip_fd, unsigned int offset, bool ini
 /**
  * @brief Set GPIO pin value
  */
-static int set_gpio_value(int gpio_fd, bool value)
+static int set_gpio_value(xensiv_bgt60trxx_linux_t *obj, int gpio_fd, bool value)
 {
     struct gpiohandle_data data;
 
     data.values[0] = value ? 1 : 0;
+    ++obj->gpio_ioctls;
     return ioctl(gpio_fd, GPIOHANDLE_SET_LINE_VALUES_IOCTL, &data);
 }
 
+/**
+ * @brief Submit a spidev message made of num_xfers transfers
+ */
+static int spi_message(xensiv_bgt60trxx_linux_t *obj,
+                       struct spi_ioc_transfer *xfers,
+                       unsigned int num_xfers)
+{
+    for (unsigned int i = 0; i < num_xfers; ++i) {
+        xfers[i].speed_hz = obj->speed_hz;
+        xfers[i].bits_per_word = XENSIV_BGT60TRXX_SPI_BITS_PER_WORD;
+    }
+
+    ++obj->spi_ioctls;
+    return ioctl(obj->spi_fd, SPI_IOC_MESSAGE(num_xfers), xfers);
+}
+
+/**
+ * @brief Read the spidev message size limit (bytes per direction per SPI_IOC_MESSAGE)
+ */
+static uint32_t read_spidev_bufsiz(void)
+{
+    unsigned long bufsiz = XENSIV_BGT60TRXX_SPIDEV_BUFSIZ_DEFAULT;
+    FILE *f = fopen(XENSIV_BGT60TRXX_SPIDEV_BUFSIZ_PATH, "r");
+
+    if (f) {
+        if (fscanf(f, "%lu", &bufsiz) != 1 || bufsiz < XENSIV_BGT60TRXX_SPIDEV_BUFSIZ_MIN ||
+            bufsiz > UINT32_MAX) {
+            bufsiz = XENSIV_BGT60TRXX_SPIDEV_BUFSIZ_DEFAULT;
+        }
+        fclose(f);
+    }
+
+    return (uint32_t) bufsiz;
+}
+
+/**
+ * @brief Clock a FIFO payload of byte_len bytes through the transfer buffers
+ *
+ * The optional burst header goes first. spidev refuses messages whose total length exceeds its
+ * bufsiz, so larger payloads are split over several messages while CS stays asserted: the GPIO CS
+ * is held by the caller, the native CS is kept active with cs_change on the last transfer. The
+ * chunk sizes come from xensiv_bgt60trxx_linux_fifo_chunk_size().
+ */
+static int fifo_xfer(xensiv_bgt60trxx_linux_t *obj,
+                     uint8_t *header,
+                     uint8_t *gsr0,
+                     uint32_t byte_len)
+{
+    struct spi_ioc_transfer tr[2];
+    uint32_t offset = 0;
+    int ret = 0;
+
+    while (ret >= 0 && offset < byte_len) {
+        uint32_t budget = xensiv_bgt60trxx_linux_fifo_chunk_size(obj, header && offset == 0);
+        unsigned int num_xfers = 0;
+
+        memset(tr, 0, sizeof(tr));
+        if (header && offset == 0) {
+            tr[0].tx_buf = (uintptr_t) header;
+            tr[0].rx_buf = (uintptr_t) gsr0;
+            tr[0].len = XENSIV_BGT60TRXX_SPI_BURST_HEADER_SIZE_BYTES;
+            ++num_xfers;
+        }
+
+        uint32_t chunk = byte_len - offset;
+        if (chunk > budget) {
+            chunk = budget;
+        }
+
+        tr[num_xfers].tx_buf = (uintptr_t) (obj->tx_buf + offset);
+        tr[num_xfers].rx_buf = (uintptr_t) (obj->rx_buf + offset);
+        tr[num_xfers].len = chunk;
+        offset += chunk;
+        tr[num_xfers].cs_change = (obj->cs_gpio_fd < 0 && offset < byte_len) ? 1 : 0;
+        ++num_xfers;
+
+        ret = spi_message(obj, tr, num_xfers);
+    }
+
+    return ret;
+}
+
+/**
+ * @brief Release the FIFO transfer buffers
+ */
+static void free_buffers(xensiv_bgt60trxx_linux_t *obj)
+{
+    if (obj->buf_locked) {
+        munlock(obj->tx_buf, obj->buf_size);
+        munlock(obj->rx_buf, obj->buf_size);
+        obj->buf_locked = false;
+    }
+
+    free(obj->tx_buf);
+    free(obj->rx_buf);
+    obj->tx_buf = NULL;
+    obj->rx_buf = NULL;
+    obj->buf_size = 0;
+}
+
+/**
+ * @brief Make sure the FIFO transfer buffers hold at least size bytes
+ */
+static int32_t reserve_buffers(xensiv_bgt60trxx_linux_t *obj, uint32_t size, bool lock)
+{
+    if (obj->buf_size < size) {
+        // Keep the buffers locked if they were locked before growing them
+        lock = lock || obj->buf_locked;
+        free_buffers(obj);
+
+        long page_size = sysconf(_SC_PAGESIZE);
+        size_t alignment = (page_size > 0) ? (size_t) page_size : 4096U;
+        size_t alloc_size = ((size + alignment - 1U) / alignment) * alignment;
+        void *tx_buf = NULL;
+        void *rx_buf = NULL;
+
+        if (posix_memalign(&tx_buf, alignment, alloc_size) != 0 ||
+            posix_memalign(&rx_buf, alignment, alloc_size) != 0) {
+            fprintf(stderr, "Failed to allocate FIFO transfer buffers\n");
+            free(tx_buf);
+            return XENSIV_BGT60TRXX_STATUS_COM_ERROR;
+        }
+
+        // TX is never written afterwards; the sensor expects MOSI high during FIFO reads
+        memset(tx_buf, 0xFF, alloc_size);
+
+        obj->tx_buf = tx_buf;
+        obj->rx_buf = rx_buf;
+        obj->buf_size = (uint32_t) alloc_size;
+        ++obj->buf_allocs;
+    }
+
+    if (lock && !obj->buf_locked) {
+        if (mlock(obj->tx_buf, obj->buf_size) == 0 && mlock(obj->rx_buf, obj->buf_size) == 0) {
+            obj->buf_locked = true;
+        } else {
+            fprintf(stderr, "Failed to lock FIFO transfer buffers: %s\n", strerror(errno));
+            munlock(obj->tx_buf, obj->buf_size);
+        }
+    }
+
+    return XENSIV_BGT60TRXX_STATUS_OK;
+}
+
+/**
+ * @brief Request a GPIO line as input with rising edge events
+ */
+static int configure_gpio_irq(int gpio_chip_fd, unsigned int offset)
+{
+    struct gpio_v2_line_request req;
+
+    memset(&req, 0, sizeof(req));
+    req.offsets[0] = offset;
+    req.num_lines = 1;
+    req.config.flags = GPIO_V2_LINE_FLAG_INPUT | GPIO_V2_LINE_FLAG_EDGE_RISING;
+    req.event_buffer_size = XENSIV_BGT60TRXX_IRQ_EVENT_BUFFER;
+    strncpy(req.consumer, XENSIV_BGT60TRXX_GPIO_CONSUMER, sizeof(req.consumer) - 1);
+
+    if (ioctl(gpio_chip_fd, GPIO_V2_GET_LINE_IOCTL, &req) < 0) {
+        return -1;
+    }
+
+    return req.fd;
+}
+
+/**
+ * @brief Read one block of test data with the FIFO read at test_hz and count its bit errors
+ *
+ * The expected LFSR sequence is seeded from the first sample; a zero seed cannot be produced by
+ * the LFSR and flags a stuck MISO line.
+ */
+static int32_t link_trial(xensiv_bgt60trxx_linux_obj_t *obj,
+                          uint32_t test_hz,
+                          uint16_t *samples,
+                          uint32_t num_samples,
+                          uint32_t num_channels,
+                          uint32_t *bit_errors)
+{
+    xensiv_bgt60trxx_t *dev = &obj->dev;
+    uint32_t base_hz = obj->iface.speed_hz;
+    uint32_t fstat = 0;
+    uint32_t polls = 0;
+
+    int32_t status = xensiv_bgt60trxx_soft_reset(dev, XENSIV_BGT60TRXX_RESET_FSM);
+    if (status == XENSIV_BGT60TRXX_STATUS_OK) {
+        status = xensiv_bgt60trxx_soft_reset(dev, XENSIV_BGT60TRXX_RESET_FIFO);
+    }
+    if (status == XENSIV_BGT60TRXX_STATUS_OK) {
+        status = xensiv_bgt60trxx_start_frame(dev, true);
+    }
+
+    while (status == XENSIV_BGT60TRXX_STATUS_OK &&
+           (fstat & XENSIV_BGT60TRXX_REG_FSTAT_CREF_MSK) == 0U) {
+        if (polls++ == XENSIV_BGT60TRXX_LINK_CREF_POLLS) {
+            status = XENSIV_BGT60TRXX_STATUS_TIMEOUT_ERROR;
+        } else {
+            status = xensiv_bgt60trxx_get_fifo_status(dev, &fstat);
+            if ((fstat & XENSIV_BGT60TRXX_REG_FSTAT_CREF_MSK) == 0U) {
+                xensiv_bgt60trxx_platform_delay(1U);
+            }
+        }
+    }
+
+    if (status == XENSIV_BGT60TRXX_STATUS_OK) {
+        obj->iface.speed_hz = test_hz;
+        status = xensiv_bgt60trxx_get_fifo_data(dev, samples, num_samples);
+        obj->iface.speed_hz = base_hz;
+    }
+
+    int32_t stop_status = xensiv_bgt60trxx_start_frame(dev, false);
+    if (status == XENSIV_BGT60TRXX_STATUS_OK) {
+        status = stop_status;
+    }
+
+    if (status == XENSIV_BGT60TRXX_STATUS_OK) {
+        uint16_t test_word = samples[0] & 0x0FFFU;
+        *bit_errors = (test_word == 0U) ? XENSIV_BGT60TRXX_SAMPLE_BITS : 0U;
+        *bit_errors +=
+            xensiv_bgt60trxx_count_test_bit_errors(samples, num_samples, num_channels, &test_word);
+    }
+
+    return status;
+}
+
 /*******************************************************************************
  * Public Functions
  *******************************************************************************/
@@ -110,6 +358,7 @@ int32_t xensiv_bgt60trxx_linux_init(xensiv_bgt60trxx_linux_t *obj,
     }
 
     memset(obj, 0, sizeof(xensiv_bgt60trxx_linux_t));
+    obj->irq_gpio_fd = -1;
 
     // Initialize SPI
     obj->spi_fd = open(spi_device, O_RDWR);
@@ -142,6 +391,11 @@ int32_t xensiv_bgt60trxx_linux_init(xensiv_bgt60trxx_linux_t *obj,
         return XENSIV_BGT60TRXX_STATUS_COM_ERROR;
     }
 
+    obj->speed_hz = speed;
+
+    // Largest message spidev accepts, FIFO reads above it are chunked
+    obj->spi_bufsiz = read_spidev_bufsiz();
+
     // Initialize GPIO chip
     obj->gpio_chip_fd = open(gpio_chip, O_RDWR);
     if (obj->gpio_chip_fd < 0) {
@@ -159,25 +413,289 @@ int32_t xensiv_bgt60trxx_linux_init(xensiv_bgt60trxx_linux_t *obj,
         return XENSIV_BGT60TRXX_STATUS_COM_ERROR;
     }
 
-    // Configure CS GPIO
-    obj->cs_gpio_fd = configure_gpio_output(obj->gpio_chip_fd, cs_gpio_offset, true);
-    if (obj->cs_gpio_fd < 0) {
-        fprintf(stderr, "Failed to configure CS GPIO: %s\n", strerror(errno));
-        close(obj->rst_gpio_fd);
-        close(obj->gpio_chip_fd);
-        close(obj->spi_fd);
+    // Configure CS GPIO, unless the SPI controller drives its native chip select
+    obj->cs_gpio_fd = -1;
+    if (cs_gpio_offset != XENSIV_BGT60TRXX_LINUX_NATIVE_CS) {
+        obj->cs_gpio_fd = configure_gpio_output(obj->gpio_chip_fd, cs_gpio_offset, true);
+        if (obj->cs_gpio_fd < 0) {
+            fprintf(stderr, "Failed to configure CS GPIO: %s\n", strerror(errno));
+            close(obj->rst_gpio_fd);
+            close(obj->gpio_chip_fd);
+            close(obj->spi_fd);
+            return XENSIV_BGT60TRXX_STATUS_COM_ERROR;
+        }
+    }
+
+    return XENSIV_BGT60TRXX_STATUS_OK;
+}
+
+int32_t xensiv_bgt60trxx_linux_alloc_buffers(xensiv_bgt60trxx_linux_t *obj,
+                                             uint32_t fifo_size,
+                                             bool lock)
+{
+    if (!obj || fifo_size == 0) {
+        return XENSIV_BGT60TRXX_STATUS_COM_ERROR;
+    }
+
+    return reserve_buffers(obj, fifo_size * XENSIV_BGT60TRXX_FIFO_WORD_SIZE_BYTES, lock);
+}
+
+int32_t xensiv_bgt60trxx_linux_set_speed(xensiv_bgt60trxx_linux_t *obj, uint32_t speed_hz)
+{
+    if (!obj || speed_hz == 0) {
         return XENSIV_BGT60TRXX_STATUS_COM_ERROR;
     }
 
+    if (ioctl(obj->spi_fd, SPI_IOC_WR_MAX_SPEED_HZ, &speed_hz) < 0) {
+        fprintf(stderr, "Failed to set SPI max speed: %s\n", strerror(errno));
+        return XENSIV_BGT60TRXX_STATUS_COM_ERROR;
+    }
+
+    obj->speed_hz = speed_hz;
     return XENSIV_BGT60TRXX_STATUS_OK;
 }
 
+uint32_t xensiv_bgt60trxx_linux_fifo_chunk_size(const xensiv_bgt60trxx_linux_t *obj,
+                                               bool with_header)
+{
+    assert(obj != NULL);
+
+    uint32_t bufsiz = (obj->spi_bufsiz >= XENSIV_BGT60TRXX_SPIDEV_BUFSIZ_MIN)
+                          ? obj->spi_bufsiz
+                          : XENSIV_BGT60TRXX_SPIDEV_BUFSIZ_DEFAULT;
+
+    /* spidev rounds the length of every transfer of a message up to ARCH_DMA_MINALIGN before
+       comparing the sum with bufsiz, so the 4 byte header takes a whole alignment unit */
+    uint32_t chunk = bufsiz - (bufsiz % XENSIV_BGT60TRXX_SPIDEV_XFER_ALIGN);
+    if (with_header) {
+        chunk = (chunk > XENSIV_BGT60TRXX_SPIDEV_XFER_ALIGN)
+                    ? (chunk - XENSIV_BGT60TRXX_SPIDEV_XFER_ALIGN)
+                    : 0U;
+    }
+
+    /* A bufsiz too small for the alignment only works with kernels that do not round up */
+    if (chunk == 0U) {
+        chunk = bufsiz - (with_header ? XENSIV_BGT60TRXX_SPI_BURST_HEADER_SIZE_BYTES : 0U);
+    }
+
+    return chunk;
+}
+
+int32_t xensiv_bgt60trxx_linux_train_link(xensiv_bgt60trxx_linux_obj_t *obj,
+                                          const xensiv_bgt60trxx_linux_link_params_t *params,
+                                          xensiv_bgt60trxx_linux_link_result_t *result)
+{
+    if (!obj || !obj->dev.type) {
+        return XENSIV_BGT60TRXX_STATUS_COM_ERROR;
+    }
+
+    xensiv_bgt60trxx_linux_link_params_t p = {
+        .speeds_hz = link_default_speeds_hz,
+        .num_speeds = sizeof(link_default_speeds_hz) / sizeof(link_default_speeds_hz[0]),
+        .num_channels = 1U,
+        .num_words = XENSIV_BGT60TRXX_LINK_DEFAULT_WORDS,
+        .num_trials = XENSIV_BGT60TRXX_LINK_DEFAULT_TRIALS,
+        .margin_steps = XENSIV_BGT60TRXX_LINK_DEFAULT_MARGIN,
+    };
+    if (params) {
+        p = *params;
+        if (!p.speeds_hz || p.num_speeds == 0) {
+            p.speeds_hz = link_default_speeds_hz;
+            p.num_speeds = sizeof(link_default_speeds_hz) / sizeof(link_default_speeds_hz[0]);
+        }
+    }
+
+    if (p.num_channels == 0 || p.num_words == 0 || p.num_trials == 0) {
+        return XENSIV_BGT60TRXX_STATUS_COM_ERROR;
+    }
+    for (uint32_t i = 1; i < p.num_speeds; ++i) {
+        if (p.speeds_hz[i] <= p.speeds_hz[i - 1]) {
+            return XENSIV_BGT60TRXX_STATUS_COM_ERROR;
+        }
+    }
+
+    // Stay well below the FIFO size so the FIFO cannot overflow while it is polled
+    uint32_t max_words = xensiv_bgt60trxx_get_fifo_size(&obj->dev) / 2U;
+    uint32_t num_words = (p.num_words < max_words) ? p.num_words : max_words;
+    uint32_t num_samples = num_words * XENSIV_BGT60TRXX_NUM_SAMPLES_FIFO_WORD;
+    uint16_t *samples = malloc(num_samples * sizeof(uint16_t));
+    if (!samples) {
+        return XENSIV_BGT60TRXX_STATUS_COM_ERROR;
+    }
+
+    uint32_t orig_hz = obj->iface.speed_hz;
+    bool orig_high_speed = obj->dev.high_speed;
+    uint32_t sfctl = 0;
+    int32_t best_idx = -1;
+    int32_t best_clean = -1;
+    bool best_high_speed = false;
+    uint64_t bits_tested = 0;
+    uint64_t bit_errors = 0;
+
+    // Register accesses stay at the slowest candidate, only FIFO reads use the clock under test
+    int32_t status = xensiv_bgt60trxx_linux_set_speed(&obj->iface, p.speeds_hz[0]);
+    if (status == XENSIV_BGT60TRXX_STATUS_OK) {
+        status = xensiv_bgt60trxx_get_reg(&obj->dev, XENSIV_BGT60TRXX_REG_SFCTL, &sfctl);
+    }
+    if (status == XENSIV_BGT60TRXX_STATUS_OK) {
+        status = xensiv_bgt60trxx_set_fifo_limit(&obj->dev, num_samples);
+    }
+    if (status == XENSIV_BGT60TRXX_STATUS_OK) {
+        status = xensiv_bgt60trxx_enable_data_test_mode(&obj->dev, true);
+    }
+
+    for (int mode = 0; mode < 2 && status == XENSIV_BGT60TRXX_STATUS_OK; ++mode) {
+        bool high_speed = (mode == 1);
+        int32_t clean = -1;
+
+        status = xensiv_bgt60trxx_set_high_speed(&obj->dev, high_speed);
+
+        // Only accept clocks whose slower neighbours are clean as well
+        for (uint32_t i = 0; i < p.num_speeds && status == XENSIV_BGT60TRXX_STATUS_OK; ++i) {
+            bool pass = true;
+
+            for (uint32_t t = 0; t < p.num_trials && pass; ++t) {
+                uint32_t errors = 0;
+                int32_t trial_status = link_trial(
+                    obj, p.speeds_hz[i], samples, num_samples, p.num_channels, &errors);
+
+                bits_tested += (uint64_t) ((num_samples + p.num_channels - 1U) / p.num_channels) *
+                               XENSIV_BGT60TRXX_SAMPLE_BITS;
+                bit_errors += errors;
+                pass = (trial_status == XENSIV_BGT60TRXX_STATUS_OK) && (errors == 0U);
+            }
+
+            if (!pass) {
+                break;
+            }
+            clean = (int32_t) i;
+        }
+
+        if (clean >= 0) {
+            int32_t idx = clean - (int32_t) p.margin_steps;
+            idx = (idx < 0) ? 0 : idx;
+            if (idx > best_idx) {
+                best_idx = idx;
+                best_clean = clean;
+                best_high_speed = high_speed;
+            }
+        }
+    }
+
+    free(samples);
+
+    // Restore FIFO limit and test mode, then apply the selected read mode
+    int32_t restore_status = xensiv_bgt60trxx_set_reg(&obj->dev, XENSIV_BGT60TRXX_REG_SFCTL, sfctl);
+    if (restore_status == XENSIV_BGT60TRXX_STATUS_OK) {
+        restore_status = xensiv_bgt60trxx_set_high_speed(
+            &obj->dev, (best_idx >= 0) ? best_high_speed : orig_high_speed);
+    }
+    if (restore_status == XENSIV_BGT60TRXX_STATUS_OK) {
+        restore_status = xensiv_bgt60trxx_linux_set_speed(
+            &obj->iface, (best_idx >= 0) ? p.speeds_hz[best_idx] : orig_hz);
+    }
+
+    if (status == XENSIV_BGT60TRXX_STATUS_OK) {
+        status = (best_idx >= 0) ? restore_status : XENSIV_BGT60TRXX_STATUS_COM_ERROR;
+    }
+
+    if (result) {
+        result->speed_hz = obj->iface.speed_hz;
+        result->high_speed = obj->dev.high_speed;
+        result->max_clean_hz = (best_clean >= 0) ? p.speeds_hz[best_clean] : 0U;
+        result->bits_tested = bits_tested;
+        result->bit_errors = bit_errors;
+    }
+
+    return status;
+}
+
+int32_t xensiv_bgt60trxx_linux_interrupt_init(xensiv_bgt60trxx_linux_obj_t *obj,
+                                              unsigned int irq_gpio_offset,
+                                              uint16_t fifo_limit)
+{
+    if (!obj) {
+        return XENSIV_BGT60TRXX_STATUS_COM_ERROR;
+    }
+
+    xensiv_bgt60trxx_linux_t *iface = &obj->iface;
+
+    if (iface->irq_gpio_fd < 0) {
+        iface->irq_gpio_fd = configure_gpio_irq(iface->gpio_chip_fd, irq_gpio_offset);
+        if (iface->irq_gpio_fd < 0) {
+            fprintf(stderr, "Failed to configure IRQ GPIO: %s\n", strerror(errno));
+            return XENSIV_BGT60TRXX_STATUS_COM_ERROR;
+        }
+        iface->irq_gpio_offset = irq_gpio_offset;
+    } else if (iface->irq_gpio_offset != irq_gpio_offset) {
+        fprintf(stderr, "IRQ GPIO already requested on offset %u\n", iface->irq_gpio_offset);
+        return XENSIV_BGT60TRXX_STATUS_COM_ERROR;
+    }
+
+    return xensiv_bgt60trxx_set_fifo_limit(&obj->dev, fifo_limit);
+}
+
+int xensiv_bgt60trxx_linux_get_irq_fd(const xensiv_bgt60trxx_linux_t *obj)
+{
+    return obj ? obj->irq_gpio_fd : -1;
+}
+
+int32_t xensiv_bgt60trxx_linux_read_irq_event(xensiv_bgt60trxx_linux_t *obj,
+                                              uint64_t *timestamp_ns)
+{
+    struct gpio_v2_line_event event;
+
+    if (!obj || obj->irq_gpio_fd < 0) {
+        return XENSIV_BGT60TRXX_STATUS_COM_ERROR;
+    }
+
+    ssize_t ret = read(obj->irq_gpio_fd, &event, sizeof(event));
+    if (ret != (ssize_t) sizeof(event)) {
+        fprintf(stderr,
+                "Failed to read IRQ event: %s\n",
+                (ret < 0) ? strerror(errno) : "short read");
+        return XENSIV_BGT60TRXX_STATUS_COM_ERROR;
+    }
+
+    if (timestamp_ns) {
+        *timestamp_ns = event.timestamp_ns;
+    }
+
+    return XENSIV_BGT60TRXX_STATUS_OK;
+}
+
+int32_t xensiv_bgt60trxx_linux_wait_fifo(xensiv_bgt60trxx_linux_t *obj,
+                                         int timeout_ms,
+                                         uint64_t *timestamp_ns)
+{
+    if (!obj || obj->irq_gpio_fd < 0) {
+        return XENSIV_BGT60TRXX_STATUS_COM_ERROR;
+    }
+
+    struct pollfd pfd = {.fd = obj->irq_gpio_fd, .events = POLLIN};
+    int ret = poll(&pfd, 1, timeout_ms);
+
+    if (ret == 0 || (ret < 0 && errno == EINTR)) {
+        return XENSIV_BGT60TRXX_STATUS_TIMEOUT_ERROR;
+    }
+    if (ret < 0 || (pfd.revents & POLLIN) == 0) {
+        return XENSIV_BGT60TRXX_STATUS_COM_ERROR;
+    }
+
+    return xensiv_bgt60trxx_linux_read_irq_event(obj, timestamp_ns);
+}
+
 void xensiv_bgt60trxx_linux_deinit(xensiv_bgt60trxx_linux_t *obj)
 {
     if (!obj) {
         return;
     }
 
+    free_buffers(obj);
+
+    if (obj->irq_gpio_fd >= 0) {
+        close(obj->irq_gpio_fd);
+    }
     if (obj->cs_gpio_fd >= 0) {
         close(obj->cs_gpio_fd);
     }
@@ -200,19 +718,22 @@ void xensiv_bgt60trxx_linux_deinit(xensiv_bgt60trxx_linux_t *obj)
 
 void xensiv_bgt60trxx_platform_rst_set(const void *iface, bool val)
 {
-    const xensiv_bgt60trxx_linux_t *obj = (const xensiv_bgt60trxx_linux_t *) iface;
+    /* The interface object is owned by the application; const only guards the core library */
+    xensiv_bgt60trxx_linux_t *obj = (xensiv_bgt60trxx_linux_t *) iface;
 
     if (obj && obj->rst_gpio_fd >= 0) {
-        set_gpio_value(obj->rst_gpio_fd, val);
+        set_gpio_value(obj, obj->rst_gpio_fd, val);
     }
 }
 
+/* With the native chip select (cs_gpio_fd < 0) CS follows each spidev message: it is asserted for
+   all transfers of a message (cs_change = 0) and released at its end, so this is a no-op. */
 void xensiv_bgt60trxx_platform_spi_cs_set(const void *iface, bool val)
 {
-    const xensiv_bgt60trxx_linux_t *obj = (const xensiv_bgt60trxx_linux_t *) iface;
+    xensiv_bgt60trxx_linux_t *obj = (xensiv_bgt60trxx_linux_t *) iface;
 
     if (obj && obj->cs_gpio_fd >= 0) {
-        set_gpio_value(obj->cs_gpio_fd, val);
+        set_gpio_value(obj, obj->cs_gpio_fd, val);
     }
 }
 
@@ -233,10 +754,8 @@ int32_t xensiv_bgt60trxx_platform_spi_transfer(void *iface,
     tr.tx_buf = (uintptr_t) tx_data;
     tr.rx_buf = (uintptr_t) rx_data;
     tr.len = len;
-    tr.speed_hz = XENSIV_BGT60TRXX_SPI_MAX_SPEED_HZ;
-    tr.bits_per_word = XENSIV_BGT60TRXX_SPI_BITS_PER_WORD;
 
-    ret = ioctl(obj->spi_fd, SPI_IOC_MESSAGE(1), &tr);
+    ret = spi_message(obj, &tr, 1);
     if (ret < 0) {
         fprintf(stderr, "SPI transfer failed: %s\n", strerror(errno));
         return XENSIV_BGT60TRXX_STATUS_COM_ERROR;
@@ -248,38 +767,62 @@ int32_t xensiv_bgt60trxx_platform_spi_transfer(void *iface,
 int32_t xensiv_bgt60trxx_platform_spi_fifo_read(void *iface, uint16_t *rx_data, uint32_t len)
 {
     xensiv_bgt60trxx_linux_t *obj = (xensiv_bgt60trxx_linux_t *) iface;
-    struct spi_ioc_transfer tr;
     int ret;
-    uint8_t *tx_buf = NULL;
-    uint32_t byte_len = len * 2;  // 16-bit data
+    uint32_t byte_len = XENSIV_BGT60TRXX_PACKED_SIZE_BYTES(len);  // 2 x 12-bit per 24-bit word
 
     if (!obj || obj->spi_fd < 0 || !rx_data || len == 0) {
         return XENSIV_BGT60TRXX_STATUS_COM_ERROR;
     }
 
-    // Allocate TX buffer filled with 0xFF for FIFO read
-    tx_buf = malloc(byte_len);
-    if (!tx_buf) {
+    // Only grows on the first oversized read; steady state reuses the preallocated buffers
+    if (reserve_buffers(obj, byte_len, false) != XENSIV_BGT60TRXX_STATUS_OK) {
         return XENSIV_BGT60TRXX_STATUS_COM_ERROR;
     }
-    memset(tx_buf, 0xFF, byte_len);
 
-    memset(&tr, 0, sizeof(tr));
-    tr.tx_buf = (uintptr_t) tx_buf;
-    tr.rx_buf = (uintptr_t) rx_data;
-    tr.len = byte_len;
-    tr.speed_hz = XENSIV_BGT60TRXX_SPI_MAX_SPEED_HZ;
-    tr.bits_per_word = XENSIV_BGT60TRXX_SPI_BITS_PER_WORD;
+    ret = fifo_xfer(obj, NULL, NULL, byte_len);
+    if (ret < 0) {
+        fprintf(stderr, "SPI FIFO read failed: %s\n", strerror(errno));
+        return XENSIV_BGT60TRXX_STATUS_COM_ERROR;
+    }
+
+    xensiv_bgt60trxx_unpack_fifo_data(obj->rx_buf, rx_data, len);
+
+    return XENSIV_BGT60TRXX_STATUS_OK;
+}
+
+int32_t xensiv_bgt60trxx_platform_spi_fifo_burst_read(void *iface,
+                                                      uint8_t *header,
+                                                      uint8_t *gsr0,
+                                                      uint16_t *rx_data,
+                                                      uint32_t len)
+{
+    xensiv_bgt60trxx_linux_t *obj = (xensiv_bgt60trxx_linux_t *) iface;
+    int ret;
+    uint32_t byte_len = XENSIV_BGT60TRXX_PACKED_SIZE_BYTES(len);
+
+    if (!obj || obj->spi_fd < 0 || !header || !gsr0 || !rx_data || len == 0) {
+        return XENSIV_BGT60TRXX_STATUS_COM_ERROR;
+    }
 
-    ret = ioctl(obj->spi_fd, SPI_IOC_MESSAGE(1), &tr);
+    if (reserve_buffers(obj, byte_len, false) != XENSIV_BGT60TRXX_STATUS_OK) {
+        return XENSIV_BGT60TRXX_STATUS_COM_ERROR;
+    }
 
-    free(tx_buf);
+    // Burst header and payload in one message (or as few as spidev bufsiz allows), one CS frame
+    xensiv_bgt60trxx_platform_spi_cs_set(obj, false);
+    ret = fifo_xfer(obj, header, gsr0, byte_len);
+    xensiv_bgt60trxx_platform_spi_cs_set(obj, true);
 
     if (ret < 0) {
-        fprintf(stderr, "SPI FIFO read failed: %s\n", strerror(errno));
+        fprintf(stderr, "SPI FIFO burst read failed: %s\n", strerror(errno));
         return XENSIV_BGT60TRXX_STATUS_COM_ERROR;
     }
 
+    // Payload clocked after a GSR0 error is not valid FIFO data, leave the caller buffer alone
+    if ((gsr0[0] & XENSIV_BGT60TRXX_REG_GSR0_ERR_MSK) == 0U) {
+        xensiv_bgt60trxx_unpack_fifo_data(obj->rx_buf, rx_data, len);
+    }
+
     return XENSIV_BGT60TRXX_STATUS_OK;
 }
 
@@ -291,6 +834,30 @@ void xensiv_bgt60trxx_platform_delay(uint32_t ms)
     nanosleep(&ts, NULL);
 }
 
+void xensiv_bgt60trxx_platform_delay_us(uint32_t us)
+{
+    struct timespec deadline;
+    clock_gettime(CLOCK_MONOTONIC, &deadline);
+    deadline.tv_sec += (time_t) (us / 1000000U);
+    deadline.tv_nsec += (long) (us % 1000000U) * 1000L;
+    if (deadline.tv_nsec >= 1000000000L) {
+        deadline.tv_sec += 1;
+        deadline.tv_nsec -= 1000000000L;
+    }
+
+    if (us < XENSIV_BGT60TRXX_LINUX_DELAY_SPIN_US) {
+        /* Short waits spin: a sleep is rounded up to the timer slack of the thread */
+        struct timespec now;
+        do {
+            clock_gettime(CLOCK_MONOTONIC, &now);
+        } while ((now.tv_sec < deadline.tv_sec) ||
+                 ((now.tv_sec == deadline.tv_sec) && (now.tv_nsec < deadline.tv_nsec)));
+    } else {
+        while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline, NULL) == EINTR) {
+        }
+    }
+}
+
 uint32_t xensiv_bgt60trxx_platform_word_reverse(uint32_t x)
 {
     return htobe32(x);
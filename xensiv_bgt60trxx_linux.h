@@ -49,6 +49,17 @@
 extern "C" {
     #endif
 
+    /*******************************************************************************
+     * Macros
+     *******************************************************************************/
+
+    /**
+     * Value for cs_gpio_offset selecting the chip select driven natively by the spidev controller
+     * instead of a GPIO line. Every SPI_IOC_MESSAGE is then framed by one CS assertion and
+     * xensiv_bgt60trxx_platform_spi_cs_set() does nothing.
+     */
+    #define XENSIV_BGT60TRXX_LINUX_NATIVE_CS (0xFFFFFFFFU)
+
 /*******************************************************************************
  * Data Structures
  *******************************************************************************/
@@ -60,10 +71,21 @@ extern "C" {
  * communicate with the sensor hardware.
  */
 typedef struct {
-    int spi_fd;       /**< SPI device file descriptor */
-    int gpio_chip_fd; /**< GPIO chip file descriptor */
-    int rst_gpio_fd;  /**< Reset GPIO line file descriptor */
-    int cs_gpio_fd;   /**< Chip select GPIO line file descriptor */
+    int spi_fd;                   /**< SPI device file descriptor */
+    int gpio_chip_fd;             /**< GPIO chip file descriptor */
+    int rst_gpio_fd;              /**< Reset GPIO line file descriptor */
+    int cs_gpio_fd;               /**< Chip select GPIO line file descriptor */
+    int irq_gpio_fd;              /**< IRQ GPIO line event file descriptor, -1 if not requested */
+    unsigned int irq_gpio_offset; /**< GPIO offset of the requested IRQ line */
+    uint8_t *tx_buf;              /**< Page-aligned FIFO read TX buffer, kept filled with 0xFF */
+    uint8_t *rx_buf;              /**< Page-aligned FIFO read RX staging buffer (packed words) */
+    uint32_t buf_size;            /**< Size in bytes of each FIFO transfer buffer */
+    uint32_t spi_bufsiz;          /**< spidev bufsiz, largest SPI message in bytes (read at init) */
+    uint32_t speed_hz;            /**< SPI clock used for every transfer, see link training */
+    bool buf_locked;              /**< FIFO transfer buffers are locked in RAM (mlock) */
+    uint32_t buf_allocs;          /**< Number of FIFO transfer buffer (re)allocations since init */
+    uint32_t spi_ioctls;          /**< Number of spidev SPI_IOC_MESSAGE ioctls since init */
+    uint32_t gpio_ioctls;         /**< Number of GPIO line value ioctls since init */
 } xensiv_bgt60trxx_linux_t;
 
 /**
@@ -74,6 +96,29 @@ typedef struct {
     xensiv_bgt60trxx_linux_t iface; /**< Linux platform interface */
 } xensiv_bgt60trxx_linux_obj_t;
 
+/**
+ * @brief SPI link training parameters, see xensiv_bgt60trxx_linux_train_link()
+ */
+typedef struct {
+    const uint32_t *speeds_hz; /**< Candidate SPI clocks in ascending order, NULL for defaults */
+    uint32_t num_speeds;       /**< Number of entries in speeds_hz */
+    uint32_t num_channels;     /**< Enabled ADC channels, test data is on every n-th sample */
+    uint32_t num_words;        /**< FIFO words read per trial, clamped to half the FIFO */
+    uint32_t num_trials;       /**< FIFO reads per setting, all of them must be error free */
+    uint32_t margin_steps;     /**< Candidate steps to back off from the fastest clean clock */
+} xensiv_bgt60trxx_linux_link_params_t;
+
+/**
+ * @brief SPI link training result
+ */
+typedef struct {
+    uint32_t speed_hz;      /**< Selected SPI clock */
+    bool high_speed;        /**< Selected MISO high speed read mode */
+    uint32_t max_clean_hz;  /**< Fastest clock without bit errors in the selected mode */
+    uint64_t bits_tested;   /**< Total number of sample bits compared during the sweep */
+    uint64_t bit_errors;    /**< Total number of bit errors seen during the sweep */
+} xensiv_bgt60trxx_linux_link_result_t;
+
 /*******************************************************************************
  * Function Prototypes
  *******************************************************************************/
@@ -88,9 +133,12 @@ typedef struct {
  * @param[in] spi_device Path to the SPI device (e.g., "/dev/spidev0.0")
  * @param[in] gpio_chip Path to the GPIO chip (e.g., "/dev/gpiochip0")
  * @param[in] rst_gpio_offset GPIO offset for the reset pin
- * @param[in] cs_gpio_offset GPIO offset for the chip select pin
+ * @param[in] cs_gpio_offset GPIO offset for the chip select pin, or
+ * XENSIV_BGT60TRXX_LINUX_NATIVE_CS to let the spidev controller drive its own chip select
  * @return XENSIV_BGT60TRXX_STATUS_OK if successful, error code otherwise
  *
+ * @note With a GPIO chip select every register access costs two GPIO ioctls on top of the SPI
+ * transfer; the native chip select needs only the SPI transfer.
  * @note The SPI device must be configured with appropriate permissions for the user
  * @note GPIO chip access requires appropriate permissions or running as root
  *
@@ -120,6 +168,127 @@ int32_t xensiv_bgt60trxx_linux_init(xensiv_bgt60trxx_linux_t *obj,
  */
 void xensiv_bgt60trxx_linux_deinit(xensiv_bgt60trxx_linux_t *obj);
 
+/**
+ * @brief Preallocate the FIFO transfer buffers
+ *
+ * Allocates page-aligned TX and RX buffers large enough to drain the whole sensor FIFO, so that
+ * steady-state FIFO reads neither allocate memory nor refill the TX buffer. Reads larger than the
+ * preallocated size grow the buffers once (see buf_allocs). Called by
+ * xensiv_bgt60trxx_linux_init_sensor() once the device FIFO size is known.
+ *
+ * @param[inout] obj Pointer to the Linux interface object
+ * @param[in] fifo_size FIFO size in words, as returned by xensiv_bgt60trxx_get_fifo_size()
+ * @param[in] lock Lock the buffers in RAM with mlock() to avoid page faults on the read path
+ * @return XENSIV_BGT60TRXX_STATUS_OK if successful, error code otherwise
+ */
+int32_t xensiv_bgt60trxx_linux_alloc_buffers(xensiv_bgt60trxx_linux_t *obj,
+                                             uint32_t fifo_size,
+                                             bool lock);
+
+/**
+ * @brief Set the SPI clock used for all transfers of the interface
+ *
+ * @param[inout] obj Pointer to the Linux interface object
+ * @param[in] speed_hz SPI clock in Hz
+ * @return XENSIV_BGT60TRXX_STATUS_OK if successful, error code otherwise
+ */
+int32_t xensiv_bgt60trxx_linux_set_speed(xensiv_bgt60trxx_linux_t *obj, uint32_t speed_hz);
+
+/**
+ * @brief Largest FIFO payload clocked in one spidev message
+ *
+ * FIFO reads larger than this are split over several messages with CS held asserted. spidev
+ * rounds each transfer of a message up to ARCH_DMA_MINALIGN before checking the total against
+ * its bufsiz, so the payload is kept to whole 128 byte units and a burst header, sent as its own
+ * transfer, is accounted for as one full unit.
+ *
+ * @param[in] obj Pointer to the Linux interface object
+ * @param[in] with_header The message also carries the 4 byte burst header
+ * @return Payload size in bytes
+ */
+uint32_t xensiv_bgt60trxx_linux_fifo_chunk_size(const xensiv_bgt60trxx_linux_t *obj,
+                                               bool with_header);
+
+/**
+ * @brief Select the fastest reliable SPI clock and MISO read mode
+ *
+ * Sweeps the candidate SPI clocks with the MISO high speed read mode off and on. Each setting
+ * reads num_trials blocks of FIFO data in data test mode and compares them against the LFSR
+ * sequence. In each mode the fastest clock whose slower candidates are also error free is taken,
+ * backed off by margin_steps; the faster of the two modes wins, normal mode on a tie. The
+ * selection is applied to this sensor object (iface.speed_hz and dev.high_speed).
+ *
+ * Register accesses during the sweep run at the slowest candidate clock, only the FIFO reads run
+ * at the clock under test. The sensor must be configured (xensiv_bgt60trxx_config()) with the
+ * first ADC channel enabled; the frame generation is stopped and SFCTL restored afterwards.
+ *
+ * @param[inout] obj Pointer to the complete sensor object
+ * @param[in] params Training parameters, NULL for the defaults
+ * @param[out] result Selected setting and sweep statistics, may be NULL
+ * @return XENSIV_BGT60TRXX_STATUS_OK if a setting was selected,
+ * XENSIV_BGT60TRXX_STATUS_COM_ERROR if no candidate passed; else an error code
+ */
+int32_t xensiv_bgt60trxx_linux_train_link(xensiv_bgt60trxx_linux_obj_t *obj,
+                                          const xensiv_bgt60trxx_linux_link_params_t *params,
+                                          xensiv_bgt60trxx_linux_link_result_t *result);
+
+/**
+ * @brief Request the sensor IRQ line and set the FIFO interrupt threshold
+ *
+ * Requests the IRQ GPIO line through the GPIO v2 character device uAPI with rising edge
+ * detection and configures the sensor to raise its IRQ once fifo_limit samples are stored in the
+ * FIFO. Calling it again with the same line only updates the FIFO limit.
+ *
+ * The IRQ output stays high while the FIFO fill level is above the limit, so every event must be
+ * followed by reading at least fifo_limit samples; otherwise no further rising edge is seen.
+ *
+ * @param[inout] obj Pointer to the complete sensor object
+ * @param[in] irq_gpio_offset GPIO offset of the sensor IRQ pin on the interface GPIO chip
+ * @param[in] fifo_limit Number of samples stored in the FIFO that trigger the interrupt
+ * @return XENSIV_BGT60TRXX_STATUS_OK if successful, error code otherwise
+ */
+int32_t xensiv_bgt60trxx_linux_interrupt_init(xensiv_bgt60trxx_linux_obj_t *obj,
+                                              unsigned int irq_gpio_offset,
+                                              uint16_t fifo_limit);
+
+/**
+ * @brief Get the pollable file descriptor of the IRQ line
+ *
+ * The descriptor becomes readable (POLLIN) when an IRQ event is pending, for integration with
+ * poll(), select() or epoll in the application event loop. Pending events are consumed with
+ * xensiv_bgt60trxx_linux_read_irq_event().
+ *
+ * @param[in] obj Pointer to the Linux interface object
+ * @return IRQ line file descriptor, or -1 if the IRQ line is not requested
+ */
+int xensiv_bgt60trxx_linux_get_irq_fd(const xensiv_bgt60trxx_linux_t *obj);
+
+/**
+ * @brief Consume one pending IRQ event, blocking until one is available
+ *
+ * @param[inout] obj Pointer to the Linux interface object
+ * @param[out] timestamp_ns Kernel CLOCK_MONOTONIC timestamp of the rising edge, may be NULL
+ * @return XENSIV_BGT60TRXX_STATUS_OK if an event was read, error code otherwise
+ */
+int32_t xensiv_bgt60trxx_linux_read_irq_event(xensiv_bgt60trxx_linux_t *obj,
+                                              uint64_t *timestamp_ns);
+
+/**
+ * @brief Wait for the FIFO interrupt
+ *
+ * Blocks until the next IRQ event or the timeout. Replaces polling the FIFO status over SPI.
+ *
+ * @param[inout] obj Pointer to the Linux interface object
+ * @param[in] timeout_ms Timeout in milliseconds, negative to wait forever
+ * @param[out] timestamp_ns Kernel CLOCK_MONOTONIC timestamp of the rising edge, may be NULL
+ * @return XENSIV_BGT60TRXX_STATUS_OK if the interrupt fired,
+ * XENSIV_BGT60TRXX_STATUS_TIMEOUT_ERROR if the timeout expired or a signal interrupted the wait;
+ * else an error code
+ */
+int32_t xensiv_bgt60trxx_linux_wait_fifo(xensiv_bgt60trxx_linux_t *obj,
+                                         int timeout_ms,
+                                         uint64_t *timestamp_ns);
+
 /**
  * @brief Initialize complete sensor object with Linux platform
  *
@@ -130,7 +299,8 @@ void xensiv_bgt60trxx_linux_deinit(xensiv_bgt60trxx_linux_t *obj);
  * @param[in] spi_device Path to the SPI device
  * @param[in] gpio_chip Path to the GPIO chip
  * @param[in] rst_gpio_offset GPIO offset for the reset pin
- * @param[in] cs_gpio_offset GPIO offset for the chip select pin
+ * @param[in] cs_gpio_offset GPIO offset for the chip select pin, or
+ * XENSIV_BGT60TRXX_LINUX_NATIVE_CS
  * @param[in] high_speed Enable high-speed SPI mode
  * @return XENSIV_BGT60TRXX_STATUS_OK if successful, error code otherwise
  */
@@ -148,6 +318,11 @@ static inline int32_t xensiv_bgt60trxx_linux_init_sensor(xensiv_bgt60trxx_linux_
     }
 
     result = xensiv_bgt60trxx_init(&obj->dev, &obj->iface, high_speed);
+    if (result == XENSIV_BGT60TRXX_STATUS_OK) {
+        result = xensiv_bgt60trxx_linux_alloc_buffers(
+            &obj->iface, xensiv_bgt60trxx_get_fifo_size(&obj->dev), false);
+    }
+
     if (result != XENSIV_BGT60TRXX_STATUS_OK) {
         xensiv_bgt60trxx_linux_deinit(&obj->iface);
     }
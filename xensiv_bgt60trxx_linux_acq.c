@@ -0,0 +1,379 @@
+/***********************************************************************************************/ /**
+                                                                                                   * \file xensiv_bgt60trxx_linux_acq.c
+                                                                                                   *
+                                                                                                   * \brief
+                                                                                                   * This file contains the Linux acquisition engine implementation for the XENSIV(TM)
+                                                                                                   * BGT60TRxx 60GHz FMCW radar sensors.
+                                                                                                   *
+                                                                                                   ***************************************************************************************************
+                                                                                                   * \copyright
+                                                                                                   * Copyright 2022 Infineon Technologies AG
+                                                                                                   * SPDX-License-Identifier: Apache-2.0
+                                                                                                   *
+                                                                                                   * Licensed under the Apache License, Version 2.0 (the "License");
+                                                                                                   * you may not use this file except in compliance with the License.
+                                                                                                   * You may obtain a copy of the License at
+                                                                                                   *
+                                                                                                   *     http://www.apache.org/licenses/LICENSE-2.0
+                                                                                                   *
+                                                                                                   * Unless required by applicable law or agreed to in writing, software
+                                                                                                   * distributed under the License is distributed on an "AS IS" BASIS,
+                                                                                                   * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+                                                                                                   * See the License for the specific language governing permissions and
+                                                                                                   * limitations under the License.
+                                                                                                   **************************************************************************************************/
+
+#ifdef __linux__
+
+    /* Feature test macros for POSIX and GNU functions */
+    #define _GNU_SOURCE
+
+    #include "xensiv_bgt60trxx_linux_acq.h"
+
+    #include <errno.h>
+    #include <sched.h>
+    #include <stdio.h>
+    #include <stdlib.h>
+    #include <string.h>
+    #include <sys/mman.h>
+    #include <time.h>
+
+    #include "xensiv_bgt60trxx_geometry.h"
+
+    /*******************************************************************************
+     * Macros
+     *******************************************************************************/
+    #define XENSIV_BGT60TRXX_ACQ_IRQ_WAIT_MS (100) /* bounds the reaction time to stop */
+
+/*******************************************************************************
+ * Local Functions
+ *******************************************************************************/
+
+static uint64_t monotonic_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t) ts.tv_sec * 1000000000ULL) + (uint64_t) ts.tv_nsec;
+}
+
+/**
+ * @brief Apply the SCHED_FIFO priority and CPU affinity to the calling thread
+ */
+static bool apply_realtime(const xensiv_bgt60trxx_linux_acq_config_t *cfg)
+{
+    bool ok = true;
+
+    if (cfg->cpu >= 0) {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(cfg->cpu, &set);
+        if (pthread_setaffinity_np(pthread_self(), sizeof(set), &set) != 0) {
+            fprintf(stderr, "Failed to pin acquisition thread to CPU %d\n", cfg->cpu);
+            ok = false;
+        }
+    }
+
+    if (cfg->rt_priority > 0) {
+        struct sched_param param;
+        memset(&param, 0, sizeof(param));
+        param.sched_priority = cfg->rt_priority;
+        int ret = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+        if (ret != 0) {
+            fprintf(stderr, "Failed to set SCHED_FIFO priority: %s\n", strerror(ret));
+            ok = false;
+        }
+    }
+
+    return ok;
+}
+
+/**
+ * @brief Wait until a frame is available in the sensor FIFO
+ * @return XENSIV_BGT60TRXX_STATUS_TIMEOUT_ERROR if no frame is available yet
+ */
+static int32_t wait_frame(xensiv_bgt60trxx_linux_acq_t *acq, uint64_t *timestamp_ns)
+{
+    xensiv_bgt60trxx_linux_obj_t *sensor = acq->sensor;
+
+    if (!acq->polled) {
+        return xensiv_bgt60trxx_linux_wait_fifo(
+            &sensor->iface, XENSIV_BGT60TRXX_ACQ_IRQ_WAIT_MS, timestamp_ns);
+    }
+
+    uint32_t fill;
+    int32_t status = xensiv_bgt60trxx_linux_sched_wait(
+        &acq->sched, &sensor->dev, XENSIV_BGT60TRXX_ACQ_IRQ_WAIT_MS, &fill);
+    if (status == XENSIV_BGT60TRXX_STATUS_OK) {
+        *timestamp_ns = monotonic_ns();
+    }
+
+    return status;
+}
+
+/**
+ * @brief Check the FIFO fill level for a whole frame
+ *
+ * The IRQ line only rises when the fill level crosses the FIFO limit: while the thread is a frame
+ * behind the line stays high and no further edge comes until the FIFO overflows.
+ */
+static int32_t frame_pending(xensiv_bgt60trxx_linux_acq_t *acq, bool *pending)
+{
+    uint32_t fill = 0;
+    int32_t status = xensiv_bgt60trxx_get_fifo_fill(&acq->sensor->dev, &fill);
+
+    *pending = (status == XENSIV_BGT60TRXX_STATUS_OK) && (fill >= acq->cfg.frame_samples);
+    return status;
+}
+
+/**
+ * @brief Restart the frame generation after a FIFO overflow or underflow
+ */
+static int32_t restart_frames(xensiv_bgt60trxx_t *dev)
+{
+    int32_t status = xensiv_bgt60trxx_soft_reset(dev, XENSIV_BGT60TRXX_RESET_FSM);
+    if (status == XENSIV_BGT60TRXX_STATUS_OK) {
+        status = xensiv_bgt60trxx_soft_reset(dev, XENSIV_BGT60TRXX_RESET_FIFO);
+    }
+    if (status == XENSIV_BGT60TRXX_STATUS_OK) {
+        status = xensiv_bgt60trxx_start_frame(dev, true);
+    }
+
+    return status;
+}
+
+static void *acq_thread(void *arg)
+{
+    xensiv_bgt60trxx_linux_acq_t *acq = arg;
+    xensiv_bgt60trxx_t *dev = &acq->sensor->dev;
+
+    __atomic_store_n(&acq->realtime, apply_realtime(&acq->cfg), __ATOMIC_RELAXED);
+
+    int32_t status = xensiv_bgt60trxx_start_frame(dev, true);
+    bool pending = false;    /* IRQ mode: a whole frame is left in the FIFO */
+    bool stale_edge = false; /* IRQ mode: frames were read without waiting for their edge */
+
+    while (status == XENSIV_BGT60TRXX_STATUS_OK &&
+           __atomic_load_n(&acq->running, __ATOMIC_ACQUIRE)) {
+        uint64_t timestamp_ns = 0;
+
+        if (pending) {
+            // Catching up, the edge of a frame completed during the last read may still be queued
+            timestamp_ns = monotonic_ns();
+            stale_edge = true;
+        } else {
+            status = wait_frame(acq, &timestamp_ns);
+
+            // A timeout may hide frames behind an IRQ line that stays high, an edge after
+            // catching up may belong to a frame already read: trust the fill level instead
+            if (!acq->polled && (status == XENSIV_BGT60TRXX_STATUS_TIMEOUT_ERROR ||
+                                 (status == XENSIV_BGT60TRXX_STATUS_OK && stale_edge))) {
+                bool timed_out = (status == XENSIV_BGT60TRXX_STATUS_TIMEOUT_ERROR);
+                stale_edge = false;
+                status = frame_pending(acq, &pending);
+                if (status == XENSIV_BGT60TRXX_STATUS_OK && !pending) {
+                    continue;
+                }
+                if (timed_out) {
+                    timestamp_ns = monotonic_ns();
+                }
+            }
+
+            if (status == XENSIV_BGT60TRXX_STATUS_TIMEOUT_ERROR) {
+                status = XENSIV_BGT60TRXX_STATUS_OK;
+                continue;
+            }
+            if (status != XENSIV_BGT60TRXX_STATUS_OK) {
+                break;
+            }
+        }
+
+        // The FIFO is drained even when the ring is full, the frame is then dropped
+        xensiv_bgt60trxx_frame_t *frame = xensiv_bgt60trxx_ring_write_begin(&acq->ring);
+        uint16_t *dst = (frame != NULL) ? frame->samples : acq->scratch;
+
+        status = xensiv_bgt60trxx_get_fifo_data(dev, dst, acq->cfg.frame_samples);
+        if (status == XENSIV_BGT60TRXX_STATUS_GSR0_ERROR) {
+            __atomic_fetch_add(&acq->fifo_errors, 1U, __ATOMIC_RELAXED);
+            status = restart_frames(dev);
+            if (acq->polled) {
+                xensiv_bgt60trxx_linux_sched_restart(&acq->sched);
+            }
+            // Edges queued before the FIFO reset announce frames that are gone
+            pending = false;
+            stale_edge = true;
+            continue;
+        }
+        if (status != XENSIV_BGT60TRXX_STATUS_OK) {
+            break;
+        }
+        if (acq->polled) {
+            xensiv_bgt60trxx_linux_sched_consumed(&acq->sched, acq->cfg.frame_samples);
+        }
+
+        __atomic_fetch_add(&acq->frames, 1U, __ATOMIC_RELAXED);
+        uint32_t seq = acq->seq++;
+        if (frame != NULL) {
+            frame->num_samples = acq->cfg.frame_samples;
+            frame->seq = seq;
+            frame->timestamp_ns = timestamp_ns;
+            xensiv_bgt60trxx_ring_write_commit(&acq->ring);
+        }
+
+        if (!acq->polled) {
+            status = frame_pending(acq, &pending);
+        }
+    }
+
+    int32_t stop_status = xensiv_bgt60trxx_start_frame(dev, false);
+    if (status == XENSIV_BGT60TRXX_STATUS_OK) {
+        status = stop_status;
+    }
+
+    __atomic_store_n(&acq->status, status, __ATOMIC_RELEASE);
+    return NULL;
+}
+
+static void free_ring(xensiv_bgt60trxx_linux_acq_t *acq)
+{
+    free(acq->slots);
+    free(acq->storage);
+    free(acq->scratch);
+    acq->slots = NULL;
+    acq->storage = NULL;
+    acq->scratch = NULL;
+}
+
+/*******************************************************************************
+ * Public Functions
+ *******************************************************************************/
+
+int32_t xensiv_bgt60trxx_linux_acq_start(xensiv_bgt60trxx_linux_acq_t *acq,
+                                         xensiv_bgt60trxx_linux_obj_t *sensor,
+                                         const xensiv_bgt60trxx_linux_acq_config_t *config)
+{
+    if (!acq || !sensor || !config || config->frame_samples == 0 ||
+        (config->frame_samples % 2U) != 0U ||
+        (config->num_slots & (config->num_slots - 1U)) != 0U || !sensor->dev.type ||
+        (config->frame_samples / 2U) > xensiv_bgt60trxx_get_fifo_size(&sensor->dev)) {
+        return XENSIV_BGT60TRXX_STATUS_COM_ERROR;
+    }
+
+    memset(acq, 0, sizeof(*acq));
+    acq->sched.timer_fd = -1;
+    acq->sensor = sensor;
+    acq->cfg = *config;
+    if (acq->cfg.num_slots == 0) {
+        acq->cfg.num_slots = XENSIV_BGT60TRXX_LINUX_ACQ_DEFAULT_SLOTS;
+    }
+    if (acq->cfg.poll_us == 0) {
+        acq->cfg.poll_us = XENSIV_BGT60TRXX_LINUX_ACQ_DEFAULT_POLL_US;
+    }
+
+    size_t slot_bytes = (size_t) acq->cfg.frame_samples * sizeof(uint16_t);
+    acq->slots = calloc(acq->cfg.num_slots, sizeof(xensiv_bgt60trxx_frame_t));
+    acq->storage = malloc(slot_bytes * acq->cfg.num_slots);
+    acq->scratch = malloc(slot_bytes);
+    if (!acq->slots || !acq->storage || !acq->scratch) {
+        fprintf(stderr, "Failed to allocate acquisition ring\n");
+        free_ring(acq);
+        return XENSIV_BGT60TRXX_STATUS_COM_ERROR;
+    }
+
+    // Touch every page now so the thread never faults on the ring
+    memset(acq->storage, 0, slot_bytes * acq->cfg.num_slots);
+    memset(acq->scratch, 0, slot_bytes);
+    xensiv_bgt60trxx_ring_init(
+        &acq->ring, acq->slots, acq->cfg.num_slots, acq->storage, acq->cfg.frame_samples);
+
+    if (acq->cfg.lock_memory && mlockall(MCL_CURRENT | MCL_FUTURE) != 0) {
+        fprintf(stderr, "Failed to lock memory: %s\n", strerror(errno));
+    }
+
+    int32_t status = xensiv_bgt60trxx_linux_alloc_buffers(
+        &sensor->iface, xensiv_bgt60trxx_get_fifo_size(&sensor->dev), acq->cfg.lock_memory);
+    if (status == XENSIV_BGT60TRXX_STATUS_OK) {
+        status = xensiv_bgt60trxx_set_fifo_limit(&sensor->dev, acq->cfg.frame_samples);
+    }
+
+    acq->polled = (xensiv_bgt60trxx_linux_get_irq_fd(&sensor->iface) < 0);
+    if (status == XENSIV_BGT60TRXX_STATUS_OK && acq->polled) {
+        xensiv_bgt60trxx_linux_sched_config_t sched_cfg = {
+            .cref_samples = acq->cfg.frame_samples,
+            .rate_sps = acq->cfg.rate_sps,
+            .fallback_us = acq->cfg.poll_us,
+        };
+
+        // Seed the rate from the programmed timing; the scheduler learns it if that fails
+        xensiv_bgt60trxx_frame_geometry_t geometry;
+        if ((sched_cfg.rate_sps == 0U) &&
+            (xensiv_bgt60trxx_get_geometry(&sensor->dev, &geometry) ==
+             XENSIV_BGT60TRXX_STATUS_OK)) {
+            sched_cfg.rate_sps = geometry.data_rate_sps;
+        }
+        status = xensiv_bgt60trxx_linux_sched_init(&acq->sched, &sched_cfg);
+    }
+
+    if (status == XENSIV_BGT60TRXX_STATUS_OK) {
+        acq->running = true;
+        if (pthread_create(&acq->thread, NULL, acq_thread, acq) != 0) {
+            fprintf(stderr, "Failed to create acquisition thread\n");
+            status = XENSIV_BGT60TRXX_STATUS_COM_ERROR;
+        } else {
+            acq->started = true;
+        }
+    }
+
+    if (status != XENSIV_BGT60TRXX_STATUS_OK) {
+        acq->running = false;
+        if (acq->polled) {
+            xensiv_bgt60trxx_linux_sched_deinit(&acq->sched);
+        }
+        free_ring(acq);
+    }
+
+    return status;
+}
+
+int32_t xensiv_bgt60trxx_linux_acq_stop(xensiv_bgt60trxx_linux_acq_t *acq)
+{
+    if (!acq) {
+        return XENSIV_BGT60TRXX_STATUS_COM_ERROR;
+    }
+
+    if (acq->started) {
+        __atomic_store_n(&acq->running, false, __ATOMIC_RELEASE);
+        pthread_join(acq->thread, NULL);
+        acq->started = false;
+        if (acq->polled) {
+            xensiv_bgt60trxx_linux_sched_deinit(&acq->sched);
+        }
+    }
+
+    free_ring(acq);
+    return __atomic_load_n(&acq->status, __ATOMIC_ACQUIRE);
+}
+
+const xensiv_bgt60trxx_frame_t *xensiv_bgt60trxx_linux_acq_acquire_frame(
+    xensiv_bgt60trxx_linux_acq_t *acq)
+{
+    return xensiv_bgt60trxx_ring_read_acquire(&acq->ring);
+}
+
+void xensiv_bgt60trxx_linux_acq_release_frame(xensiv_bgt60trxx_linux_acq_t *acq)
+{
+    xensiv_bgt60trxx_ring_read_release(&acq->ring);
+}
+
+void xensiv_bgt60trxx_linux_acq_get_stats(const xensiv_bgt60trxx_linux_acq_t *acq,
+                                          xensiv_bgt60trxx_linux_acq_stats_t *stats)
+{
+    stats->frames = __atomic_load_n(&acq->frames, __ATOMIC_RELAXED);
+    stats->dropped = xensiv_bgt60trxx_ring_get_dropped(&acq->ring);
+    stats->fifo_errors = __atomic_load_n(&acq->fifo_errors, __ATOMIC_RELAXED);
+    stats->queued = xensiv_bgt60trxx_ring_count(&acq->ring);
+    stats->status = __atomic_load_n(&acq->status, __ATOMIC_ACQUIRE);
+    stats->realtime = __atomic_load_n(&acq->realtime, __ATOMIC_RELAXED);
+}
+
+#endif /* __linux__ */
@@ -0,0 +1,191 @@
+/***********************************************************************************************/ /**
+                                                                                                   * \file xensiv_bgt60trxx_linux_acq.h
+                                                                                                   *
+                                                                                                   * \brief
+                                                                                                   * This file contains the Linux acquisition engine for the XENSIV(TM) BGT60TRxx 60GHz FMCW
+                                                                                                   * radar sensors: a dedicated thread draining the sensor FIFO into a lock-free frame ring.
+                                                                                                   *
+                                                                                                   ***************************************************************************************************
+                                                                                                   * \copyright
+                                                                                                   * Copyright 2022 Infineon Technologies AG
+                                                                                                   * SPDX-License-Identifier: Apache-2.0
+                                                                                                   *
+                                                                                                   * Licensed under the Apache License, Version 2.0 (the "License");
+                                                                                                   * you may not use this file except in compliance with the License.
+                                                                                                   * You may obtain a copy of the License at
+                                                                                                   *
+                                                                                                   *     http://www.apache.org/licenses/LICENSE-2.0
+                                                                                                   *
+                                                                                                   * Unless required by applicable law or agreed to in writing, software
+                                                                                                   * distributed under the License is distributed on an "AS IS" BASIS,
+                                                                                                   * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+                                                                                                   * See the License for the specific language governing permissions and
+                                                                                                   * limitations under the License.
+                                                                                                   **************************************************************************************************/
+
+#ifndef XENSIV_BGT60TRXX_LINUX_ACQ_H_
+#define XENSIV_BGT60TRXX_LINUX_ACQ_H_
+
+#ifdef __linux__
+
+    #include <pthread.h>
+    #include <stdbool.h>
+    #include <stdint.h>
+
+    #include "xensiv_bgt60trxx_linux.h"
+    #include "xensiv_bgt60trxx_linux_sched.h"
+    #include "xensiv_bgt60trxx_ring.h"
+
+    /**
+     * \addtogroup group_board_libs_linux_acq XENSIV BGT60TRxx Linux Acquisition Engine
+     * \{
+     * Decouples the SPI readout deadline from the processing jitter of the application.
+     *
+     * A dedicated thread, optionally with SCHED_FIFO priority, CPU affinity and locked memory,
+     * waits for the FIFO interrupt (if xensiv_bgt60trxx_linux_interrupt_init() was called) or
+     * polls the FIFO status at the times predicted by the FIFO polling scheduler, and reads one
+     * frame per wakeup into a preallocated frame ring.
+     * The application picks frames up with the non-blocking
+     * xensiv_bgt60trxx_linux_acq_acquire_frame() / xensiv_bgt60trxx_linux_acq_release_frame()
+     * pair. When the application falls behind, the FIFO keeps being drained and the frames that
+     * do not fit are dropped and counted instead of overflowing the sensor FIFO.
+     *
+     * While the engine runs it is the only user of the sensor object.
+     */
+
+    #ifdef __cplusplus
+extern "C" {
+    #endif
+
+    /*******************************************************************************
+     * Macros
+     *******************************************************************************/
+
+    /** Default number of frame slots in the ring */
+    #define XENSIV_BGT60TRXX_LINUX_ACQ_DEFAULT_SLOTS (8U)
+
+    /** Default FIFO status polling interval without IRQ line while the data rate is unknown */
+    #define XENSIV_BGT60TRXX_LINUX_ACQ_DEFAULT_POLL_US (500U)
+
+/*******************************************************************************
+ * Data Structures
+ *******************************************************************************/
+
+/**
+ * @brief Acquisition engine configuration
+ */
+typedef struct {
+    uint32_t frame_samples; /**< Samples read per FIFO interrupt, one ring slot (even) */
+    uint32_t num_slots;     /**< Ring slots (power of two), 0 for the default */
+    int rt_priority;        /**< SCHED_FIFO priority of the thread, 0 keeps SCHED_OTHER */
+    int cpu;                /**< CPU the thread is pinned to, -1 for no affinity */
+    bool lock_memory;       /**< Lock all current and future pages with mlockall() */
+    uint32_t poll_us;       /**< Polling interval without IRQ until the rate is known, 0: default */
+    uint32_t rate_sps;      /**< Polling scheduler sample rate, 0: from the frame geometry */
+} xensiv_bgt60trxx_linux_acq_config_t;
+
+/**
+ * @brief Acquisition engine statistics
+ */
+typedef struct {
+    uint32_t frames;      /**< Frames read from the sensor FIFO */
+    uint32_t dropped;     /**< Frames read but discarded because the ring was full */
+    uint32_t fifo_errors; /**< FIFO overflow/underflow reports, each restarts the frames */
+    uint32_t queued;      /**< Frames waiting in the ring */
+    int32_t status;       /**< Error that stopped the thread, XENSIV_BGT60TRXX_STATUS_OK if none */
+    bool realtime;        /**< Thread runs with the requested priority and affinity */
+} xensiv_bgt60trxx_linux_acq_stats_t;
+
+/**
+ * @brief Acquisition engine object
+ *
+ * Application code should not rely on the specific content of this struct.
+ */
+typedef struct {
+    xensiv_bgt60trxx_linux_obj_t *sensor;    /**< Sensor drained by the thread */
+    xensiv_bgt60trxx_linux_acq_config_t cfg; /**< Configuration with defaults applied */
+    xensiv_bgt60trxx_ring_t ring;            /**< Frame ring */
+    xensiv_bgt60trxx_frame_t *slots;         /**< Ring slots */
+    uint16_t *storage;                       /**< Ring sample storage */
+    uint16_t *scratch;                       /**< Read target for frames dropped on a full ring */
+    pthread_t thread;                        /**< Acquisition thread */
+    bool started;                            /**< Thread was created */
+    bool running;                            /**< Cleared to stop the thread */
+    uint32_t seq;                            /**< Next frame sequence number */
+    uint32_t frames;                         /**< Frames read from the sensor FIFO */
+    uint32_t fifo_errors;                    /**< FIFO overflow/underflow reports */
+    int32_t status;                          /**< Error that stopped the thread */
+    bool realtime;                           /**< Priority and affinity were applied */
+    xensiv_bgt60trxx_linux_sched_t sched;    /**< FIFO polling scheduler without IRQ line */
+    bool polled;                             /**< No IRQ line, the scheduler is used */
+} xensiv_bgt60trxx_linux_acq_t;
+
+/*******************************************************************************
+ * Function Prototypes
+ *******************************************************************************/
+
+/**
+ * @brief Start the acquisition engine
+ *
+ * Allocates the ring, sets the FIFO limit to frame_samples, locks memory if requested, and
+ * starts the acquisition thread, which starts the frame generation of the sensor. Failing to
+ * apply the real-time priority or affinity (e.g. missing CAP_SYS_NICE) is not fatal and is
+ * reported in the statistics.
+ *
+ * @param[out] acq Pointer to the acquisition engine object
+ * @param[in] sensor Pointer to the initialized and configured sensor object
+ * @param[in] config Engine configuration
+ * @return XENSIV_BGT60TRXX_STATUS_OK if successful, error code otherwise
+ */
+int32_t xensiv_bgt60trxx_linux_acq_start(xensiv_bgt60trxx_linux_acq_t *acq,
+                                         xensiv_bgt60trxx_linux_obj_t *sensor,
+                                         const xensiv_bgt60trxx_linux_acq_config_t *config);
+
+/**
+ * @brief Stop the acquisition engine
+ *
+ * Stops and joins the thread, stops the frame generation and releases the ring. Frames still
+ * held by the application must not be used afterwards.
+ *
+ * @param[inout] acq Pointer to the acquisition engine object
+ * @return Error that stopped the thread, XENSIV_BGT60TRXX_STATUS_OK if none
+ */
+int32_t xensiv_bgt60trxx_linux_acq_stop(xensiv_bgt60trxx_linux_acq_t *acq);
+
+/**
+ * @brief Get the oldest acquired frame without blocking
+ *
+ * The frame stays valid until xensiv_bgt60trxx_linux_acq_release_frame() is called. Only one
+ * thread may consume frames.
+ *
+ * @param[inout] acq Pointer to the acquisition engine object
+ * @return Oldest frame, or NULL if no frame is pending
+ */
+const xensiv_bgt60trxx_frame_t *xensiv_bgt60trxx_linux_acq_acquire_frame(
+    xensiv_bgt60trxx_linux_acq_t *acq);
+
+/**
+ * @brief Return the frame obtained with xensiv_bgt60trxx_linux_acq_acquire_frame()
+ *
+ * @param[inout] acq Pointer to the acquisition engine object
+ */
+void xensiv_bgt60trxx_linux_acq_release_frame(xensiv_bgt60trxx_linux_acq_t *acq);
+
+/**
+ * @brief Get the acquisition statistics
+ *
+ * @param[in] acq Pointer to the acquisition engine object
+ * @param[out] stats Statistics snapshot
+ */
+void xensiv_bgt60trxx_linux_acq_get_stats(const xensiv_bgt60trxx_linux_acq_t *acq,
+                                          xensiv_bgt60trxx_linux_acq_stats_t *stats);
+
+    #ifdef __cplusplus
+}
+    #endif
+
+    /** \} group_board_libs_linux_acq */
+
+#endif /* __linux__ */
+
+#endif /* XENSIV_BGT60TRXX_LINUX_ACQ_H_ */
@@ -0,0 +1,241 @@
+/***********************************************************************************************/ /**
+                                                                                                   * \file xensiv_bgt60trxx_linux_sched.c
+                                                                                                   *
+                                                                                                   * \brief
+                                                                                                   * This file contains the Linux FIFO polling scheduler for XENSIV(TM) BGT60TRxx radar sensors
+                                                                                                   * without a routed IRQ line.
+                                                                                                   *
+                                                                                                   ***************************************************************************************************
+                                                                                                   * \copyright
+                                                                                                   * Copyright 2022 Infineon Technologies AG
+                                                                                                   * SPDX-License-Identifier: Apache-2.0
+                                                                                                   *
+                                                                                                   * Licensed under the Apache License, Version 2.0 (the "License");
+                                                                                                   * you may not use this file except in compliance with the License.
+                                                                                                   * You may obtain a copy of the License at
+                                                                                                   *
+                                                                                                   *     http://www.apache.org/licenses/LICENSE-2.0
+                                                                                                   *
+                                                                                                   * Unless required by applicable law or agreed to in writing, software
+                                                                                                   * distributed under the License is distributed on an "AS IS" BASIS,
+                                                                                                   * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+                                                                                                   * See the License for the specific language governing permissions and
+                                                                                                   * limitations under the License.
+                                                                                                   **************************************************************************************************/
+
+#ifdef __linux__
+
+    /* Feature test macros for POSIX and GNU functions */
+    #define _GNU_SOURCE
+
+    #include "xensiv_bgt60trxx_linux_sched.h"
+
+    #include <errno.h>
+    #include <stdio.h>
+    #include <string.h>
+    #include <sys/timerfd.h>
+    #include <time.h>
+    #include <unistd.h>
+
+/*******************************************************************************
+ * Local Functions
+ *******************************************************************************/
+
+static uint64_t monotonic_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t) ts.tv_sec * 1000000000ULL) + (uint64_t) ts.tv_nsec;
+}
+
+/**
+ * @brief Time of the next status read predicted from the last anchor
+ */
+static uint64_t next_read_ns(const xensiv_bgt60trxx_linux_sched_t *sched)
+{
+    const xensiv_bgt60trxx_linux_sched_config_t *cfg = &sched->cfg;
+
+    if (sched->last_fill >= cfg->cref_samples) {
+        return sched->last_ns;
+    }
+
+    uint64_t delay_ns = (uint64_t) cfg->fallback_us * 1000U;
+    if (sched->rate_sps > 0.0) {
+        double remaining_ns =
+            ((double) (cfg->cref_samples - sched->last_fill) * 1e9) / sched->rate_sps;
+        double lead_ns = (double) cfg->lead_us * 1000.0;
+        delay_ns = (remaining_ns > lead_ns) ? (uint64_t) (remaining_ns - lead_ns) : 0U;
+    }
+
+    uint64_t min_sleep_ns = (uint64_t) cfg->min_sleep_us * 1000U;
+    return sched->last_ns + ((delay_ns > min_sleep_ns) ? delay_ns : min_sleep_ns);
+}
+
+/**
+ * @brief Sleep on the timerfd until the given CLOCK_MONOTONIC time
+ */
+static int32_t sleep_until(const xensiv_bgt60trxx_linux_sched_t *sched, uint64_t wake_ns)
+{
+    if (wake_ns <= monotonic_ns()) {
+        return XENSIV_BGT60TRXX_STATUS_OK;
+    }
+
+    struct itimerspec its;
+    memset(&its, 0, sizeof(its));
+    its.it_value.tv_sec = (time_t) (wake_ns / 1000000000ULL);
+    its.it_value.tv_nsec = (long) (wake_ns % 1000000000ULL);
+    if (timerfd_settime(sched->timer_fd, TFD_TIMER_ABSTIME, &its, NULL) < 0) {
+        perror("Failed to arm FIFO poll timer");
+        return XENSIV_BGT60TRXX_STATUS_COM_ERROR;
+    }
+
+    uint64_t expirations;
+    ssize_t ret;
+    do {
+        ret = read(sched->timer_fd, &expirations, sizeof(expirations));
+    } while (ret < 0 && errno == EINTR);
+
+    if (ret != (ssize_t) sizeof(expirations)) {
+        perror("Failed to wait for FIFO poll timer");
+        return XENSIV_BGT60TRXX_STATUS_COM_ERROR;
+    }
+
+    return XENSIV_BGT60TRXX_STATUS_OK;
+}
+
+/*******************************************************************************
+ * Public Functions
+ *******************************************************************************/
+
+int32_t xensiv_bgt60trxx_linux_sched_init(xensiv_bgt60trxx_linux_sched_t *sched,
+                                          const xensiv_bgt60trxx_linux_sched_config_t *config)
+{
+    if (!sched || !config || config->cref_samples == 0U) {
+        return XENSIV_BGT60TRXX_STATUS_COM_ERROR;
+    }
+
+    memset(sched, 0, sizeof(*sched));
+    sched->cfg = *config;
+    if (sched->cfg.lead_us == 0U) {
+        sched->cfg.lead_us = XENSIV_BGT60TRXX_LINUX_SCHED_DEFAULT_LEAD_US;
+    }
+    if (sched->cfg.min_sleep_us == 0U) {
+        sched->cfg.min_sleep_us = XENSIV_BGT60TRXX_LINUX_SCHED_DEFAULT_MIN_SLEEP_US;
+    }
+    if (sched->cfg.fallback_us == 0U) {
+        sched->cfg.fallback_us = XENSIV_BGT60TRXX_LINUX_SCHED_DEFAULT_FALLBACK_US;
+    }
+    sched->rate_sps = (double) config->rate_sps;
+
+    sched->timer_fd = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC);
+    if (sched->timer_fd < 0) {
+        perror("Failed to create FIFO poll timer");
+        return XENSIV_BGT60TRXX_STATUS_COM_ERROR;
+    }
+
+    return XENSIV_BGT60TRXX_STATUS_OK;
+}
+
+void xensiv_bgt60trxx_linux_sched_deinit(xensiv_bgt60trxx_linux_sched_t *sched)
+{
+    if (sched && sched->timer_fd >= 0) {
+        close(sched->timer_fd);
+        sched->timer_fd = -1;
+    }
+}
+
+int32_t xensiv_bgt60trxx_linux_sched_wait(xensiv_bgt60trxx_linux_sched_t *sched,
+                                          const xensiv_bgt60trxx_t *dev,
+                                          int timeout_ms,
+                                          uint32_t *fill_samples)
+{
+    uint64_t end_ns = (timeout_ms >= 0) ? monotonic_ns() + ((uint64_t) timeout_ms * 1000000U)
+                                        : UINT64_MAX;
+    uint64_t wake_ns = sched->anchored ? next_read_ns(sched) : 0U;
+    int32_t status = XENSIV_BGT60TRXX_STATUS_OK;
+
+    while (status == XENSIV_BGT60TRXX_STATUS_OK) {
+        status = sleep_until(sched, (wake_ns < end_ns) ? wake_ns : end_ns);
+        if (status != XENSIV_BGT60TRXX_STATUS_OK) {
+            break;
+        }
+
+        uint32_t fill = 0U;
+        uint64_t start_ns = monotonic_ns();
+        status = xensiv_bgt60trxx_get_fifo_fill(dev, &fill);
+        uint64_t read_ns = start_ns + ((monotonic_ns() - start_ns) / 2U);
+        if (status != XENSIV_BGT60TRXX_STATUS_OK) {
+            break;
+        }
+
+        wake_ns = xensiv_bgt60trxx_linux_sched_observe(sched, read_ns, fill);
+        *fill_samples = fill;
+        if (fill >= sched->cfg.cref_samples) {
+            break;
+        }
+
+        if (read_ns >= end_ns) {
+            status = XENSIV_BGT60TRXX_STATUS_TIMEOUT_ERROR;
+        }
+    }
+
+    return status;
+}
+
+void xensiv_bgt60trxx_linux_sched_consumed(xensiv_bgt60trxx_linux_sched_t *sched,
+                                           uint32_t num_samples)
+{
+    sched->last_fill = (num_samples < sched->last_fill) ? (sched->last_fill - num_samples) : 0U;
+}
+
+void xensiv_bgt60trxx_linux_sched_restart(xensiv_bgt60trxx_linux_sched_t *sched)
+{
+    sched->anchored = false;
+    sched->last_fill = 0U;
+}
+
+uint64_t xensiv_bgt60trxx_linux_sched_observe(xensiv_bgt60trxx_linux_sched_t *sched,
+                                              uint64_t now_ns,
+                                              uint32_t fill_samples)
+{
+    ++sched->reads;
+
+    // The growth since the last anchor corrects the rate; a drop means unreported reads
+    if (sched->anchored && now_ns > sched->last_ns && fill_samples >= sched->last_fill) {
+        double observed =
+            ((double) (fill_samples - sched->last_fill) * 1e9) / (double) (now_ns - sched->last_ns);
+
+        if (sched->rate_sps > 0.0) {
+            double gain = 1.0 / (double) (1U << XENSIV_BGT60TRXX_LINUX_SCHED_RATE_SHIFT);
+            sched->rate_sps += (observed - sched->rate_sps) * gain;
+        } else {
+            sched->rate_sps = observed;
+        }
+    }
+
+    sched->anchored = true;
+    sched->last_ns = now_ns;
+    sched->last_fill = fill_samples;
+
+    if (fill_samples < sched->cfg.cref_samples) {
+        ++sched->early_reads;
+    } else if ((fill_samples - sched->cfg.cref_samples) > sched->late_samples) {
+        sched->late_samples = fill_samples - sched->cfg.cref_samples;
+    } else {
+        // On time
+    }
+
+    return next_read_ns(sched);
+}
+
+void xensiv_bgt60trxx_linux_sched_get_stats(const xensiv_bgt60trxx_linux_sched_t *sched,
+                                            xensiv_bgt60trxx_linux_sched_stats_t *stats)
+{
+    stats->reads = sched->reads;
+    stats->early_reads = sched->early_reads;
+    stats->late_samples = sched->late_samples;
+    stats->rate_sps = sched->rate_sps;
+}
+
+#endif /* __linux__ */
@@ -0,0 +1,202 @@
+/***********************************************************************************************/ /**
+                                                                                                   * \file xensiv_bgt60trxx_linux_sched.h
+                                                                                                   *
+                                                                                                   * \brief
+                                                                                                   * This file contains the Linux FIFO polling scheduler for XENSIV(TM) BGT60TRxx radar sensors
+                                                                                                   * without a routed IRQ line: a timerfd armed for the predicted time the FIFO limit is reached.
+                                                                                                   *
+                                                                                                   ***************************************************************************************************
+                                                                                                   * \copyright
+                                                                                                   * Copyright 2022 Infineon Technologies AG
+                                                                                                   * SPDX-License-Identifier: Apache-2.0
+                                                                                                   *
+                                                                                                   * Licensed under the Apache License, Version 2.0 (the "License");
+                                                                                                   * you may not use this file except in compliance with the License.
+                                                                                                   * You may obtain a copy of the License at
+                                                                                                   *
+                                                                                                   *     http://www.apache.org/licenses/LICENSE-2.0
+                                                                                                   *
+                                                                                                   * Unless required by applicable law or agreed to in writing, software
+                                                                                                   * distributed under the License is distributed on an "AS IS" BASIS,
+                                                                                                   * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+                                                                                                   * See the License for the specific language governing permissions and
+                                                                                                   * limitations under the License.
+                                                                                                   **************************************************************************************************/
+
+#ifndef XENSIV_BGT60TRXX_LINUX_SCHED_H_
+#define XENSIV_BGT60TRXX_LINUX_SCHED_H_
+
+#ifdef __linux__
+
+    #include <stdbool.h>
+    #include <stdint.h>
+
+    #include "xensiv_bgt60trxx.h"
+
+    /**
+     * \addtogroup group_board_libs_linux_sched XENSIV BGT60TRxx Linux FIFO Polling Scheduler
+     * \{
+     * Replaces fixed-period FIFO status polling on boards without the IRQ line. Every FSTAT read
+     * anchors the fill level in time and refines the estimate of the sample production rate,
+     * then a CLOCK_MONOTONIC timerfd is armed for the time the fill level is predicted to
+     * reach the FIFO limit. Status reads on an empty FIFO become rare and the wakeup follows
+     * the data instead of a poll grid.
+     *
+     * The rate can be seeded from the programmed frame and chirp timing and is corrected by the
+     * observed fill levels; without a seed it is learned, polling with a fallback period until
+     * the first estimate exists. The samples read by the caller are reported with
+     * xensiv_bgt60trxx_linux_sched_consumed() so that the next prediction starts from the right
+     * fill level.
+     */
+
+    #ifdef __cplusplus
+extern "C" {
+    #endif
+
+    /*******************************************************************************
+     * Macros
+     *******************************************************************************/
+
+    /** Default wakeup lead on the predicted time, covering timer and scheduling latency */
+    #define XENSIV_BGT60TRXX_LINUX_SCHED_DEFAULT_LEAD_US (50U)
+
+    /** Default shortest sleep between two FIFO status reads */
+    #define XENSIV_BGT60TRXX_LINUX_SCHED_DEFAULT_MIN_SLEEP_US (20U)
+
+    /** Default status polling period while the production rate is unknown */
+    #define XENSIV_BGT60TRXX_LINUX_SCHED_DEFAULT_FALLBACK_US (500U)
+
+    /** The rate estimate moves by 1/2^shift of the difference to each new observation */
+    #define XENSIV_BGT60TRXX_LINUX_SCHED_RATE_SHIFT (3U)
+
+/*******************************************************************************
+ * Data Structures
+ *******************************************************************************/
+
+/**
+ * @brief Scheduler configuration
+ */
+typedef struct {
+    uint32_t cref_samples; /**< Fill level to wait for in samples, normally the FIFO limit */
+    uint32_t rate_sps;     /**< Initial production rate in samples/s, 0 to learn it */
+    uint32_t lead_us;      /**< Wake up this long before the predicted time, 0 for the default */
+    uint32_t min_sleep_us; /**< Shortest sleep between two status reads, 0 for the default */
+    uint32_t fallback_us;  /**< Polling period while the rate is unknown, 0 for the default */
+} xensiv_bgt60trxx_linux_sched_config_t;
+
+/**
+ * @brief Scheduler statistics
+ */
+typedef struct {
+    uint32_t reads;        /**< FIFO status reads */
+    uint32_t early_reads;  /**< Status reads that found the FIFO below cref_samples */
+    uint32_t late_samples; /**< Largest fill beyond cref_samples found by a read */
+    double rate_sps;       /**< Current production rate estimate in samples/s */
+} xensiv_bgt60trxx_linux_sched_stats_t;
+
+/**
+ * @brief Scheduler object
+ *
+ * Application code should not rely on the specific content of this struct.
+ */
+typedef struct {
+    xensiv_bgt60trxx_linux_sched_config_t cfg; /**< Configuration with defaults applied */
+    int timer_fd;                              /**< CLOCK_MONOTONIC timerfd */
+    double rate_sps;                           /**< Production rate estimate, 0 if unknown */
+    bool anchored;                             /**< last_ns and last_fill are valid */
+    uint64_t last_ns;                          /**< Time of the last status read */
+    uint32_t last_fill;                        /**< Fill level at last_ns, minus consumption */
+    uint32_t reads;                            /**< FIFO status reads */
+    uint32_t early_reads;                      /**< Reads below cref_samples */
+    uint32_t late_samples;                     /**< Largest fill beyond cref_samples */
+} xensiv_bgt60trxx_linux_sched_t;
+
+/*******************************************************************************
+ * Function Prototypes
+ *******************************************************************************/
+
+/**
+ * @brief Initialize the scheduler and create its timerfd
+ *
+ * @param[out] sched Pointer to the scheduler object
+ * @param[in] config Scheduler configuration
+ * @return XENSIV_BGT60TRXX_STATUS_OK if successful, error code otherwise
+ */
+int32_t xensiv_bgt60trxx_linux_sched_init(xensiv_bgt60trxx_linux_sched_t *sched,
+                                          const xensiv_bgt60trxx_linux_sched_config_t *config);
+
+/**
+ * @brief Release the timerfd of the scheduler
+ *
+ * @param[inout] sched Pointer to the scheduler object
+ */
+void xensiv_bgt60trxx_linux_sched_deinit(xensiv_bgt60trxx_linux_sched_t *sched);
+
+/**
+ * @brief Wait until the FIFO holds at least cref_samples
+ *
+ * Sleeps until the predicted time, reads the FIFO status, and sleeps again on the corrected
+ * prediction until the fill level is reached.
+ *
+ * @param[inout] sched Pointer to the scheduler object
+ * @param[in] dev Pointer to the sensor device object
+ * @param[in] timeout_ms Maximum time to wait, negative to wait indefinitely
+ * @param[out] fill_samples FIFO fill level in samples found by the last status read
+ * @return XENSIV_BGT60TRXX_STATUS_OK if the fill level was reached,
+ * XENSIV_BGT60TRXX_STATUS_TIMEOUT_ERROR on timeout, error code otherwise
+ */
+int32_t xensiv_bgt60trxx_linux_sched_wait(xensiv_bgt60trxx_linux_sched_t *sched,
+                                          const xensiv_bgt60trxx_t *dev,
+                                          int timeout_ms,
+                                          uint32_t *fill_samples);
+
+/**
+ * @brief Report the samples read from the FIFO since the last status read
+ *
+ * @param[inout] sched Pointer to the scheduler object
+ * @param[in] num_samples Number of samples read
+ */
+void xensiv_bgt60trxx_linux_sched_consumed(xensiv_bgt60trxx_linux_sched_t *sched,
+                                           uint32_t num_samples);
+
+/**
+ * @brief Forget the fill level anchor, e.g. after a FIFO reset. The rate estimate is kept.
+ *
+ * @param[inout] sched Pointer to the scheduler object
+ */
+void xensiv_bgt60trxx_linux_sched_restart(xensiv_bgt60trxx_linux_sched_t *sched);
+
+/**
+ * @brief Feed a FIFO status read to the predictor
+ *
+ * Used by xensiv_bgt60trxx_linux_sched_wait(); exposed for callers running their own event
+ * loop around the status reads.
+ *
+ * @param[inout] sched Pointer to the scheduler object
+ * @param[in] now_ns CLOCK_MONOTONIC time of the status read in ns
+ * @param[in] fill_samples FIFO fill level in samples
+ * @return CLOCK_MONOTONIC time in ns of the next status read, now_ns if the fill level
+ * already reached cref_samples
+ */
+uint64_t xensiv_bgt60trxx_linux_sched_observe(xensiv_bgt60trxx_linux_sched_t *sched,
+                                              uint64_t now_ns,
+                                              uint32_t fill_samples);
+
+/**
+ * @brief Get the scheduler statistics
+ *
+ * @param[in] sched Pointer to the scheduler object
+ * @param[out] stats Statistics snapshot
+ */
+void xensiv_bgt60trxx_linux_sched_get_stats(const xensiv_bgt60trxx_linux_sched_t *sched,
+                                            xensiv_bgt60trxx_linux_sched_stats_t *stats);
+
+    #ifdef __cplusplus
+}
+    #endif
+
+    /** \} group_board_libs_linux_sched */
+
+#endif /* __linux__ */
+
+#endif /* XENSIV_BGT60TRXX_LINUX_SCHED_H_ */
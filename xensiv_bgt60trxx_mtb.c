@@ -91,11 +91,11 @@ cy_rslt_t xensiv_bgt60trxx_mtb_init(xensiv_bgt60trxx_mtb_t *obj,
     /* perform device hard reset before beginning init via SPI */
     xensiv_bgt60trxx_platform_rst_set(iface, true);
     xensiv_bgt60trxx_platform_spi_cs_set(iface, true);
-    xensiv_bgt60trxx_platform_delay(1U);
+    xensiv_bgt60trxx_platform_delay_us(XENSIV_BGT60TRXX_HARD_RESET_PULSE_US);
     xensiv_bgt60trxx_platform_rst_set(iface, false);
-    xensiv_bgt60trxx_platform_delay(1U);
+    xensiv_bgt60trxx_platform_delay_us(XENSIV_BGT60TRXX_HARD_RESET_PULSE_US);
     xensiv_bgt60trxx_platform_rst_set(iface, true);
-    xensiv_bgt60trxx_platform_delay(1U);
+    xensiv_bgt60trxx_platform_delay_us(XENSIV_BGT60TRXX_HARD_RESET_SETTLE_US);
 
     if (CY_RSLT_SUCCESS == rslt) {
         int32_t res = xensiv_bgt60trxx_init(dev, iface, false);
@@ -223,6 +223,30 @@ int32_t xensiv_bgt60trxx_platform_spi_fifo_read(void *iface, uint16_t *rx_data,
 }
 
 
+int32_t xensiv_bgt60trxx_platform_spi_fifo_burst_read(void *iface,
+                                                      uint8_t *header,
+                                                      uint8_t *gsr0,
+                                                      uint16_t *rx_data,
+                                                      uint32_t len)
+{
+    CY_ASSERT(iface != NULL);
+
+    xensiv_bgt60trxx_platform_spi_cs_set(iface, false);
+
+    int32_t retval = xensiv_bgt60trxx_platform_spi_transfer(
+        iface, header, gsr0, XENSIV_BGT60TRXX_SPI_BURST_HEADER_SIZE_BYTES);
+
+    if ((XENSIV_BGT60TRXX_STATUS_OK == retval) &&
+        ((gsr0[0] & XENSIV_BGT60TRXX_REG_GSR0_ERR_MSK) == 0U)) {
+        retval = xensiv_bgt60trxx_platform_spi_fifo_read(iface, rx_data, len);
+    }
+
+    xensiv_bgt60trxx_platform_spi_cs_set(iface, true);
+
+    return retval;
+}
+
+
 void xensiv_bgt60trxx_platform_rst_set(const void *iface, bool val)
 {
     CY_ASSERT(iface != NULL);
@@ -253,6 +277,17 @@ void xensiv_bgt60trxx_platform_delay(uint32_t ms)
 }
 
 
+void xensiv_bgt60trxx_platform_delay_us(uint32_t us)
+{
+    while (us > UINT16_MAX) {
+        cyhal_system_delay_us(UINT16_MAX);
+        us -= UINT16_MAX;
+    }
+
+    cyhal_system_delay_us((uint16_t) us);
+}
+
+
 uint32_t xensiv_bgt60trxx_platform_word_reverse(uint32_t x)
 {
     return __REV(x);
@@ -85,6 +85,9 @@ int32_t xensiv_bgt60trxx_platform_spi_transfer(void *iface,
  * ADC samples are stored in the sensor FIFO using 12bits.
  * It is expected to use SPI read transfers with a word length of 12bits.
  * It is expected to drive TX high while data is read in from RX.
+ * Platforms limited to 8-bit SPI transfers can read the packed FIFO words
+ * (XENSIV_BGT60TRXX_PACKED_SIZE_BYTES(len) bytes) and expand them with
+ * xensiv_bgt60trxx_unpack_fifo_data().
  *
  * @param[in] iface Platform SPI interface object.
  * @param[in] rx_data The pointer to the buffer to store the received data.
@@ -94,6 +97,30 @@ int32_t xensiv_bgt60trxx_platform_spi_transfer(void *iface,
  */
 int32_t xensiv_bgt60trxx_platform_spi_fifo_read(void *iface, uint16_t *rx_data, uint32_t len);
 
+/**
+ * @brief Platform-specific function that performs a complete SPI burst read of the sensor FIFO.
+ * Asserts the SPI CS, sends the 4-byte burst command header while receiving GSR0, receives the
+ * FIFO payload and releases the SPI CS. Implementations should issue the header and the payload
+ * as a single bus transaction where possible.
+ * The payload must not be written to rx_data when GSR0 reports an error
+ * (XENSIV_BGT60TRXX_REG_GSR0_ERR_MSK).
+ *
+ * @param[in] iface Platform SPI interface object.
+ * @param[in] header The burst command header to transmit, XENSIV_BGT60TRXX_SPI_BURST_HEADER_SIZE_BYTES
+ * long, already in transmission byte order.
+ * @param[out] gsr0 The buffer to store the bytes received during the header,
+ * XENSIV_BGT60TRXX_SPI_BURST_HEADER_SIZE_BYTES long. The first byte holds GSR0.
+ * @param[in] rx_data The pointer to the buffer to store the received data.
+ * @param[in] len The number of FIFO data elements of 12bits to receive.
+ * @return XENSIV_BGT60TRXX_STATUS_OK if the read is completed without errors,
+ * otherwise returns XENSIV_BGT60TRXX_STATUS_COM_ERROR.
+ */
+int32_t xensiv_bgt60trxx_platform_spi_fifo_burst_read(void *iface,
+                                                      uint8_t *header,
+                                                      uint8_t *gsr0,
+                                                      uint16_t *rx_data,
+                                                      uint32_t len);
+
 /**
  * @brief Platform-specific function that waits for a specified time period in milliseconds.
  *
@@ -101,6 +128,15 @@ int32_t xensiv_bgt60trxx_platform_spi_fifo_read(void *iface, uint16_t *rx_data,
  */
 void xensiv_bgt60trxx_platform_delay(uint32_t ms);
 
+/**
+ * @brief Platform-specific function that waits for a specified time period in microseconds.
+ * The wait must not be shorter than requested; it is used for reset pulses and for the
+ * backoff while polling a pending software reset.
+ *
+ * @param[in] us Number of microseconds to wait for.
+ */
+void xensiv_bgt60trxx_platform_delay_us(uint32_t us);
+
 /**
  * @brief Platform-specific function to reverse the byte order (32 bits).
  * A sample implementation would look like
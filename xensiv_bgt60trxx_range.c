@@ -0,0 +1,300 @@
+/***********************************************************************************************/ /**
+                                                                                                   * \file xensiv_bgt60trxx_range.c
+                                                                                                   *
+                                                                                                   * \brief
+                                                                                                   * This file contains the range processing stage of the XENSIV(TM) BGT60TRxx radar sensor.
+                                                                                                   *
+                                                                                                   ***************************************************************************************************
+                                                                                                   * \copyright
+                                                                                                   * Copyright 2022 Infineon Technologies AG
+                                                                                                   * SPDX-License-Identifier: Apache-2.0
+                                                                                                   *
+                                                                                                   * Licensed under the Apache License, Version 2.0 (the "License");
+                                                                                                   * you may not use this file except in compliance with the License.
+                                                                                                   * You may obtain a copy of the License at
+                                                                                                   *
+                                                                                                   *     http://www.apache.org/licenses/LICENSE-2.0
+                                                                                                   *
+                                                                                                   * Unless required by applicable law or agreed to in writing, software
+                                                                                                   * distributed under the License is distributed on an "AS IS" BASIS,
+                                                                                                   * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+                                                                                                   * See the License for the specific language governing permissions and
+                                                                                                   * limitations under the License.
+                                                                                                   **************************************************************************************************/
+
+#include "xensiv_bgt60trxx_range.h"
+
+#include <math.h>
+#include <string.h>
+
+#include "xensiv_bgt60trxx.h"
+#include "xensiv_bgt60trxx_platform.h"
+
+static uint32_t next_pow2(uint32_t val)
+{
+    uint32_t size = 2U;
+
+    while (size < val) {
+        size <<= 1;
+    }
+
+    return size;
+}
+
+
+static uint32_t plan_fft_size(const xensiv_bgt60trxx_range_config_t *config, uint32_t num_samples)
+{
+    return (config->fft_size != 0U) ? config->fft_size : next_pow2(num_samples);
+}
+
+
+static size_t plan_storage_size(uint32_t num_samples, uint32_t fft_size)
+{
+    return (num_samples * sizeof(float)) + XENSIV_BGT60TRXX_RFFT_PLAN_STORAGE_BYTES(fft_size);
+}
+
+
+/* Returns the plan of segments with this chirp length among the first num_segments segments,
+   or num_segments if it is the first segment with this length */
+static uint32_t find_plan(const xensiv_bgt60trxx_assembler_t *assembler, uint32_t num_segments,
+                          uint32_t num_samples)
+{
+    uint32_t seg = 0U;
+
+    while ((seg < num_segments) && (assembler->segments[seg].num_samples != num_samples)) {
+        ++seg;
+    }
+
+    return seg;
+}
+
+
+void xensiv_bgt60trxx_window_init(float *window,
+                                  uint32_t num_samples,
+                                  xensiv_bgt60trxx_window_t type)
+{
+    xensiv_bgt60trxx_platform_assert(window != NULL);
+
+    const double pi = 3.14159265358979323846;
+
+    /* A single sample passes unweighted; the cosine windows would zero it */
+    if (num_samples == 1U) {
+        window[0] = 1.0f;
+        return;
+    }
+
+    for (uint32_t n = 0; n < num_samples; ++n) {
+        double x = (2.0 * pi * n) / (double) (num_samples - 1U);
+        double w;
+
+        switch (type) {
+            case XENSIV_BGT60TRXX_WINDOW_HANN:
+                w = 0.5 - (0.5 * cos(x));
+                break;
+            case XENSIV_BGT60TRXX_WINDOW_HAMMING:
+                w = 0.54 - (0.46 * cos(x));
+                break;
+            case XENSIV_BGT60TRXX_WINDOW_BLACKMAN_HARRIS:
+                w = 0.35875 - (0.48829 * cos(x)) + (0.14128 * cos(2.0 * x)) -
+                    (0.01168 * cos(3.0 * x));
+                break;
+            default:
+                w = 1.0;
+                break;
+        }
+
+        window[n] = (float) w;
+    }
+}
+
+
+size_t xensiv_bgt60trxx_range_storage_size(const xensiv_bgt60trxx_assembler_t *assembler,
+                                           const xensiv_bgt60trxx_range_config_t *config)
+{
+    xensiv_bgt60trxx_platform_assert(assembler != NULL);
+    xensiv_bgt60trxx_platform_assert(config != NULL);
+
+    size_t size = 0U;
+    uint32_t max_fft_size = 0U;
+
+    for (uint32_t seg = 0; seg < assembler->num_segments; ++seg) {
+        uint32_t num_samples = assembler->segments[seg].num_samples;
+        uint32_t fft_size = plan_fft_size(config, num_samples);
+
+        if (find_plan(assembler, seg, num_samples) == seg) {
+            size += plan_storage_size(num_samples, fft_size);
+        }
+        max_fft_size = (fft_size > max_fft_size) ? fft_size : max_fft_size;
+    }
+
+    return size + (max_fft_size * sizeof(float));
+}
+
+
+int32_t xensiv_bgt60trxx_range_init(xensiv_bgt60trxx_range_t *range,
+                                    const xensiv_bgt60trxx_assembler_t *assembler,
+                                    const xensiv_bgt60trxx_range_config_t *config,
+                                    void *storage,
+                                    size_t storage_size)
+{
+    xensiv_bgt60trxx_platform_assert(range != NULL);
+    xensiv_bgt60trxx_platform_assert(assembler != NULL);
+    xensiv_bgt60trxx_platform_assert(assembler->layout == XENSIV_BGT60TRXX_LAYOUT_PLANAR);
+    xensiv_bgt60trxx_platform_assert(config != NULL);
+    xensiv_bgt60trxx_platform_assert(storage != NULL);
+
+    if (storage_size < xensiv_bgt60trxx_range_storage_size(assembler, config)) {
+        return XENSIV_BGT60TRXX_STATUS_DEV_ERROR;
+    }
+
+    for (uint32_t seg = 0; seg < assembler->num_segments; ++seg) {
+        uint32_t num_samples = assembler->segments[seg].num_samples;
+        uint32_t fft_size = plan_fft_size(config, num_samples);
+        if (((fft_size & (fft_size - 1U)) != 0U) || (fft_size < 2U) || (fft_size < num_samples)) {
+            return XENSIV_BGT60TRXX_STATUS_DEV_ERROR;
+        }
+    }
+
+    memset(range, 0, sizeof(*range));
+    range->config = *config;
+    range->assembler = assembler;
+
+    uint8_t *next = (uint8_t *) storage;
+    uint32_t max_fft_size = 0U;
+
+    for (uint32_t seg = 0; seg < assembler->num_segments; ++seg) {
+        const xensiv_bgt60trxx_frame_segment_t *segment = &assembler->segments[seg];
+        uint32_t first = find_plan(assembler, seg, segment->num_samples);
+
+        if (first == seg) {
+            xensiv_bgt60trxx_range_plan_t *plan = &range->plans[range->num_plans];
+
+            plan->num_samples = segment->num_samples;
+            plan->fft_size = plan_fft_size(config, segment->num_samples);
+            plan->window = (float *) next;
+            xensiv_bgt60trxx_window_init(plan->window, plan->num_samples, config->window);
+            next += plan->num_samples * sizeof(float);
+            xensiv_bgt60trxx_rfft_plan_init(&plan->plan, plan->fft_size, config->algo, next);
+            next += XENSIV_BGT60TRXX_RFFT_PLAN_STORAGE_BYTES(plan->fft_size);
+
+            range->segment_plan[seg] = range->num_plans;
+            ++range->num_plans;
+        } else {
+            range->segment_plan[seg] = range->segment_plan[first];
+        }
+
+        const xensiv_bgt60trxx_range_plan_t *plan = &range->plans[range->segment_plan[seg]];
+        range->segment_offset[seg] = range->group_bins;
+        range->group_bins += segment->num_rx * segment->num_chirps * (plan->fft_size / 2U);
+        max_fft_size = (plan->fft_size > max_fft_size) ? plan->fft_size : max_fft_size;
+    }
+
+    range->scratch = (float *) next;
+    range->frame_bins = range->group_bins * assembler->num_groups;
+
+    return XENSIV_BGT60TRXX_STATUS_OK;
+}
+
+
+uint32_t xensiv_bgt60trxx_range_profile_offset(const xensiv_bgt60trxx_range_t *range,
+                                               uint32_t group,
+                                               uint32_t segment,
+                                               uint32_t rx,
+                                               uint32_t chirp)
+{
+    xensiv_bgt60trxx_platform_assert(range != NULL);
+    xensiv_bgt60trxx_platform_assert(segment < range->assembler->num_segments);
+
+    const xensiv_bgt60trxx_frame_segment_t *seg = &range->assembler->segments[segment];
+    uint32_t bins = range->plans[range->segment_plan[segment]].fft_size / 2U;
+
+    return (group * range->group_bins) + range->segment_offset[segment] +
+           (((rx * seg->num_chirps) + chirp) * bins);
+}
+
+
+/* Windowed, zero-padded FFT of one chirp into fft_size / 2 bins, Nyquist bin dropped */
+static void transform_row(const xensiv_bgt60trxx_range_t *range,
+                          const xensiv_bgt60trxx_range_plan_t *plan,
+                          const uint16_t *src,
+                          xensiv_bgt60trxx_complex_t *dst)
+{
+    float *buf = (float *) dst;
+    float mean = 0.0f;
+
+    if (range->config.remove_dc) {
+        uint32_t sum = 0U;
+        for (uint32_t n = 0; n < plan->num_samples; ++n) {
+            sum += src[n];
+        }
+        mean = (float) sum / (float) plan->num_samples;
+    }
+
+    for (uint32_t n = 0; n < plan->num_samples; ++n) {
+        buf[n] = ((float) src[n] - mean) * plan->window[n];
+    }
+    for (uint32_t n = plan->num_samples; n < plan->fft_size; ++n) {
+        buf[n] = 0.0f;
+    }
+
+    xensiv_bgt60trxx_rfft(&plan->plan, buf, dst);
+    dst[0].im = 0.0f;
+}
+
+
+static void process(xensiv_bgt60trxx_range_t *range,
+                    const uint16_t *frame,
+                    xensiv_bgt60trxx_complex_t *complex_out,
+                    float *magnitude_out)
+{
+    const xensiv_bgt60trxx_assembler_t *assembler = range->assembler;
+
+    for (uint32_t group = 0; group < assembler->num_groups; ++group) {
+        for (uint32_t seg = 0; seg < assembler->num_segments; ++seg) {
+            const xensiv_bgt60trxx_frame_segment_t *segment = &assembler->segments[seg];
+            const xensiv_bgt60trxx_range_plan_t *plan = &range->plans[range->segment_plan[seg]];
+            const uint32_t bins = plan->fft_size / 2U;
+            const uint32_t num_rows = segment->num_rx * segment->num_chirps;
+            const uint16_t *src = &frame[(group * assembler->group_size) + segment->offset];
+            uint32_t offset = (group * range->group_bins) + range->segment_offset[seg];
+
+            /* Rows of a segment are contiguous in both the frame and the output */
+            for (uint32_t row = 0; row < num_rows; ++row) {
+                if (complex_out != NULL) {
+                    transform_row(range, plan, src, &complex_out[offset]);
+                } else {
+                    xensiv_bgt60trxx_complex_t *tmp = (xensiv_bgt60trxx_complex_t *) range->scratch;
+                    transform_row(range, plan, src, tmp);
+                    for (uint32_t bin = 0; bin < bins; ++bin) {
+                        magnitude_out[offset + bin] =
+                            sqrtf((tmp[bin].re * tmp[bin].re) + (tmp[bin].im * tmp[bin].im));
+                    }
+                }
+                src += segment->row_stride;
+                offset += bins;
+            }
+        }
+    }
+}
+
+
+void xensiv_bgt60trxx_range_process(xensiv_bgt60trxx_range_t *range,
+                                    const uint16_t *frame,
+                                    xensiv_bgt60trxx_complex_t *out)
+{
+    xensiv_bgt60trxx_platform_assert(range != NULL);
+    xensiv_bgt60trxx_platform_assert((frame != NULL) && (out != NULL));
+
+    process(range, frame, out, NULL);
+}
+
+
+void xensiv_bgt60trxx_range_process_magnitude(xensiv_bgt60trxx_range_t *range,
+                                              const uint16_t *frame,
+                                              float *out)
+{
+    xensiv_bgt60trxx_platform_assert(range != NULL);
+    xensiv_bgt60trxx_platform_assert((frame != NULL) && (out != NULL));
+
+    process(range, frame, NULL, out);
+}
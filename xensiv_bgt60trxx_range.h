@@ -0,0 +1,184 @@
+/***********************************************************************************************/ /**
+                                                                                                   * \file xensiv_bgt60trxx_range.h
+                                                                                                   *
+                                                                                                   * \brief
+                                                                                                   * This file contains the range processing stage of the XENSIV(TM) BGT60TRxx radar sensor:
+                                                                                                   * DC removal, windowing and a real-input FFT of every chirp of an assembled frame.
+                                                                                                   *
+                                                                                                   ***************************************************************************************************
+                                                                                                   * \copyright
+                                                                                                   * Copyright 2022 Infineon Technologies AG
+                                                                                                   * SPDX-License-Identifier: Apache-2.0
+                                                                                                   *
+                                                                                                   * Licensed under the Apache License, Version 2.0 (the "License");
+                                                                                                   * you may not use this file except in compliance with the License.
+                                                                                                   * You may obtain a copy of the License at
+                                                                                                   *
+                                                                                                   *     http://www.apache.org/licenses/LICENSE-2.0
+                                                                                                   *
+                                                                                                   * Unless required by applicable law or agreed to in writing, software
+                                                                                                   * distributed under the License is distributed on an "AS IS" BASIS,
+                                                                                                   * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+                                                                                                   * See the License for the specific language governing permissions and
+                                                                                                   * limitations under the License.
+                                                                                                   **************************************************************************************************/
+
+#ifndef XENSIV_BGT60TRXX_RANGE_H_
+#define XENSIV_BGT60TRXX_RANGE_H_
+
+/**
+ * \addtogroup group_board_libs_range XENSIV(TM) BGT60TRxx range processing
+ * \{
+ * Turns every chirp of a planar frame from the frame assembler into a range profile: the mean
+ * of the chirp is removed, the window applied, the chirp zero-padded to the FFT size and
+ * transformed with a real-input FFT. The fft_size/2 positive frequency bins of each chirp are
+ * written as complex values or magnitudes to a caller buffer laid out like the frame:
+ * [group][segment][rx][chirp][bin].
+ *
+ * Windows and FFT plans are built once at initialization, one per distinct number of samples
+ * per chirp of the configuration, into caller-provided storage; segments with the same chirp
+ * length share them. Processing allocates nothing. The magnitude output uses a scratch row in
+ * the storage, so a range object must not process two frames at the same time.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "xensiv_bgt60trxx_assembler.h"
+#include "xensiv_bgt60trxx_fft.h"
+
+/********************************* Type definitions **************************************/
+
+/** enum with the range windows */
+typedef enum {
+    XENSIV_BGT60TRXX_WINDOW_RECT = 0,           /**< No window */
+    XENSIV_BGT60TRXX_WINDOW_HANN = 1,           /**< Hann */
+    XENSIV_BGT60TRXX_WINDOW_HAMMING = 2,        /**< Hamming */
+    XENSIV_BGT60TRXX_WINDOW_BLACKMAN_HARRIS = 3 /**< 4-term Blackman-Harris */
+} xensiv_bgt60trxx_window_t;
+
+/** Range stage configuration */
+typedef struct {
+    xensiv_bgt60trxx_window_t window; /**< Window applied to every chirp */
+    xensiv_bgt60trxx_fft_algo_t algo; /**< FFT kernel */
+    bool remove_dc;                   /**< Subtract the mean of every chirp before windowing */
+    uint32_t fft_size;                /**< FFT size, 0 for the next power of two of each chirp */
+} xensiv_bgt60trxx_range_config_t;
+
+/** Window and FFT plan shared by all segments with the same chirp length */
+typedef struct {
+    uint32_t num_samples;              /**< Samples per chirp */
+    uint32_t fft_size;                 /**< FFT size, bins per profile are fft_size / 2 */
+    float *window;                     /**< num_samples window coefficients */
+    xensiv_bgt60trxx_rfft_plan_t plan; /**< Real-input FFT plan */
+} xensiv_bgt60trxx_range_plan_t;
+
+/** Range stage object */
+typedef struct {
+    xensiv_bgt60trxx_range_config_t config;        /**< Configuration */
+    const xensiv_bgt60trxx_assembler_t *assembler; /**< Frame layout */
+    uint32_t group_bins;                           /**< Output bins per shape group */
+    uint32_t frame_bins;                           /**< Output bins per frame */
+    float *scratch;                                /**< Magnitude output scratch row */
+    uint32_t num_plans;                            /**< Distinct chirp lengths */
+    xensiv_bgt60trxx_range_plan_t plans[XENSIV_BGT60TRXX_ASSEMBLER_MAX_SEGMENTS];
+    uint32_t segment_plan[XENSIV_BGT60TRXX_ASSEMBLER_MAX_SEGMENTS];   /**< Plan per segment */
+    uint32_t segment_offset[XENSIV_BGT60TRXX_ASSEMBLER_MAX_SEGMENTS]; /**< Output offset */
+} xensiv_bgt60trxx_range_t;
+
+/******************************* Function prototypes *************************************/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Computes the coefficients of a symmetric window. A window of one sample is 1 for every
+ * type.
+ *
+ * @param[out] window num_samples coefficients.
+ * @param[in] num_samples Window length.
+ * @param[in] type Window type.
+ */
+void xensiv_bgt60trxx_window_init(float *window,
+                                  uint32_t num_samples,
+                                  xensiv_bgt60trxx_window_t type);
+
+/**
+ * @brief Obtains the storage needed by a range stage.
+ *
+ * @param[in] assembler Frame assembler describing the frames, planar layout.
+ * @param[in] config Range stage configuration.
+ * @return Storage size in bytes.
+ */
+size_t xensiv_bgt60trxx_range_storage_size(const xensiv_bgt60trxx_assembler_t *assembler,
+                                           const xensiv_bgt60trxx_range_config_t *config);
+
+/**
+ * @brief Initializes a range stage, building its windows and FFT plans.
+ *
+ * @param[out] range Pointer to the range stage object.
+ * @param[in] assembler Frame assembler describing the frames, planar layout. Must outlive the
+ * range stage.
+ * @param[in] config Range stage configuration.
+ * @param[out] storage Storage of xensiv_bgt60trxx_range_storage_size() bytes, aligned for
+ * float, owned by the range stage until it is no longer used.
+ * @param[in] storage_size Size of storage in bytes.
+ * @return XENSIV_BGT60TRXX_STATUS_OK if the range stage was initialized;
+ * XENSIV_BGT60TRXX_STATUS_DEV_ERROR if the storage is too small or fft_size is not a power of
+ * two covering every chirp.
+ */
+int32_t xensiv_bgt60trxx_range_init(xensiv_bgt60trxx_range_t *range,
+                                    const xensiv_bgt60trxx_assembler_t *assembler,
+                                    const xensiv_bgt60trxx_range_config_t *config,
+                                    void *storage,
+                                    size_t storage_size);
+
+/**
+ * @brief Computes the complex range profiles of a frame. Uses the scratch row, so a range stage
+ * must not process two frames at the same time.
+ *
+ * @param[inout] range Pointer to the range stage object.
+ * @param[in] frame Planar frame from the frame assembler.
+ * @param[out] out frame_bins complex bins.
+ */
+void xensiv_bgt60trxx_range_process(xensiv_bgt60trxx_range_t *range,
+                                    const uint16_t *frame,
+                                    xensiv_bgt60trxx_complex_t *out);
+
+/**
+ * @brief Computes the magnitude range profiles of a frame. Uses the scratch row, so a range
+ * stage must not process two frames at the same time.
+ *
+ * @param[inout] range Pointer to the range stage object.
+ * @param[in] frame Planar frame from the frame assembler.
+ * @param[out] out frame_bins magnitudes.
+ */
+void xensiv_bgt60trxx_range_process_magnitude(xensiv_bgt60trxx_range_t *range,
+                                              const uint16_t *frame,
+                                              float *out);
+
+/**
+ * @brief Obtains the offset of the range profile of one chirp and RX channel in the output.
+ *
+ * @param[in] range Pointer to the range stage object.
+ * @param[in] group Shape group.
+ * @param[in] segment Segment index within the shape group.
+ * @param[in] rx RX channel index within the segment.
+ * @param[in] chirp Chirp index.
+ * @return Offset of the first bin in elements.
+ */
+uint32_t xensiv_bgt60trxx_range_profile_offset(const xensiv_bgt60trxx_range_t *range,
+                                               uint32_t group,
+                                               uint32_t segment,
+                                               uint32_t rx,
+                                               uint32_t chirp);
+
+#ifdef __cplusplus
+}
+#endif
+
+/** \} group_board_libs_range */
+
+#endif  // ifndef XENSIV_BGT60TRXX_RANGE_H_
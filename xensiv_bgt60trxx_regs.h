@@ -31,6 +31,11 @@
  * \{
  */
 
+#define XENSIV_BGT60TRXX_SPI_REGADR_MSK (0xFE000000UL) /*!< SPI register word: address msk */
+#define XENSIV_BGT60TRXX_SPI_REGADR_POS (25U)          /*!< SPI register word: address pos */
+#define XENSIV_BGT60TRXX_SPI_DATA_MSK (0x00FFFFFFUL)   /*!< SPI register word: data msk */
+#define XENSIV_BGT60TRXX_SPI_DATA_POS (0U)             /*!< SPI register word: data pos */
+
 #define XENSIV_BGT60TRXX_REG_MAIN (0x00U)         /*!< MAIN: addr */
 #define XENSIV_BGT60TRXX_REG_ADC0 (0x01U)         /*!< ADC0: addr */
 #define XENSIV_BGT60TRXX_REG_CHIP_ID (0x02U)      /*!< CHIP_ID: addr */
@@ -130,6 +135,11 @@
 #define XENSIV_BGT60TRXX_REG_MAIN_RESET_POS (1)                /*!< RESET: pos */
 #define XENSIV_BGT60TRXX_REG_MAIN_RESET_MSK (0x00000eUL)       /*!< RESET: msk */
 
+/* Fields of register ADC0 */
+/* ----------------------- */
+#define XENSIV_BGT60TRXX_REG_ADC0_ADC_DIV_POS (14)          /*!< ADC_DIV: pos */
+#define XENSIV_BGT60TRXX_REG_ADC0_ADC_DIV_MSK (0xffc000UL)  /*!< ADC_DIV: msk */
+
 /* Fields of register CHIP_ID */
 /* -------------------------- */
 #define XENSIV_BGT60TRXX_REG_CHIP_ID_RF_ID_POS (0)               /*!< RF_ID: pos */
@@ -157,6 +167,57 @@
 #define XENSIV_BGT60TRXX_REG_SFCTL_PREFIX_EN_POS (18)            /*!< PREFIX_EN: pos */
 #define XENSIV_BGT60TRXX_REG_SFCTL_PREFIX_EN_MSK (0x040000UL)    /*!< PREFIX_EN: msk */
 
+/* Fields of registers CSx_1 (channel set control, also CSI_1 and CSDS_1) */
+/* ------------------------------------------------------------------------ */
+#define XENSIV_BGT60TRXX_REG_CS_1_BBCH_SEL_POS (20)         /*!< BBCH_SEL: pos */
+#define XENSIV_BGT60TRXX_REG_CS_1_BBCH_SEL_MSK (0xf00000UL) /*!< BBCH_SEL: msk */
+
+/* Fields of register CCR1 */
+/* ----------------------- */
+#define XENSIV_BGT60TRXX_REG_CCR1_TR_FED_POS (0)                /*!< TR_FED: pos */
+#define XENSIV_BGT60TRXX_REG_CCR1_TR_FED_MSK (0x0000ffUL)       /*!< TR_FED: msk */
+#define XENSIV_BGT60TRXX_REG_CCR1_TR_FED_MUL_POS (8)            /*!< TR_FED_MUL: pos */
+#define XENSIV_BGT60TRXX_REG_CCR1_TR_FED_MUL_MSK (0x001f00UL)   /*!< TR_FED_MUL: msk */
+
+/* Fields of register CCR2 */
+/* ----------------------- */
+#define XENSIV_BGT60TRXX_REG_CCR2_MAX_FRAME_CNT_POS (0)          /*!< MAX_FRAME_CNT: pos */
+#define XENSIV_BGT60TRXX_REG_CCR2_MAX_FRAME_CNT_MSK (0x000fffUL) /*!< MAX_FRAME_CNT: msk */
+#define XENSIV_BGT60TRXX_REG_CCR2_FRAME_LEN_POS (12)             /*!< FRAME_LEN: pos */
+#define XENSIV_BGT60TRXX_REG_CCR2_FRAME_LEN_MSK (0xfff000UL)     /*!< FRAME_LEN: msk */
+
+/* Fields of registers PLLx_2 (up-chirp ramp) */
+/* ------------------------------------------ */
+#define XENSIV_BGT60TRXX_REG_PLL_2_RTU_POS (0)           /*!< RTU: pos */
+#define XENSIV_BGT60TRXX_REG_PLL_2_RTU_MSK (0x003fffUL)  /*!< RTU: msk */
+#define XENSIV_BGT60TRXX_REG_PLL_2_TEDU_POS (16)         /*!< TEDU: pos */
+#define XENSIV_BGT60TRXX_REG_PLL_2_TEDU_MSK (0xff0000UL) /*!< TEDU: msk */
+
+/* Fields of registers PLLx_3 (ADC sampling points) */
+/* ------------------------------------------------ */
+#define XENSIV_BGT60TRXX_REG_PLL_3_APU_POS (0)          /*!< APU: pos */
+#define XENSIV_BGT60TRXX_REG_PLL_3_APU_MSK (0x000fffUL) /*!< APU: msk */
+#define XENSIV_BGT60TRXX_REG_PLL_3_APD_POS (12)         /*!< APD: pos */
+#define XENSIV_BGT60TRXX_REG_PLL_3_APD_MSK (0xfff000UL) /*!< APD: msk */
+
+/* Fields of registers PLLx_6 (down-chirp ramp) */
+/* -------------------------------------------- */
+#define XENSIV_BGT60TRXX_REG_PLL_6_RTD_POS (0)           /*!< RTD: pos */
+#define XENSIV_BGT60TRXX_REG_PLL_6_RTD_MSK (0x003fffUL)  /*!< RTD: msk */
+#define XENSIV_BGT60TRXX_REG_PLL_6_TEDD_POS (16)         /*!< TEDD: pos */
+#define XENSIV_BGT60TRXX_REG_PLL_6_TEDD_MSK (0xff0000UL) /*!< TEDD: msk */
+
+/* Fields of registers PLLx_7 (shape control) */
+/* ------------------------------------------ */
+#define XENSIV_BGT60TRXX_REG_PLL_7_REPS_POS (0)               /*!< REPS: pos */
+#define XENSIV_BGT60TRXX_REG_PLL_7_REPS_MSK (0x00000fUL)      /*!< REPS: msk */
+#define XENSIV_BGT60TRXX_REG_PLL_7_SH_EN_POS (4)              /*!< SH_EN: pos */
+#define XENSIV_BGT60TRXX_REG_PLL_7_SH_EN_MSK (0x000010UL)     /*!< SH_EN: msk */
+#define XENSIV_BGT60TRXX_REG_PLL_7_CONT_MODE_POS (5)          /*!< CONT_MODE: pos */
+#define XENSIV_BGT60TRXX_REG_PLL_7_CONT_MODE_MSK (0x000020UL) /*!< CONT_MODE: msk */
+#define XENSIV_BGT60TRXX_REG_PLL_7_PD_MODE_POS (6)            /*!< PD_MODE: pos */
+#define XENSIV_BGT60TRXX_REG_PLL_7_PD_MODE_MSK (0x0000c0UL)   /*!< PD_MODE: msk */
+
 /* Fields of register STAT0 */
 /* ------------------------ */
 #define XENSIV_BGT60TRXX_REG_STAT0_SADC_RDY_POS (0)           /*!< SADC_RDY: pos */
@@ -199,6 +260,7 @@
 #define XENSIV_BGT60TRXX_REG_GSR0_MISO_HS_READ_MSK (0x02UL)  /*!< MISO_HS_READ: msk */
 #define XENSIV_BGT60TRXX_REG_GSR0_SPI_BURST_ERR_MSK (0x04UL) /*!< SPI_BURST_ERR: msk */
 #define XENSIV_BGT60TRXX_REG_GSR0_CLK_NUM_ERR_MSK (0x08UL)   /*!< CLK_NUM_ERR: msk */
+#define XENSIV_BGT60TRXX_REG_GSR0_ERR_MSK (0x0dUL)           /*!< FOU/BURST/CLK_NUM errors */
 
 /** \} group_board_libs */
 
@@ -0,0 +1,128 @@
+/***********************************************************************************************/ /**
+                                                                                                   * \file xensiv_bgt60trxx_ring.c
+                                                                                                   *
+                                                                                                   * \brief
+                                                                                                   * This file contains the lock-free single-producer/single-consumer frame ring
+                                                                                                   * implementation.
+                                                                                                   *
+                                                                                                   ***************************************************************************************************
+                                                                                                   * \copyright
+                                                                                                   * Copyright 2022 Infineon Technologies AG
+                                                                                                   * SPDX-License-Identifier: Apache-2.0
+                                                                                                   *
+                                                                                                   * Licensed under the Apache License, Version 2.0 (the "License");
+                                                                                                   * you may not use this file except in compliance with the License.
+                                                                                                   * You may obtain a copy of the License at
+                                                                                                   *
+                                                                                                   *     http://www.apache.org/licenses/LICENSE-2.0
+                                                                                                   *
+                                                                                                   * Unless required by applicable law or agreed to in writing, software
+                                                                                                   * distributed under the License is distributed on an "AS IS" BASIS,
+                                                                                                   * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+                                                                                                   * See the License for the specific language governing permissions and
+                                                                                                   * limitations under the License.
+                                                                                                   **************************************************************************************************/
+
+#include "xensiv_bgt60trxx_ring.h"
+
+#include <stddef.h>
+
+#include "xensiv_bgt60trxx_platform.h"
+
+/* head and tail are free-running counters; the slot index is counter & mask. The producer
+   publishes head with release semantics after filling the slot and the consumer publishes tail
+   with release semantics after it is done with the slot, so each side sees complete slots. */
+
+void xensiv_bgt60trxx_ring_init(xensiv_bgt60trxx_ring_t *ring,
+                                xensiv_bgt60trxx_frame_t *slots,
+                                uint32_t num_slots,
+                                uint16_t *storage,
+                                uint32_t slot_samples)
+{
+    xensiv_bgt60trxx_platform_assert(ring != NULL);
+    xensiv_bgt60trxx_platform_assert(slots != NULL);
+    xensiv_bgt60trxx_platform_assert(storage != NULL);
+    xensiv_bgt60trxx_platform_assert((num_slots > 0U) && ((num_slots & (num_slots - 1U)) == 0U));
+
+    for (uint32_t i = 0; i < num_slots; ++i) {
+        slots[i].samples = &storage[i * slot_samples];
+        slots[i].num_samples = 0U;
+        slots[i].seq = 0U;
+        slots[i].timestamp_ns = 0U;
+    }
+
+    ring->slots = slots;
+    ring->mask = num_slots - 1U;
+    ring->dropped = 0U;
+    ring->head = 0U;
+    ring->tail = 0U;
+}
+
+
+xensiv_bgt60trxx_frame_t *xensiv_bgt60trxx_ring_write_begin(xensiv_bgt60trxx_ring_t *ring)
+{
+    xensiv_bgt60trxx_platform_assert(ring != NULL);
+
+    uint32_t head = __atomic_load_n(&ring->head, __ATOMIC_RELAXED);
+    uint32_t tail = __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE);
+
+    if ((head - tail) > ring->mask) {
+        __atomic_fetch_add(&ring->dropped, 1U, __ATOMIC_RELAXED);
+        return NULL;
+    }
+
+    return &ring->slots[head & ring->mask];
+}
+
+
+void xensiv_bgt60trxx_ring_write_commit(xensiv_bgt60trxx_ring_t *ring)
+{
+    xensiv_bgt60trxx_platform_assert(ring != NULL);
+
+    uint32_t head = __atomic_load_n(&ring->head, __ATOMIC_RELAXED);
+    __atomic_store_n(&ring->head, head + 1U, __ATOMIC_RELEASE);
+}
+
+
+const xensiv_bgt60trxx_frame_t *xensiv_bgt60trxx_ring_read_acquire(xensiv_bgt60trxx_ring_t *ring)
+{
+    xensiv_bgt60trxx_platform_assert(ring != NULL);
+
+    uint32_t tail = __atomic_load_n(&ring->tail, __ATOMIC_RELAXED);
+    uint32_t head = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+
+    if (head == tail) {
+        return NULL;
+    }
+
+    return &ring->slots[tail & ring->mask];
+}
+
+
+void xensiv_bgt60trxx_ring_read_release(xensiv_bgt60trxx_ring_t *ring)
+{
+    xensiv_bgt60trxx_platform_assert(ring != NULL);
+
+    uint32_t tail = __atomic_load_n(&ring->tail, __ATOMIC_RELAXED);
+    xensiv_bgt60trxx_platform_assert(tail != __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE));
+    __atomic_store_n(&ring->tail, tail + 1U, __ATOMIC_RELEASE);
+}
+
+
+uint32_t xensiv_bgt60trxx_ring_count(const xensiv_bgt60trxx_ring_t *ring)
+{
+    xensiv_bgt60trxx_platform_assert(ring != NULL);
+
+    uint32_t head = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+    uint32_t tail = __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE);
+
+    return head - tail;
+}
+
+
+uint32_t xensiv_bgt60trxx_ring_get_dropped(const xensiv_bgt60trxx_ring_t *ring)
+{
+    xensiv_bgt60trxx_platform_assert(ring != NULL);
+
+    return __atomic_load_n(&ring->dropped, __ATOMIC_RELAXED);
+}
@@ -0,0 +1,148 @@
+/***********************************************************************************************/ /**
+                                                                                                   * \file xensiv_bgt60trxx_ring.h
+                                                                                                   *
+                                                                                                   * \brief
+                                                                                                   * This file contains a lock-free single-producer/single-consumer ring of frame slots used
+                                                                                                   * to hand XENSIV(TM) BGT60TRxx FIFO data from the readout context to the processing context.
+                                                                                                   *
+                                                                                                   ***************************************************************************************************
+                                                                                                   * \copyright
+                                                                                                   * Copyright 2022 Infineon Technologies AG
+                                                                                                   * SPDX-License-Identifier: Apache-2.0
+                                                                                                   *
+                                                                                                   * Licensed under the Apache License, Version 2.0 (the "License");
+                                                                                                   * you may not use this file except in compliance with the License.
+                                                                                                   * You may obtain a copy of the License at
+                                                                                                   *
+                                                                                                   *     http://www.apache.org/licenses/LICENSE-2.0
+                                                                                                   *
+                                                                                                   * Unless required by applicable law or agreed to in writing, software
+                                                                                                   * distributed under the License is distributed on an "AS IS" BASIS,
+                                                                                                   * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+                                                                                                   * See the License for the specific language governing permissions and
+                                                                                                   * limitations under the License.
+                                                                                                   **************************************************************************************************/
+
+#ifndef XENSIV_BGT60TRXX_RING_H_
+#define XENSIV_BGT60TRXX_RING_H_
+
+/**
+ * \addtogroup group_board_libs_ring XENSIV(TM) BGT60TRxx frame ring
+ * \{
+ * Fixed-capacity queue of frame slots shared by exactly one producer (the context draining the
+ * sensor FIFO) and one consumer (the processing context). Slots and sample storage are provided
+ * by the caller, so neither side allocates memory or takes a lock.
+ *
+ * The producer fills the slot returned by xensiv_bgt60trxx_ring_write_begin() and publishes it
+ * with xensiv_bgt60trxx_ring_write_commit(). The consumer works on the slot returned by
+ * xensiv_bgt60trxx_ring_read_acquire() in place and hands it back with
+ * xensiv_bgt60trxx_ring_read_release(). When the ring is full the newest frame is dropped and
+ * counted, a slot held by the consumer is never overwritten.
+ *
+ * Requires the GCC/Clang __atomic builtins.
+ */
+
+#include <stdint.h>
+
+/************************************** Macros *******************************************/
+
+/** Alignment used to keep the producer and consumer indices on separate cache lines. */
+#ifndef XENSIV_BGT60TRXX_RING_CACHE_LINE_SIZE
+    #define XENSIV_BGT60TRXX_RING_CACHE_LINE_SIZE (64U)
+#endif
+
+/********************************* Type definitions **************************************/
+
+/** Frame slot of the ring */
+typedef struct {
+    uint16_t *samples;     /**< Frame samples, slot_samples long */
+    uint32_t num_samples;  /**< Number of valid samples */
+    uint32_t seq;          /**< Frame sequence number, gaps indicate dropped frames */
+    uint64_t timestamp_ns; /**< Acquisition timestamp in ns */
+} xensiv_bgt60trxx_frame_t;
+
+/** Ring object, content initialized using \ref xensiv_bgt60trxx_ring_init */
+typedef struct {
+    xensiv_bgt60trxx_frame_t *slots; /**< Slot array, num_slots long */
+    uint32_t mask;                   /**< num_slots - 1 */
+    uint8_t pad0[XENSIV_BGT60TRXX_RING_CACHE_LINE_SIZE];
+    uint32_t head;                   /**< Next slot to write, owned by the producer */
+    uint32_t dropped;                /**< Frames dropped because the ring was full */
+    uint8_t pad1[XENSIV_BGT60TRXX_RING_CACHE_LINE_SIZE];
+    uint32_t tail;                   /**< Next slot to read, owned by the consumer */
+} xensiv_bgt60trxx_ring_t;
+
+/******************************* Function prototypes *************************************/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Initializes the ring over caller provided slots and sample storage.
+ *
+ * @param[out] ring Pointer to the ring object.
+ * @param[in] slots Slot array, num_slots long.
+ * @param[in] num_slots Number of slots, a power of two.
+ * @param[in] storage Sample storage, num_slots * slot_samples long.
+ * @param[in] slot_samples Capacity of each slot in samples.
+ */
+void xensiv_bgt60trxx_ring_init(xensiv_bgt60trxx_ring_t *ring,
+                                xensiv_bgt60trxx_frame_t *slots,
+                                uint32_t num_slots,
+                                uint16_t *storage,
+                                uint32_t slot_samples);
+
+/**
+ * @brief Producer: obtains the next free slot.
+ *
+ * @param[inout] ring Pointer to the ring object.
+ * @return Slot to fill, or NULL if the ring is full; the frame is then counted as dropped.
+ */
+xensiv_bgt60trxx_frame_t *xensiv_bgt60trxx_ring_write_begin(xensiv_bgt60trxx_ring_t *ring);
+
+/**
+ * @brief Producer: publishes the slot obtained by xensiv_bgt60trxx_ring_write_begin().
+ *
+ * @param[inout] ring Pointer to the ring object.
+ */
+void xensiv_bgt60trxx_ring_write_commit(xensiv_bgt60trxx_ring_t *ring);
+
+/**
+ * @brief Consumer: obtains the oldest published frame without copying it.
+ *
+ * @param[inout] ring Pointer to the ring object.
+ * @return Oldest frame, or NULL if the ring is empty.
+ */
+const xensiv_bgt60trxx_frame_t *xensiv_bgt60trxx_ring_read_acquire(xensiv_bgt60trxx_ring_t *ring);
+
+/**
+ * @brief Consumer: returns the frame obtained by xensiv_bgt60trxx_ring_read_acquire().
+ *
+ * @param[inout] ring Pointer to the ring object.
+ */
+void xensiv_bgt60trxx_ring_read_release(xensiv_bgt60trxx_ring_t *ring);
+
+/**
+ * @brief Obtains the number of published frames not yet released by the consumer.
+ *
+ * @param[in] ring Pointer to the ring object.
+ * @return Number of frames in the ring.
+ */
+uint32_t xensiv_bgt60trxx_ring_count(const xensiv_bgt60trxx_ring_t *ring);
+
+/**
+ * @brief Obtains the number of frames dropped because the ring was full.
+ *
+ * @param[in] ring Pointer to the ring object.
+ * @return Number of dropped frames.
+ */
+uint32_t xensiv_bgt60trxx_ring_get_dropped(const xensiv_bgt60trxx_ring_t *ring);
+
+#ifdef __cplusplus
+}
+#endif
+
+/** \} group_board_libs_ring */
+
+#endif  // ifndef XENSIV_BGT60TRXX_RING_H_
@@ -0,0 +1,675 @@
+/***********************************************************************************************/ /**
+                                                                                                   * \file xensiv_bgt60trxx_tracker.c
+                                                                                                   *
+                                                                                                   * \brief
+                                                                                                   * This file contains the multi-target tracker of the XENSIV(TM) BGT60TRxx radar sensor library:
+                                                                                                   * grid DBSCAN clustering, Kalman filtering and gated data association.
+                                                                                                   *
+                                                                                                   ***************************************************************************************************
+                                                                                                   * \copyright
+                                                                                                   * Copyright 2022 Infineon Technologies AG
+                                                                                                   * SPDX-License-Identifier: Apache-2.0
+                                                                                                   *
+                                                                                                   * Licensed under the Apache License, Version 2.0 (the "License");
+                                                                                                   * you may not use this file except in compliance with the License.
+                                                                                                   * You may obtain a copy of the License at
+                                                                                                   *
+                                                                                                   *     http://www.apache.org/licenses/LICENSE-2.0
+                                                                                                   *
+                                                                                                   * Unless required by applicable law or agreed to in writing, software
+                                                                                                   * distributed under the License is distributed on an "AS IS" BASIS,
+                                                                                                   * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+                                                                                                   * See the License for the specific language governing permissions and
+                                                                                                   * limitations under the License.
+                                                                                                   **************************************************************************************************/
+
+#include "xensiv_bgt60trxx_tracker.h"
+
+#include <float.h>
+#include <math.h>
+#include <string.h>
+
+#include "xensiv_bgt60trxx.h"
+#include "xensiv_bgt60trxx_platform.h"
+
+/* Point labels besides the cluster index */
+#define XENSIV_BGT60TRXX_TRACKER_UNVISITED (-2)
+#define XENSIV_BGT60TRXX_TRACKER_NOISE (-1)
+
+/* Grid cell coordinates are clamped so the hash arithmetic cannot overflow */
+#define XENSIV_BGT60TRXX_TRACKER_MAX_CELL (1073741823.0f)
+
+/* Association size: every track and cluster can also stay unassigned through a dummy */
+static uint32_t assoc_size(const xensiv_bgt60trxx_tracker_config_t *config)
+{
+    return config->max_tracks + config->max_clusters;
+}
+
+
+/* Grid hash table size: a power of two of at least twice the points */
+static uint32_t grid_size(uint32_t num_points)
+{
+    uint32_t size = 1U;
+
+    while (size < (2U * num_points)) {
+        size <<= 1;
+    }
+
+    return size;
+}
+
+
+size_t xensiv_bgt60trxx_tracker_storage_size(const xensiv_bgt60trxx_tracker_config_t *config)
+{
+    xensiv_bgt60trxx_platform_assert(config != NULL);
+
+    const size_t n = assoc_size(config);
+
+    return (config->max_tracks * sizeof(xensiv_bgt60trxx_track_t)) +
+           (config->max_clusters * sizeof(xensiv_bgt60trxx_cluster_t)) +
+           (config->max_points * (sizeof(int32_t) + (3U * sizeof(uint32_t)))) +
+           ((grid_size(config->max_points) + 1U) * sizeof(uint32_t)) +
+           (n * n * sizeof(float)) +
+           (3U * (n + 1U) * sizeof(float)) +
+           (3U * (n + 1U) * sizeof(int32_t)) +
+           (((2U * config->max_tracks) + config->max_clusters) * sizeof(int32_t));
+}
+
+
+static void init_model(xensiv_bgt60trxx_tracker_t *tracker)
+{
+    const float dt = tracker->config.dt;
+    const float q = tracker->config.process_noise;
+    const float dt2 = dt * dt;
+    const float dt3 = dt2 * dt;
+
+    memset(tracker->f, 0, sizeof(tracker->f));
+    memset(tracker->q, 0, sizeof(tracker->q));
+    for (uint32_t i = 0; i < XENSIV_BGT60TRXX_TRACKER_MAX_STATE; ++i) {
+        tracker->f[i][i] = 1.0f;
+    }
+    tracker->f[0][1] = dt;
+
+    if (tracker->config.model == XENSIV_BGT60TRXX_MOTION_CA) {
+        /* White jerk noise */
+        tracker->dim = 3U;
+        tracker->f[0][2] = 0.5f * dt2;
+        tracker->f[1][2] = dt;
+        tracker->q[0][0] = q * (dt3 * dt2) / 20.0f;
+        tracker->q[0][1] = q * (dt2 * dt2) / 8.0f;
+        tracker->q[0][2] = q * dt3 / 6.0f;
+        tracker->q[1][1] = q * dt3 / 3.0f;
+        tracker->q[1][2] = q * dt2 / 2.0f;
+        tracker->q[2][2] = q * dt;
+    } else {
+        /* White acceleration noise */
+        tracker->dim = 2U;
+        tracker->q[0][0] = q * dt3 / 3.0f;
+        tracker->q[0][1] = q * dt2 / 2.0f;
+        tracker->q[1][1] = q * dt;
+    }
+    for (uint32_t i = 0; i < XENSIV_BGT60TRXX_TRACKER_MAX_STATE; ++i) {
+        for (uint32_t j = 0; j < i; ++j) {
+            tracker->q[i][j] = tracker->q[j][i];
+        }
+    }
+}
+
+
+int32_t xensiv_bgt60trxx_tracker_init(xensiv_bgt60trxx_tracker_t *tracker,
+                                      const xensiv_bgt60trxx_tracker_config_t *config,
+                                      void *storage,
+                                      size_t storage_size)
+{
+    xensiv_bgt60trxx_platform_assert(tracker != NULL);
+    xensiv_bgt60trxx_platform_assert(config != NULL);
+    xensiv_bgt60trxx_platform_assert(storage != NULL);
+
+    if ((config->max_points == 0U) || (config->max_clusters == 0U) ||
+        (config->max_tracks == 0U) || !(config->cluster_eps > 0.0f) || !(config->dt > 0.0f) ||
+        !(config->measurement_noise > 0.0f) || !(config->gate > 0.0f) ||
+        (storage_size < xensiv_bgt60trxx_tracker_storage_size(config))) {
+        return XENSIV_BGT60TRXX_STATUS_DEV_ERROR;
+    }
+
+    const uint32_t n = assoc_size(config);
+
+    memset(tracker, 0, sizeof(*tracker));
+    tracker->config = *config;
+    tracker->next_id = 1U;
+    init_model(tracker);
+
+    uint8_t *next = (uint8_t *) storage;
+    tracker->tracks = (xensiv_bgt60trxx_track_t *) next;
+    next += config->max_tracks * sizeof(xensiv_bgt60trxx_track_t);
+    tracker->clusters = (xensiv_bgt60trxx_cluster_t *) next;
+    next += config->max_clusters * sizeof(xensiv_bgt60trxx_cluster_t);
+    tracker->labels = (int32_t *) next;
+    next += config->max_points * sizeof(int32_t);
+    tracker->grid_order = (uint32_t *) next;
+    next += config->max_points * sizeof(uint32_t);
+    tracker->grid_key = (uint32_t *) next;
+    next += config->max_points * sizeof(uint32_t);
+    tracker->queue = (uint32_t *) next;
+    next += config->max_points * sizeof(uint32_t);
+    tracker->grid_start = (uint32_t *) next;
+    next += (grid_size(config->max_points) + 1U) * sizeof(uint32_t);
+    tracker->cost = (float *) next;
+    next += (size_t) n * n * sizeof(float);
+    tracker->work = (float *) next;
+    next += 3U * (n + 1U) * sizeof(float);
+    tracker->assign = (int32_t *) next;
+    next += 3U * (n + 1U) * sizeof(int32_t);
+    tracker->track_cluster = (int32_t *) next;
+    next += config->max_tracks * sizeof(int32_t);
+    tracker->cluster_track = (int32_t *) next;
+    next += config->max_clusters * sizeof(int32_t);
+    tracker->track_slot = (int32_t *) next;
+
+    for (uint32_t t = 0; t < config->max_tracks; ++t) {
+        tracker->tracks[t].state = XENSIV_BGT60TRXX_TRACK_FREE;
+    }
+
+    return XENSIV_BGT60TRXX_STATUS_OK;
+}
+
+
+static int32_t grid_cell(float pos, float inv_eps)
+{
+    float cell = pos * inv_eps;
+
+    /* Also maps NaN to the lowest cell */
+    cell = (cell > -XENSIV_BGT60TRXX_TRACKER_MAX_CELL) ? cell : -XENSIV_BGT60TRXX_TRACKER_MAX_CELL;
+    cell = (cell < XENSIV_BGT60TRXX_TRACKER_MAX_CELL) ? cell : XENSIV_BGT60TRXX_TRACKER_MAX_CELL;
+
+    /* floorf() without the library call */
+    int32_t index = (int32_t) cell;
+    return (cell < (float) index) ? (index - 1) : index;
+}
+
+
+static uint32_t grid_hash(const xensiv_bgt60trxx_tracker_t *tracker, int32_t cx, int32_t cy)
+{
+    return (((uint32_t) cx * 73856093U) ^ ((uint32_t) cy * 19349663U)) & tracker->grid_mask;
+}
+
+
+/* Sorts the points by the hash bucket of their grid cell, with a table sized for the points */
+static void build_grid(xensiv_bgt60trxx_tracker_t *tracker,
+                       const xensiv_bgt60trxx_point_t *points,
+                       uint32_t num_points)
+{
+    const float inv_eps = 1.0f / tracker->config.cluster_eps;
+    uint32_t *start = tracker->grid_start;
+
+    tracker->grid_mask = grid_size(num_points) - 1U;
+    memset(start, 0, (tracker->grid_mask + 2U) * sizeof(uint32_t));
+    for (uint32_t i = 0; i < num_points; ++i) {
+        uint32_t key = grid_hash(tracker, grid_cell(points[i].x, inv_eps),
+                                 grid_cell(points[i].y, inv_eps));
+        tracker->grid_key[i] = key;
+        ++start[key + 1U];
+    }
+    for (uint32_t b = 0; b <= tracker->grid_mask; ++b) {
+        start[b + 1U] += start[b];
+    }
+    for (uint32_t i = 0; i < num_points; ++i) {
+        /* grid_start[key] is advanced while filling and restored below */
+        tracker->grid_order[start[tracker->grid_key[i]]++] = i;
+    }
+    for (uint32_t b = tracker->grid_mask + 1U; b > 0U; --b) {
+        start[b] = start[b - 1U];
+    }
+    start[0] = 0U;
+}
+
+
+/* Visits the points within cluster_eps of point p in the 3 x 3 grid cells around it. Without a
+   cluster index counts them up to cluster_min_points, with one also labels the unlabelled ones
+   and queues the unvisited. */
+static uint32_t visit_region(xensiv_bgt60trxx_tracker_t *tracker,
+                             const xensiv_bgt60trxx_point_t *points,
+                             uint32_t p,
+                             int32_t cluster,
+                             uint32_t *tail)
+{
+    const float eps = tracker->config.cluster_eps;
+    const uint32_t min_points = tracker->config.cluster_min_points;
+    const int32_t cx = grid_cell(points[p].x, 1.0f / eps);
+    const int32_t cy = grid_cell(points[p].y, 1.0f / eps);
+    uint32_t buckets[9];
+    uint32_t num_buckets = 1U;
+    uint32_t count = 0U;
+
+    /* The own cell first, it holds most neighbours */
+    buckets[0] = grid_hash(tracker, cx, cy);
+    for (int32_t dy = -1; dy <= 1; ++dy) {
+        for (int32_t dx = -1; dx <= 1; ++dx) {
+            /* Neighbouring cells may share a bucket; visit each bucket once */
+            uint32_t key = grid_hash(tracker, cx + dx, cy + dy);
+            uint32_t b = 0U;
+            while ((b < num_buckets) && (buckets[b] != key)) {
+                ++b;
+            }
+            if (b == num_buckets) {
+                buckets[num_buckets++] = key;
+            }
+        }
+    }
+
+    for (uint32_t b = 0; b < num_buckets; ++b) {
+        for (uint32_t k = tracker->grid_start[buckets[b]];
+             k < tracker->grid_start[buckets[b] + 1U]; ++k) {
+            const uint32_t q = tracker->grid_order[k];
+            const float dx = points[q].x - points[p].x;
+            const float dy = points[q].y - points[p].y;
+            if (((dx * dx) + (dy * dy)) > (eps * eps)) {
+                continue;
+            }
+            ++count;
+            if (cluster < 0) {
+                if (count >= min_points) {
+                    return count;
+                }
+            } else {
+                if (tracker->labels[q] == XENSIV_BGT60TRXX_TRACKER_UNVISITED) {
+                    tracker->queue[(*tail)++] = q;
+                    tracker->labels[q] = cluster;
+                } else if (tracker->labels[q] == XENSIV_BGT60TRXX_TRACKER_NOISE) {
+                    /* Border point */
+                    tracker->labels[q] = cluster;
+                } else {
+                    /* Already in a cluster */
+                }
+            }
+        }
+    }
+
+    return count;
+}
+
+
+uint32_t xensiv_bgt60trxx_tracker_cluster(xensiv_bgt60trxx_tracker_t *tracker,
+                                          const xensiv_bgt60trxx_point_t *points,
+                                          uint32_t num_points)
+{
+    xensiv_bgt60trxx_platform_assert(tracker != NULL);
+    xensiv_bgt60trxx_platform_assert((points != NULL) || (num_points == 0U));
+    xensiv_bgt60trxx_platform_assert(num_points <= tracker->config.max_points);
+
+    const uint32_t min_points = tracker->config.cluster_min_points;
+    int32_t num_clusters = 0;
+
+    build_grid(tracker, points, num_points);
+    for (uint32_t i = 0; i < num_points; ++i) {
+        tracker->labels[i] = XENSIV_BGT60TRXX_TRACKER_UNVISITED;
+    }
+
+    for (uint32_t p = 0; p < num_points; ++p) {
+        if (tracker->labels[p] != XENSIV_BGT60TRXX_TRACKER_UNVISITED) {
+            continue;
+        }
+        if ((visit_region(tracker, points, p, -1, NULL) < min_points) ||
+            (num_clusters >= (int32_t) tracker->config.max_clusters)) {
+            tracker->labels[p] = XENSIV_BGT60TRXX_TRACKER_NOISE;
+            continue;
+        }
+
+        /* Expand a new cluster from the core point p */
+        uint32_t head = 0U;
+        uint32_t tail = 0U;
+        tracker->labels[p] = num_clusters;
+        tracker->queue[tail++] = p;
+        while (head < tail) {
+            uint32_t q = tracker->queue[head++];
+            if ((q == p) || (visit_region(tracker, points, q, -1, NULL) >= min_points)) {
+                (void) visit_region(tracker, points, q, num_clusters, &tail);
+            }
+        }
+        ++num_clusters;
+    }
+
+    memset(tracker->clusters, 0, (size_t) num_clusters * sizeof(xensiv_bgt60trxx_cluster_t));
+    for (uint32_t i = 0; i < num_points; ++i) {
+        if (tracker->labels[i] >= 0) {
+            xensiv_bgt60trxx_cluster_t *cluster = &tracker->clusters[tracker->labels[i]];
+            cluster->x += points[i].x;
+            cluster->y += points[i].y;
+            cluster->power += points[i].power;
+            ++cluster->num_points;
+        }
+    }
+    for (int32_t c = 0; c < num_clusters; ++c) {
+        tracker->clusters[c].x /= (float) tracker->clusters[c].num_points;
+        tracker->clusters[c].y /= (float) tracker->clusters[c].num_points;
+    }
+    tracker->num_clusters = (uint32_t) num_clusters;
+
+    return tracker->num_clusters;
+}
+
+
+static void predict(const xensiv_bgt60trxx_tracker_t *tracker, xensiv_bgt60trxx_track_t *track)
+{
+    const uint32_t dim = tracker->dim;
+
+    for (uint32_t axis = 0; axis < 2U; ++axis) {
+        float x[XENSIV_BGT60TRXX_TRACKER_MAX_STATE] = {0.0f};
+        float fp[XENSIV_BGT60TRXX_TRACKER_MAX_STATE][XENSIV_BGT60TRXX_TRACKER_MAX_STATE] = {{0}};
+
+        for (uint32_t i = 0; i < dim; ++i) {
+            for (uint32_t k = 0; k < dim; ++k) {
+                x[i] += tracker->f[i][k] * track->x[axis][k];
+                for (uint32_t j = 0; j < dim; ++j) {
+                    fp[i][j] += tracker->f[i][k] * track->p[axis][k][j];
+                }
+            }
+        }
+        for (uint32_t i = 0; i < dim; ++i) {
+            track->x[axis][i] = x[i];
+            for (uint32_t j = 0; j < dim; ++j) {
+                float sum = tracker->q[i][j];
+                for (uint32_t k = 0; k < dim; ++k) {
+                    sum += fp[i][k] * tracker->f[j][k];
+                }
+                track->p[axis][i][j] = sum;
+            }
+        }
+    }
+}
+
+
+static void correct(const xensiv_bgt60trxx_tracker_t *tracker,
+                    xensiv_bgt60trxx_track_t *track,
+                    const xensiv_bgt60trxx_cluster_t *cluster)
+{
+    const uint32_t dim = tracker->dim;
+    const float z[2] = {cluster->x, cluster->y};
+
+    for (uint32_t axis = 0; axis < 2U; ++axis) {
+        float (*p)[XENSIV_BGT60TRXX_TRACKER_MAX_STATE] = track->p[axis];
+        float gain[XENSIV_BGT60TRXX_TRACKER_MAX_STATE];
+        float row[XENSIV_BGT60TRXX_TRACKER_MAX_STATE];
+        float innovation = z[axis] - track->x[axis][0];
+        float s = p[0][0] + tracker->config.measurement_noise;
+
+        for (uint32_t i = 0; i < dim; ++i) {
+            gain[i] = p[i][0] / s;
+            row[i] = p[0][i];
+            track->x[axis][i] += gain[i] * innovation;
+        }
+        for (uint32_t i = 0; i < dim; ++i) {
+            for (uint32_t j = 0; j < dim; ++j) {
+                p[i][j] -= gain[i] * row[j];
+            }
+        }
+    }
+}
+
+
+/* Squared Mahalanobis distance of a cluster from a predicted track */
+static float distance(const xensiv_bgt60trxx_tracker_t *tracker,
+                      const xensiv_bgt60trxx_track_t *track,
+                      const xensiv_bgt60trxx_cluster_t *cluster)
+{
+    const float r = tracker->config.measurement_noise;
+    const float dx = cluster->x - track->x[0][0];
+    const float dy = cluster->y - track->x[1][0];
+
+    return ((dx * dx) / (track->p[0][0][0] + r)) + ((dy * dy) / (track->p[1][0][0] + r));
+}
+
+
+/* Fills the (num_tracks + num_clusters) square cost matrix. Rows are live tracks then one dummy
+   row per cluster, columns are clusters then one dummy column per track. Leaving a track or a
+   cluster unassigned costs the gate, so a pair is only worth assigning inside it. */
+static uint32_t fill_cost(xensiv_bgt60trxx_tracker_t *tracker, uint32_t num_tracks)
+{
+    const uint32_t num_clusters = tracker->num_clusters;
+    const uint32_t n = num_tracks + num_clusters;
+    const float gate = tracker->config.gate;
+    /* Above the cost of leaving both sides of any pair unassigned */
+    const float forbidden = (2.0f * gate) + 1.0f;
+
+    for (uint32_t row = 0; row < n; ++row) {
+        float *cost = &tracker->cost[row * n];
+        for (uint32_t col = 0; col < n; ++col) {
+            if ((row < num_tracks) && (col < num_clusters)) {
+                const xensiv_bgt60trxx_track_t *track = &tracker->tracks[tracker->track_slot[row]];
+                float d2 = distance(tracker, track, &tracker->clusters[col]);
+                cost[col] = (d2 < gate) ? d2 : forbidden;
+            } else if (row < num_tracks) {
+                cost[col] = ((col - num_clusters) == row) ? gate : forbidden;
+            } else if (col < num_clusters) {
+                cost[col] = ((row - num_tracks) == col) ? gate : forbidden;
+            } else {
+                cost[col] = 0.0f;
+            }
+        }
+    }
+
+    return n;
+}
+
+
+/* Minimum cost assignment of the square cost matrix with the O(n^3) shortest augmenting path
+   method, keeping row and column potentials. Leaves the row assigned to column j in p[j]. */
+static void hungarian(xensiv_bgt60trxx_tracker_t *tracker, uint32_t n)
+{
+    float *u = tracker->work;
+    float *v = &u[n + 1U];
+    float *minv = &v[n + 1U];
+    int32_t *p = tracker->assign;
+    int32_t *way = &p[n + 1U];
+    int32_t *used = &way[n + 1U];
+
+    for (uint32_t j = 0; j <= n; ++j) {
+        u[j] = 0.0f;
+        v[j] = 0.0f;
+        p[j] = 0;
+    }
+
+    /* Rows and columns are counted from 1, column 0 holds the row being inserted */
+    for (uint32_t i = 1; i <= n; ++i) {
+        uint32_t j0 = 0U;
+        p[0] = (int32_t) i;
+        for (uint32_t j = 0; j <= n; ++j) {
+            minv[j] = FLT_MAX;
+            used[j] = 0;
+        }
+        do {
+            const uint32_t i0 = (uint32_t) p[j0];
+            const float *cost = &tracker->cost[(i0 - 1U) * n];
+            float delta = FLT_MAX;
+            uint32_t j1 = 0U;
+
+            used[j0] = 1;
+            for (uint32_t j = 1; j <= n; ++j) {
+                if (used[j] == 0) {
+                    float cur = cost[j - 1U] - u[i0] - v[j];
+                    if (cur < minv[j]) {
+                        minv[j] = cur;
+                        way[j] = (int32_t) j0;
+                    }
+                    if (minv[j] < delta) {
+                        delta = minv[j];
+                        j1 = j;
+                    }
+                }
+            }
+            for (uint32_t j = 0; j <= n; ++j) {
+                if (used[j] != 0) {
+                    u[p[j]] += delta;
+                    v[j] -= delta;
+                } else {
+                    minv[j] -= delta;
+                }
+            }
+            j0 = j1;
+        } while (p[j0] != 0);
+
+        /* Flip the augmenting path */
+        do {
+            uint32_t j1 = (uint32_t) way[j0];
+            p[j0] = p[j1];
+            j0 = j1;
+        } while (j0 != 0U);
+    }
+}
+
+
+static void associate_hungarian(xensiv_bgt60trxx_tracker_t *tracker, uint32_t num_tracks)
+{
+    const uint32_t n = fill_cost(tracker, num_tracks);
+
+    hungarian(tracker, n);
+    for (uint32_t col = 0; col < tracker->num_clusters; ++col) {
+        const uint32_t row = (uint32_t) tracker->assign[col + 1U] - 1U;
+        /* Dummy rows and pairs outside the gate leave the cluster unassigned */
+        if ((row < num_tracks) && (tracker->cost[(row * n) + col] < tracker->config.gate)) {
+            const int32_t slot = tracker->track_slot[row];
+            tracker->track_cluster[slot] = (int32_t) col;
+            tracker->cluster_track[col] = slot;
+        }
+    }
+}
+
+
+/* Global nearest neighbour: repeatedly assigns the cheapest remaining pair inside the gate */
+static void associate_gnn(xensiv_bgt60trxx_tracker_t *tracker, uint32_t num_tracks)
+{
+    const uint32_t num_clusters = tracker->num_clusters;
+    const float gate = tracker->config.gate;
+
+    for (uint32_t t = 0; t < num_tracks; ++t) {
+        const xensiv_bgt60trxx_track_t *track = &tracker->tracks[tracker->track_slot[t]];
+        for (uint32_t c = 0; c < num_clusters; ++c) {
+            tracker->cost[(t * num_clusters) + c] =
+                distance(tracker, track, &tracker->clusters[c]);
+        }
+    }
+
+    for (;;) {
+        float best = gate;
+        uint32_t best_track = 0U;
+        uint32_t best_cluster = 0U;
+
+        for (uint32_t t = 0; t < num_tracks; ++t) {
+            if (tracker->track_cluster[tracker->track_slot[t]] >= 0) {
+                continue;
+            }
+            const float *cost = &tracker->cost[t * num_clusters];
+            for (uint32_t c = 0; c < num_clusters; ++c) {
+                if ((cost[c] < best) && (tracker->cluster_track[c] < 0)) {
+                    best = cost[c];
+                    best_track = t;
+                    best_cluster = c;
+                }
+            }
+        }
+        if (!(best < gate)) {
+            break;
+        }
+        tracker->track_cluster[tracker->track_slot[best_track]] = (int32_t) best_cluster;
+        tracker->cluster_track[best_cluster] = tracker->track_slot[best_track];
+    }
+}
+
+
+static void start_track(xensiv_bgt60trxx_tracker_t *tracker,
+                        xensiv_bgt60trxx_track_t *track,
+                        const xensiv_bgt60trxx_cluster_t *cluster)
+{
+    const float z[2] = {cluster->x, cluster->y};
+
+    memset(track, 0, sizeof(*track));
+    track->state = (tracker->config.confirm_hits <= 1U)
+                   ? XENSIV_BGT60TRXX_TRACK_CONFIRMED
+                   : XENSIV_BGT60TRXX_TRACK_TENTATIVE;
+    track->id = tracker->next_id++;
+    track->hits = 1U;
+    track->age = 1U;
+    track->power = cluster->power;
+    for (uint32_t axis = 0; axis < 2U; ++axis) {
+        track->x[axis][0] = z[axis];
+        track->p[axis][0][0] = tracker->config.measurement_noise;
+        track->p[axis][1][1] = tracker->config.initial_velocity_var;
+        if (tracker->dim > 2U) {
+            track->p[axis][2][2] = tracker->config.initial_accel_var;
+        }
+    }
+}
+
+
+void xensiv_bgt60trxx_tracker_update(xensiv_bgt60trxx_tracker_t *tracker,
+                                     const xensiv_bgt60trxx_point_t *points,
+                                     uint32_t num_points)
+{
+    xensiv_bgt60trxx_platform_assert(tracker != NULL);
+
+    const uint32_t num_tracks = tracker->config.max_tracks;
+    const uint32_t num_clusters = xensiv_bgt60trxx_tracker_cluster(tracker, points, num_points);
+    uint32_t num_live = 0U;
+
+    for (uint32_t t = 0; t < num_tracks; ++t) {
+        if (tracker->tracks[t].state != XENSIV_BGT60TRXX_TRACK_FREE) {
+            predict(tracker, &tracker->tracks[t]);
+            ++tracker->tracks[t].age;
+            tracker->track_slot[num_live++] = (int32_t) t;
+        }
+        tracker->track_cluster[t] = -1;
+    }
+    for (uint32_t c = 0; c < num_clusters; ++c) {
+        tracker->cluster_track[c] = -1;
+    }
+
+    if ((num_clusters > 0U) && (num_live > 0U)) {
+        if (tracker->config.association == XENSIV_BGT60TRXX_ASSOC_GNN) {
+            associate_gnn(tracker, num_live);
+        } else {
+            associate_hungarian(tracker, num_live);
+        }
+    }
+
+    for (uint32_t t = 0; t < num_tracks; ++t) {
+        xensiv_bgt60trxx_track_t *track = &tracker->tracks[t];
+        const int32_t c = tracker->track_cluster[t];
+
+        if (track->state == XENSIV_BGT60TRXX_TRACK_FREE) {
+            continue;
+        }
+        if (c >= 0) {
+            correct(tracker, track, &tracker->clusters[c]);
+            track->power = tracker->clusters[c].power;
+            ++track->hits;
+            track->misses = 0U;
+            if (track->hits >= tracker->config.confirm_hits) {
+                track->state = XENSIV_BGT60TRXX_TRACK_CONFIRMED;
+            }
+        } else {
+            /* A tentative track is dropped on its first miss */
+            ++track->misses;
+            if ((track->state == XENSIV_BGT60TRXX_TRACK_TENTATIVE) ||
+                (track->misses >= tracker->config.max_misses)) {
+                track->state = XENSIV_BGT60TRXX_TRACK_FREE;
+            }
+        }
+    }
+
+    /* Unassigned clusters start tracks in free slots, in cluster order */
+    uint32_t slot = 0U;
+    for (uint32_t c = 0; c < num_clusters; ++c) {
+        if (tracker->cluster_track[c] >= 0) {
+            continue;
+        }
+        while ((slot < num_tracks) &&
+               (tracker->tracks[slot].state != XENSIV_BGT60TRXX_TRACK_FREE)) {
+            ++slot;
+        }
+        if (slot == num_tracks) {
+            break;
+        }
+        start_track(tracker, &tracker->tracks[slot], &tracker->clusters[c]);
+        tracker->cluster_track[c] = (int32_t) slot;
+    }
+}
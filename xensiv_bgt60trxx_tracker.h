@@ -0,0 +1,216 @@
+/***********************************************************************************************/ /**
+                                                                                                   * \file xensiv_bgt60trxx_tracker.h
+                                                                                                   *
+                                                                                                   * \brief
+                                                                                                   * This file contains the multi-target tracker of the XENSIV(TM) BGT60TRxx radar sensor library:
+                                                                                                   * grid DBSCAN clustering, Kalman filtering and gated data association.
+                                                                                                   *
+                                                                                                   ***************************************************************************************************
+                                                                                                   * \copyright
+                                                                                                   * Copyright 2022 Infineon Technologies AG
+                                                                                                   * SPDX-License-Identifier: Apache-2.0
+                                                                                                   *
+                                                                                                   * Licensed under the Apache License, Version 2.0 (the "License");
+                                                                                                   * you may not use this file except in compliance with the License.
+                                                                                                   * You may obtain a copy of the License at
+                                                                                                   *
+                                                                                                   *     http://www.apache.org/licenses/LICENSE-2.0
+                                                                                                   *
+                                                                                                   * Unless required by applicable law or agreed to in writing, software
+                                                                                                   * distributed under the License is distributed on an "AS IS" BASIS,
+                                                                                                   * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+                                                                                                   * See the License for the specific language governing permissions and
+                                                                                                   * limitations under the License.
+                                                                                                   **************************************************************************************************/
+
+#ifndef XENSIV_BGT60TRXX_TRACKER_H_
+#define XENSIV_BGT60TRXX_TRACKER_H_
+
+/**
+ * \addtogroup group_board_libs_tracker XENSIV(TM) BGT60TRxx multi-target tracker
+ * \{
+ * Turns the detections of each frame into tracks with stable IDs. Detections are given as
+ * points in a Cartesian plane, for example range and azimuth converted to x and y.
+ *
+ * Every update runs four steps:
+ * - The points are clustered with DBSCAN. Points are hashed into a grid of cluster_eps cells, so
+ *   a neighbour query only visits the 3 x 3 cells around a point instead of every point.
+ * - Each track is predicted with a constant velocity or constant acceleration Kalman filter.
+ *   The axes are filtered independently, which is exact for position measurements with the
+ *   same noise on both axes.
+ * - Clusters are associated to tracks within a Mahalanobis gate, either optimally with the
+ *   Hungarian algorithm or greedily by nearest neighbour (GNN).
+ * - Associated tracks are updated. Unassociated clusters start tentative tracks that are
+ *   confirmed after confirm_hits associations; tracks are deleted after max_misses frames
+ *   without one, tentative tracks after their first miss.
+ *
+ * All memory is caller-provided at initialization and sized by max_points, max_clusters and
+ * max_tracks; an update does not allocate.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/************************************** Macros *******************************************/
+
+/** Largest Kalman filter state per axis: position, velocity and acceleration */
+#define XENSIV_BGT60TRXX_TRACKER_MAX_STATE (3U)
+
+/********************************* Type definitions **************************************/
+
+/** enum with the Kalman filter motion models */
+typedef enum {
+    XENSIV_BGT60TRXX_MOTION_CV = 0, /**< Constant velocity, white acceleration noise */
+    XENSIV_BGT60TRXX_MOTION_CA = 1  /**< Constant acceleration, white jerk noise */
+} xensiv_bgt60trxx_motion_model_t;
+
+/** enum with the data association methods */
+typedef enum {
+    XENSIV_BGT60TRXX_ASSOC_HUNGARIAN = 0, /**< Minimum total distance assignment */
+    XENSIV_BGT60TRXX_ASSOC_GNN = 1        /**< Greedy, closest gated pairs first */
+} xensiv_bgt60trxx_association_t;
+
+/** enum with the track states */
+typedef enum {
+    XENSIV_BGT60TRXX_TRACK_FREE = 0,      /**< Unused slot */
+    XENSIV_BGT60TRXX_TRACK_TENTATIVE = 1, /**< Started, not yet confirmed */
+    XENSIV_BGT60TRXX_TRACK_CONFIRMED = 2  /**< Confirmed */
+} xensiv_bgt60trxx_track_state_t;
+
+/** Detection point */
+typedef struct {
+    float x;     /**< Horizontal position */
+    float y;     /**< Vertical or depth position */
+    float power; /**< Detection power, summed per cluster */
+} xensiv_bgt60trxx_point_t;
+
+/** Cluster of points */
+typedef struct {
+    float x;             /**< Mean horizontal position */
+    float y;             /**< Mean vertical or depth position */
+    float power;         /**< Summed power */
+    uint32_t num_points; /**< Points in the cluster */
+} xensiv_bgt60trxx_cluster_t;
+
+/** Track */
+typedef struct {
+    xensiv_bgt60trxx_track_state_t state; /**< Track state */
+    uint32_t id;                          /**< Track ID, unique for the tracker lifetime */
+    uint32_t hits;                        /**< Associations since the track started */
+    uint32_t misses;                      /**< Consecutive frames without association */
+    uint32_t age;                         /**< Frames since the track started */
+    float power;                          /**< Power of the last associated cluster */
+    /** Kalman state per axis (x, y): position, velocity, acceleration */
+    float x[2][XENSIV_BGT60TRXX_TRACKER_MAX_STATE];
+    /** Kalman covariance per axis */
+    float p[2][XENSIV_BGT60TRXX_TRACKER_MAX_STATE][XENSIV_BGT60TRXX_TRACKER_MAX_STATE];
+} xensiv_bgt60trxx_track_t;
+
+/** Tracker configuration */
+typedef struct {
+    xensiv_bgt60trxx_motion_model_t model;      /**< Motion model */
+    xensiv_bgt60trxx_association_t association; /**< Data association method */
+    uint32_t max_points;                        /**< Points per update */
+    uint32_t max_clusters;                      /**< Clusters per update, more are dropped */
+    uint32_t max_tracks;                        /**< Tracks, no birth while all are in use */
+    float cluster_eps;                          /**< DBSCAN neighbourhood radius */
+    uint32_t cluster_min_points;                /**< DBSCAN points to form a core point */
+    float dt;                                   /**< Update period in seconds */
+    float process_noise;                        /**< Acceleration (CV) or jerk (CA) density */
+    float measurement_noise;                    /**< Cluster position variance per axis */
+    float initial_velocity_var;                 /**< Velocity variance of a new track */
+    float initial_accel_var;                    /**< Acceleration variance of a new track (CA) */
+    float gate;                                 /**< Squared Mahalanobis distance gate */
+    uint32_t confirm_hits;                      /**< Associations to confirm a track */
+    uint32_t max_misses;                        /**< Misses to delete a confirmed track */
+} xensiv_bgt60trxx_tracker_config_t;
+
+/** Tracker object */
+typedef struct {
+    xensiv_bgt60trxx_tracker_config_t config; /**< Configuration */
+    uint32_t dim;                             /**< Kalman state per axis */
+    /** State transition per axis */
+    float f[XENSIV_BGT60TRXX_TRACKER_MAX_STATE][XENSIV_BGT60TRXX_TRACKER_MAX_STATE];
+    /** Process noise covariance per axis */
+    float q[XENSIV_BGT60TRXX_TRACKER_MAX_STATE][XENSIV_BGT60TRXX_TRACKER_MAX_STATE];
+    uint32_t next_id;                     /**< ID of the next track */
+    xensiv_bgt60trxx_track_t *tracks;     /**< max_tracks track slots */
+    xensiv_bgt60trxx_cluster_t *clusters; /**< Clusters of the last update */
+    uint32_t num_clusters;                /**< Clusters of the last update */
+    int32_t *labels;                      /**< Cluster per point, -1 for noise */
+    uint32_t grid_mask;                   /**< Grid hash table size of the last update minus one */
+    uint32_t *grid_start;                 /**< First sorted point per hash bucket */
+    uint32_t *grid_order;                 /**< Points sorted by hash bucket */
+    uint32_t *grid_key;                   /**< Hash bucket per point */
+    uint32_t *queue;                      /**< DBSCAN expansion queue */
+    float *cost;                          /**< Association cost matrix */
+    float *work;                          /**< Association scratch */
+    int32_t *assign;                      /**< Association scratch */
+    int32_t *track_cluster;               /**< Cluster per track slot, -1 if none */
+    int32_t *cluster_track;               /**< Track slot per cluster, -1 if none */
+    int32_t *track_slot;                  /**< Track slot per association row */
+} xensiv_bgt60trxx_tracker_t;
+
+/******************************* Function prototypes *************************************/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Obtains the storage needed by a tracker.
+ *
+ * @param[in] config Tracker configuration.
+ * @return Storage size in bytes.
+ */
+size_t xensiv_bgt60trxx_tracker_storage_size(const xensiv_bgt60trxx_tracker_config_t *config);
+
+/**
+ * @brief Initializes a tracker without tracks.
+ *
+ * @param[out] tracker Pointer to the tracker object.
+ * @param[in] config Tracker configuration.
+ * @param[out] storage Storage of xensiv_bgt60trxx_tracker_storage_size() bytes, aligned for
+ * float, owned by the tracker until it is no longer used.
+ * @param[in] storage_size Size of storage in bytes.
+ * @return XENSIV_BGT60TRXX_STATUS_OK if the tracker was initialized;
+ * XENSIV_BGT60TRXX_STATUS_DEV_ERROR if the storage is too small, a capacity is zero, or
+ * cluster_eps, dt, measurement_noise or gate is not positive.
+ */
+int32_t xensiv_bgt60trxx_tracker_init(xensiv_bgt60trxx_tracker_t *tracker,
+                                      const xensiv_bgt60trxx_tracker_config_t *config,
+                                      void *storage,
+                                      size_t storage_size);
+
+/**
+ * @brief Clusters points with DBSCAN into tracker->clusters, labelling each point.
+ *
+ * @param[in,out] tracker Pointer to the tracker object.
+ * @param[in] points Detection points.
+ * @param[in] num_points Number of points, at most max_points.
+ * @return Number of clusters, at most max_clusters.
+ */
+uint32_t xensiv_bgt60trxx_tracker_cluster(xensiv_bgt60trxx_tracker_t *tracker,
+                                          const xensiv_bgt60trxx_point_t *points,
+                                          uint32_t num_points);
+
+/**
+ * @brief Runs one tracker update: clustering, prediction, association, correction and track
+ * management. The tracks are in tracker->tracks; slots in the FREE state are unused.
+ *
+ * @param[in,out] tracker Pointer to the tracker object.
+ * @param[in] points Detection points of the frame.
+ * @param[in] num_points Number of points, at most max_points.
+ */
+void xensiv_bgt60trxx_tracker_update(xensiv_bgt60trxx_tracker_t *tracker,
+                                     const xensiv_bgt60trxx_point_t *points,
+                                     uint32_t num_points);
+
+#ifdef __cplusplus
+}
+#endif
+
+/** \} group_board_libs_tracker */
+
+#endif  // ifndef XENSIV_BGT60TRXX_TRACKER_H_
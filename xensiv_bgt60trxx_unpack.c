@@ -0,0 +1,242 @@
+/***********************************************************************************************/ /**
+                                                                                                   * \file xensiv_bgt60trxx_unpack.c
+                                                                                                   *
+                                                                                                   * \brief
+                                                                                                   * This file contains the scalar and SIMD implementations of the FIFO word unpacking
+                                                                                                   * for the XENSIV(TM) BGT60TRxx 60GHz FMCW radar sensors.
+                                                                                                   *
+                                                                                                   ***************************************************************************************************
+                                                                                                   * \copyright
+                                                                                                   * Copyright 2022 Infineon Technologies AG
+                                                                                                   * SPDX-License-Identifier: Apache-2.0
+                                                                                                   *
+                                                                                                   * Licensed under the Apache License, Version 2.0 (the "License");
+                                                                                                   * you may not use this file except in compliance with the License.
+                                                                                                   * You may obtain a copy of the License at
+                                                                                                   *
+                                                                                                   *     http://www.apache.org/licenses/LICENSE-2.0
+                                                                                                   *
+                                                                                                   * Unless required by applicable law or agreed to in writing, software
+                                                                                                   * distributed under the License is distributed on an "AS IS" BASIS,
+                                                                                                   * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+                                                                                                   * See the License for the specific language governing permissions and
+                                                                                                   * limitations under the License.
+                                                                                                   **************************************************************************************************/
+
+#include "xensiv_bgt60trxx_unpack.h"
+
+#include <stddef.h>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    #define XENSIV_BGT60TRXX_UNPACK_X86 (1)
+    #include <immintrin.h>
+#endif
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+    #define XENSIV_BGT60TRXX_UNPACK_ARM_NEON (1)
+    #include <arm_neon.h>
+#endif
+
+/* Bytes consumed per FIFO word and samples produced from it */
+#define XENSIV_BGT60TRXX_UNPACK_WORD_BYTES (3U)
+#define XENSIV_BGT60TRXX_UNPACK_WORD_SAMPLES (2U)
+
+typedef void (*unpack_func_t)(const uint8_t *src, uint16_t *dst, uint32_t num_samples);
+
+static void unpack_scalar(const uint8_t *src, uint16_t *dst, uint32_t num_samples)
+{
+    for (uint32_t i = 0; i < (num_samples / XENSIV_BGT60TRXX_UNPACK_WORD_SAMPLES); ++i) {
+        uint32_t b0 = src[0];
+        uint32_t b1 = src[1];
+        uint32_t b2 = src[2];
+
+        dst[0] = (uint16_t) ((b0 << 4) | (b1 >> 4));
+        dst[1] = (uint16_t) (((b1 & 0x0FU) << 8) | b2);
+
+        src += XENSIV_BGT60TRXX_UNPACK_WORD_BYTES;
+        dst += XENSIV_BGT60TRXX_UNPACK_WORD_SAMPLES;
+    }
+}
+
+
+#if defined(XENSIV_BGT60TRXX_UNPACK_X86)
+/* Each FIFO word {b0, b1, b2} is shuffled into two little-endian 16-bit lanes {b1, b0} and
+   {b2, b1}. The even lane is then shifted right by 4 and the odd lane masked to 12 bits. */
+    #define XENSIV_BGT60TRXX_UNPACK_SHUFFLE_MASK                                                   \
+        1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10
+
+__attribute__((target("ssse3"))) static void unpack_ssse3(const uint8_t *src,
+                                                          uint16_t *dst,
+                                                          uint32_t num_samples)
+{
+    const __m128i shuffle = _mm_setr_epi8(XENSIV_BGT60TRXX_UNPACK_SHUFFLE_MASK);
+    const __m128i even_msk = _mm_set1_epi32(0x0000FFFF);
+    const __m128i odd_msk = _mm_set1_epi32(0x0FFF0000);
+
+    /* 16 bytes are loaded but only 12 consumed, keep the last load inside the buffer */
+    uint32_t i = 0;
+    for (; XENSIV_BGT60TRXX_PACKED_SIZE_BYTES(num_samples - i) >= 16U; i += 8U) {
+        __m128i v = _mm_loadu_si128((const __m128i *) src);
+        v = _mm_shuffle_epi8(v, shuffle);
+        v = _mm_or_si128(_mm_and_si128(_mm_srli_epi16(v, 4), even_msk),
+                         _mm_and_si128(v, odd_msk));
+        _mm_storeu_si128((__m128i *) dst, v);
+
+        src += 12;
+        dst += 8;
+    }
+
+    unpack_scalar(src, dst, num_samples - i);
+}
+
+
+__attribute__((target("avx2"))) static void unpack_avx2(const uint8_t *src,
+                                                        uint16_t *dst,
+                                                        uint32_t num_samples)
+{
+    const __m256i shuffle = _mm256_setr_epi8(XENSIV_BGT60TRXX_UNPACK_SHUFFLE_MASK,
+                                             XENSIV_BGT60TRXX_UNPACK_SHUFFLE_MASK);
+    const __m256i even_msk = _mm256_set1_epi32(0x0000FFFF);
+    const __m256i odd_msk = _mm256_set1_epi32(0x0FFF0000);
+
+    /* Two 16-byte loads 12 bytes apart, 28 bytes must be readable */
+    uint32_t i = 0;
+    for (; XENSIV_BGT60TRXX_PACKED_SIZE_BYTES(num_samples - i) >= 28U; i += 16U) {
+        __m256i v = _mm256_inserti128_si256(
+            _mm256_castsi128_si256(_mm_loadu_si128((const __m128i *) src)),
+            _mm_loadu_si128((const __m128i *) (src + 12)),
+            1);
+        v = _mm256_shuffle_epi8(v, shuffle);
+        v = _mm256_or_si256(_mm256_and_si256(_mm256_srli_epi16(v, 4), even_msk),
+                            _mm256_and_si256(v, odd_msk));
+        _mm256_storeu_si256((__m256i *) dst, v);
+
+        src += 24;
+        dst += 16;
+    }
+
+    unpack_ssse3(src, dst, num_samples - i);
+}
+
+
+#endif  // defined(XENSIV_BGT60TRXX_UNPACK_X86)
+
+
+#if defined(XENSIV_BGT60TRXX_UNPACK_ARM_NEON)
+static void unpack_neon(const uint8_t *src, uint16_t *dst, uint32_t num_samples)
+{
+    const uint8x8_t low_nibble = vdup_n_u8(0x0FU);
+
+    uint32_t i = 0;
+    for (; (i + 32U) <= num_samples; i += 32U) {
+        /* De-interleave 16 FIFO words into b0[], b1[] and b2[] */
+        uint8x16x3_t in = vld3q_u8(src);
+        uint16x8x2_t lo;
+        uint16x8x2_t hi;
+
+        lo.val[0] = vorrq_u16(vshll_n_u8(vget_low_u8(in.val[0]), 4),
+                              vmovl_u8(vshr_n_u8(vget_low_u8(in.val[1]), 4)));
+        lo.val[1] = vorrq_u16(vshll_n_u8(vand_u8(vget_low_u8(in.val[1]), low_nibble), 8),
+                              vmovl_u8(vget_low_u8(in.val[2])));
+        hi.val[0] = vorrq_u16(vshll_n_u8(vget_high_u8(in.val[0]), 4),
+                              vmovl_u8(vshr_n_u8(vget_high_u8(in.val[1]), 4)));
+        hi.val[1] = vorrq_u16(vshll_n_u8(vand_u8(vget_high_u8(in.val[1]), low_nibble), 8),
+                              vmovl_u8(vget_high_u8(in.val[2])));
+
+        /* Re-interleave S0/S1 pairs */
+        vst2q_u16(dst, lo);
+        vst2q_u16(dst + 16, hi);
+
+        src += 48;
+        dst += 32;
+    }
+
+    unpack_scalar(src, dst, num_samples - i);
+}
+
+
+#endif  // defined(XENSIV_BGT60TRXX_UNPACK_ARM_NEON)
+
+
+static unpack_func_t get_func(xensiv_bgt60trxx_unpack_impl_t impl)
+{
+    switch (impl) {
+#if defined(XENSIV_BGT60TRXX_UNPACK_X86)
+        case XENSIV_BGT60TRXX_UNPACK_SSSE3:
+            return unpack_ssse3;
+        case XENSIV_BGT60TRXX_UNPACK_AVX2:
+            return unpack_avx2;
+#endif
+#if defined(XENSIV_BGT60TRXX_UNPACK_ARM_NEON)
+        case XENSIV_BGT60TRXX_UNPACK_NEON:
+            return unpack_neon;
+#endif
+        default:
+            return unpack_scalar;
+    }
+}
+
+
+bool xensiv_bgt60trxx_unpack_impl_supported(xensiv_bgt60trxx_unpack_impl_t impl)
+{
+    switch (impl) {
+        case XENSIV_BGT60TRXX_UNPACK_SCALAR:
+            return true;
+#if defined(XENSIV_BGT60TRXX_UNPACK_X86)
+        case XENSIV_BGT60TRXX_UNPACK_SSSE3:
+            __builtin_cpu_init();
+            return (__builtin_cpu_supports("ssse3") != 0);
+        case XENSIV_BGT60TRXX_UNPACK_AVX2:
+            __builtin_cpu_init();
+            return (__builtin_cpu_supports("avx2") != 0) &&
+                   (__builtin_cpu_supports("ssse3") != 0);
+#endif
+#if defined(XENSIV_BGT60TRXX_UNPACK_ARM_NEON)
+        case XENSIV_BGT60TRXX_UNPACK_NEON:
+            return true;
+#endif
+        default:
+            return false;
+    }
+}
+
+
+xensiv_bgt60trxx_unpack_impl_t xensiv_bgt60trxx_unpack_get_impl(void)
+{
+    static const xensiv_bgt60trxx_unpack_impl_t preference[] = {XENSIV_BGT60TRXX_UNPACK_AVX2,
+                                                                XENSIV_BGT60TRXX_UNPACK_NEON,
+                                                                XENSIV_BGT60TRXX_UNPACK_SSSE3};
+
+    for (size_t i = 0; i < (sizeof(preference) / sizeof(preference[0])); ++i) {
+        if (xensiv_bgt60trxx_unpack_impl_supported(preference[i])) {
+            return preference[i];
+        }
+    }
+
+    return XENSIV_BGT60TRXX_UNPACK_SCALAR;
+}
+
+
+void xensiv_bgt60trxx_unpack_fifo_data_impl(xensiv_bgt60trxx_unpack_impl_t impl,
+                                            const uint8_t *src,
+                                            uint16_t *dst,
+                                            uint32_t num_samples)
+{
+    get_func(impl)(src, dst, num_samples);
+}
+
+
+void xensiv_bgt60trxx_unpack_fifo_data(const uint8_t *src, uint16_t *dst, uint32_t num_samples)
+{
+    /* Resolved once; concurrent first calls store the same value, atomically so that the
+       lazy initialisation is not a data race */
+    static unpack_func_t cached = NULL;
+    unpack_func_t func = __atomic_load_n(&cached, __ATOMIC_RELAXED);
+
+    if (func == NULL) {
+        func = get_func(xensiv_bgt60trxx_unpack_get_impl());
+        __atomic_store_n(&cached, func, __ATOMIC_RELAXED);
+    }
+
+    func(src, dst, num_samples);
+}
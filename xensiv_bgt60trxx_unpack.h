@@ -0,0 +1,117 @@
+/***********************************************************************************************/ /**
+                                                                                                   * \file xensiv_bgt60trxx_unpack.h
+                                                                                                   *
+                                                                                                   * \brief
+                                                                                                   * This file contains the functions for unpacking the 24-bit FIFO words read from the
+                                                                                                   * XENSIV(TM) BGT60TRxx 60GHz FMCW radar sensors into 12-bit ADC samples.
+                                                                                                   *
+                                                                                                   ***************************************************************************************************
+                                                                                                   * \copyright
+                                                                                                   * Copyright 2022 Infineon Technologies AG
+                                                                                                   * SPDX-License-Identifier: Apache-2.0
+                                                                                                   *
+                                                                                                   * Licensed under the Apache License, Version 2.0 (the "License");
+                                                                                                   * you may not use this file except in compliance with the License.
+                                                                                                   * You may obtain a copy of the License at
+                                                                                                   *
+                                                                                                   *     http://www.apache.org/licenses/LICENSE-2.0
+                                                                                                   *
+                                                                                                   * Unless required by applicable law or agreed to in writing, software
+                                                                                                   * distributed under the License is distributed on an "AS IS" BASIS,
+                                                                                                   * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+                                                                                                   * See the License for the specific language governing permissions and
+                                                                                                   * limitations under the License.
+                                                                                                   **************************************************************************************************/
+
+#ifndef XENSIV_BGT60TRXX_UNPACK_H_
+#define XENSIV_BGT60TRXX_UNPACK_H_
+
+/**
+ * \addtogroup group_board_libs_unpack XENSIV(TM) BGT60TRxx FIFO data unpacking
+ * \{
+ * The sensor FIFO stores two 12-bit ADC samples in each 24-bit FIFO word. Platforms that cannot
+ * clock the SPI with a 12-bit word length read the FIFO as a packed byte stream and use the
+ * functions below to expand it into one sample per uint16_t.
+ *
+ * Byte layout of a FIFO word (MSB first on the wire):
+ * \code
+ *   byte 0       byte 1       byte 2
+ *   S0[11:4]     S0[3:0] S1[11:8]   S1[7:0]
+ * \endcode
+ *
+ * The fastest kernel supported by the running CPU is selected on first use. SSSE3 and AVX2 are
+ * detected at runtime on x86, NEON is used when the compiler targets it on ARM, and a portable
+ * scalar kernel is used everywhere else.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/************************************** Macros *******************************************/
+
+/** Number of packed bytes holding the given (even) number of 12-bit samples. */
+#define XENSIV_BGT60TRXX_PACKED_SIZE_BYTES(num_samples) (((num_samples) * 3U) / 2U)
+
+/********************************* Type definitions **************************************/
+
+/** enum with the available unpack kernels */
+typedef enum {
+    XENSIV_BGT60TRXX_UNPACK_SCALAR = 0, /**< Portable C implementation */
+    XENSIV_BGT60TRXX_UNPACK_SSSE3 = 1,  /**< x86 SSSE3 implementation (16 bytes per step) */
+    XENSIV_BGT60TRXX_UNPACK_AVX2 = 2,   /**< x86 AVX2 implementation (32 bytes per step) */
+    XENSIV_BGT60TRXX_UNPACK_NEON = 3    /**< ARM NEON implementation (48 bytes per step) */
+} xensiv_bgt60trxx_unpack_impl_t;
+
+/******************************* Function prototypes *************************************/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Unpacks FIFO words into 12-bit samples using the fastest available kernel.
+ *
+ * @param[in] src Pointer to the packed FIFO data, XENSIV_BGT60TRXX_PACKED_SIZE_BYTES(num_samples)
+ * bytes long.
+ * @param[out] dst Pointer to the output buffer, num_samples elements long.
+ * @param[in] num_samples Number of samples to unpack.
+ * @note num_samples should be an even number. src and dst must not overlap.
+ */
+void xensiv_bgt60trxx_unpack_fifo_data(const uint8_t *src, uint16_t *dst, uint32_t num_samples);
+
+/**
+ * @brief Unpacks FIFO words into 12-bit samples using the given kernel.
+ * Intended for testing and benchmarking; the kernel must be supported by the running CPU.
+ *
+ * @param[in] impl Kernel to use.
+ * @param[in] src Pointer to the packed FIFO data.
+ * @param[out] dst Pointer to the output buffer.
+ * @param[in] num_samples Number of samples to unpack.
+ */
+void xensiv_bgt60trxx_unpack_fifo_data_impl(xensiv_bgt60trxx_unpack_impl_t impl,
+                                            const uint8_t *src,
+                                            uint16_t *dst,
+                                            uint32_t num_samples);
+
+/**
+ * @brief Checks whether a kernel is compiled in and supported by the running CPU.
+ *
+ * @param[in] impl Kernel to check.
+ * @return true if the kernel can be used, false otherwise.
+ */
+bool xensiv_bgt60trxx_unpack_impl_supported(xensiv_bgt60trxx_unpack_impl_t impl);
+
+/**
+ * @brief Obtains the kernel selected by xensiv_bgt60trxx_unpack_fifo_data().
+ *
+ * @return Selected kernel.
+ */
+xensiv_bgt60trxx_unpack_impl_t xensiv_bgt60trxx_unpack_get_impl(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+/** \} group_board_libs_unpack */
+
+#endif  // ifndef XENSIV_BGT60TRXX_UNPACK_H_